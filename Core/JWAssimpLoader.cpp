@@ -397,6 +397,9 @@ PRIVATE void JWAssimpLoader::ExtractAnimationSet(const aiScene* Scene, const SMo
 			animation.TotalAnimationTicks = static_cast<float>(ai_animation->mDuration);
 
 			animation.TotalFrameCount = static_cast<int>(animation.TotalAnimationTicks / animation.AnimationTicksPerGameTick);
+
+			// NodeID -> channel index (filled below)
+			animation.vNodeAnimationIndexFromNodeID.resize(NodeTree.vNodes.size(), KInvalidNodeAnimationIndex);
 			
 			// channel = animation of a single node
 			if (ai_animation->mNumChannels)
@@ -415,6 +418,8 @@ PRIVATE void JWAssimpLoader::ExtractAnimationSet(const aiScene* Scene, const SMo
 						{
 							// We found the matching name
 							node_animation.NodeID = node.ID;
+
+							animation.vNodeAnimationIndexFromNodeID[node.ID] = static_cast<int32_t>(animation.vNodeAnimation.size() - 1);
 							break;
 						}
 					}
@@ -3,8 +3,10 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <algorithm>
 #include <memory>
 #include <map>
+#include <unordered_map>
 #include <cassert>
 #include <chrono>
 #include <cstdint>
@@ -40,6 +42,9 @@
 	template <typename KeyType, typename ValueType>
 	using MAP = std::map<KeyType, ValueType>;
 
+	template <typename KeyType, typename ValueType>
+	using UNORDERED_MAP = std::unordered_map<KeyType, ValueType>;
+
 	template <typename T>
 	using UNIQUE_PTR = std::unique_ptr<T>;
 
@@ -122,6 +127,33 @@ namespace JWEngine
 	using EntityIndexType = uint32_t;
 	static constexpr EntityIndexType KInvalidEntityIndex{ (EntityIndexType)-1 };
 
+	// Generational entity handle
+	// Low KEntityHandleIndexBits bits are the entity index (slot), the rest is the generation of the slot.
+	// The generation is increased every time the slot is freed, so handles to destroyed entities become stale.
+	using EntityHandleType = uint32_t;
+	static constexpr EntityHandleType KInvalidEntityHandle{ (EntityHandleType)-1 };
+	static constexpr uint32_t KEntityHandleIndexBits{ 20 };
+	static constexpr uint32_t KEntityHandleIndexMask{ (1u << KEntityHandleIndexBits) - 1 };
+	static constexpr uint32_t KEntityHandleGenerationMask{ (1u << (32 - KEntityHandleIndexBits)) - 1 };
+
+	// The last index is never used so that KInvalidEntityHandle can't be a valid handle.
+	static constexpr uint32_t KMaxEntityCount{ KEntityHandleIndexMask };
+
+	inline auto MakeEntityHandle(EntityIndexType Index, uint32_t Generation) noexcept->EntityHandleType
+	{
+		return ((Generation & KEntityHandleGenerationMask) << KEntityHandleIndexBits) | (Index & KEntityHandleIndexMask);
+	}
+
+	inline auto GetEntityHandleIndex(EntityHandleType Handle) noexcept->EntityIndexType
+	{
+		return (Handle & KEntityHandleIndexMask);
+	}
+
+	inline auto GetEntityHandleGeneration(EntityHandleType Handle) noexcept->uint32_t
+	{
+		return (Handle >> KEntityHandleIndexBits);
+	}
+
 	using ComponentIndexType = uint32_t;
 	static constexpr ComponentIndexType KInvalidComponentIndex{ (ComponentIndexType)-1 };
 
@@ -519,8 +551,9 @@ namespace JWEngine
 		// Loaded at model import time, and will not be altered.
 		XMMATRIX Offset{};
 
-		// Updated evrey (rendering) frame according to node's animation.
-		XMMATRIX FinalTransformation{};
+		// @important
+		// Final transformations are not stored here, because a model is shared by many components.
+		// Each component's pose lives in JWSystemRender's pose buffer.
 
 		SModelBone() = default;
 		SModelBone(STRING _Name) :Name{ _Name } {};
@@ -557,6 +590,49 @@ namespace JWEngine
 		VECTOR<SModelAnimationKeyScaling> vKeyScaling;
 	};
 
+	static constexpr int32_t KInvalidNodeAnimationIndex{ -1 };
+
+	// How far a key cursor walks forward before giving up and doing a binary search
+	static constexpr uint32_t KAnimationKeyCursorMaxSteps{ 4 };
+
+	// Last used key indices of a node animation (cached per instance, indexed by node ID)
+	struct SAnimationKeyCursor
+	{
+		uint32_t Position{};
+		uint32_t Rotation{};
+		uint32_t Scaling{};
+	};
+
+	// Returns the index of the last key whose TimeInTicks <= TimeInTicks (0 if there's no such key).
+	// Playback moves forward a little every frame, so the hint is usually right or a few keys behind.
+	// Otherwise (seek, loop) it falls back to binary search.
+	// @important: vKeys must not be empty.
+	template <typename KeyType>
+	static auto FindAnimationKeyIndex(const VECTOR<KeyType>& vKeys, float TimeInTicks, uint32_t Hint = 0) noexcept->uint32_t
+	{
+		auto key_count = static_cast<uint32_t>(vKeys.size());
+		assert(key_count);
+
+		auto search_begin = vKeys.begin();
+		if ((Hint < key_count) && (vKeys[Hint].TimeInTicks <= TimeInTicks))
+		{
+			for (uint32_t step = 0; step < KAnimationKeyCursorMaxSteps; ++step)
+			{
+				if ((Hint + 1 >= key_count) || (vKeys[Hint + 1].TimeInTicks > TimeInTicks)) { return Hint; }
+				++Hint;
+			}
+
+			// The answer is at or after the hint.
+			search_begin += Hint;
+		}
+
+		auto found = std::upper_bound(search_begin, vKeys.end(), TimeInTicks,
+			[](float Time, const KeyType& Key) { return Time < Key.TimeInTicks; });
+
+		if (found == vKeys.begin()) { return 0; }
+		return static_cast<uint32_t>(found - vKeys.begin() - 1);
+	}
+
 	struct SModelAnimation
 	{
 		// Animation's name. This can be null.
@@ -578,7 +654,21 @@ namespace JWEngine
 
 		VECTOR<SModelNodeAnimation> vNodeAnimation;
 
+		// NodeID -> index in vNodeAnimation (KInvalidNodeAnimationIndex if the node is not animated)
+		// Built by the loader.
+		VECTOR<int32_t> vNodeAnimationIndexFromNodeID;
+
 		SModelAnimation() = default;
+
+		auto GetNodeAnimation(size_t NodeID) const noexcept->const SModelNodeAnimation*
+		{
+			if (NodeID >= vNodeAnimationIndexFromNodeID.size()) { return nullptr; }
+
+			auto index = vNodeAnimationIndexFromNodeID[NodeID];
+			if (index == KInvalidNodeAnimationIndex) { return nullptr; }
+
+			return &vNodeAnimation[index];
+		}
 	};
 
 	struct SModelAnimationSet
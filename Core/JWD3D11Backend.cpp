@@ -0,0 +1,797 @@
+#include "JWD3D11Backend.h"
+#include "JWDX.h"
+#include "JWLogger.h"
+
+using namespace JWEngine;
+
+JW_LOGGER_USE;
+
+void JWD3D11Backend::Create(HWND hWnd, const SSize2& WindowSize, const STRING& Directory, const SClearColor& ClearColor) noexcept
+{
+	if (!m_IsCreated)
+	{
+		// Set base directory
+		m_BaseDirectory = Directory;
+
+		// Set window size
+		m_pWindowSize = &WindowSize;
+
+		// Set clear color
+		m_ClearColor[0] = ClearColor.R;
+		m_ClearColor[1] = ClearColor.G;
+		m_ClearColor[2] = ClearColor.B;
+		m_ClearColor[3] = 1.0f;
+
+		// Create device and swap chain
+		CreateDeviceAndSwapChain(hWnd);
+
+		// Create VS shaders and input layouts
+		CreateVSBase();
+		CreateVSRaw();
+		CreateVSSkyMap();
+		CreateVSInstantText();
+
+		// Create GS shaders
+		CreateGSNormal();
+
+		// Create PS shaders
+		CreatePSBase();
+		CreatePSRaw();
+		CreatePSSkyMap();
+		CreatePSInstantText();
+
+		// Views
+		// Create render target view
+		CreateRenderTargetView();
+
+		// Create depth-stencil view
+		CreateDepthStencilView();
+
+		// Set views
+		SetViews();
+
+		// States
+		// Create depth-stencil states
+		CreateDepthStencilStates();
+
+		// Create rasterizer states
+		CreateRasterizerStates();
+
+		// Create sampler states
+		CreateSamplerStates();
+
+		// Create blend states
+		CreateBlendStates();
+
+		UpdateDefaultViewport();
+
+		m_IsCreated = true;
+	}
+}
+
+void JWD3D11Backend::Destroy() noexcept
+{
+	if (!m_IsCreated) { return; }
+
+	uint64_t reference_count{};
+
+	// @important
+	m_SwapChain->SetFullscreenState(FALSE, nullptr);
+
+	// Release the COM objects we created.
+
+	// States
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_SamplerStateAnisotropic);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_SamplerStateMinMagMipPointWrap);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_SamplerStateMinMagMipLinearWrapBias2);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_SamplerStateMinMagMipLinearWrap);
+
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_BlendStateOpaque);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_BlendStateTransparent);
+
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_RasterizerStateSolidBackCullCW11);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_RasterizerStateSolidBackCullCCW11);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_RasterizerStateSolidNoCull11);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_RasterizerStateWireFrame11);
+
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_DepthStencilStateZDisabled11);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_DepthStencilStateZEnabled11);
+
+	// Views
+	DestroyViews();
+
+	// PS
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_PSInstantTextBlob);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_PSInstantText);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_PSSkyMap);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_PSSkyMapBuffer);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_PSRaw);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_PSRawBuffer);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_PSBase);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_PSBaseBuffer);
+
+	// GS
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_GSNormal);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_GSNormalBuffer);
+
+	// VS
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_VSInstantTextInputLayout);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_VSInstantText);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_VSInstantTextBlob);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_VSSkyMap);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_VSSkyMapBuffer);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_VSRaw);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_VSRawBuffer);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_VSBaseInputLayout);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_VSBase);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_VSBaseBuffer);
+
+	// Device, Context, SwapChain
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_DeviceContext11);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_Device11);
+	JW_RELEASE_CHECK_REFERENCE_COUNT(m_SwapChain);
+
+	// Reference count check!
+	assert(reference_count == 0);
+
+	m_IsCreated = false;
+}
+
+void JWD3D11Backend::GetAvailableDisplayModes(VECTOR<SSize2>& OutModes) const noexcept
+{
+	IDXGIOutput* output{};
+	DXGI_MODE_DESC* mode_list{};
+	UINT mode_count{};
+
+	OutModes.clear();
+
+	m_SwapChain->GetContainingOutput(&output);
+	output->GetDisplayModeList(DXGI_FORMAT::DXGI_FORMAT_R8G8B8A8_UNORM, 0, &mode_count, nullptr);
+
+	mode_list = new DXGI_MODE_DESC[mode_count];
+	output->GetDisplayModeList(DXGI_FORMAT::DXGI_FORMAT_R8G8B8A8_UNORM, 0, &mode_count, mode_list);
+
+	for (UINT capable_id = 0; capable_id < mode_count; ++capable_id)
+	{
+		for (uint32_t allowed_id = 0; allowed_id < KAllowedDisplayModeCount; ++allowed_id)
+		{
+			if ((mode_list[capable_id].Width == KAllowedDisplayModes[allowed_id].Width) &&
+				(mode_list[capable_id].Height == KAllowedDisplayModes[allowed_id].Height))
+			{
+				if (OutModes.size())
+				{
+					if (OutModes[OutModes.size() - 1] == KAllowedDisplayModes[allowed_id])
+					{
+						continue;
+					}
+				}
+
+				OutModes.emplace_back(KAllowedDisplayModes[allowed_id]);
+			}
+		}
+	}
+
+	JW_DELETE_ARRAY(mode_list);
+	JW_RELEASE(output);
+}
+
+auto JWD3D11Backend::IsFullScreen() const noexcept->bool
+{
+	BOOL is_fullscreen{ false };
+	IDXGIOutput* dxgi_output{};
+
+	m_SwapChain->GetFullscreenState(&is_fullscreen, &dxgi_output);
+
+	JW_RELEASE(dxgi_output);
+
+	return (is_fullscreen == TRUE);
+}
+
+void JWD3D11Backend::ResizeTarget(const SSize2& Size) noexcept
+{
+	m_DeviceContext11->OMSetRenderTargets(0, nullptr, nullptr);
+
+	DXGI_MODE_DESC mode{};
+	mode.Format = DXGI_FORMAT_UNKNOWN;
+	mode.Width = Size.Width;
+	mode.Height = Size.Height;
+	mode.RefreshRate.Denominator = 0;
+	mode.RefreshRate.Numerator = 0;
+	mode.ScanlineOrdering = DXGI_MODE_SCANLINE_ORDER_UNSPECIFIED;
+	mode.Scaling = DXGI_MODE_SCALING_UNSPECIFIED;
+
+	m_SwapChain->ResizeTarget(&mode);
+
+	DestroyViews();
+
+	m_SwapChain->ResizeBuffers(0, 0, 0, DXGI_FORMAT_UNKNOWN, 0);
+
+	CreateRenderTargetView();
+	CreateDepthStencilView();
+
+	SetViews();
+
+	UpdateDefaultViewport();
+}
+
+PRIVATE void JWD3D11Backend::CreateDeviceAndSwapChain(HWND hWnd) noexcept
+{
+	JW_LOG_METHOD_START(0);
+
+	// Describe the screen buffer
+	DXGI_MODE_DESC buffer_description{};
+	buffer_description.Width = m_pWindowSize->Width;
+	buffer_description.Height = m_pWindowSize->Height;
+	buffer_description.RefreshRate.Numerator = 60;
+	buffer_description.RefreshRate.Denominator = 1;
+	buffer_description.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	buffer_description.ScanlineOrdering = DXGI_MODE_SCANLINE_ORDER_UNSPECIFIED;
+	buffer_description.Scaling = DXGI_MODE_SCALING_UNSPECIFIED;
+
+	// Describe the SwapChain
+	DXGI_SWAP_CHAIN_DESC swap_chain_description{};
+	swap_chain_description.BufferDesc = buffer_description;
+	swap_chain_description.SampleDesc.Count = 1;
+	swap_chain_description.SampleDesc.Quality = 0;
+	swap_chain_description.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+	swap_chain_description.BufferCount = 2; // @important
+	swap_chain_description.OutputWindow = hWnd;
+	swap_chain_description.Windowed = TRUE;
+	swap_chain_description.SwapEffect = DXGI_SWAP_EFFECT_DISCARD;
+	//swap_chain_description.Flags = DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH;
+
+	// Create the Device and the SwapChain
+	if (FAILED(D3D11CreateDeviceAndSwapChain(nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr, 0,
+		nullptr, 0, D3D11_SDK_VERSION, &swap_chain_description, &m_SwapChain,
+		&m_Device11, nullptr, &m_DeviceContext11)))
+	{
+		JW_ERROR_ABORT("Failed to create Device and SwapChain.");
+	}
+
+	JW_LOG_METHOD_END(0);
+}
+
+PRIVATE void JWD3D11Backend::UpdateDefaultViewport() noexcept
+{
+	// Setup the viewport
+	m_DefaultViewPort.TopLeftX = 0;
+	m_DefaultViewPort.TopLeftY = 0;
+	m_DefaultViewPort.Width = m_pWindowSize->floatX();
+	m_DefaultViewPort.Height = m_pWindowSize->floatY();
+	m_DefaultViewPort.MinDepth = 0.0f; // IMPORTANT!
+	m_DefaultViewPort.MaxDepth = 1.0f; // IMPORTANT!
+
+	// Set the viewport
+	m_DeviceContext11->RSSetViewports(1, &m_DefaultViewPort);
+}
+
+PRIVATE void JWD3D11Backend::CreateVSBase() noexcept
+{
+	// Compile shader from file
+	WSTRING shader_file_name;
+	shader_file_name = StringToWstring(m_BaseDirectory) + L"Shaders\\VSBase.hlsl";
+	D3DCompileFromFile(shader_file_name.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", "vs_4_0",
+		D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION, 0, &m_VSBaseBuffer, nullptr);
+
+	// Create vertex shader
+	m_Device11->CreateVertexShader(m_VSBaseBuffer->GetBufferPointer(), m_VSBaseBuffer->GetBufferSize(), nullptr, &m_VSBase);
+
+	// Create input layout
+	m_Device11->CreateInputLayout(KInputElementDescriptionModel, ARRAYSIZE(KInputElementDescriptionModel),
+		m_VSBaseBuffer->GetBufferPointer(), m_VSBaseBuffer->GetBufferSize(), &m_VSBaseInputLayout);
+}
+
+PRIVATE void JWD3D11Backend::CreateVSRaw() noexcept
+{
+	// Compile shader from file
+	WSTRING shader_file_name;
+	shader_file_name = StringToWstring(m_BaseDirectory) + L"Shaders\\VSRaw.hlsl";
+	D3DCompileFromFile(shader_file_name.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", "vs_4_0",
+		D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION, 0, &m_VSRawBuffer, nullptr);
+
+	// Create vertex shader
+	m_Device11->CreateVertexShader(m_VSRawBuffer->GetBufferPointer(), m_VSRawBuffer->GetBufferSize(), nullptr, &m_VSRaw);
+}
+
+PRIVATE void JWD3D11Backend::CreateVSSkyMap() noexcept
+{
+	// Compile shader from file
+	WSTRING shader_file_name;
+	shader_file_name = StringToWstring(m_BaseDirectory) + L"Shaders\\VSSkyMap.hlsl";
+	D3DCompileFromFile(shader_file_name.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", "vs_4_0",
+		D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION, 0, &m_VSSkyMapBuffer, nullptr);
+
+	// Create vertex shader
+	m_Device11->CreateVertexShader(m_VSSkyMapBuffer->GetBufferPointer(), m_VSSkyMapBuffer->GetBufferSize(), nullptr, &m_VSSkyMap);
+}
+
+PRIVATE void JWD3D11Backend::CreateVSInstantText() noexcept
+{
+	// Compile Shaders from shader file
+	WSTRING shader_file_name = StringToWstring(m_BaseDirectory) + L"Shaders\\VSInstantText.hlsl";
+	D3DCompileFromFile(shader_file_name.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", "vs_4_0",
+		D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION, 0, &m_VSInstantTextBlob, nullptr);
+
+	// Create vertex shader
+	m_Device11->CreateVertexShader(m_VSInstantTextBlob->GetBufferPointer(), m_VSInstantTextBlob->GetBufferSize(), nullptr, &m_VSInstantText);
+
+	// Create input layout
+	m_Device11->CreateInputLayout(KInputElementDescriptionText, ARRAYSIZE(KInputElementDescriptionText),
+		m_VSInstantTextBlob->GetBufferPointer(), m_VSInstantTextBlob->GetBufferSize(), &m_VSInstantTextInputLayout);
+}
+
+PRIVATE void JWD3D11Backend::CreateGSNormal() noexcept
+{
+	// Compile shader from file
+	WSTRING shader_file_name;
+	shader_file_name = StringToWstring(m_BaseDirectory) + L"Shaders\\GSNormal.hlsl";
+	D3DCompileFromFile(shader_file_name.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", "gs_4_0",
+		D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION, 0, &m_GSNormalBuffer, nullptr);
+
+	// Create geometry shader
+	m_Device11->CreateGeometryShader(m_GSNormalBuffer->GetBufferPointer(), m_GSNormalBuffer->GetBufferSize(), nullptr, &m_GSNormal);
+}
+
+PRIVATE void JWD3D11Backend::CreatePSBase() noexcept
+{
+	// Compile shader from file
+	WSTRING shader_file_name;
+	shader_file_name = StringToWstring(m_BaseDirectory) + L"Shaders\\PSBase.hlsl";
+	D3DCompileFromFile(shader_file_name.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", "ps_4_0",
+		D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION, 0, &m_PSBaseBuffer, nullptr);
+
+	// Create pixel shader
+	m_Device11->CreatePixelShader(m_PSBaseBuffer->GetBufferPointer(), m_PSBaseBuffer->GetBufferSize(), nullptr, &m_PSBase);
+}
+
+PRIVATE void JWD3D11Backend::CreatePSRaw() noexcept
+{
+	// Compile shader from file
+	WSTRING shader_file_name;
+	shader_file_name = StringToWstring(m_BaseDirectory) + L"Shaders\\PSRaw.hlsl";
+	D3DCompileFromFile(shader_file_name.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", "ps_4_0",
+		D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION, 0, &m_PSRawBuffer, nullptr);
+
+	// Create pixel shader
+	m_Device11->CreatePixelShader(m_PSRawBuffer->GetBufferPointer(), m_PSRawBuffer->GetBufferSize(), nullptr, &m_PSRaw);
+}
+
+PRIVATE void JWD3D11Backend::CreatePSSkyMap() noexcept
+{
+	// Compile shader from file
+	WSTRING shader_file_name;
+	shader_file_name = StringToWstring(m_BaseDirectory) + L"Shaders\\PSSkyMap.hlsl";
+	D3DCompileFromFile(shader_file_name.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", "ps_4_0",
+		D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION, 0, &m_PSSkyMapBuffer, nullptr);
+
+	// Create pixel shader
+	m_Device11->CreatePixelShader(m_PSSkyMapBuffer->GetBufferPointer(), m_PSSkyMapBuffer->GetBufferSize(), nullptr, &m_PSSkyMap);
+}
+
+PRIVATE void JWD3D11Backend::CreatePSInstantText() noexcept
+{
+	// Compile Shaders from shader file
+	WSTRING shader_file_name = StringToWstring(m_BaseDirectory) + L"Shaders\\PSInstantText.hlsl";
+	D3DCompileFromFile(shader_file_name.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", "ps_4_0",
+		D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION, 0, &m_PSInstantTextBlob, nullptr);
+
+	// Create pixel shader
+	m_Device11->CreatePixelShader(m_PSInstantTextBlob->GetBufferPointer(), m_PSInstantTextBlob->GetBufferSize(), nullptr, &m_PSInstantText);
+}
+
+PRIVATE void JWD3D11Backend::CreateRenderTargetView() noexcept
+{
+	// Create buffer for render target view
+	if (SUCCEEDED(m_SwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)&m_RenderTargetTexture)))
+	{
+		// Create render target view
+		m_Device11->CreateRenderTargetView(m_RenderTargetTexture, nullptr, &m_RenderTargetView);
+	}
+	else
+	{
+		JW_ERROR_ABORT("Failed to get back buffer.");
+	}
+}
+
+PRIVATE void JWD3D11Backend::CreateDepthStencilView() noexcept
+{
+	// Describe depth-stencil buffer
+	D3D11_TEXTURE2D_DESC depth_stencil_texture_descrption{};
+	depth_stencil_texture_descrption.Width = m_pWindowSize->Width;
+	depth_stencil_texture_descrption.Height = m_pWindowSize->Height;
+	depth_stencil_texture_descrption.MipLevels = 1;
+	depth_stencil_texture_descrption.ArraySize = 1;
+	depth_stencil_texture_descrption.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
+	depth_stencil_texture_descrption.SampleDesc.Count = 1;
+	depth_stencil_texture_descrption.SampleDesc.Quality = 0;
+	depth_stencil_texture_descrption.Usage = D3D11_USAGE_DEFAULT;
+	depth_stencil_texture_descrption.BindFlags = D3D11_BIND_DEPTH_STENCIL;
+	depth_stencil_texture_descrption.CPUAccessFlags = 0;
+	depth_stencil_texture_descrption.MiscFlags = 0;
+
+	// Create buffer for depth-stencil view
+	ID3D11Texture2D* depth_stencil_buffer{};
+	if (SUCCEEDED(m_Device11->CreateTexture2D(&depth_stencil_texture_descrption, nullptr, &depth_stencil_buffer)))
+	{
+		// Create the depth-stencil View
+		m_Device11->CreateDepthStencilView(depth_stencil_buffer, nullptr, &m_DepthStencilView);
+
+		JW_RELEASE(depth_stencil_buffer);
+	}
+	else
+	{
+		JW_ERROR_ABORT("Failed to create texture.");
+	}
+}
+
+PRIVATE void JWD3D11Backend::SetViews() noexcept
+{
+	// Set render target view & depth-stencil view
+	m_DeviceContext11->OMSetRenderTargets(1, &m_RenderTargetView, m_DepthStencilView);
+}
+
+PRIVATE void JWD3D11Backend::DestroyViews() noexcept
+{
+	//m_DeviceContext11->OMSetRenderTargets(0, nullptr, nullptr);
+
+	JW_RELEASE(m_DepthStencilView);
+
+	JW_RELEASE(m_RenderTargetTexture);
+	JW_RELEASE(m_RenderTargetView);
+}
+
+PRIVATE void JWD3D11Backend::CreateDepthStencilStates() noexcept
+{
+	D3D11_DEPTH_STENCIL_DESC depth_stencil_description{};
+
+	depth_stencil_description.DepthEnable = TRUE;
+	depth_stencil_description.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
+	depth_stencil_description.DepthFunc = D3D11_COMPARISON_LESS_EQUAL;
+
+	depth_stencil_description.StencilEnable = FALSE;
+	depth_stencil_description.StencilReadMask = D3D11_DEFAULT_STENCIL_READ_MASK;
+	depth_stencil_description.StencilWriteMask = D3D11_DEFAULT_STENCIL_WRITE_MASK;
+
+	depth_stencil_description.FrontFace.StencilFunc = D3D11_COMPARISON_ALWAYS;
+	depth_stencil_description.FrontFace.StencilPassOp = D3D11_STENCIL_OP_KEEP;
+	depth_stencil_description.FrontFace.StencilFailOp = D3D11_STENCIL_OP_KEEP;
+	depth_stencil_description.FrontFace.StencilDepthFailOp = D3D11_STENCIL_OP_KEEP;
+
+	depth_stencil_description.BackFace = depth_stencil_description.FrontFace;
+
+	m_Device11->CreateDepthStencilState(&depth_stencil_description, &m_DepthStencilStateZEnabled11);
+
+	depth_stencil_description.DepthEnable = FALSE;
+	depth_stencil_description.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO; // Read-only
+
+	m_Device11->CreateDepthStencilState(&depth_stencil_description, &m_DepthStencilStateZDisabled11);
+}
+
+PRIVATE void JWD3D11Backend::CreateRasterizerStates() noexcept
+{
+	D3D11_RASTERIZER_DESC rasterizer_description{};
+	rasterizer_description.FillMode = D3D11_FILL_WIREFRAME;
+	rasterizer_description.CullMode = D3D11_CULL_NONE;
+
+	m_Device11->CreateRasterizerState(&rasterizer_description, &m_RasterizerStateWireFrame11);
+
+	rasterizer_description.FillMode = D3D11_FILL_SOLID;
+	rasterizer_description.CullMode = D3D11_CULL_NONE;
+
+	m_Device11->CreateRasterizerState(&rasterizer_description, &m_RasterizerStateSolidNoCull11);
+
+	rasterizer_description.FillMode = D3D11_FILL_SOLID;
+	rasterizer_description.CullMode = D3D11_CULL_BACK;
+	rasterizer_description.FrontCounterClockwise = true;
+
+	m_Device11->CreateRasterizerState(&rasterizer_description, &m_RasterizerStateSolidBackCullCCW11);
+
+	rasterizer_description.FrontCounterClockwise = false;
+	m_Device11->CreateRasterizerState(&rasterizer_description, &m_RasterizerStateSolidBackCullCW11);
+}
+
+PRIVATE void JWD3D11Backend::CreateBlendStates() noexcept
+{
+	D3D11_BLEND_DESC blend_description{};
+	blend_description.RenderTarget[0].BlendEnable = true;
+	
+	blend_description.RenderTarget[0].SrcBlend = blend_description.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_SRC_ALPHA;
+	blend_description.RenderTarget[0].DestBlend = blend_description.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_INV_SRC_ALPHA;
+	blend_description.RenderTarget[0].BlendOp = blend_description.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
+
+	blend_description.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+
+	m_Device11->CreateBlendState(&blend_description, &m_BlendStateTransparent);
+
+	blend_description.RenderTarget[0].BlendEnable = false;
+
+	m_Device11->CreateBlendState(&blend_description, &m_BlendStateOpaque);
+}
+
+PRIVATE void JWD3D11Backend::CreateSamplerStates() noexcept
+{
+	D3D11_SAMPLER_DESC sampler_description{};
+	sampler_description.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+	sampler_description.Filter = D3D11_FILTER_ANISOTROPIC;
+	sampler_description.AddressU = D3D11_TEXTURE_ADDRESS_WRAP;
+	sampler_description.AddressV = D3D11_TEXTURE_ADDRESS_WRAP;
+	sampler_description.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
+	sampler_description.MaxAnisotropy = 1;
+	sampler_description.ComparisonFunc = D3D11_COMPARISON_ALWAYS;
+	sampler_description.MinLOD = 0;
+	sampler_description.MaxLOD = D3D11_FLOAT32_MAX;
+	sampler_description.MipLODBias = 0;
+
+	m_Device11->CreateSamplerState(&sampler_description, &m_SamplerStateMinMagMipLinearWrap);
+
+	sampler_description.MipLODBias = 2;
+	m_Device11->CreateSamplerState(&sampler_description, &m_SamplerStateMinMagMipLinearWrapBias2);
+
+	sampler_description.Filter = D3D11_FILTER_MIN_MAG_MIP_POINT;
+	sampler_description.AddressU = D3D11_TEXTURE_ADDRESS_WRAP;
+	sampler_description.AddressV = D3D11_TEXTURE_ADDRESS_WRAP;
+	sampler_description.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
+	sampler_description.ComparisonFunc = D3D11_COMPARISON_NEVER;
+	sampler_description.MinLOD = 0;
+	sampler_description.MaxLOD = D3D11_FLOAT32_MAX;
+	sampler_description.MipLODBias = 0;
+
+	m_Device11->CreateSamplerState(&sampler_description, &m_SamplerStateMinMagMipPointWrap);
+
+	sampler_description.Filter = D3D11_FILTER_ANISOTROPIC;
+	sampler_description.MaxAnisotropy = 16;
+	sampler_description.ComparisonFunc = D3D11_COMPARISON_ALWAYS;
+	m_Device11->CreateSamplerState(&sampler_description, &m_SamplerStateAnisotropic);
+}
+
+void JWD3D11Backend::CreateBuffer(EGraphicsBufferType Type, UINT ByteSize, const void* pData, ID3D11Buffer** ppBuffer) noexcept
+{
+	bool is_dynamic = (Type == EGraphicsBufferType::DynamicVertex) || (Type == EGraphicsBufferType::Constant);
+
+	D3D11_BUFFER_DESC buffer_description{};
+	buffer_description.Usage = (is_dynamic) ? D3D11_USAGE_DYNAMIC : D3D11_USAGE_DEFAULT;
+	buffer_description.ByteWidth = ByteSize;
+	buffer_description.CPUAccessFlags = (is_dynamic) ? D3D11_CPU_ACCESS_WRITE : 0;
+	buffer_description.MiscFlags = 0;
+
+	switch (Type)
+	{
+	case EGraphicsBufferType::Index:
+		buffer_description.BindFlags = D3D11_BIND_INDEX_BUFFER;
+		break;
+	case EGraphicsBufferType::Constant:
+		buffer_description.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		break;
+	default:
+		buffer_description.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+		break;
+	}
+
+	D3D11_SUBRESOURCE_DATA buffer_data{};
+	buffer_data.pSysMem = pData;
+
+	m_Device11->CreateBuffer(&buffer_description, (pData) ? &buffer_data : nullptr, ppBuffer);
+}
+
+void JWD3D11Backend::UpdateBuffer(ID3D11Resource* pResource, const void* pData, size_t Size) noexcept
+{
+	D3D11_MAPPED_SUBRESOURCE mapped_subresource{};
+	if (SUCCEEDED(m_DeviceContext11->Map(pResource, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_subresource)))
+	{
+		memcpy(mapped_subresource.pData, pData, Size);
+
+		m_DeviceContext11->Unmap(pResource, 0);
+	}
+}
+
+void JWD3D11Backend::BindVertexBuffers(UINT StartSlot, UINT BufferCount, ID3D11Buffer* const* ppBuffers,
+	const UINT* pStrides, const UINT* pOffsets) noexcept
+{
+	m_DeviceContext11->IASetVertexBuffers(StartSlot, BufferCount, ppBuffers, pStrides, pOffsets);
+}
+
+void JWD3D11Backend::BindIndexBuffer(ID3D11Buffer* pBuffer) noexcept
+{
+	m_DeviceContext11->IASetIndexBuffer(pBuffer, DXGI_FORMAT_R32_UINT, 0);
+}
+
+void JWD3D11Backend::BindConstantBuffer(EShaderStage Stage, UINT Slot, ID3D11Buffer* pBuffer) noexcept
+{
+	if (Stage == EShaderStage::VS)
+	{
+		m_DeviceContext11->VSSetConstantBuffers(Slot, 1, &pBuffer);
+	}
+	else
+	{
+		m_DeviceContext11->PSSetConstantBuffers(Slot, 1, &pBuffer);
+	}
+}
+
+void JWD3D11Backend::BindPipelineState(EPipelineStateType Type, uint32_t Value) noexcept
+{
+	switch (Type)
+	{
+	case EPipelineStateType::Rasterizer:
+		switch (static_cast<ERasterizerState>(Value))
+		{
+		case JWEngine::ERasterizerState::WireFrame:
+			m_DeviceContext11->RSSetState(m_RasterizerStateWireFrame11);
+			break;
+		case JWEngine::ERasterizerState::SolidNoCull:
+			m_DeviceContext11->RSSetState(m_RasterizerStateSolidNoCull11);
+			break;
+		case JWEngine::ERasterizerState::SolidBackCullCCW:
+			m_DeviceContext11->RSSetState(m_RasterizerStateSolidBackCullCCW11);
+			break;
+		case JWEngine::ERasterizerState::SolidBackCullCW:
+			m_DeviceContext11->RSSetState(m_RasterizerStateSolidBackCullCW11);
+			break;
+		default:
+			break;
+		}
+		break;
+	case EPipelineStateType::Blend:
+		switch (static_cast<EBlendState>(Value))
+		{
+		case JWEngine::EBlendState::Transprent:
+			m_DeviceContext11->OMSetBlendState(m_BlendStateTransparent, 0, 0xFFFFFFFF);
+			break;
+		case JWEngine::EBlendState::Opaque:
+			m_DeviceContext11->OMSetBlendState(m_BlendStateOpaque, 0, 0xFFFFFFFF);
+			break;
+		default:
+			break;
+		}
+		break;
+	case EPipelineStateType::PSSampler:
+		switch (static_cast<ESamplerState>(Value))
+		{
+		case JWEngine::ESamplerState::MinMagMipLinearWrap:
+			m_DeviceContext11->PSSetSamplers(0, 1, &m_SamplerStateMinMagMipLinearWrap);
+			break;
+		case JWEngine::ESamplerState::MinMagMipLinearWrapBias2:
+			m_DeviceContext11->PSSetSamplers(0, 1, &m_SamplerStateMinMagMipLinearWrapBias2);
+			break;
+		case JWEngine::ESamplerState::MinMagMipPointWrap:
+			m_DeviceContext11->PSSetSamplers(0, 1, &m_SamplerStateMinMagMipPointWrap);
+			break;
+		case JWEngine::ESamplerState::Anisotropic:
+			m_DeviceContext11->PSSetSamplers(0, 1, &m_SamplerStateAnisotropic);
+			break;
+		default:
+			break;
+		}
+		break;
+	case EPipelineStateType::PrimitiveTopology:
+		switch (static_cast<EPrimitiveTopology>(Value))
+		{
+		case JWEngine::EPrimitiveTopology::TriangleList:
+			m_DeviceContext11->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+			break;
+		case JWEngine::EPrimitiveTopology::TriangleStrip:
+			m_DeviceContext11->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+			break;
+		case JWEngine::EPrimitiveTopology::LineList:
+			m_DeviceContext11->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+			break;
+		case JWEngine::EPrimitiveTopology::LineStrip:
+			m_DeviceContext11->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP);
+			break;
+		default:
+			break;
+		}
+		break;
+	case EPipelineStateType::DepthStencil:
+		switch (static_cast<EDepthStencilState>(Value))
+		{
+		case JWEngine::EDepthStencilState::ZEnabled:
+			m_DeviceContext11->OMSetDepthStencilState(m_DepthStencilStateZEnabled11, 0);
+			break;
+		case JWEngine::EDepthStencilState::ZDisabled:
+			m_DeviceContext11->OMSetDepthStencilState(m_DepthStencilStateZDisabled11, 0);
+			break;
+		default:
+			break;
+		}
+		break;
+	case EPipelineStateType::VS:
+		switch (static_cast<EVertexShader>(Value))
+		{
+		case JWEngine::EVertexShader::VSBase:
+			m_DeviceContext11->IASetInputLayout(m_VSBaseInputLayout);
+			m_DeviceContext11->VSSetShader(m_VSBase, nullptr, 0);
+			break;
+		case JWEngine::EVertexShader::VSRaw:
+			m_DeviceContext11->IASetInputLayout(nullptr);
+			m_DeviceContext11->VSSetShader(m_VSRaw, nullptr, 0);
+			break;
+		case JWEngine::EVertexShader::VSSkyMap:
+			m_DeviceContext11->IASetInputLayout(m_VSBaseInputLayout);
+			m_DeviceContext11->VSSetShader(m_VSSkyMap, nullptr, 0);
+			break;
+		case JWEngine::EVertexShader::VSIntantText:
+			m_DeviceContext11->IASetInputLayout(m_VSInstantTextInputLayout);
+			m_DeviceContext11->VSSetShader(m_VSInstantText, nullptr, 0);
+			break;
+		default:
+			break;
+		}
+		break;
+	case EPipelineStateType::GS:
+		switch (static_cast<EGeometryShader>(Value))
+		{
+		case JWEngine::EGeometryShader::None:
+			m_DeviceContext11->GSSetShader(nullptr, nullptr, 0);
+			break;
+		case JWEngine::EGeometryShader::GSNormal:
+			m_DeviceContext11->GSSetShader(m_GSNormal, nullptr, 0);
+			break;
+		default:
+			break;
+		}
+		break;
+	case EPipelineStateType::PS:
+		switch (static_cast<EPixelShader>(Value))
+		{
+		case JWEngine::EPixelShader::PSBase:
+			m_DeviceContext11->PSSetShader(m_PSBase, nullptr, 0);
+			break;
+		case JWEngine::EPixelShader::PSRaw:
+			m_DeviceContext11->PSSetShader(m_PSRaw, nullptr, 0);
+			break;
+		case JWEngine::EPixelShader::PSSkyMap:
+			m_DeviceContext11->PSSetShader(m_PSSkyMap, nullptr, 0);
+			break;
+		case JWEngine::EPixelShader::PSIntantText:
+			m_DeviceContext11->PSSetShader(m_PSInstantText, nullptr, 0);
+			break;
+		default:
+			break;
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void JWD3D11Backend::BindShaderResource(EShaderStage Stage, UINT Slot, ID3D11ShaderResourceView* pView) noexcept
+{
+	if (Stage == EShaderStage::VS)
+	{
+		m_DeviceContext11->VSSetShaderResources(Slot, 1, &pView);
+	}
+	else
+	{
+		m_DeviceContext11->PSSetShaderResources(Slot, 1, &pView);
+	}
+}
+
+void JWD3D11Backend::SubmitDraw(UINT VertexCount) noexcept
+{
+	m_DeviceContext11->Draw(VertexCount, 0);
+}
+
+void JWD3D11Backend::SubmitDrawIndexed(UINT IndexCount) noexcept
+{
+	m_DeviceContext11->DrawIndexed(IndexCount, 0, 0);
+}
+
+void JWD3D11Backend::SubmitDrawIndexedInstanced(UINT IndexCount, UINT InstanceCount) noexcept
+{
+	m_DeviceContext11->DrawIndexedInstanced(IndexCount, InstanceCount, 0, 0, 0);
+}
+
+void JWD3D11Backend::BeginFrame() noexcept
+{
+	// Clear render target view
+	m_DeviceContext11->ClearRenderTargetView(m_RenderTargetView, m_ClearColor);
+
+	// Clear depth-stencil view
+	m_DeviceContext11->ClearDepthStencilView(m_DepthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+}
+
+void JWD3D11Backend::EndFrame() noexcept
+{
+	// Present back buffer to screen
+	m_SwapChain->Present(0, 0);
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "JWGraphicsBackend.h"
+
+namespace JWEngine
+{
+	// Owns the device, the swap chain, the views, the compiled shaders and the pipeline state objects.
+	// JWDX filters and counts the commands, then sends them here (unless it's created headless).
+	class JWD3D11Backend final : public JWGraphicsBackend
+	{
+	public:
+		JWD3D11Backend() = default;
+		~JWD3D11Backend() = default;
+
+		// Shaders are compiled from Directory + "Shaders\\".
+		void Create(HWND hWnd, const SSize2& WindowSize, const STRING& Directory, const SClearColor& ClearColor) noexcept;
+		void Destroy() noexcept;
+
+		auto IsCreated() const noexcept { return m_IsCreated; }
+
+		// Display modes of the output that are in KAllowedDisplayModes (32-bit color)
+		void GetAvailableDisplayModes(VECTOR<SSize2>& OutModes) const noexcept;
+		auto IsFullScreen() const noexcept->bool;
+
+		// Resizes the target and the back buffer, and recreates the views and the viewport with the new window size.
+		void ResizeTarget(const SSize2& Size) noexcept;
+
+		auto GetSwapChain() const noexcept { return m_SwapChain; }
+		auto GetDevice() const noexcept { return m_Device11; }
+		auto GetDeviceContext() const noexcept { return m_DeviceContext11; }
+
+		void CreateBuffer(EGraphicsBufferType Type, UINT ByteSize, const void* pData, ID3D11Buffer** ppBuffer) noexcept override;
+		void UpdateBuffer(ID3D11Resource* pResource, const void* pData, size_t Size) noexcept override;
+
+		void BindVertexBuffers(UINT StartSlot, UINT BufferCount, ID3D11Buffer* const* ppBuffers,
+			const UINT* pStrides, const UINT* pOffsets) noexcept override;
+		void BindIndexBuffer(ID3D11Buffer* pBuffer) noexcept override;
+		void BindConstantBuffer(EShaderStage Stage, UINT Slot, ID3D11Buffer* pBuffer) noexcept override;
+		void BindPipelineState(EPipelineStateType Type, uint32_t Value) noexcept override;
+		void BindShaderResource(EShaderStage Stage, UINT Slot, ID3D11ShaderResourceView* pView) noexcept override;
+
+		void SubmitDraw(UINT VertexCount) noexcept override;
+		void SubmitDrawIndexed(UINT IndexCount) noexcept override;
+		void SubmitDrawIndexedInstanced(UINT IndexCount, UINT InstanceCount) noexcept override;
+
+		// Clears the views / presents the back buffer.
+		void BeginFrame() noexcept override;
+		void EndFrame() noexcept override;
+
+	private:
+		// Called in Create()
+		void CreateDeviceAndSwapChain(HWND hWnd) noexcept;
+
+		void UpdateDefaultViewport() noexcept;
+
+		// VS Shader & input layout creation
+		void CreateVSBase() noexcept;
+		void CreateVSRaw() noexcept;
+		void CreateVSSkyMap() noexcept;
+		void CreateVSInstantText() noexcept;
+
+		// GS Shader creation
+		void CreateGSNormal() noexcept;
+
+		// PS Shader creation
+		void CreatePSBase() noexcept;
+		void CreatePSRaw() noexcept;
+		void CreatePSSkyMap() noexcept;
+		void CreatePSInstantText() noexcept;
+
+		// Views
+		void CreateRenderTargetView() noexcept;
+		void CreateDepthStencilView() noexcept;
+		void SetViews() noexcept;
+		void DestroyViews() noexcept;
+
+		// States
+		void CreateDepthStencilStates() noexcept;
+		void CreateRasterizerStates() noexcept;
+		void CreateBlendStates() noexcept;
+		void CreateSamplerStates() noexcept;
+
+	private:
+		bool			m_IsCreated{ false };
+
+		STRING			m_BaseDirectory;
+		const SSize2*	m_pWindowSize{};
+		FLOAT			m_ClearColor[4]{};
+
+		IDXGISwapChain*			m_SwapChain{};
+		ID3D11Device*			m_Device11{};
+		ID3D11DeviceContext*	m_DeviceContext11{};
+
+		// Shaders and input layouts
+		ID3D11InputLayout*		m_VSBaseInputLayout{};
+		ID3D10Blob*				m_VSBaseBuffer{};
+		ID3D11VertexShader*		m_VSBase{};
+		ID3D10Blob*				m_VSRawBuffer{};
+		ID3D11VertexShader*		m_VSRaw{};
+		ID3D10Blob*				m_VSSkyMapBuffer{};
+		ID3D11VertexShader*		m_VSSkyMap{};
+		ID3D11InputLayout*		m_VSInstantTextInputLayout{};
+		ID3D10Blob*				m_VSInstantTextBlob{};
+		ID3D11VertexShader*		m_VSInstantText{};
+		ID3D10Blob*				m_GSNormalBuffer{};
+		ID3D11GeometryShader*	m_GSNormal{};
+		ID3D10Blob*				m_PSBaseBuffer{};
+		ID3D11PixelShader*		m_PSBase{};
+		ID3D10Blob*				m_PSRawBuffer{};
+		ID3D11PixelShader*		m_PSRaw{};
+		ID3D10Blob*				m_PSSkyMapBuffer{};
+		ID3D11PixelShader*		m_PSSkyMap{};
+		ID3D10Blob*				m_PSInstantTextBlob{};
+		ID3D11PixelShader*		m_PSInstantText{};
+
+		ID3D11RenderTargetView*		m_RenderTargetView{};
+		ID3D11Texture2D*			m_RenderTargetTexture{};
+		ID3D11DepthStencilView*		m_DepthStencilView{};
+		D3D11_VIEWPORT				m_DefaultViewPort{};
+
+		//
+		// States
+		//
+		ID3D11DepthStencilState*	m_DepthStencilStateZEnabled11{};
+		ID3D11DepthStencilState*	m_DepthStencilStateZDisabled11{};
+
+		ID3D11RasterizerState*		m_RasterizerStateWireFrame11{};
+		ID3D11RasterizerState*		m_RasterizerStateSolidNoCull11{};
+		ID3D11RasterizerState*		m_RasterizerStateSolidBackCullCCW11{};
+		ID3D11RasterizerState*		m_RasterizerStateSolidBackCullCW11{};
+
+		ID3D11BlendState*			m_BlendStateTransparent{};
+		ID3D11BlendState*			m_BlendStateOpaque{};
+
+		ID3D11SamplerState*			m_SamplerStateMinMagMipLinearWrap{};
+		ID3D11SamplerState*			m_SamplerStateMinMagMipLinearWrapBias2{};
+		ID3D11SamplerState*			m_SamplerStateMinMagMipPointWrap{};
+		ID3D11SamplerState*			m_SamplerStateAnisotropic{};
+	};
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "JWCommon.h"
+#include "JWD3D11Backend.h"
 
 namespace JWEngine
 {
@@ -110,13 +111,36 @@ namespace JWEngine
 		return EAllowedDisplayMode::w640h480;
 	}
 
-	class JWDX
+	// Shader resource slots whose bindings are cached (the engine's shaders use t0 and t1)
+	static constexpr uint32_t KCachedShaderResourceSlotCount{ 2 };
+
+	// Counted from BeginDrawing() on
+	struct SDXFrameStatistics
+	{
+		uint32_t	DrawCallCount{};
+
+		// States, shaders and shader resources
+		uint32_t	StateChangeCount{};
+		uint32_t	RedundantStateChangeCount{};
+
+		uint32_t	ConstantBufferUpdateCount{};
+		uint32_t	RedundantConstantBufferUpdateCount{};
+	};
+
+	// Caches the bound states and constant buffer data, counts the commands and sends them to a JWGraphicsBackend
+	// (JWD3D11Backend, or the one given to CreateHeadless()).
+	class JWDX final
 	{
 	public:
 		JWDX() = default;
 		~JWDX() = default;
 
 		void Create(HWND hWnd, const SSize2& WindowSize, EAllowedDisplayMode InitialMode, STRING Directory, const SClearColor& ClearColor) noexcept;
+
+		// @important
+		// No device is created, every GPU command goes to pBackend (e.g. JWNullGraphicsBackend).
+		// Textures (DirectXTK loaders, animation textures, height maps) still need the device, so they can't be created headless.
+		void CreateHeadless(const SSize2& WindowSize, STRING Directory, JWGraphicsBackend* pBackend) noexcept;
 		void Destroy() noexcept;
 
 		// Factory functions
@@ -150,7 +174,18 @@ namespace JWEngine
 		void SetGS(EGeometryShader GS) noexcept;
 		void SetPS(EPixelShader PS) noexcept;
 
+		// @important
+		// Every Set*() call is skipped if the same thing is already bound,
+		// so shader resources in cached slots must be bound through these (not through the device context).
+		void SetPSShaderResource(uint32_t Slot, ID3D11ShaderResourceView* ShaderResourceView) noexcept;
+		void SetVSShaderResource(uint32_t Slot, ID3D11ShaderResourceView* ShaderResourceView) noexcept;
+
+		// Index buffers are always 32-bit (DXGI_FORMAT_R32_UINT).
+		void SetVertexBuffers(UINT StartSlot, UINT BufferCount, ID3D11Buffer* const* ppBuffers, const UINT* pStrides, const UINT* pOffsets) noexcept;
+		void SetIndexBuffer(ID3D11Buffer* pBuffer) noexcept;
+
 		// Update VS constant buffers
+		// (Space and flags buffers are not uploaded again if the data hasn't changed.)
 		void UpdateVSCBSpace(const SVSCBSpace& Data) noexcept;
 		void UpdateVSCBFlags(const SVSCBFlags& Data) noexcept;
 		void UpdateVSCBCPUAnimationData(const SVSCBCPUAnimationData& Data) noexcept;
@@ -161,69 +196,42 @@ namespace JWEngine
 		void UpdatePSCBLights(const SPSCBLights& Data) noexcept;
 		void UpdatePSCBCamera(const XMVECTOR& CameraPosition) noexcept;
 
+		// Draw calls (counted)
+		void Draw(UINT VertexCount) noexcept;
+		void DrawIndexed(UINT IndexCount) noexcept;
+		void DrawIndexedInstanced(UINT IndexCount, UINT InstanceCount) noexcept;
+
 		void BeginDrawing() noexcept;
 		void EndDrawing() noexcept;
 
-		auto GetSwapChain() const noexcept { return m_SwapChain; }
-		auto GetDevice() const noexcept { return m_Device11; }
-		auto GetDeviceContext() const noexcept { return m_DeviceContext11; }
+		const auto& GetFrameStatistics() const noexcept { return m_FrameStatistics; }
+		auto IsHeadless() const noexcept { return m_IsHeadless; }
+
+		// nullptr if created headless
+		auto GetSwapChain() const noexcept { return m_D3D11Backend.GetSwapChain(); }
+		auto GetDevice() const noexcept { return m_D3D11Backend.GetDevice(); }
+		auto GetDeviceContext() const noexcept { return m_D3D11Backend.GetDeviceContext(); }
 		auto GetWindowedDisplayMode() const noexcept { return m_WindowedDisplayMode; }
 		auto GetFullScreenDisplayMode() const noexcept { return m_FullScreenDisplayMode; }
 		const auto& GetAvailableDisplayModes() const noexcept { return m_AvailableDisplayModes; }
 		const auto& GetUniversalOrthoProjMatrix() const noexcept { return m_UniversalOrthoProjMat; }
 
 	private:
-		void CreateAllDX(HWND hWnd) noexcept;
-		void DestroyAllDX() noexcept;
-
-		// Called in Create()
-		void CreateDeviceAndSwapChain(HWND hWnd) noexcept;
-
-		void UpdateAvailableDisplayModes() noexcept;
-		void UpdateDefaultViewport() noexcept;
 		void UpdateUniversalOrthoProjMatrix() noexcept;
 
-		// VS Shader & input layout creation
-		void CreateVSBase() noexcept;
-		void CreateVSRaw() noexcept;
-		void CreateVSSkyMap() noexcept;
-		void CreateVSInstantText() noexcept;
 		void CreateAndSetVSCBs() noexcept;
-
-		// GS Shader creation
-		void CreateGSNormal() noexcept;
-
-		// PS Shader creation
-		void CreatePSBase() noexcept;
-		void CreatePSRaw() noexcept;
-		void CreatePSSkyMap() noexcept;
-		void CreatePSInstantText() noexcept;
 		void CreateAndSetPSCBs() noexcept;
 
-
-		// Views
-		void CreateRenderTargetView() noexcept;
-		void CreateDepthStencilView() noexcept;
-		void SetViews() noexcept;
-		void DestroyViews() noexcept;
-		
-
-		// States
-		void CreateDepthStencilStates() noexcept;
-		void CreateRasterizerStates() noexcept;
-		void CreateBlendStates() noexcept;
-		void CreateSamplerStates() noexcept;
-
 	private:
 		bool			m_IsCreated{ false };
+		bool			m_IsHeadless{ false };
 
-		STRING			m_BaseDirectory;
-		const SSize2*	m_pWindowSize{};
-		FLOAT			m_ClearColor[4]{};
+		JWD3D11Backend		m_D3D11Backend{};
+
+		// &m_D3D11Backend, unless created headless
+		JWGraphicsBackend*	m_pBackend{};
 
-		IDXGISwapChain*			m_SwapChain{};
-		ID3D11Device*			m_Device11{};
-		ID3D11DeviceContext*	m_DeviceContext11{};
+		const SSize2*	m_pWindowSize{};
 
 		// Display mode & projection matrix
 		VECTOR<SSize2>			m_AvailableDisplayModes{};
@@ -231,27 +239,7 @@ namespace JWEngine
 		EAllowedDisplayMode		m_FullScreenDisplayMode{};
 		EAllowedDisplayMode		m_WindowedDisplayMode{};
 
-		// Shaders and input layouts
-		ID3D11InputLayout*		m_VSBaseInputLayout{};
-		ID3D10Blob*				m_VSBaseBuffer{};
-		ID3D11VertexShader*		m_VSBase{};
-		ID3D10Blob*				m_VSRawBuffer{};
-		ID3D11VertexShader*		m_VSRaw{};
-		ID3D10Blob*				m_VSSkyMapBuffer{};
-		ID3D11VertexShader*		m_VSSkyMap{};
-		ID3D11InputLayout*		m_VSInstantTextInputLayout{};
-		ID3D10Blob*				m_VSInstantTextBlob{};
-		ID3D11VertexShader*		m_VSInstantText{};
-		ID3D10Blob*				m_GSNormalBuffer{};
-		ID3D11GeometryShader*	m_GSNormal{};
-		ID3D10Blob*				m_PSBaseBuffer{};
-		ID3D11PixelShader*		m_PSBase{};
-		ID3D10Blob*				m_PSRawBuffer{};
-		ID3D11PixelShader*		m_PSRaw{};
-		ID3D10Blob*				m_PSSkyMapBuffer{};
-		ID3D11PixelShader*		m_PSSkyMap{};
-		ID3D10Blob*				m_PSInstantTextBlob{};
-		ID3D11PixelShader*		m_PSInstantText{};
+		// Shaders
 		EVertexShader			m_CurrentVS{ EVertexShader::Invalid };
 		EGeometryShader			m_CurrentGS{ EGeometryShader::None };
 		EPixelShader			m_CurrentPS{ EPixelShader::Invalid };
@@ -266,35 +254,31 @@ namespace JWEngine
 		ID3D11Buffer*			m_PSCBCamera{};
 		SPSCBCamera				m_PSCBCameraData{};
 
-		ID3D11RenderTargetView*		m_RenderTargetView{};
-		ID3D11Texture2D*			m_RenderTargetTexture{};
-		ID3D11DepthStencilView*		m_DepthStencilView{};
-		D3D11_VIEWPORT				m_DefaultViewPort{};
+		// Last uploaded data
+		SVSCBSpace				m_VSCBSpaceCache{};
+		SVSCBFlags				m_VSCBFlagsCache{};
+		SPSCBFlags				m_PSCBFlagsCache{};
+		bool					m_IsVSCBSpaceCached{ false };
+		bool					m_IsVSCBFlagsCached{ false };
+		bool					m_IsPSCBFlagsCached{ false };
+
+		ID3D11ShaderResourceView*	m_CurrentPSShaderResources[KCachedShaderResourceSlotCount]{};
+		ID3D11ShaderResourceView*	m_CurrentVSShaderResources[KCachedShaderResourceSlotCount]{};
 
 		//
 		// States
 		//
 		EDepthStencilState			m_CurrentDepthStencilState{ EDepthStencilState::Invalid };
-		ID3D11DepthStencilState*	m_DepthStencilStateZEnabled11{};
-		ID3D11DepthStencilState*	m_DepthStencilStateZDisabled11{};
 
 		ERasterizerState			m_CurrentRasterizerState{};
 		ERasterizerState			m_PreviousRasterizerState{};
-		ID3D11RasterizerState*		m_RasterizerStateWireFrame11{};
-		ID3D11RasterizerState*		m_RasterizerStateSolidNoCull11{};
-		ID3D11RasterizerState*		m_RasterizerStateSolidBackCullCCW11{};
-		ID3D11RasterizerState*		m_RasterizerStateSolidBackCullCW11{};
 
 		EBlendState					m_CurerntBlendState{ EBlendState::Invalid };
-		ID3D11BlendState*			m_BlendStateTransparent{};
-		ID3D11BlendState*			m_BlendStateOpaque{};
 		
 		ESamplerState				m_CurrentSamplerState{ ESamplerState::Invalid };
-		ID3D11SamplerState*			m_SamplerStateMinMagMipLinearWrap{};
-		ID3D11SamplerState*			m_SamplerStateMinMagMipLinearWrapBias2{};
-		ID3D11SamplerState*			m_SamplerStateMinMagMipPointWrap{};
-		ID3D11SamplerState*			m_SamplerStateAnisotropic{};
 
 		EPrimitiveTopology			m_CurrentPrimitiveTopology{ EPrimitiveTopology::Invalid };
+
+		SDXFrameStatistics			m_FrameStatistics{};
 	};
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "JWCommon.h"
+
+namespace JWEngine
+{
+	enum class EGraphicsBufferType : uint8_t
+	{
+		DynamicVertex,
+		StaticVertex,
+		Index,
+		Constant,
+	};
+
+	enum class EPipelineStateType : uint8_t
+	{
+		Rasterizer,
+		DepthStencil,
+		Blend,
+		PSSampler,
+		PrimitiveTopology,
+		VS,
+		GS,
+		PS,
+	};
+
+	enum class EShaderStage : uint8_t
+	{
+		VS,
+		PS,
+	};
+
+	// Everything JWDX sends to the GPU goes through this interface.
+	// JWD3D11Backend talks to Direct3D 11, JWNullGraphicsBackend only records the calls and
+	// JWSoftwareRasterizer draws on the CPU (both for headless runs).
+	// @important: JWDX filters redundant state and shader resource binds before they get here.
+	class JWGraphicsBackend
+	{
+	public:
+		virtual ~JWGraphicsBackend() = default;
+
+		virtual void CreateBuffer(EGraphicsBufferType Type, UINT ByteSize, const void* pData, ID3D11Buffer** ppBuffer) noexcept = 0;
+		virtual void UpdateBuffer(ID3D11Resource* pResource, const void* pData, size_t Size) noexcept = 0;
+
+		virtual void BindVertexBuffers(UINT StartSlot, UINT BufferCount, ID3D11Buffer* const* ppBuffers,
+			const UINT* pStrides, const UINT* pOffsets) noexcept = 0;
+		virtual void BindIndexBuffer(ID3D11Buffer* pBuffer) noexcept = 0;
+		virtual void BindConstantBuffer(EShaderStage Stage, UINT Slot, ID3D11Buffer* pBuffer) noexcept = 0;
+
+		// Value is the engine's enum value for the state type (ERasterizerState, EVertexShader, ...).
+		virtual void BindPipelineState(EPipelineStateType Type, uint32_t Value) noexcept = 0;
+		virtual void BindShaderResource(EShaderStage Stage, UINT Slot, ID3D11ShaderResourceView* pView) noexcept = 0;
+
+		virtual void SubmitDraw(UINT VertexCount) noexcept = 0;
+		virtual void SubmitDrawIndexed(UINT IndexCount) noexcept = 0;
+		virtual void SubmitDrawIndexedInstanced(UINT IndexCount, UINT InstanceCount) noexcept = 0;
+
+		virtual void BeginFrame() noexcept = 0;
+		virtual void EndFrame() noexcept = 0;
+	};
+};
@@ -107,7 +107,7 @@ void JWImageCursor::Draw() noexcept
 	m_pDX->UpdateVSCBSpace(m_VSCBSpace);
 
 	// Set PS texture and sampler
-	m_pDX->GetDeviceContext()->PSSetShaderResources(0, 1, &m_TextureShaderResourceView);
+	m_pDX->SetPSShaderResource(0, m_TextureShaderResourceView);
 	m_pDX->SetPSSamplerState(ESamplerState::MinMagMipLinearWrap);
 
 	// Update PS constant buffer
@@ -117,11 +117,11 @@ void JWImageCursor::Draw() noexcept
 	m_pDX->SetPrimitiveTopology(EPrimitiveTopology::TriangleList);
 
 	// Set IA vertex buffer
-	m_pDX->GetDeviceContext()->IASetVertexBuffers(0, 1, &m_VertexBuffer, m_VertexData.GetPtrStrides(), m_VertexData.GetPtrOffsets());
+	m_pDX->SetVertexBuffers(0, 1, &m_VertexBuffer, m_VertexData.GetPtrStrides(), m_VertexData.GetPtrOffsets());
 	
 	// Set IA index buffer
-	m_pDX->GetDeviceContext()->IASetIndexBuffer(m_IndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+	m_pDX->SetIndexBuffer(m_IndexBuffer);
 
 	// Draw indexed
-	m_pDX->GetDeviceContext()->DrawIndexed(m_IndexData.GetCount(), 0, 0);
+	m_pDX->DrawIndexed(m_IndexData.GetCount());
 }
\ No newline at end of file
@@ -106,7 +106,7 @@ void JWInstantText::BeginRendering() noexcept
 	m_pDX->SetPS(EPixelShader::PSIntantText);
 
 	// Set PS texture and sampler
-	m_pDX->GetDeviceContext()->PSSetShaderResources(0, 1, &m_FontTextureSRV);
+	m_pDX->SetPSShaderResource(0, m_FontTextureSRV);
 	m_pDX->SetPSSamplerState(ESamplerState::MinMagMipLinearWrap);
 
 	// Initialize text length
@@ -189,14 +189,14 @@ void JWInstantText::EndRendering() noexcept
 	m_pDX->SetPrimitiveTopology(EPrimitiveTopology::TriangleList);
 
 	// Set IA vertex buffer
-	m_pDX->GetDeviceContext()->IASetVertexBuffers(0, 1, &m_VertexBuffer, m_VertexData.GetPtrStride(), m_VertexData.GetPtrOffset());
+	m_pDX->SetVertexBuffers(0, 1, &m_VertexBuffer, m_VertexData.GetPtrStride(), m_VertexData.GetPtrOffset());
 
 	// Set IA index buffer
-	m_pDX->GetDeviceContext()->IASetIndexBuffer(m_IndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+	m_pDX->SetIndexBuffer(m_IndexBuffer);
 
 	// @important for performance (Draw ONLY the visible vertices)
 	// Draw indexed 
-	m_pDX->GetDeviceContext()->DrawIndexed(3 * m_TotalTextLength * 2, 0, 0);
+	m_pDX->DrawIndexed(3 * m_TotalTextLength * 2);
 
 	// Restore rasterizer state
 	if (m_ShouldToggleWireFrame)
@@ -0,0 +1,159 @@
+#include "JWJobSystem.h"
+
+using namespace JWEngine;
+
+// Which job system (and which queue of it) the current thread works for.
+static thread_local const JWJobSystem*	t_pOwnerJobSystem{};
+static thread_local uint32_t			t_QueueID{};
+
+void JWJobSystem::Create(uint32_t WorkerThreadCount) noexcept
+{
+	if (IsCreated()) { return; }
+
+	if (WorkerThreadCount == KJobSystemAutoWorkerCount)
+	{
+		auto hardware_thread_count = std::thread::hardware_concurrency();
+		WorkerThreadCount = (hardware_thread_count > 1) ? hardware_thread_count - 1 : 0;
+	}
+
+	// Queue 0 + worker queues
+	for (uint32_t i = 0; i <= WorkerThreadCount; ++i)
+	{
+		m_vQueues.emplace_back(MAKE_UNIQUE(SJobQueue)());
+	}
+
+	m_IsRunning = true;
+
+	for (uint32_t i = 1; i <= WorkerThreadCount; ++i)
+	{
+		m_vWorkerThreads.emplace_back(&JWJobSystem::WorkerMain, this, i);
+	}
+}
+
+void JWJobSystem::Destroy() noexcept
+{
+	if (!IsCreated()) { return; }
+
+	{
+		std::lock_guard<std::mutex> lock{ m_WakeMutex };
+		m_IsRunning = false;
+	}
+	m_WakeCondition.notify_all();
+
+	for (auto& iter : m_vWorkerThreads)
+	{
+		if (iter.joinable()) { iter.join(); }
+	}
+
+	m_vWorkerThreads.clear();
+	m_vQueues.clear();
+	m_PendingJobCount = 0;
+}
+
+void JWJobSystem::Run(JobFunction Function, SJobCounter& Counter) noexcept
+{
+	if (!IsCreated())
+	{
+		Function();
+		return;
+	}
+
+	// @important: the counter must be incremented before the job becomes visible to other threads.
+	++Counter.Count;
+
+	auto& queue = *m_vQueues[GetCurrentQueueID()];
+	{
+		std::lock_guard<std::mutex> lock{ queue.Mutex };
+		queue.Jobs.emplace_back(MOVE(Function), &Counter);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{ m_WakeMutex };
+		++m_PendingJobCount;
+	}
+	m_WakeCondition.notify_one();
+}
+
+void JWJobSystem::Wait(SJobCounter& Counter) noexcept
+{
+	if (!IsCreated()) { return; }
+
+	auto queue_id = GetCurrentQueueID();
+
+	while (Counter.Count.load() > 0)
+	{
+		if (!ExecuteOneJob(queue_id))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+PRIVATE void JWJobSystem::WorkerMain(uint32_t QueueID) noexcept
+{
+	t_pOwnerJobSystem = this;
+	t_QueueID = QueueID;
+
+	while (true)
+	{
+		if (ExecuteOneJob(QueueID)) { continue; }
+
+		std::unique_lock<std::mutex> lock{ m_WakeMutex };
+		m_WakeCondition.wait(lock, [this]() { return (!m_IsRunning) || (m_PendingJobCount.load() > 0); });
+
+		if (!m_IsRunning) { break; }
+	}
+}
+
+PRIVATE auto JWJobSystem::GetCurrentQueueID() const noexcept->uint32_t
+{
+	return (t_pOwnerJobSystem == this) ? t_QueueID : 0;
+}
+
+PRIVATE auto JWJobSystem::PopJob(uint32_t QueueID, SJob& OutJob) noexcept->bool
+{
+	auto& queue = *m_vQueues[QueueID];
+	std::lock_guard<std::mutex> lock{ queue.Mutex };
+
+	if (queue.Jobs.empty()) { return false; }
+
+	OutJob = MOVE(queue.Jobs.back());
+	queue.Jobs.pop_back();
+	return true;
+}
+
+PRIVATE auto JWJobSystem::StealJob(uint32_t ThiefQueueID, SJob& OutJob) noexcept->bool
+{
+	auto queue_count = static_cast<uint32_t>(m_vQueues.size());
+
+	for (uint32_t i = 1; i < queue_count; ++i)
+	{
+		auto& queue = *m_vQueues[(ThiefQueueID + i) % queue_count];
+		std::lock_guard<std::mutex> lock{ queue.Mutex };
+
+		if (queue.Jobs.empty()) { continue; }
+
+		OutJob = MOVE(queue.Jobs.front());
+		queue.Jobs.pop_front();
+		return true;
+	}
+
+	return false;
+}
+
+PRIVATE auto JWJobSystem::ExecuteOneJob(uint32_t QueueID) noexcept->bool
+{
+	SJob job{};
+	if ((!PopJob(QueueID, job)) && (!StealJob(QueueID, job)))
+	{
+		return false;
+	}
+
+	--m_PendingJobCount;
+
+	job.Function();
+
+	--job.PtrCounter->Count;
+
+	return true;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "JWCommon.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+#include <functional>
+
+namespace JWEngine
+{
+	// Worker thread count is (hardware threads - 1), the calling thread helps while it waits.
+	static constexpr uint32_t KJobSystemAutoWorkerCount{ (uint32_t)-1 };
+
+	// ParallelFor() never makes chunks smaller than this by default.
+	static constexpr uint32_t KJobSystemDefaultMinChunkSize{ 64 };
+
+	// Upper bound of chunks per thread in ParallelFor() (more chunks = better stealing, more overhead)
+	static constexpr uint32_t KJobSystemChunksPerThread{ 4 };
+
+	using JobFunction = std::function<void()>;
+
+	// Number of unfinished jobs of a group.
+	// Run() increments it, finished jobs decrement it, Wait() returns when it reaches zero.
+	struct SJobCounter
+	{
+		std::atomic<uint32_t> Count{};
+	};
+
+	struct SJob
+	{
+		SJob() {};
+		SJob(JobFunction _Function, SJobCounter* _PtrCounter) : Function{ MOVE(_Function) }, PtrCounter{ _PtrCounter } {};
+
+		JobFunction		Function{};
+		SJobCounter*	PtrCounter{};
+	};
+
+	// Owner pushes and pops at the back (LIFO), thieves steal from the front (FIFO).
+	struct SJobQueue
+	{
+		std::mutex		Mutex{};
+		std::deque<SJob>	Jobs{};
+	};
+
+	// Work-stealing job scheduler.
+	// @important: it doesn't depend on JWDX or a window, so it can be used headless.
+	class JWJobSystem
+	{
+	public:
+		JWJobSystem() = default;
+		~JWJobSystem() { Destroy(); };
+
+		JWJobSystem(const JWJobSystem&) = delete;
+		JWJobSystem& operator=(const JWJobSystem&) = delete;
+
+		// WorkerThreadCount 0 means no worker threads (every job runs on the calling thread).
+		void Create(uint32_t WorkerThreadCount = KJobSystemAutoWorkerCount) noexcept;
+		void Destroy() noexcept;
+
+		// If the job system is not created, the job is executed immediately.
+		void Run(JobFunction Function, SJobCounter& Counter) noexcept;
+
+		// The calling thread executes (or steals) jobs until Counter reaches zero.
+		void Wait(SJobCounter& Counter) noexcept;
+
+		// Calls Function(Begin, End) for chunks of [0, Count) and returns when all of them are done.
+		template <typename FunctionType>
+		void ParallelFor(uint32_t Count, uint32_t MinChunkSize, const FunctionType& Function) noexcept
+		{
+			if (Count == 0) { return; }
+
+			MinChunkSize = max(MinChunkSize, (uint32_t)1);
+
+			auto thread_count = GetWorkerThreadCount() + 1;
+			if ((thread_count == 1) || (Count <= MinChunkSize))
+			{
+				Function(0, Count);
+				return;
+			}
+
+			auto chunk_count = min((Count + MinChunkSize - 1) / MinChunkSize, thread_count * KJobSystemChunksPerThread);
+			auto chunk_size = (Count + chunk_count - 1) / chunk_count;
+
+			SJobCounter counter{};
+			for (uint32_t begin = chunk_size; begin < Count; begin += chunk_size)
+			{
+				auto end = min(begin + chunk_size, Count);
+				Run([&Function, begin, end]() { Function(begin, end); }, counter);
+			}
+
+			// The calling thread takes the first chunk.
+			Function(0, min(chunk_size, Count));
+
+			Wait(counter);
+		}
+
+		auto GetWorkerThreadCount() const noexcept { return static_cast<uint32_t>(m_vWorkerThreads.size()); };
+		auto IsCreated() const noexcept { return (m_vQueues.size() > 0); };
+
+	private:
+		void WorkerMain(uint32_t QueueID) noexcept;
+
+		auto GetCurrentQueueID() const noexcept->uint32_t;
+		auto PopJob(uint32_t QueueID, SJob& OutJob) noexcept->bool;
+		auto StealJob(uint32_t ThiefQueueID, SJob& OutJob) noexcept->bool;
+		auto ExecuteOneJob(uint32_t QueueID) noexcept->bool;
+
+	private:
+		// Queue 0 is shared by every non-worker thread, queue n (n >= 1) belongs to worker n.
+		VECTOR<UNIQUE_PTR<SJobQueue>>	m_vQueues{};
+		VECTOR<std::thread>				m_vWorkerThreads{};
+
+		std::atomic<bool>				m_IsRunning{ false };
+		std::atomic<uint32_t>			m_PendingJobCount{};
+
+		std::mutex						m_WakeMutex{};
+		std::condition_variable			m_WakeCondition{};
+	};
+};
@@ -12,6 +12,9 @@ namespace JWEngine
 
 	static const XMMATRIX KMatrixIdentity = XMMatrixIdentity();
 
+	// Left, right, bottom, top, near, far
+	static constexpr uint32_t KFrustumPlaneCount{ 6 };
+
 	static auto __vectorcall GetRayDirection(const XMVECTOR& RayOrigin, const XMVECTOR& PointInRayDirection)->XMVECTOR
 	{
 		return XMVector3Normalize(PointInRayDirection - RayOrigin);
@@ -310,6 +313,21 @@ namespace JWEngine
 		return false;
 	}
 
+	// Planes of a view-projection matrix (row vectors, clip-space z in [0, w]) in world space.
+	// They are normalized and point inward, so a sphere is outside if XMPlaneDotCoord(Plane, Center) < -Radius for any of them.
+	static void __vectorcall ExtractFrustumPlanes(const XMMATRIX& ViewProjection, XMVECTOR* OutPlanes) noexcept
+	{
+		// Rows of the transpose are the columns of the matrix (clip.x = Dot(v, column 0), ...)
+		auto columns = XMMatrixTranspose(ViewProjection);
+
+		OutPlanes[0] = XMPlaneNormalize(columns.r[3] + columns.r[0]);
+		OutPlanes[1] = XMPlaneNormalize(columns.r[3] - columns.r[0]);
+		OutPlanes[2] = XMPlaneNormalize(columns.r[3] + columns.r[1]);
+		OutPlanes[3] = XMPlaneNormalize(columns.r[3] - columns.r[1]);
+		OutPlanes[4] = XMPlaneNormalize(columns.r[2]);
+		OutPlanes[5] = XMPlaneNormalize(columns.r[3] - columns.r[2]);
+	}
+
 	static auto __vectorcall IntersectSpheres(
 		float RadiusA, const XMVECTOR& CenterA, float RadiusB, const XMVECTOR& CenterB, float* OutSqaureDistancePtr = nullptr) noexcept->bool
 	{
@@ -222,49 +222,36 @@ PRIVATE void JWModel::SaveAnimationFrameIntoFrameMatrices(XMMATRIX* OutFrameMatr
 		auto& bone = ModelData.BoneTree.vBones[CurrentNode.BoneID];
 		auto& current_animation = ModelData.AnimationSet.vAnimations[AnimationID];
 
-		for (const auto& CurrentNode_animation : current_animation.vNodeAnimation)
+		auto node_animation = current_animation.GetNodeAnimation(CurrentNode.ID);
+		if (node_animation)
 		{
-			if (CurrentNode_animation.NodeID == CurrentNode.ID)
-			{
-				XMVECTOR scaling_key_a{};
-				XMVECTOR rotation_key_a{};
-				XMVECTOR translation_key_a{};
-
-				// #1. Find scaling keys
-				for (const auto& key : CurrentNode_animation.vKeyScaling)
-				{
-					if (key.TimeInTicks <= FrameTime)
-					{
-						scaling_key_a = XMLoadFloat3(&key.Key);
-					}
-				}
+			XMVECTOR scaling_key_a{};
+			XMVECTOR rotation_key_a{};
+			XMVECTOR translation_key_a{};
 
-				// #2. Find rotation keys
-				for (const auto& key : CurrentNode_animation.vKeyRotation)
-				{
-					if (key.TimeInTicks <= FrameTime)
-					{
-						rotation_key_a = key.Key;
-					}
-				}
+			// #1. Find scaling keys
+			if (node_animation->vKeyScaling.size())
+			{
+				scaling_key_a = XMLoadFloat3(&node_animation->vKeyScaling[FindAnimationKeyIndex(node_animation->vKeyScaling, FrameTime)].Key);
+			}
 
-				// #3. Find translation keys
-				for (const auto& key : CurrentNode_animation.vKeyPosition)
-				{
-					if (key.TimeInTicks <= FrameTime)
-					{
-						translation_key_a = XMLoadFloat3(&key.Key);
-					}
-				}
+			// #2. Find rotation keys
+			if (node_animation->vKeyRotation.size())
+			{
+				rotation_key_a = node_animation->vKeyRotation[FindAnimationKeyIndex(node_animation->vKeyRotation, FrameTime)].Key;
+			}
 
-				XMMATRIX matrix_scaling{ XMMatrixScalingFromVector(scaling_key_a) };
-				XMMATRIX matrix_rotation{ XMMatrixRotationQuaternion(rotation_key_a) };
-				XMMATRIX matrix_translation{ XMMatrixTranslationFromVector(translation_key_a) };
+			// #3. Find translation keys
+			if (node_animation->vKeyPosition.size())
+			{
+				translation_key_a = XMLoadFloat3(&node_animation->vKeyPosition[FindAnimationKeyIndex(node_animation->vKeyPosition, FrameTime)].Key);
+			}
 
-				global_transformation = matrix_scaling * matrix_rotation * matrix_translation * Accumulated;
+			XMMATRIX matrix_scaling{ XMMatrixScalingFromVector(scaling_key_a) };
+			XMMATRIX matrix_rotation{ XMMatrixRotationQuaternion(rotation_key_a) };
+			XMMATRIX matrix_translation{ XMMatrixTranslationFromVector(translation_key_a) };
 
-				break;
-			}
+			global_transformation = matrix_scaling * matrix_rotation * matrix_translation * Accumulated;
 		}
 
 		OutFrameMatrices[CurrentNode.BoneID] = bone.Offset * global_transformation;
@@ -0,0 +1,239 @@
+#include "JWNullGraphicsBackend.h"
+
+using namespace JWEngine;
+
+// Identifies buffers created by JWNullGraphicsBackend among other ID3D11Resource objects (QueryInterface()).
+static constexpr GUID KNullBufferGUID{ 0x3f9b7e21, 0x5c0d, 0x4a86, { 0xb1, 0x4e, 0x72, 0x0f, 0xd8, 0x93, 0x26, 0xcb } };
+
+namespace JWEngine
+{
+	// Opaque handle that can be handed out wherever the engine expects an ID3D11Buffer (JW_RELEASE() works on it).
+	// It owns no memory, only the ID and the description of the buffer.
+	class JWNullBuffer final : public ID3D11Buffer
+	{
+	public:
+		JWNullBuffer(uint32_t ID, EGraphicsBufferType Type, UINT ByteSize) : m_ID{ ID }, m_Type{ Type }, m_ByteSize{ ByteSize } {}
+
+		auto GetID() const noexcept { return m_ID; }
+
+		HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override
+		{
+			if (!ppvObject) { return E_POINTER; }
+
+			if ((riid == KNullBufferGUID) || (riid == __uuidof(IUnknown)) || (riid == __uuidof(ID3D11DeviceChild)) ||
+				(riid == __uuidof(ID3D11Resource)) || (riid == __uuidof(ID3D11Buffer)))
+			{
+				*ppvObject = this;
+				AddRef();
+				return S_OK;
+			}
+
+			*ppvObject = nullptr;
+			return E_NOINTERFACE;
+		}
+
+		ULONG STDMETHODCALLTYPE AddRef() override { return ++m_ReferenceCount; }
+
+		ULONG STDMETHODCALLTYPE Release() override
+		{
+			auto reference_count = --m_ReferenceCount;
+			if (reference_count == 0) { delete this; }
+			return reference_count;
+		}
+
+		// There is no device behind these buffers.
+		void STDMETHODCALLTYPE GetDevice(ID3D11Device** ppDevice) override { *ppDevice = nullptr; }
+		HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData) override { return DXGI_ERROR_NOT_FOUND; }
+		HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT DataSize, const void* pData) override { return E_NOTIMPL; }
+		HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* pData) override { return E_NOTIMPL; }
+
+		void STDMETHODCALLTYPE GetType(D3D11_RESOURCE_DIMENSION* pResourceDimension) override
+		{
+			*pResourceDimension = D3D11_RESOURCE_DIMENSION_BUFFER;
+		}
+		void STDMETHODCALLTYPE SetEvictionPriority(UINT EvictionPriority) override {}
+		UINT STDMETHODCALLTYPE GetEvictionPriority() override { return DXGI_RESOURCE_PRIORITY_NORMAL; }
+
+		void STDMETHODCALLTYPE GetDesc(D3D11_BUFFER_DESC* pDesc) override
+		{
+			*pDesc = D3D11_BUFFER_DESC{};
+			pDesc->ByteWidth = m_ByteSize;
+
+			switch (m_Type)
+			{
+			case EGraphicsBufferType::DynamicVertex:
+				pDesc->Usage = D3D11_USAGE_DYNAMIC;
+				pDesc->BindFlags = D3D11_BIND_VERTEX_BUFFER;
+				pDesc->CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+				break;
+			case EGraphicsBufferType::StaticVertex:
+				pDesc->Usage = D3D11_USAGE_DEFAULT;
+				pDesc->BindFlags = D3D11_BIND_VERTEX_BUFFER;
+				break;
+			case EGraphicsBufferType::Index:
+				pDesc->Usage = D3D11_USAGE_DEFAULT;
+				pDesc->BindFlags = D3D11_BIND_INDEX_BUFFER;
+				break;
+			case EGraphicsBufferType::Constant:
+				pDesc->Usage = D3D11_USAGE_DYNAMIC;
+				pDesc->BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+				pDesc->CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+				break;
+			default:
+				break;
+			}
+		}
+
+	private:
+		~JWNullBuffer() = default;
+
+	private:
+		uint32_t			m_ID{};
+		EGraphicsBufferType	m_Type{};
+		UINT				m_ByteSize{};
+		ULONG				m_ReferenceCount{ 1 };
+	};
+};
+
+STATIC auto JWNullGraphicsBackend::GetBufferID(ID3D11Resource* pResource) noexcept->uint32_t
+{
+	if (!pResource) { return 0; }
+
+	void* result{};
+	if (FAILED(pResource->QueryInterface(KNullBufferGUID, &result))) { return 0; }
+
+	// QueryInterface() added a reference, the caller doesn't own one.
+	auto buffer = static_cast<JWNullBuffer*>(result);
+	buffer->Release();
+
+	return buffer->GetID();
+}
+
+void JWNullGraphicsBackend::Clear() noexcept
+{
+	m_vCommands.clear();
+	m_vPayload.clear();
+	m_Counters = SGraphicsCommandCounters();
+}
+
+PRIVATE void JWNullGraphicsBackend::Record(EGraphicsCommandType Type, uint8_t SubType, uint32_t Value, uint32_t Count,
+	const void* Handle) noexcept
+{
+	SGraphicsCommand command{};
+	command.Type = Type;
+	command.SubType = SubType;
+	command.Value = Value;
+	command.Count = Count;
+	command.Handle = Handle;
+
+	m_vCommands.emplace_back(command);
+}
+
+PRIVATE auto JWNullGraphicsBackend::RecordPayload(const void* pData, size_t Size) noexcept->uint32_t
+{
+	auto offset = static_cast<uint32_t>(m_vPayload.size());
+
+	if ((m_ShouldRecordPayload) && (pData) && (Size))
+	{
+		auto bytes = static_cast<const uint8_t*>(pData);
+		m_vPayload.insert(m_vPayload.end(), bytes, bytes + Size);
+	}
+
+	return offset;
+}
+
+void JWNullGraphicsBackend::CreateBuffer(EGraphicsBufferType Type, UINT ByteSize, const void* pData, ID3D11Buffer** ppBuffer) noexcept
+{
+	auto buffer = new JWNullBuffer(++m_LastBufferID, Type, ByteSize);
+	*ppBuffer = buffer;
+
+	Record(EGraphicsCommandType::CreateBuffer, static_cast<uint8_t>(Type), buffer->GetID(), ByteSize, buffer);
+	m_vCommands.back().PayloadOffset = RecordPayload(pData, ByteSize);
+
+	++m_Counters.BufferCreationCount;
+	m_Counters.CreatedBufferByteCount += ByteSize;
+}
+
+void JWNullGraphicsBackend::UpdateBuffer(ID3D11Resource* pResource, const void* pData, size_t Size) noexcept
+{
+	Record(EGraphicsCommandType::UpdateBuffer, 0, 0, static_cast<uint32_t>(Size), pResource);
+	m_vCommands.back().PayloadOffset = RecordPayload(pData, Size);
+
+	++m_Counters.BufferUpdateCount;
+	m_Counters.UpdatedBufferByteCount += Size;
+}
+
+void JWNullGraphicsBackend::BindVertexBuffers(UINT StartSlot, UINT BufferCount, ID3D11Buffer* const* ppBuffers,
+	const UINT* pStrides, const UINT* pOffsets) noexcept
+{
+	Record(EGraphicsCommandType::BindVertexBuffers, 0, StartSlot, BufferCount, (BufferCount) ? ppBuffers[0] : nullptr);
+
+	++m_Counters.BindCount;
+}
+
+void JWNullGraphicsBackend::BindIndexBuffer(ID3D11Buffer* pBuffer) noexcept
+{
+	Record(EGraphicsCommandType::BindIndexBuffer, 0, 0, 0, pBuffer);
+
+	++m_Counters.BindCount;
+}
+
+void JWNullGraphicsBackend::BindConstantBuffer(EShaderStage Stage, UINT Slot, ID3D11Buffer* pBuffer) noexcept
+{
+	Record(EGraphicsCommandType::BindConstantBuffer, static_cast<uint8_t>(Stage), Slot, 1, pBuffer);
+
+	++m_Counters.BindCount;
+}
+
+void JWNullGraphicsBackend::BindPipelineState(EPipelineStateType Type, uint32_t Value) noexcept
+{
+	Record(EGraphicsCommandType::BindPipelineState, static_cast<uint8_t>(Type), Value, 0, nullptr);
+
+	++m_Counters.BindCount;
+}
+
+void JWNullGraphicsBackend::BindShaderResource(EShaderStage Stage, UINT Slot, ID3D11ShaderResourceView* pView) noexcept
+{
+	Record(EGraphicsCommandType::BindShaderResource, static_cast<uint8_t>(Stage), Slot, 1, pView);
+
+	++m_Counters.BindCount;
+}
+
+void JWNullGraphicsBackend::SubmitDraw(UINT VertexCount) noexcept
+{
+	Record(EGraphicsCommandType::Draw, 0, VertexCount, 1, nullptr);
+
+	++m_Counters.DrawCallCount;
+	m_Counters.DrawnVertexCount += VertexCount;
+	++m_Counters.DrawnInstanceCount;
+}
+
+void JWNullGraphicsBackend::SubmitDrawIndexed(UINT IndexCount) noexcept
+{
+	Record(EGraphicsCommandType::DrawIndexed, 0, IndexCount, 1, nullptr);
+
+	++m_Counters.DrawCallCount;
+	m_Counters.DrawnIndexCount += IndexCount;
+	++m_Counters.DrawnInstanceCount;
+}
+
+void JWNullGraphicsBackend::SubmitDrawIndexedInstanced(UINT IndexCount, UINT InstanceCount) noexcept
+{
+	Record(EGraphicsCommandType::DrawIndexedInstanced, 0, IndexCount, InstanceCount, nullptr);
+
+	++m_Counters.DrawCallCount;
+	m_Counters.DrawnIndexCount += static_cast<uint64_t>(IndexCount) * InstanceCount;
+	m_Counters.DrawnInstanceCount += InstanceCount;
+}
+
+void JWNullGraphicsBackend::BeginFrame() noexcept
+{
+	Record(EGraphicsCommandType::BeginFrame, 0, m_Counters.FrameCount, 0, nullptr);
+}
+
+void JWNullGraphicsBackend::EndFrame() noexcept
+{
+	Record(EGraphicsCommandType::EndFrame, 0, m_Counters.FrameCount, 0, nullptr);
+
+	++m_Counters.FrameCount;
+}
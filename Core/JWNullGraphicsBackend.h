@@ -0,0 +1,112 @@
+#pragma once
+
+#include "JWGraphicsBackend.h"
+
+namespace JWEngine
+{
+	enum class EGraphicsCommandType : uint8_t
+	{
+		CreateBuffer,
+		UpdateBuffer,
+		BindVertexBuffers,
+		BindIndexBuffer,
+		BindConstantBuffer,
+		BindPipelineState,
+		BindShaderResource,
+		Draw,
+		DrawIndexed,
+		DrawIndexedInstanced,
+		BeginFrame,
+		EndFrame,
+	};
+
+	struct SGraphicsCommand
+	{
+		EGraphicsCommandType	Type{};
+
+		// EGraphicsBufferType, EPipelineStateType or EShaderStage
+		uint8_t					SubType{};
+
+		// State value, slot, start slot, vertex count, index count or buffer ID (CreateBuffer)
+		uint32_t				Value{};
+
+		// Byte size, buffer count or instance count
+		uint32_t				Count{};
+
+		// Buffer, resource or shader resource view
+		const void*				Handle{};
+
+		// Where the uploaded bytes start in the payload (CreateBuffer and UpdateBuffer only)
+		uint32_t				PayloadOffset{};
+	};
+
+	// Totals since the last Clear()
+	struct SGraphicsCommandCounters
+	{
+		uint32_t	FrameCount{};
+
+		uint32_t	DrawCallCount{};
+		uint64_t	DrawnVertexCount{};
+		uint64_t	DrawnIndexCount{};
+		uint64_t	DrawnInstanceCount{};
+
+		uint32_t	BufferCreationCount{};
+		uint64_t	CreatedBufferByteCount{};
+		uint32_t	BufferUpdateCount{};
+		uint64_t	UpdatedBufferByteCount{};
+
+		uint32_t	BindCount{};
+	};
+
+	// Records every command into memory instead of talking to a GPU (see JWDX::CreateHeadless()).
+	// @important: CreateBuffer() hands out opaque ID3D11Buffer handles that own no memory.
+	// Every handle has its own ID (starting from 1, never reused, not reset by Clear()) and must be released with JW_RELEASE().
+	class JWNullGraphicsBackend final : public JWGraphicsBackend
+	{
+	public:
+		JWNullGraphicsBackend() = default;
+		~JWNullGraphicsBackend() = default;
+
+		// If false, only commands are recorded (buffer contents are counted but not copied).
+		void SetPayloadRecording(bool ShouldRecordPayload) noexcept { m_ShouldRecordPayload = ShouldRecordPayload; }
+
+		void Clear() noexcept;
+
+		const auto& GetCommands() const noexcept { return m_vCommands; }
+		const auto& GetPayload() const noexcept { return m_vPayload; }
+		const auto& GetCounters() const noexcept { return m_Counters; }
+
+		// 0 if pResource wasn't created by a JWNullGraphicsBackend
+		static auto GetBufferID(ID3D11Resource* pResource) noexcept->uint32_t;
+
+		void CreateBuffer(EGraphicsBufferType Type, UINT ByteSize, const void* pData, ID3D11Buffer** ppBuffer) noexcept override;
+		void UpdateBuffer(ID3D11Resource* pResource, const void* pData, size_t Size) noexcept override;
+
+		void BindVertexBuffers(UINT StartSlot, UINT BufferCount, ID3D11Buffer* const* ppBuffers,
+			const UINT* pStrides, const UINT* pOffsets) noexcept override;
+		void BindIndexBuffer(ID3D11Buffer* pBuffer) noexcept override;
+		void BindConstantBuffer(EShaderStage Stage, UINT Slot, ID3D11Buffer* pBuffer) noexcept override;
+		void BindPipelineState(EPipelineStateType Type, uint32_t Value) noexcept override;
+		void BindShaderResource(EShaderStage Stage, UINT Slot, ID3D11ShaderResourceView* pView) noexcept override;
+
+		void SubmitDraw(UINT VertexCount) noexcept override;
+		void SubmitDrawIndexed(UINT IndexCount) noexcept override;
+		void SubmitDrawIndexedInstanced(UINT IndexCount, UINT InstanceCount) noexcept override;
+
+		void BeginFrame() noexcept override;
+		void EndFrame() noexcept override;
+
+	private:
+		void Record(EGraphicsCommandType Type, uint8_t SubType, uint32_t Value, uint32_t Count, const void* Handle) noexcept;
+
+		// Returns the payload offset of the copied bytes.
+		auto RecordPayload(const void* pData, size_t Size) noexcept->uint32_t;
+
+	private:
+		VECTOR<SGraphicsCommand>	m_vCommands{};
+		VECTOR<uint8_t>				m_vPayload{};
+		SGraphicsCommandCounters	m_Counters{};
+		bool						m_ShouldRecordPayload{ true };
+		uint32_t					m_LastBufferID{};
+	};
+};
@@ -82,16 +82,15 @@ void JWRawPixelSetter::Draw() noexcept
 	m_pDX->SetPS(EPixelShader::PSRaw);
 
 	// Set texture and sampler for pixel shader (RawPixelSetter = t0)
-	m_pDX->GetDeviceContext()->PSSetShaderResources(0, 1, &m_RawTexture2DSRV);
+	m_pDX->SetPSShaderResource(0, m_RawTexture2DSRV);
 	m_pDX->SetPSSamplerState(ESamplerState::MinMagMipPointWrap);
 
 	// Set primitive topology
 	m_pDX->SetPrimitiveTopology(EPrimitiveTopology::TriangleStrip);
 
 	// Draw Screen-quad
-	m_pDX->GetDeviceContext()->IASetInputLayout(nullptr);
-	m_pDX->GetDeviceContext()->IASetVertexBuffers(0, 0, nullptr, nullptr, nullptr);
-	m_pDX->GetDeviceContext()->Draw(4, 0);
+	m_pDX->SetVertexBuffers(0, 0, nullptr, nullptr, nullptr);
+	m_pDX->Draw(4);
 }
 
 PRIVATE void JWRawPixelSetter::UpdateRawTexture() noexcept
@@ -0,0 +1,728 @@
+#include "JWSoftwareRasterizer.h"
+#include "JWDX.h"
+#include "JWJobSystem.h"
+
+using namespace JWEngine;
+
+// Triangles with a vertex this close to (or behind) the camera plane are dropped (no near plane clipping).
+static constexpr float KRasterMinClipW{ 0.0001f };
+
+// Identifies buffers created by JWSoftwareRasterizer among other ID3D11Resource objects (QueryInterface()).
+static constexpr GUID KSoftwareBufferGUID{ 0x6a1d3c52, 0x84f1, 0x4e0b, { 0x9d, 0x27, 0x51, 0xc8, 0x3e, 0x0a, 0x7b, 0x94 } };
+
+namespace JWEngine
+{
+	// CPU-side buffer that can be handed out wherever the engine expects an ID3D11Buffer (JW_RELEASE() works on it).
+	class JWSoftwareBuffer final : public ID3D11Buffer
+	{
+	public:
+		JWSoftwareBuffer(EGraphicsBufferType Type, UINT ByteSize, const void* pData) : m_Type{ Type }, m_vData(ByteSize)
+		{
+			if ((pData) && (ByteSize)) { memcpy(&m_vData[0], pData, ByteSize); }
+		}
+
+		auto GetData() const noexcept { return (m_vData.size()) ? &m_vData[0] : nullptr; }
+		auto GetByteSize() const noexcept { return static_cast<uint32_t>(m_vData.size()); }
+
+		void Update(const void* pData, size_t Size) noexcept
+		{
+			Size = min(Size, m_vData.size());
+			if ((pData) && (Size)) { memcpy(&m_vData[0], pData, Size); }
+		}
+
+		HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override
+		{
+			if (!ppvObject) { return E_POINTER; }
+
+			if ((riid == KSoftwareBufferGUID) || (riid == __uuidof(IUnknown)) || (riid == __uuidof(ID3D11DeviceChild)) ||
+				(riid == __uuidof(ID3D11Resource)) || (riid == __uuidof(ID3D11Buffer)))
+			{
+				*ppvObject = this;
+				AddRef();
+				return S_OK;
+			}
+
+			*ppvObject = nullptr;
+			return E_NOINTERFACE;
+		}
+
+		ULONG STDMETHODCALLTYPE AddRef() override { return ++m_ReferenceCount; }
+
+		ULONG STDMETHODCALLTYPE Release() override
+		{
+			auto reference_count = --m_ReferenceCount;
+			if (reference_count == 0) { delete this; }
+			return reference_count;
+		}
+
+		// There is no device behind these buffers.
+		void STDMETHODCALLTYPE GetDevice(ID3D11Device** ppDevice) override { *ppDevice = nullptr; }
+		HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData) override { return DXGI_ERROR_NOT_FOUND; }
+		HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT DataSize, const void* pData) override { return E_NOTIMPL; }
+		HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* pData) override { return E_NOTIMPL; }
+
+		void STDMETHODCALLTYPE GetType(D3D11_RESOURCE_DIMENSION* pResourceDimension) override
+		{
+			*pResourceDimension = D3D11_RESOURCE_DIMENSION_BUFFER;
+		}
+		void STDMETHODCALLTYPE SetEvictionPriority(UINT EvictionPriority) override {}
+		UINT STDMETHODCALLTYPE GetEvictionPriority() override { return DXGI_RESOURCE_PRIORITY_NORMAL; }
+
+		void STDMETHODCALLTYPE GetDesc(D3D11_BUFFER_DESC* pDesc) override
+		{
+			*pDesc = D3D11_BUFFER_DESC{};
+			pDesc->ByteWidth = GetByteSize();
+
+			switch (m_Type)
+			{
+			case EGraphicsBufferType::DynamicVertex:
+				pDesc->Usage = D3D11_USAGE_DYNAMIC;
+				pDesc->BindFlags = D3D11_BIND_VERTEX_BUFFER;
+				pDesc->CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+				break;
+			case EGraphicsBufferType::StaticVertex:
+				pDesc->Usage = D3D11_USAGE_DEFAULT;
+				pDesc->BindFlags = D3D11_BIND_VERTEX_BUFFER;
+				break;
+			case EGraphicsBufferType::Index:
+				pDesc->Usage = D3D11_USAGE_DEFAULT;
+				pDesc->BindFlags = D3D11_BIND_INDEX_BUFFER;
+				break;
+			case EGraphicsBufferType::Constant:
+				pDesc->Usage = D3D11_USAGE_DYNAMIC;
+				pDesc->BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+				pDesc->CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+				break;
+			default:
+				break;
+			}
+		}
+
+	private:
+		~JWSoftwareBuffer() = default;
+
+	private:
+		EGraphicsBufferType	m_Type{};
+		VECTOR<uint8_t>		m_vData{};
+		ULONG				m_ReferenceCount{ 1 };
+	};
+};
+
+// Returns nullptr for resources that weren't created by JWSoftwareRasterizer (e.g. textures).
+static auto ToSoftwareBuffer(ID3D11Resource* pResource) noexcept->JWSoftwareBuffer*
+{
+	if (!pResource) { return nullptr; }
+
+	void* result{};
+	if (FAILED(pResource->QueryInterface(KSoftwareBufferGUID, &result))) { return nullptr; }
+
+	auto buffer = static_cast<JWSoftwareBuffer*>(result);
+	buffer->Release();
+	return buffer;
+}
+
+template <typename DataType>
+static auto ReadConstantBuffer(const JWSoftwareBuffer* pBuffer, DataType& Out) noexcept->bool
+{
+	if ((!pBuffer) || (pBuffer->GetByteSize() < sizeof(DataType))) { return false; }
+
+	memcpy(&Out, pBuffer->GetData(), sizeof(DataType));
+	return true;
+}
+
+static inline auto PackColor(float R, float G, float B, float A) noexcept->uint32_t
+{
+	return static_cast<uint32_t>(R * 255.0f + 0.5f) | (static_cast<uint32_t>(G * 255.0f + 0.5f) << 8) |
+		(static_cast<uint32_t>(B * 255.0f + 0.5f) << 16) | (static_cast<uint32_t>(A * 255.0f + 0.5f) << 24);
+}
+
+static inline auto UnpackColorChannel(uint32_t Color, uint32_t Channel) noexcept->float
+{
+	return static_cast<float>((Color >> (Channel * 8)) & 0xFF) / 255.0f;
+}
+
+// Evaluates Plane (X * x + Y * y + Z) for every lane.
+static inline auto EvaluatePlane(const XMVECTOR& PlaneX, const XMVECTOR& PlaneY, const XMVECTOR& PlaneZ,
+	const XMVECTOR& X, const XMVECTOR& Y) noexcept->XMVECTOR
+{
+	return XMVectorMultiplyAdd(PlaneX, X, XMVectorMultiplyAdd(PlaneY, Y, PlaneZ));
+}
+
+template <typename FunctionType>
+PRIVATE void JWSoftwareRasterizer::ParallelFor(uint32_t Count, uint32_t MinChunkSize, const FunctionType& Function) noexcept
+{
+	if (m_pJobSystem)
+	{
+		m_pJobSystem->ParallelFor(Count, MinChunkSize, Function);
+		return;
+	}
+
+	if (Count) { Function(0, Count); }
+}
+
+void JWSoftwareRasterizer::Create(uint32_t Width, uint32_t Height, const SClearColor& ClearColor, JWJobSystem* pJobSystem) noexcept
+{
+	assert(Width && Height);
+
+	m_Width = Width;
+	m_Height = Height;
+	m_TileCountX = (Width + KRasterTileSize - 1) / KRasterTileSize;
+	m_TileCountY = (Height + KRasterTileSize - 1) / KRasterTileSize;
+	m_ClearColor = PackColor(ClearColor.R, ClearColor.G, ClearColor.B, 1.0f);
+	m_pJobSystem = pJobSystem;
+
+	// @important: Rows are padded to whole tiles so that tiles never need bounds checks.
+	auto pixel_count = GetBufferPitch() * m_TileCountY * KRasterTileSize;
+	m_vColorBuffer.resize(pixel_count);
+	m_vDepthBuffer.resize(pixel_count);
+	m_vTileMaxDepth.resize(m_TileCountX * m_TileCountY);
+	m_vTileBins.resize(m_TileCountX * m_TileCountY);
+
+	// Initial states of a Direct3D 11 device context (JWDX skips binds of states it believes are already set).
+	m_PipelineStates[static_cast<uint32_t>(EPipelineStateType::Rasterizer)] = static_cast<uint32_t>(ERasterizerState::SolidBackCullCW);
+	m_PipelineStates[static_cast<uint32_t>(EPipelineStateType::DepthStencil)] = static_cast<uint32_t>(EDepthStencilState::ZEnabled);
+	m_PipelineStates[static_cast<uint32_t>(EPipelineStateType::Blend)] = static_cast<uint32_t>(EBlendState::Opaque);
+
+	BeginFrame();
+}
+
+auto JWSoftwareRasterizer::IsRectOccluded(uint32_t MinX, uint32_t MinY, uint32_t MaxX, uint32_t MaxY, float NearestDepth) const noexcept->bool
+{
+	if ((MinX > MaxX) || (MinY > MaxY) || (MinX >= m_Width) || (MinY >= m_Height)) { return false; }
+
+	auto min_tile_x = MinX / KRasterTileSize;
+	auto min_tile_y = MinY / KRasterTileSize;
+	auto max_tile_x = min(MaxX, m_Width - 1) / KRasterTileSize;
+	auto max_tile_y = min(MaxY, m_Height - 1) / KRasterTileSize;
+
+	for (auto tile_y = min_tile_y; tile_y <= max_tile_y; ++tile_y)
+	{
+		for (auto tile_x = min_tile_x; tile_x <= max_tile_x; ++tile_x)
+		{
+			if (m_vTileMaxDepth[tile_y * m_TileCountX + tile_x] >= NearestDepth) { return false; }
+		}
+	}
+
+	return true;
+}
+
+void JWSoftwareRasterizer::CreateBuffer(EGraphicsBufferType Type, UINT ByteSize, const void* pData, ID3D11Buffer** ppBuffer) noexcept
+{
+	*ppBuffer = new JWSoftwareBuffer(Type, ByteSize, pData);
+}
+
+void JWSoftwareRasterizer::UpdateBuffer(ID3D11Resource* pResource, const void* pData, size_t Size) noexcept
+{
+	if (auto buffer = ToSoftwareBuffer(pResource))
+	{
+		buffer->Update(pData, Size);
+	}
+}
+
+void JWSoftwareRasterizer::BindVertexBuffers(UINT StartSlot, UINT BufferCount, ID3D11Buffer* const* ppBuffers,
+	const UINT* pStrides, const UINT* pOffsets) noexcept
+{
+	for (UINT buffer_id = 0; buffer_id < BufferCount; ++buffer_id)
+	{
+		auto slot = StartSlot + buffer_id;
+		if (slot >= KVertexBufferCount) { break; }
+
+		m_pVertexBuffers[slot] = ToSoftwareBuffer(ppBuffers[buffer_id]);
+		m_VertexStrides[slot] = pStrides[buffer_id];
+		m_VertexOffsets[slot] = pOffsets[buffer_id];
+	}
+}
+
+void JWSoftwareRasterizer::BindIndexBuffer(ID3D11Buffer* pBuffer) noexcept
+{
+	m_pIndexBuffer = ToSoftwareBuffer(pBuffer);
+}
+
+void JWSoftwareRasterizer::BindConstantBuffer(EShaderStage Stage, UINT Slot, ID3D11Buffer* pBuffer) noexcept
+{
+	if ((Stage == EShaderStage::VS) && (Slot < KRasterVSConstantBufferCount))
+	{
+		m_pVSConstantBuffers[Slot] = ToSoftwareBuffer(pBuffer);
+	}
+	else if ((Stage == EShaderStage::PS) && (Slot < KRasterPSConstantBufferCount))
+	{
+		m_pPSConstantBuffers[Slot] = ToSoftwareBuffer(pBuffer);
+	}
+}
+
+void JWSoftwareRasterizer::BindPipelineState(EPipelineStateType Type, uint32_t Value) noexcept
+{
+	m_PipelineStates[static_cast<uint32_t>(Type)] = Value;
+}
+
+void JWSoftwareRasterizer::BindShaderResource(EShaderStage Stage, UINT Slot, ID3D11ShaderResourceView* pView) noexcept
+{
+	// Textures are not sampled, draws that use them are skipped in CanDraw() (by their JWFlagPS).
+}
+
+void JWSoftwareRasterizer::SubmitDraw(UINT VertexCount) noexcept
+{
+	if (!CanDraw()) { ++m_SkippedDrawCount; return; }
+
+	DrawTriangles(nullptr, VertexCount, 1);
+}
+
+void JWSoftwareRasterizer::SubmitDrawIndexed(UINT IndexCount) noexcept
+{
+	if ((!CanDraw()) || (!m_pIndexBuffer)) { ++m_SkippedDrawCount; return; }
+
+	IndexCount = min(IndexCount, m_pIndexBuffer->GetByteSize() / static_cast<UINT>(sizeof(uint32_t)));
+
+	DrawTriangles(reinterpret_cast<const uint32_t*>(m_pIndexBuffer->GetData()), IndexCount, 1);
+}
+
+void JWSoftwareRasterizer::SubmitDrawIndexedInstanced(UINT IndexCount, UINT InstanceCount) noexcept
+{
+	if ((!CanDraw()) || (!m_pIndexBuffer)) { ++m_SkippedDrawCount; return; }
+
+	IndexCount = min(IndexCount, m_pIndexBuffer->GetByteSize() / static_cast<UINT>(sizeof(uint32_t)));
+
+	DrawTriangles(reinterpret_cast<const uint32_t*>(m_pIndexBuffer->GetData()), IndexCount, InstanceCount);
+}
+
+void JWSoftwareRasterizer::BeginFrame() noexcept
+{
+	std::fill(m_vColorBuffer.begin(), m_vColorBuffer.end(), m_ClearColor);
+	std::fill(m_vDepthBuffer.begin(), m_vDepthBuffer.end(), 1.0f);
+	std::fill(m_vTileMaxDepth.begin(), m_vTileMaxDepth.end(), 1.0f);
+
+	m_vTriangles.clear();
+	m_SkippedDrawCount = 0;
+}
+
+void JWSoftwareRasterizer::EndFrame() noexcept
+{
+	auto start_time = STEADY_CLOCK::now();
+
+	BinTriangles();
+
+	ParallelFor(m_TileCountX * m_TileCountY, KRasterTileMinChunkSize, [this](uint32_t Begin, uint32_t End)
+	{
+		for (uint32_t tile_id = Begin; tile_id < End; ++tile_id)
+		{
+			RasterizeTile(tile_id);
+		}
+	});
+
+	m_LastRasterizationTime = std::chrono::duration_cast<TIME_UNIT_mS>(STEADY_CLOCK::now() - start_time).count();
+}
+
+PRIVATE auto JWSoftwareRasterizer::CanDraw() const noexcept->bool
+{
+	if (m_PipelineStates[static_cast<uint32_t>(EPipelineStateType::VS)] != static_cast<uint32_t>(EVertexShader::VSBase)) { return false; }
+	if (m_PipelineStates[static_cast<uint32_t>(EPipelineStateType::GS)] != static_cast<uint32_t>(EGeometryShader::None)) { return false; }
+	if (m_PipelineStates[static_cast<uint32_t>(EPipelineStateType::PS)] != static_cast<uint32_t>(EPixelShader::PSBase)) { return false; }
+	if (m_PipelineStates[static_cast<uint32_t>(EPipelineStateType::PrimitiveTopology)] !=
+		static_cast<uint32_t>(EPrimitiveTopology::TriangleList)) { return false; }
+	if (m_PipelineStates[static_cast<uint32_t>(EPipelineStateType::Rasterizer)] ==
+		static_cast<uint32_t>(ERasterizerState::WireFrame)) { return false; }
+
+	auto model_buffer = m_pVertexBuffers[KVBIDModel];
+	if ((!model_buffer) || (m_VertexStrides[KVBIDModel] < sizeof(SVertexModel)) ||
+		(m_VertexOffsets[KVBIDModel] > model_buffer->GetByteSize())) { return false; }
+
+	SVSCBSpace space{};
+	SVSCBFlags vs_flags{};
+	SPSCBFlags ps_flags{};
+	SPSCBLights lights{};
+	if (!ReadConstantBuffer(m_pVSConstantBuffers[0], space)) { return false; }
+	if (!ReadConstantBuffer(m_pVSConstantBuffers[1], vs_flags)) { return false; }
+	if (!ReadConstantBuffer(m_pPSConstantBuffers[0], ps_flags)) { return false; }
+	if (!ReadConstantBuffer(m_pPSConstantBuffers[1], lights)) { return false; }
+
+	// Skinning and texture sampling are not implemented.
+	if (vs_flags.FlagVS & JWFlagVS_UseAnimation) { return false; }
+	if (ps_flags.FlagPS & (JWFlagPS_UseDiffuseTexture | JWFlagPS_UseNormalTexture)) { return false; }
+
+	if (vs_flags.FlagVS & JWFlagVS_Instanced)
+	{
+		auto instance_buffer = m_pVertexBuffers[KVBIDInstancing];
+		if ((!instance_buffer) || (m_VertexStrides[KVBIDInstancing] < sizeof(SModelInstanceData)) ||
+			(m_VertexOffsets[KVBIDInstancing] > instance_buffer->GetByteSize())) { return false; }
+	}
+
+	return true;
+}
+
+PRIVATE void JWSoftwareRasterizer::DrawTriangles(const uint32_t* pIndices, uint32_t IndexCount, uint32_t InstanceCount) noexcept
+{
+	SVSCBFlags vs_flags{};
+	SPSCBFlags ps_flags{};
+	ReadConstantBuffer(m_pVSConstantBuffers[1], vs_flags);
+	ReadConstantBuffer(m_pPSConstantBuffers[0], ps_flags);
+
+	bool is_instanced = (vs_flags.FlagVS & JWFlagVS_Instanced);
+	bool use_lighting = (ps_flags.FlagPS & JWFlagPS_UseLighting);
+
+	auto model_buffer = m_pVertexBuffers[KVBIDModel];
+	auto vertex_count = (model_buffer->GetByteSize() - m_VertexOffsets[KVBIDModel]) / m_VertexStrides[KVBIDModel];
+
+	const uint8_t* instance_data{};
+	UINT instance_stride{};
+	if (is_instanced)
+	{
+		auto instance_buffer = m_pVertexBuffers[KVBIDInstancing];
+		instance_data = instance_buffer->GetData() + m_VertexOffsets[KVBIDInstancing];
+		instance_stride = m_VertexStrides[KVBIDInstancing];
+
+		InstanceCount = min(InstanceCount, (instance_buffer->GetByteSize() - m_VertexOffsets[KVBIDInstancing]) / instance_stride);
+	}
+	else
+	{
+		InstanceCount = 1;
+	}
+
+	IndexCount -= IndexCount % 3;
+
+	for (uint32_t instance_id = 0; instance_id < InstanceCount; ++instance_id)
+	{
+		auto instance_world = XMMatrixIdentity();
+		if (is_instanced)
+		{
+			XMFLOAT4X4 world{};
+			memcpy(&world, instance_data + instance_id * instance_stride, sizeof(world));
+			instance_world = XMLoadFloat4x4(&world);
+		}
+
+		ShadeVertices(vertex_count, instance_world, use_lighting);
+
+		// @important: Triangles are set up in submission order, so that blending and equal depths resolve as on the GPU.
+		for (uint32_t index_id = 0; index_id < IndexCount; index_id += 3)
+		{
+			auto id0 = (pIndices) ? pIndices[index_id + 0] : index_id + 0;
+			auto id1 = (pIndices) ? pIndices[index_id + 1] : index_id + 1;
+			auto id2 = (pIndices) ? pIndices[index_id + 2] : index_id + 2;
+			if ((id0 >= vertex_count) || (id1 >= vertex_count) || (id2 >= vertex_count)) { continue; }
+
+			SetUpTriangle(m_vShadedVertices[id0], m_vShadedVertices[id1], m_vShadedVertices[id2]);
+		}
+	}
+}
+
+PRIVATE void JWSoftwareRasterizer::ShadeVertices(uint32_t VertexCount, const XMMATRIX& InstanceWorld, bool UseLighting) noexcept
+{
+	SVSCBSpace space{};
+	SPSCBLights lights{};
+	ReadConstantBuffer(m_pVSConstantBuffers[0], space);
+	ReadConstantBuffer(m_pPSConstantBuffers[1], lights);
+
+	// Constant buffer matrices are stored transposed (for HLSL), instance matrices are not (as VSBase.hlsl).
+	auto wvp = InstanceWorld * XMMatrixTranspose(space.WVP);
+	auto world = InstanceWorld * XMMatrixTranspose(space.World);
+
+	auto ambient_color = XMLoadFloat4(&lights.AmbientColor);
+	auto directional_color = XMLoadFloat4(&lights.DirectionalColor);
+	auto light_direction = XMVectorNegate(XMLoadFloat4(&lights.DirectionalDirection));
+
+	// Premultiply light colors by their intensity (w)
+	ambient_color = XMVectorMultiply(ambient_color, XMVectorSplatW(ambient_color));
+	directional_color = XMVectorMultiply(directional_color, XMVectorSplatW(directional_color));
+
+	const uint8_t* vertices = m_pVertexBuffers[KVBIDModel]->GetData() + m_VertexOffsets[KVBIDModel];
+	auto stride = m_VertexStrides[KVBIDModel];
+
+	m_vShadedVertices.resize(VertexCount);
+
+	ParallelFor(VertexCount, KRasterVertexMinChunkSize, [&](uint32_t Begin, uint32_t End)
+	{
+		for (uint32_t vertex_id = Begin; vertex_id < End; ++vertex_id)
+		{
+			auto vertex = vertices + vertex_id * stride;
+			auto& shaded = m_vShadedVertices[vertex_id];
+
+			auto position = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(vertex + offsetof(SVertexModel, Position)));
+			auto diffuse = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(vertex + offsetof(SVertexModel, Diffuse)));
+
+			// @important: position.w must be '1' before multiplying WVP
+			XMStoreFloat4(&shaded.ClipPosition, XMVector4Transform(XMVectorSetW(position, 1.0f), wvp));
+
+			auto color = diffuse;
+			if (UseLighting)
+			{
+				// PSBase lighting without specular, evaluated per vertex
+				auto normal = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(vertex + offsetof(SVertexModel, Normal)));
+				normal = XMVector3Normalize(XMVector3TransformNormal(normal, world));
+
+				auto directional_amount = XMVectorSaturate(XMVector3Dot(normal, light_direction));
+				auto light = XMVectorMultiplyAdd(directional_color, directional_amount, ambient_color);
+
+				color = XMVectorSelect(diffuse, XMVectorSaturate(XMVectorMultiply(diffuse, light)), g_XMSelect1110);
+			}
+
+			// Gamma correction (as PSBase)
+			XMStoreFloat4(&shaded.Color, XMVectorSaturate(XMVectorMultiply(color, color)));
+		}
+	});
+}
+
+PRIVATE void JWSoftwareRasterizer::SetUpTriangle(const SRasterVertex& V0, const SRasterVertex& V1, const SRasterVertex& V2) noexcept
+{
+	const SRasterVertex* vertices[3]{ &V0, &V1, &V2 };
+
+	// @important: Near plane clipping is not implemented, triangles reaching behind the camera are dropped.
+	if ((V0.ClipPosition.w <= KRasterMinClipW) || (V1.ClipPosition.w <= KRasterMinClipW) || (V2.ClipPosition.w <= KRasterMinClipW)) { return; }
+
+	// Perspective division and viewport transform (pixel centers are at +0.5)
+	float x[3]{};
+	float y[3]{};
+	float z[3]{};
+	for (uint32_t vertex_id = 0; vertex_id < 3; ++vertex_id)
+	{
+		const auto& clip = vertices[vertex_id]->ClipPosition;
+		auto inverse_w = 1.0f / clip.w;
+
+		x[vertex_id] = (clip.x * inverse_w * 0.5f + 0.5f) * static_cast<float>(m_Width);
+		y[vertex_id] = (0.5f - clip.y * inverse_w * 0.5f) * static_cast<float>(m_Height);
+		z[vertex_id] = clip.z * inverse_w;
+	}
+
+	// Screen y points down, so a positive area means clockwise on screen.
+	auto area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (area == 0.0f) { return; }
+
+	switch (static_cast<ERasterizerState>(m_PipelineStates[static_cast<uint32_t>(EPipelineStateType::Rasterizer)]))
+	{
+	case ERasterizerState::SolidBackCullCW:
+		if (area < 0.0f) { return; }
+		break;
+	case ERasterizerState::SolidBackCullCCW:
+		if (area > 0.0f) { return; }
+		break;
+	default:
+		break;
+	}
+
+	// Make the winding clockwise so that every edge function is positive inside
+	if (area < 0.0f)
+	{
+		std::swap(vertices[1], vertices[2]);
+		std::swap(x[1], x[2]);
+		std::swap(y[1], y[2]);
+		std::swap(z[1], z[2]);
+		area = -area;
+	}
+
+	auto min_x = min(min(x[0], x[1]), x[2]);
+	auto min_y = min(min(y[0], y[1]), y[2]);
+	auto max_x = max(max(x[0], x[1]), x[2]);
+	auto max_y = max(max(y[0], y[1]), y[2]);
+	if ((max_x < 0.0f) || (max_y < 0.0f) || (min_x >= static_cast<float>(m_Width)) || (min_y >= static_cast<float>(m_Height))) { return; }
+
+	SRasterTriangle triangle{};
+	triangle.MinTileX = static_cast<uint16_t>(static_cast<uint32_t>(max(min_x, 0.0f)) / KRasterTileSize);
+	triangle.MinTileY = static_cast<uint16_t>(static_cast<uint32_t>(max(min_y, 0.0f)) / KRasterTileSize);
+	triangle.MaxTileX = static_cast<uint16_t>(static_cast<uint32_t>(min(max_x, static_cast<float>(m_Width - 1))) / KRasterTileSize);
+	triangle.MaxTileY = static_cast<uint16_t>(static_cast<uint32_t>(min(max_y, static_cast<float>(m_Height - 1))) / KRasterTileSize);
+
+	// Edge i goes from vertex i to vertex (i + 1) and is zero on them
+	for (uint32_t edge_id = 0; edge_id < 3; ++edge_id)
+	{
+		auto a = edge_id;
+		auto b = (edge_id + 1) % 3;
+
+		auto& edge = triangle.Edge[edge_id];
+		edge.x = y[a] - y[b];
+		edge.y = x[b] - x[a];
+		edge.z = -(edge.x * x[a] + edge.y * y[a]);
+
+		// Inside lies to the right of a left edge and below a top edge
+		if ((edge.x > 0.0f) || ((edge.x == 0.0f) && (edge.y > 0.0f)))
+		{
+			triangle.TopLeftEdgeMask |= (1 << edge_id);
+		}
+	}
+
+	// Edge i divided by the area is the barycentric weight of the vertex opposite to it, (i + 2).
+	auto inverse_area = 1.0f / area;
+	auto make_plane = [&](float A0, float A1, float A2)
+	{
+		const auto& e0 = triangle.Edge[0];
+		const auto& e1 = triangle.Edge[1];
+		const auto& e2 = triangle.Edge[2];
+
+		return XMFLOAT3(
+			(A2 * e0.x + A0 * e1.x + A1 * e2.x) * inverse_area,
+			(A2 * e0.y + A0 * e1.y + A1 * e2.y) * inverse_area,
+			(A2 * e0.z + A0 * e1.z + A1 * e2.z) * inverse_area);
+	};
+
+	triangle.Depth = make_plane(z[0], z[1], z[2]);
+
+	const auto& c0 = vertices[0]->Color;
+	const auto& c1 = vertices[1]->Color;
+	const auto& c2 = vertices[2]->Color;
+	triangle.Color[0] = make_plane(c0.x, c1.x, c2.x);
+	triangle.Color[1] = make_plane(c0.y, c1.y, c2.y);
+	triangle.Color[2] = make_plane(c0.z, c1.z, c2.z);
+	triangle.Color[3] = make_plane(c0.w, c1.w, c2.w);
+
+	triangle.UseDepth = (m_PipelineStates[static_cast<uint32_t>(EPipelineStateType::DepthStencil)] ==
+		static_cast<uint32_t>(EDepthStencilState::ZEnabled));
+	triangle.UseBlending = (m_PipelineStates[static_cast<uint32_t>(EPipelineStateType::Blend)] ==
+		static_cast<uint32_t>(EBlendState::Transprent));
+
+	m_vTriangles.emplace_back(triangle);
+}
+
+PRIVATE void JWSoftwareRasterizer::BinTriangles() noexcept
+{
+	for (auto& bin : m_vTileBins)
+	{
+		bin.clear();
+	}
+
+	// Bins keep submission order
+	auto triangle_count = static_cast<uint32_t>(m_vTriangles.size());
+	for (uint32_t triangle_id = 0; triangle_id < triangle_count; ++triangle_id)
+	{
+		const auto& triangle = m_vTriangles[triangle_id];
+
+		for (uint32_t tile_y = triangle.MinTileY; tile_y <= triangle.MaxTileY; ++tile_y)
+		{
+			for (uint32_t tile_x = triangle.MinTileX; tile_x <= triangle.MaxTileX; ++tile_x)
+			{
+				m_vTileBins[tile_y * m_TileCountX + tile_x].emplace_back(triangle_id);
+			}
+		}
+	}
+}
+
+PRIVATE void JWSoftwareRasterizer::RasterizeTile(uint32_t TileIndex) noexcept
+{
+	const auto& bin = m_vTileBins[TileIndex];
+
+	// Nothing was drawn, the tile keeps its cleared depth
+	if (bin.empty()) { m_vTileMaxDepth[TileIndex] = 1.0f; return; }
+
+	auto tile_x = (TileIndex % m_TileCountX) * KRasterTileSize;
+	auto tile_y = (TileIndex / m_TileCountX) * KRasterTileSize;
+	auto pitch = GetBufferPitch();
+
+	const auto lane_offsets = XMVectorSet(0.5f, 1.5f, 2.5f, 3.5f);
+	const auto zero = XMVectorZero();
+	const auto one = XMVectorSplatOne();
+
+	for (auto triangle_id : bin)
+	{
+		const auto& triangle = m_vTriangles[triangle_id];
+
+		XMVECTOR edge_x[3]{};
+		XMVECTOR edge_y[3]{};
+		XMVECTOR edge_z[3]{};
+		XMVECTOR top_left[3]{};
+		for (uint32_t edge_id = 0; edge_id < 3; ++edge_id)
+		{
+			edge_x[edge_id] = XMVectorReplicate(triangle.Edge[edge_id].x);
+			edge_y[edge_id] = XMVectorReplicate(triangle.Edge[edge_id].y);
+			edge_z[edge_id] = XMVectorReplicate(triangle.Edge[edge_id].z);
+			top_left[edge_id] = (triangle.TopLeftEdgeMask & (1 << edge_id)) ? XMVectorTrueInt() : XMVectorFalseInt();
+		}
+
+		auto depth_x = XMVectorReplicate(triangle.Depth.x);
+		auto depth_y = XMVectorReplicate(triangle.Depth.y);
+		auto depth_z = XMVectorReplicate(triangle.Depth.z);
+
+		XMVECTOR color_x[4]{};
+		XMVECTOR color_y[4]{};
+		XMVECTOR color_z[4]{};
+		for (uint32_t channel = 0; channel < 4; ++channel)
+		{
+			color_x[channel] = XMVectorReplicate(triangle.Color[channel].x);
+			color_y[channel] = XMVectorReplicate(triangle.Color[channel].y);
+			color_z[channel] = XMVectorReplicate(triangle.Color[channel].z);
+		}
+
+		for (uint32_t row = 0; row < KRasterTileSize; ++row)
+		{
+			auto pixel_y = XMVectorReplicate(static_cast<float>(tile_y + row) + 0.5f);
+
+			for (uint32_t column = 0; column < KRasterTileSize; column += KRasterLaneCount)
+			{
+				auto pixel_x = XMVectorAdd(XMVectorReplicate(static_cast<float>(tile_x + column)), lane_offsets);
+
+				auto coverage = XMVectorTrueInt();
+				for (uint32_t edge_id = 0; edge_id < 3; ++edge_id)
+				{
+					auto edge = EvaluatePlane(edge_x[edge_id], edge_y[edge_id], edge_z[edge_id], pixel_x, pixel_y);
+					auto inside = XMVectorOrInt(XMVectorGreater(edge, zero), XMVectorAndInt(XMVectorEqual(edge, zero), top_left[edge_id]));
+
+					coverage = XMVectorAndInt(coverage, inside);
+				}
+				if (XMVector4EqualInt(coverage, XMVectorFalseInt())) { continue; }
+
+				// Depth clipping (viewport depth range is [0, 1])
+				auto depth = EvaluatePlane(depth_x, depth_y, depth_z, pixel_x, pixel_y);
+				coverage = XMVectorAndInt(coverage, XMVectorAndInt(XMVectorGreaterOrEqual(depth, zero), XMVectorLessOrEqual(depth, one)));
+
+				auto pixel_index = (tile_y + row) * pitch + tile_x + column;
+				if (triangle.UseDepth)
+				{
+					auto depth_buffer = reinterpret_cast<XMFLOAT4*>(&m_vDepthBuffer[pixel_index]);
+					auto stored_depth = XMLoadFloat4(depth_buffer);
+
+					coverage = XMVectorAndInt(coverage, XMVectorLessOrEqual(depth, stored_depth));
+					XMStoreFloat4(depth_buffer, XMVectorSelect(stored_depth, depth, coverage));
+				}
+				if (XMVector4EqualInt(coverage, XMVectorFalseInt())) { continue; }
+
+				XMFLOAT4A colors[4]{};
+				for (uint32_t channel = 0; channel < 4; ++channel)
+				{
+					auto color = EvaluatePlane(color_x[channel], color_y[channel], color_z[channel], pixel_x, pixel_y);
+					XMStoreFloat4A(&colors[channel], XMVectorSaturate(color));
+				}
+
+				XMUINT4 lane_coverage{};
+				XMStoreUInt4(&lane_coverage, coverage);
+				const uint32_t* lane_covered = &lane_coverage.x;
+				const float* r = &colors[0].x;
+				const float* g = &colors[1].x;
+				const float* b = &colors[2].x;
+				const float* a = &colors[3].x;
+
+				for (uint32_t lane = 0; lane < KRasterLaneCount; ++lane)
+				{
+					if (!lane_covered[lane]) { continue; }
+
+					auto& pixel = m_vColorBuffer[pixel_index + lane];
+					if (triangle.UseBlending)
+					{
+						// SRC_ALPHA, INV_SRC_ALPHA for both color and alpha
+						auto source_alpha = a[lane];
+						auto dest_factor = 1.0f - source_alpha;
+
+						pixel = PackColor(
+							r[lane] * source_alpha + UnpackColorChannel(pixel, 0) * dest_factor,
+							g[lane] * source_alpha + UnpackColorChannel(pixel, 1) * dest_factor,
+							b[lane] * source_alpha + UnpackColorChannel(pixel, 2) * dest_factor,
+							a[lane] * source_alpha + UnpackColorChannel(pixel, 3) * dest_factor);
+					}
+					else
+					{
+						pixel = PackColor(r[lane], g[lane], b[lane], a[lane]);
+					}
+				}
+			}
+		}
+	}
+
+	// Hierarchical depth
+	auto max_depth = XMVectorZero();
+	for (uint32_t row = 0; row < KRasterTileSize; ++row)
+	{
+		auto row_index = (tile_y + row) * pitch + tile_x;
+		for (uint32_t column = 0; column < KRasterTileSize; column += KRasterLaneCount)
+		{
+			max_depth = XMVectorMax(max_depth, XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_vDepthBuffer[row_index + column])));
+		}
+	}
+	max_depth = XMVectorMax(max_depth, XMVectorSwizzle<2, 3, 0, 1>(max_depth));
+	max_depth = XMVectorMax(max_depth, XMVectorSwizzle<1, 0, 3, 2>(max_depth));
+
+	m_vTileMaxDepth[TileIndex] = XMVectorGetX(max_depth);
+}
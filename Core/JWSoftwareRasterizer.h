@@ -0,0 +1,153 @@
+#pragma once
+
+#include "JWGraphicsBackend.h"
+
+namespace JWEngine
+{
+	class JWJobSystem;
+	class JWSoftwareBuffer;
+
+	// The screen is rasterized in square tiles of this many pixels.
+	static constexpr uint32_t KRasterTileSize{ 8 };
+
+	// Pixels are shaded in groups of this many lanes (one XMVECTOR).
+	static constexpr uint32_t KRasterLaneCount{ 4 };
+
+	// ParallelFor() chunk size for vertex shading and tile rasterization
+	static constexpr uint32_t KRasterVertexMinChunkSize{ 1024 };
+	static constexpr uint32_t KRasterTileMinChunkSize{ 16 };
+
+	static constexpr uint32_t KRasterVSConstantBufferCount{ 4 };
+	static constexpr uint32_t KRasterPSConstantBufferCount{ 3 };
+
+	// Screen-space triangle ready for rasterization.
+	// Every attribute is a plane (value = X * x + Y * y + Z) evaluated at pixel centers.
+	struct SRasterTriangle
+	{
+		// Edge functions (> 0 inside)
+		XMFLOAT3	Edge[3]{};
+
+		XMFLOAT3	Depth{};
+		XMFLOAT3	Color[4]{};
+
+		// Covered tiles (inclusive)
+		uint16_t	MinTileX{};
+		uint16_t	MinTileY{};
+		uint16_t	MaxTileX{};
+		uint16_t	MaxTileY{};
+
+		// Bit i is set if Edge[i] is a top or left edge (pixels exactly on it are covered).
+		uint8_t		TopLeftEdgeMask{};
+
+		bool		UseDepth{};
+		bool		UseBlending{};
+	};
+
+	// Vertex after VSBase and per-vertex lighting
+	struct SRasterVertex
+	{
+		XMFLOAT4	ClipPosition{};
+		XMFLOAT4	Color{};
+	};
+
+	// Multithreaded tile-based software rasterizer (a JWGraphicsBackend for JWDX::CreateHeadless()).
+	// It covers the subset of the pipeline the engine's models use:
+	// - VSBase (static, dynamic and instanced models; rigged models are skipped)
+	// - PSBase with vertex colors and Lambert lighting (ambient + directional) from SPSCBLights, evaluated per vertex
+	// - Triangle lists, back-face culling, depth test (LESS_EQUAL) and alpha blending
+	// Textures, other shaders and line topologies are skipped (see GetSkippedDrawCount()).
+	// Triangles crossing the near plane are rejected instead of clipped.
+	class JWSoftwareRasterizer final : public JWGraphicsBackend
+	{
+	public:
+		JWSoftwareRasterizer() = default;
+		~JWSoftwareRasterizer() = default;
+
+		// If pJobSystem is nullptr, everything runs on the calling thread.
+		void Create(uint32_t Width, uint32_t Height, const SClearColor& ClearColor, JWJobSystem* pJobSystem) noexcept;
+
+		// R8G8B8A8, GetBufferPitch() pixels per row (padded to KRasterTileSize)
+		const auto& GetColorBuffer() const noexcept { return m_vColorBuffer; }
+		const auto& GetDepthBuffer() const noexcept { return m_vDepthBuffer; }
+		auto GetBufferPitch() const noexcept { return m_TileCountX * KRasterTileSize; }
+		auto GetWidth() const noexcept { return m_Width; }
+		auto GetHeight() const noexcept { return m_Height; }
+
+		// Hierarchical depth: farthest depth of each tile (row-major, GetTileCountX() tiles per row)
+		const auto& GetTileMaxDepthBuffer() const noexcept { return m_vTileMaxDepth; }
+		auto GetTileCountX() const noexcept { return m_TileCountX; }
+		auto GetTileCountY() const noexcept { return m_TileCountY; }
+
+		// True if every tile overlapping the pixel rectangle is closer than NearestDepth (valid after EndFrame()).
+		auto IsRectOccluded(uint32_t MinX, uint32_t MinY, uint32_t MaxX, uint32_t MaxY, float NearestDepth) const noexcept->bool;
+
+		// Counted since BeginFrame()
+		auto GetTriangleCount() const noexcept { return static_cast<uint32_t>(m_vTriangles.size()); }
+		auto GetSkippedDrawCount() const noexcept { return m_SkippedDrawCount; }
+
+		// Time spent in the last EndFrame() (binning and rasterization) in microseconds
+		auto GetLastRasterizationTime() const noexcept { return m_LastRasterizationTime; }
+
+		void CreateBuffer(EGraphicsBufferType Type, UINT ByteSize, const void* pData, ID3D11Buffer** ppBuffer) noexcept override;
+		void UpdateBuffer(ID3D11Resource* pResource, const void* pData, size_t Size) noexcept override;
+
+		void BindVertexBuffers(UINT StartSlot, UINT BufferCount, ID3D11Buffer* const* ppBuffers,
+			const UINT* pStrides, const UINT* pOffsets) noexcept override;
+		void BindIndexBuffer(ID3D11Buffer* pBuffer) noexcept override;
+		void BindConstantBuffer(EShaderStage Stage, UINT Slot, ID3D11Buffer* pBuffer) noexcept override;
+		void BindPipelineState(EPipelineStateType Type, uint32_t Value) noexcept override;
+		void BindShaderResource(EShaderStage Stage, UINT Slot, ID3D11ShaderResourceView* pView) noexcept override;
+
+		void SubmitDraw(UINT VertexCount) noexcept override;
+		void SubmitDrawIndexed(UINT IndexCount) noexcept override;
+		void SubmitDrawIndexedInstanced(UINT IndexCount, UINT InstanceCount) noexcept override;
+
+		void BeginFrame() noexcept override;
+
+		// Bins and rasterizes every triangle submitted since BeginFrame().
+		void EndFrame() noexcept override;
+
+	private:
+		auto CanDraw() const noexcept->bool;
+
+		// If pIndices is nullptr, vertices are drawn in order.
+		void DrawTriangles(const uint32_t* pIndices, uint32_t IndexCount, uint32_t InstanceCount) noexcept;
+		void ShadeVertices(uint32_t VertexCount, const XMMATRIX& InstanceWorld, bool UseLighting) noexcept;
+		void SetUpTriangle(const SRasterVertex& V0, const SRasterVertex& V1, const SRasterVertex& V2) noexcept;
+
+		void BinTriangles() noexcept;
+		void RasterizeTile(uint32_t TileIndex) noexcept;
+
+		template <typename FunctionType>
+		void ParallelFor(uint32_t Count, uint32_t MinChunkSize, const FunctionType& Function) noexcept;
+
+	private:
+		uint32_t					m_Width{};
+		uint32_t					m_Height{};
+		uint32_t					m_TileCountX{};
+		uint32_t					m_TileCountY{};
+		uint32_t					m_ClearColor{};
+		JWJobSystem*				m_pJobSystem{};
+
+		VECTOR<uint32_t>			m_vColorBuffer{};
+		VECTOR<float>				m_vDepthBuffer{};
+		VECTOR<float>				m_vTileMaxDepth{};
+
+		// Bound state
+		// @important: Bindings don't hold references (as with JWDX's own caches), buffers must outlive them.
+		JWSoftwareBuffer*			m_pVertexBuffers[KVertexBufferCount]{};
+		UINT						m_VertexStrides[KVertexBufferCount]{};
+		UINT						m_VertexOffsets[KVertexBufferCount]{};
+		JWSoftwareBuffer*			m_pIndexBuffer{};
+		JWSoftwareBuffer*			m_pVSConstantBuffers[KRasterVSConstantBufferCount]{};
+		JWSoftwareBuffer*			m_pPSConstantBuffers[KRasterPSConstantBufferCount]{};
+		uint32_t					m_PipelineStates[static_cast<uint32_t>(EPipelineStateType::PS) + 1]{};
+
+		// Per frame
+		VECTOR<SRasterVertex>		m_vShadedVertices{};
+		VECTOR<SRasterTriangle>		m_vTriangles{};
+		VECTOR<VECTOR<uint32_t>>	m_vTileBins{};
+		uint32_t					m_SkippedDrawCount{};
+		long long					m_LastRasterizationTime{};
+	};
+};
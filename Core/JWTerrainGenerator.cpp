@@ -471,147 +471,330 @@ auto JWTerrainGenerator::GenerateTerrainFromHeightMap(const STRING& HeightMapFN,
 	return terrain_data;
 }
 
-void JWTerrainGenerator::SaveTerrainAsTRN(const STRING& TRNFileName, const STerrainData& TerrainData) noexcept
+static __forceinline auto AlignTRNOffset(uint64_t Offset) noexcept->uint64_t
 {
-	using namespace tinyxml2;
-	tinyxml2::XMLDocument doc{};
+	return (Offset + KTRNBlobAlignment - 1) & ~(KTRNBlobAlignment - 1);
+}
 
-	auto root = doc.NewElement("jw_terrain_root");
-
-	auto terrain_info = doc.NewElement("terrain_info");
-	terrain_info->SetAttribute("size_x", TerrainData.TerrainSizeX);
-	terrain_info->SetAttribute("size_z", TerrainData.TerrainSizeZ);
-	terrain_info->SetAttribute("height_factor", TerrainData.HeightFactor);
-	terrain_info->SetAttribute("xy_size_factor", TerrainData.XYSizeFactor);
-	terrain_info->SetAttribute("whole_bounding_sphere_center_x", XMVectorGetX(TerrainData.WholeBoundingSphere.Center));
-	terrain_info->SetAttribute("whole_bounding_sphere_center_y", XMVectorGetY(TerrainData.WholeBoundingSphere.Center));
-	terrain_info->SetAttribute("whole_bounding_sphere_center_z", XMVectorGetZ(TerrainData.WholeBoundingSphere.Center));
-	terrain_info->SetAttribute("whole_bounding_sphere_radius", TerrainData.WholeBoundingSphere.Radius);
-	/*
-	terrain_info->SetAttribute("whole_bounding_ellipsoid_offset_x", XMVectorGetX(TerrainData.WholeBoundingEllipsoid.Offset));
-	terrain_info->SetAttribute("whole_bounding_ellipsoid_offset_y", XMVectorGetY(TerrainData.WholeBoundingEllipsoid.Offset));
-	terrain_info->SetAttribute("whole_bounding_ellipsoid_offset_z", XMVectorGetZ(TerrainData.WholeBoundingEllipsoid.Offset));
-	terrain_info->SetAttribute("whole_bounding_ellipsoid_radius_x", TerrainData.WholeBoundingEllipsoid.RadiusX);
-	terrain_info->SetAttribute("whole_bounding_ellipsoid_radius_y", TerrainData.WholeBoundingEllipsoid.RadiusY);
-	terrain_info->SetAttribute("whole_bounding_ellipsoid_radius_z", TerrainData.WholeBoundingEllipsoid.RadiusZ);
-	*/
-
-	auto quad_tree = doc.NewElement("quad_tree");
-	quad_tree->SetAttribute("node_count", static_cast<int>(TerrainData.QuadTree.size()));
-
-	for (auto& iter : TerrainData.QuadTree)
+void JWTerrainGenerator::SaveTerrainAsTRN(const STRING& TRNFileName, const STerrainData& TerrainData) noexcept
+{
+	// #1 Header
+	STRNHeader header{};
+	header.TerrainSizeX = TerrainData.TerrainSizeX;
+	header.TerrainSizeZ = TerrainData.TerrainSizeZ;
+	header.HeightFactor = TerrainData.HeightFactor;
+	header.XYSizeFactor = TerrainData.XYSizeFactor;
+	header.WholeBoundingSphereCenter[0] = XMVectorGetX(TerrainData.WholeBoundingSphere.Center);
+	header.WholeBoundingSphereCenter[1] = XMVectorGetY(TerrainData.WholeBoundingSphere.Center);
+	header.WholeBoundingSphereCenter[2] = XMVectorGetZ(TerrainData.WholeBoundingSphere.Center);
+	header.WholeBoundingSphereRadius = TerrainData.WholeBoundingSphere.Radius;
+	header.NodeCount = static_cast<uint32_t>(TerrainData.QuadTree.size());
+	header.SubBoundingSphereCount = static_cast<uint32_t>(TerrainData.SubBoundingSpheres.size());
+	header.NodeTableOffset = sizeof(STRNHeader);
+	header.SubBoundingSphereTableOffset = header.NodeTableOffset + sizeof(STRNNodeEntry) * header.NodeCount;
+
+	// #2 Node table (blob offsets are laid out here)
+	VECTOR<STRNNodeEntry> node_table{};
+	node_table.reserve(header.NodeCount);
+
+	uint64_t blob_offset{ AlignTRNOffset(header.SubBoundingSphereTableOffset + sizeof(STRNSubBoundingSphere) * header.SubBoundingSphereCount) };
+	for (const auto& iter : TerrainData.QuadTree)
 	{
-		auto node = doc.NewElement("node");
-		node->SetAttribute("node_id", iter.NodeID);
-		node->SetAttribute("parent_id", iter.ParentID);
-		node->SetAttribute("children_id_0", iter.ChildrenID[0]);
-		node->SetAttribute("children_id_1", iter.ChildrenID[1]);
-		node->SetAttribute("children_id_2", iter.ChildrenID[2]);
-		node->SetAttribute("children_id_3", iter.ChildrenID[3]);
-		node->SetAttribute("start_x", iter.StartX);
-		node->SetAttribute("start_z", iter.StartZ);
-		node->SetAttribute("size_x", iter.SizeX);
-		node->SetAttribute("size_z", iter.SizeZ);
-		node->SetAttribute("has_meshes", iter.HasMeshes);
-		node->SetAttribute("sub_bounding_sphere_id", iter.SubBoundingVolumeID);
+		STRNNodeEntry entry{};
+		entry.NodeID = iter.NodeID;
+		entry.ParentID = iter.ParentID;
+		memcpy(entry.ChildrenID, iter.ChildrenID, sizeof(entry.ChildrenID));
+		entry.StartX = iter.StartX;
+		entry.StartZ = iter.StartZ;
+		entry.SizeX = iter.SizeX;
+		entry.SizeZ = iter.SizeZ;
+		entry.HasMeshes = (iter.HasMeshes) ? 1 : 0;
+		entry.SubBoundingVolumeID = iter.SubBoundingVolumeID;
 
 		if (iter.HasMeshes)
 		{
-			auto vertices = doc.NewElement("vertices");
-			vertices->SetAttribute("vertex_count", static_cast<int>(iter.VertexData.vVerticesModel.size()));
-			for (auto& vertex_iter : iter.VertexData.vVerticesModel)
-			{
-				auto vertex = doc.NewElement("vertex");
+			entry.VertexCount = static_cast<uint32_t>(iter.VertexData.vVerticesModel.size());
+			entry.FaceCount = static_cast<uint32_t>(iter.IndexData.vFaces.size());
 
-				auto position = doc.NewElement("position");
-				position->SetAttribute("x", XMVectorGetX(vertex_iter.Position));
-				position->SetAttribute("y", XMVectorGetY(vertex_iter.Position));
-				position->SetAttribute("z", XMVectorGetZ(vertex_iter.Position));
+			entry.VertexBlobOffset = blob_offset;
+			blob_offset = AlignTRNOffset(blob_offset + sizeof(SVertexModel) * entry.VertexCount);
 
-				auto texcoord = doc.NewElement("texcoord");
-				position->SetAttribute("u", XMVectorGetX(vertex_iter.TexCoord));
-				position->SetAttribute("v", XMVectorGetY(vertex_iter.TexCoord));
-				
-				auto normal = doc.NewElement("normal");
-				normal->SetAttribute("x", XMVectorGetX(vertex_iter.Normal));
-				normal->SetAttribute("y", XMVectorGetY(vertex_iter.Normal));
-				normal->SetAttribute("z", XMVectorGetZ(vertex_iter.Normal));
-
-				auto tangent = doc.NewElement("tangent");
-				tangent->SetAttribute("x", XMVectorGetX(vertex_iter.Tangent));
-				tangent->SetAttribute("y", XMVectorGetY(vertex_iter.Tangent));
-				tangent->SetAttribute("z", XMVectorGetZ(vertex_iter.Tangent));
-				
-				auto bitangent = doc.NewElement("bitangent");
-				bitangent->SetAttribute("x", XMVectorGetX(vertex_iter.Bitangent));
-				bitangent->SetAttribute("y", XMVectorGetY(vertex_iter.Bitangent));
-				bitangent->SetAttribute("z", XMVectorGetZ(vertex_iter.Bitangent));
-				
-				vertex->InsertEndChild(position);
-				vertex->InsertEndChild(texcoord);
-				vertex->InsertEndChild(normal);
-				vertex->InsertEndChild(tangent);
-				vertex->InsertEndChild(bitangent);
+			entry.IndexBlobOffset = blob_offset;
+			blob_offset = AlignTRNOffset(blob_offset + sizeof(SIndexTriangle) * entry.FaceCount);
+		}
 
-				vertices->InsertEndChild(vertex);
-			}
+		node_table.emplace_back(entry);
+	}
+
+	// #3 Sub-bounding spheres
+	VECTOR<STRNSubBoundingSphere> sub_bounding_spheres{};
+	sub_bounding_spheres.reserve(header.SubBoundingSphereCount);
+	for (const auto& iter : TerrainData.SubBoundingSpheres)
+	{
+		STRNSubBoundingSphere sphere{};
+		sphere.Center[0] = XMVectorGetX(iter.Center);
+		sphere.Center[1] = XMVectorGetY(iter.Center);
+		sphere.Center[2] = XMVectorGetZ(iter.Center);
+		sphere.Radius = iter.Radius;
+
+		sub_bounding_spheres.emplace_back(sphere);
+	}
+
+	// #4 Write
+	std::ofstream ofs{ m_BaseDirectory + KAssetDirectory + TRNFileName, std::ios::binary | std::ios::trunc };
+	if (!ofs.is_open())
+	{
+		JW_ERROR_RETURN("Failed to create the TRN file.");
+	}
+
+	static constexpr char KZeroPadding[KTRNBlobAlignment]{};
+	uint64_t written{};
+	auto write = [&](const void* Data, uint64_t ByteSize)
+	{
+		ofs.write(reinterpret_cast<const char*>(Data), static_cast<std::streamsize>(ByteSize));
+		written += ByteSize;
+	};
+	auto pad_to = [&](uint64_t Offset)
+	{
+		assert(Offset >= written);
+		write(KZeroPadding, Offset - written);
+	};
+
+	write(&header, sizeof(header));
+	if (node_table.size()) { write(node_table.data(), sizeof(STRNNodeEntry) * node_table.size()); }
+	if (sub_bounding_spheres.size()) { write(sub_bounding_spheres.data(), sizeof(STRNSubBoundingSphere) * sub_bounding_spheres.size()); }
+
+	for (size_t i = 0; i < node_table.size(); ++i)
+	{
+		const auto& entry = node_table[i];
+		if (entry.HasMeshes == 0) { continue; }
+
+		const auto& node = TerrainData.QuadTree[i];
+
+		pad_to(entry.VertexBlobOffset);
+		write(node.VertexData.vVerticesModel.data(), sizeof(SVertexModel) * entry.VertexCount);
+
+		pad_to(entry.IndexBlobOffset);
+		write(node.IndexData.vFaces.data(), sizeof(SIndexTriangle) * entry.FaceCount);
+	}
+}
+
+auto JWTerrainGenerator::LoadTerrainFromTRN(const STRING& TRNFileName) noexcept->STerrainData
+{
+	auto start_time = STEADY_CLOCK::now();
+
+	STerrainData terrain_data{};
+
+	auto path = m_BaseDirectory + KAssetDirectory + TRNFileName;
+	if (IsBinaryTRN(path))
+	{
+		terrain_data = LoadTerrainFromBinaryTRN(path);
+	}
+	else
+	{
+		terrain_data = LoadTerrainFromXMLTRN(path);
+	}
+
+	m_LastTRNLoadTime = std::chrono::duration_cast<TIME_UNIT_mS>(STEADY_CLOCK::now() - start_time).count();
+
+	return terrain_data;
+}
+
+void JWTerrainGenerator::ConvertXMLTRNToBinaryTRN(const STRING& XMLTRNFileName, const STRING& BinaryTRNFileName) noexcept
+{
+	auto terrain_data = LoadTerrainFromXMLTRN(m_BaseDirectory + KAssetDirectory + XMLTRNFileName);
+
+	SaveTerrainAsTRN(BinaryTRNFileName, terrain_data);
+
+	// Release GPU buffers created while loading.
+	terrain_data.Destroy();
+}
+
+PRIVATE auto JWTerrainGenerator::IsBinaryTRN(const STRING& TRNFilePath) noexcept->bool
+{
+	std::ifstream ifs{ TRNFilePath, std::ios::binary };
+	if (!ifs.is_open()) { return false; }
+
+	char magic[4]{};
+	ifs.read(magic, sizeof(magic));
+	if (ifs.gcount() != sizeof(magic)) { return false; }
 
-			auto faces = doc.NewElement("faces");
-			faces->SetAttribute("face_count", static_cast<int>(iter.IndexData.vFaces.size()));
-			for (auto& face_iter : iter.IndexData.vFaces)
+	return (memcmp(magic, KTRNMagic, sizeof(magic)) == 0);
+}
+
+PRIVATE auto JWTerrainGenerator::LoadTerrainFromBinaryTRN(const STRING& TRNFilePath) noexcept->STerrainData
+{
+	STerrainData terrain_data{};
+
+	// #1 Map the whole file
+	auto file = CreateFileA(TRNFilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		JW_ERROR("Failed to open the TRN file.");
+		return terrain_data;
+	}
+
+	LARGE_INTEGER file_size{};
+	GetFileSizeEx(file, &file_size);
+
+	auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	const uint8_t* base{};
+	if (mapping)
+	{
+		base = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	}
+
+	if (base == nullptr)
+	{
+		if (mapping) { CloseHandle(mapping); }
+		CloseHandle(file);
+
+		JW_ERROR("Failed to map the TRN file.");
+		return terrain_data;
+	}
+
+	auto byte_size = static_cast<uint64_t>(file_size.QuadPart);
+	auto is_in_file = [&](uint64_t Offset, uint64_t Size) { return (Offset <= byte_size) && (Size <= byte_size - Offset); };
+
+	// -1 (none) or an index into a table of Count entries
+	auto is_valid_id = [](int32_t ID, uint32_t Count) { return (ID == -1) || ((ID >= 0) && (static_cast<uint32_t>(ID) < Count)); };
+
+	// #2 Validate the header
+	const auto& header = *reinterpret_cast<const STRNHeader*>(base);
+	bool is_valid{ is_in_file(0, sizeof(STRNHeader)) };
+	if (is_valid)
+	{
+		is_valid =
+			(memcmp(header.Magic, KTRNMagic, sizeof(KTRNMagic)) == 0) &&
+			(header.Version == KTRNVersion) &&
+			(header.HeaderByteSize == sizeof(STRNHeader)) &&
+			(header.NodeEntryByteSize == sizeof(STRNNodeEntry)) &&
+			(header.VertexByteSize == sizeof(SVertexModel)) &&
+			(header.IndexTriangleByteSize == sizeof(SIndexTriangle)) &&
+			is_in_file(header.NodeTableOffset, sizeof(STRNNodeEntry) * static_cast<uint64_t>(header.NodeCount)) &&
+			is_in_file(header.SubBoundingSphereTableOffset, sizeof(STRNSubBoundingSphere) * static_cast<uint64_t>(header.SubBoundingSphereCount));
+	}
+
+	if (is_valid)
+	{
+		terrain_data.TerrainSizeX = header.TerrainSizeX;
+		terrain_data.TerrainSizeZ = header.TerrainSizeZ;
+		terrain_data.HeightFactor = header.HeightFactor;
+		terrain_data.XYSizeFactor = header.XYSizeFactor;
+		terrain_data.WholeBoundingSphere.Center = XMVectorSet(
+			header.WholeBoundingSphereCenter[0], header.WholeBoundingSphereCenter[1], header.WholeBoundingSphereCenter[2], 0.0f);
+		terrain_data.WholeBoundingSphere.Radius = header.WholeBoundingSphereRadius;
+
+		// #3 Nodes
+		// @important: blobs are used in place, there is no per-vertex parsing.
+		auto node_table = reinterpret_cast<const STRNNodeEntry*>(base + header.NodeTableOffset);
+		terrain_data.QuadTree.resize(header.NodeCount);
+		for (uint32_t i = 0; i < header.NodeCount; ++i)
+		{
+			const auto& entry = node_table[i];
+			auto& current_node = terrain_data.QuadTree[i];
+
+			// Culling, picking and the heightfield index QuadTree and SubBoundingSpheres with these IDs.
+			is_valid =
+				is_valid_id(entry.ParentID, header.NodeCount) &&
+				is_valid_id(entry.ChildrenID[0], header.NodeCount) && is_valid_id(entry.ChildrenID[1], header.NodeCount) &&
+				is_valid_id(entry.ChildrenID[2], header.NodeCount) && is_valid_id(entry.ChildrenID[3], header.NodeCount) &&
+				is_valid_id(entry.SubBoundingVolumeID, header.SubBoundingSphereCount);
+			if (!is_valid) { break; }
+
+			current_node.NodeID = entry.NodeID;
+			current_node.ParentID = entry.ParentID;
+			memcpy(current_node.ChildrenID, entry.ChildrenID, sizeof(current_node.ChildrenID));
+			current_node.StartX = entry.StartX;
+			current_node.StartZ = entry.StartZ;
+			current_node.SizeX = entry.SizeX;
+			current_node.SizeZ = entry.SizeZ;
+			current_node.HasMeshes = (entry.HasMeshes != 0);
+			current_node.SubBoundingVolumeID = entry.SubBoundingVolumeID;
+
+			if (current_node.HasMeshes)
 			{
-				auto face = doc.NewElement("face");
-				face->SetAttribute("_0", static_cast<int>(face_iter._0));
-				face->SetAttribute("_1", static_cast<int>(face_iter._1));
-				face->SetAttribute("_2", static_cast<int>(face_iter._2));
-				
-				faces->InsertEndChild(face);
-			}
+				auto vertex_blob_size = sizeof(SVertexModel) * static_cast<uint64_t>(entry.VertexCount);
+				auto index_blob_size = sizeof(SIndexTriangle) * static_cast<uint64_t>(entry.FaceCount);
+				if ((entry.VertexCount == 0) || (entry.FaceCount == 0) ||
+					(!is_in_file(entry.VertexBlobOffset, vertex_blob_size)) || (!is_in_file(entry.IndexBlobOffset, index_blob_size)))
+				{
+					is_valid = false;
+					break;
+				}
+
+				auto vertices = reinterpret_cast<const SVertexModel*>(base + entry.VertexBlobOffset);
+				auto faces = reinterpret_cast<const SIndexTriangle*>(base + entry.IndexBlobOffset);
 
-			node->InsertEndChild(vertices);
-			node->InsertEndChild(faces);
+				// Every face must index this node's vertices.
+				for (uint32_t face = 0; face < entry.FaceCount; ++face)
+				{
+					const auto& triangle = faces[face];
+					if ((triangle._0 >= entry.VertexCount) || (triangle._1 >= entry.VertexCount) || (triangle._2 >= entry.VertexCount))
+					{
+						is_valid = false;
+						break;
+					}
+				}
+				if (!is_valid) { break; }
+
+				// Keep CPU copies (picking uses them), one bulk copy per blob.
+				current_node.VertexData.vVerticesModel.assign(vertices, vertices + entry.VertexCount);
+				current_node.IndexData.vFaces.assign(faces, faces + entry.FaceCount);
+
+				// GPU buffers are created straight from the mapped memory.
+				m_pDX->CreateStaticVertexBuffer(static_cast<UINT>(vertex_blob_size), vertices, &current_node.VertexBuffer);
+				m_pDX->CreateIndexBuffer(static_cast<UINT>(index_blob_size), faces, &current_node.IndexBuffer);
+			}
 		}
-		
-		quad_tree->InsertEndChild(node);
 	}
 
-	auto sub_bounding_spheres = doc.NewElement("sub_bounding_spheres");
-	sub_bounding_spheres->SetAttribute("count", static_cast<int>(TerrainData.SubBoundingSpheres.size()));
-
-	for (auto& iter : TerrainData.SubBoundingSpheres)
+	if (is_valid)
 	{
-		auto sub_bounding_sphere = doc.NewElement("sub_bounding_sphere");
+		// #4 Sub-bounding spheres
+		auto sphere_table = reinterpret_cast<const STRNSubBoundingSphere*>(base + header.SubBoundingSphereTableOffset);
+		terrain_data.SubBoundingSpheres.reserve(header.SubBoundingSphereCount);
+		for (uint32_t i = 0; i < header.SubBoundingSphereCount; ++i)
+		{
+			SBoundingSphereData curr_sub_bounding_sphere{};
+			curr_sub_bounding_sphere.Center = XMVectorSet(sphere_table[i].Center[0], sphere_table[i].Center[1], sphere_table[i].Center[2], 0.0f);
+			curr_sub_bounding_sphere.Radius = sphere_table[i].Radius;
 
-		auto center = doc.NewElement("center");
-		center->SetAttribute("x", XMVectorGetX(iter.Center));
-		center->SetAttribute("y", XMVectorGetY(iter.Center));
-		center->SetAttribute("z", XMVectorGetZ(iter.Center));
+			terrain_data.SubBoundingSpheres.emplace_back(curr_sub_bounding_sphere);
+		}
+	}
 
-		auto radius = doc.NewElement("radius");
-		radius->SetText(iter.Radius);
+	UnmapViewOfFile(base);
+	CloseHandle(mapping);
+	CloseHandle(file);
 
-		sub_bounding_sphere->InsertEndChild(center);
-		sub_bounding_sphere->InsertEndChild(radius);
+	if (!is_valid)
+	{
+		terrain_data.Destroy();
+		terrain_data = STerrainData();
 
-		sub_bounding_spheres->InsertEndChild(sub_bounding_sphere);
+		// Headless runs have nobody to close the dialog, the empty terrain reports the failure.
+		if (!m_pDX->IsHeadless())
+		{
+			JW_ERROR("Invalid TRN file.");
+		}
 	}
 
-	root->InsertEndChild(terrain_info);
-	root->InsertEndChild(quad_tree);
-	root->InsertEndChild(sub_bounding_spheres);
-	
-	doc.InsertFirstChild(root);
-	doc.SaveFile((m_BaseDirectory + KAssetDirectory + TRNFileName).c_str());
+	return terrain_data;
 }
 
-auto JWTerrainGenerator::LoadTerrainFromTRN(const STRING& TRNFileName) noexcept->STerrainData
+PRIVATE auto JWTerrainGenerator::LoadTerrainFromXMLTRN(const STRING& TRNFilePath) noexcept->STerrainData
 {
 	STerrainData terrain_data{};
-	SModelData model_data{};
 
 	using namespace tinyxml2;
 	tinyxml2::XMLDocument doc{};
-	doc.LoadFile((m_BaseDirectory + KAssetDirectory + TRNFileName).c_str());
+	if (doc.LoadFile(TRNFilePath.c_str()) != XML_SUCCESS)
+	{
+		JW_ERROR("Failed to load the XML TRN file.");
+		return terrain_data;
+	}
 
 	auto root = doc.FirstChildElement();
 
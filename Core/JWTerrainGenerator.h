@@ -30,6 +30,65 @@ namespace JWEngine
 
 	using SVertexMap = VECTOR<SVertexMapEntry>;
 
+	// ### TRN v2 (binary) ###
+	// [STRNHeader][STRNNodeEntry x NodeCount][STRNSubBoundingSphere x SubBoundingSphereCount][blobs...]
+	// Each blob is a raw SVertexModel or SIndexTriangle array, aligned to KTRNBlobAlignment.
+	// Offsets are in bytes from the beginning of the file. (little-endian only)
+	static constexpr char		KTRNMagic[4]{ 'J', 'W', 'T', 'R' };
+	static constexpr uint32_t	KTRNVersion{ 2 };
+	static constexpr uint64_t	KTRNBlobAlignment{ 16 };
+
+	struct STRNNodeEntry
+	{
+		int32_t		NodeID{};
+		int32_t		ParentID{ -1 };
+		int32_t		ChildrenID[4]{ -1, -1, -1, -1 };
+
+		uint32_t	StartX{};
+		uint32_t	StartZ{};
+		uint32_t	SizeX{};
+		uint32_t	SizeZ{};
+
+		uint32_t	HasMeshes{};
+		int32_t		SubBoundingVolumeID{ -1 };
+
+		uint32_t	VertexCount{};
+		uint32_t	FaceCount{};
+		uint64_t	VertexBlobOffset{};
+		uint64_t	IndexBlobOffset{};
+	};
+
+	struct STRNSubBoundingSphere
+	{
+		float		Center[3]{};
+		float		Radius{};
+	};
+
+	struct STRNHeader
+	{
+		char		Magic[4]{ KTRNMagic[0], KTRNMagic[1], KTRNMagic[2], KTRNMagic[3] };
+		uint32_t	Version{ KTRNVersion };
+
+		// For validation (the blobs are raw copies of these structs)
+		uint32_t	HeaderByteSize{ sizeof(STRNHeader) };
+		uint32_t	NodeEntryByteSize{ sizeof(STRNNodeEntry) };
+		uint32_t	VertexByteSize{ sizeof(SVertexModel) };
+		uint32_t	IndexTriangleByteSize{ sizeof(SIndexTriangle) };
+
+		uint32_t	TerrainSizeX{};
+		uint32_t	TerrainSizeZ{};
+		float		HeightFactor{};
+		float		XYSizeFactor{};
+
+		float		WholeBoundingSphereCenter[3]{};
+		float		WholeBoundingSphereRadius{};
+
+		uint32_t	NodeCount{};
+		uint32_t	SubBoundingSphereCount{};
+		uint64_t	NodeTableOffset{};
+		uint64_t	SubBoundingSphereTableOffset{};
+	};
+
 	class JWDX;
 
 	class JWTerrainGenerator
@@ -43,10 +102,18 @@ namespace JWEngine
 		// TIF(R8, non-compressed, non-layered)
 		auto GenerateTerrainFromHeightMap(const STRING& HeightMapFN, float HeightFactor = 1.0f, float XYSizeFactor = 1.0f) noexcept->STerrainData;
 
+		// Saves TRN v2 (binary)
 		void SaveTerrainAsTRN(const STRING& TRNFileName, const STerrainData& TerrainData) noexcept;
 
+		// Loads both TRN v2 (binary, memory-mapped) and the old XML TRN.
 		auto LoadTerrainFromTRN(const STRING& TRNFileName) noexcept->STerrainData;
 
+		// Converts an old XML TRN file into TRN v2.
+		void ConvertXMLTRNToBinaryTRN(const STRING& XMLTRNFileName, const STRING& BinaryTRNFileName) noexcept;
+
+		// Time spent in the last LoadTerrainFromTRN() in microseconds.
+		auto GetLastTRNLoadTime() const noexcept { return m_LastTRNLoadTime; };
+
 		inline auto ConvertR8G8B8ToFloat(unsigned char R, unsigned char G, unsigned char B, float factor) noexcept->float;
 		inline auto ConvertR8ToFloat(unsigned char R, float factor) noexcept->float;
 		inline auto ConvertR16ToFloat(unsigned short R, float factor) noexcept->float;
@@ -62,11 +129,17 @@ namespace JWEngine
 		void LoadR8G8B8A8UnormData(ID3D11Texture2D* Texture, uint32_t TextureWidth, uint32_t TextureHeight,
 			float HeightFactor, float XYSizeFactor, SModelData& OutModelData, SVertexMap& OutVertexMap) noexcept;
 
+		auto IsBinaryTRN(const STRING& TRNFilePath) noexcept->bool;
+		auto LoadTerrainFromBinaryTRN(const STRING& TRNFilePath) noexcept->STerrainData;
+		auto LoadTerrainFromXMLTRN(const STRING& TRNFilePath) noexcept->STerrainData;
+
 		void BuildQuadTree(STerrainData& TerrainData, int32_t CurrentNodeID) noexcept;
 		void BuildQuadTreeMesh(STerrainData& TerrainData, const SModelData& ModelData) noexcept;
 		
 	private:
-		JWDX*	m_pDX{};
-		STRING	m_BaseDirectory{};
+		JWDX*		m_pDX{};
+		STRING		m_BaseDirectory{};
+
+		long long	m_LastTRNLoadTime{};
 	};
 };
\ No newline at end of file
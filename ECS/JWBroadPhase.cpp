@@ -0,0 +1,483 @@
+#include "JWBroadPhase.h"
+#include <algorithm>
+
+using namespace JWEngine;
+
+static __forceinline auto GetAxis(const XMFLOAT3& Vector, uint32_t Axis) noexcept->float
+{
+	return (&Vector.x)[Axis];
+}
+
+static __forceinline auto ToCellCoordinate(float Value, float InverseCellSize) noexcept->int32_t
+{
+	return static_cast<int32_t>(floorf(Value * InverseCellSize));
+}
+
+static __forceinline auto GetCellKey(int32_t X, int32_t Y, int32_t Z) noexcept->uint64_t
+{
+	return
+		((static_cast<uint64_t>(X + KSpatialHashCellBias) & KSpatialHashCellMask) << 42) |
+		((static_cast<uint64_t>(Y + KSpatialHashCellBias) & KSpatialHashCellMask) << 21) |
+		(static_cast<uint64_t>(Z + KSpatialHashCellBias) & KSpatialHashCellMask);
+}
+
+JWBroadPhase::JWBroadPhase() noexcept
+{
+	// Every layer collides with every layer by default.
+	std::fill(std::begin(m_LayerCollisionMasks), std::end(m_LayerCollisionMasks), KCollisionLayerMaskAll);
+}
+
+void JWBroadPhase::SetType(EBroadPhaseType Type) noexcept
+{
+	if (m_Type != Type)
+	{
+		m_Type = Type;
+
+		// Persistent data of the previous broad phase is no longer valid.
+		m_vSortedProxyIDs.clear();
+		m_IsSortedListValid = false;
+		m_IsSpatialHashValid = false;
+	}
+}
+
+void JWBroadPhase::SetSpatialHashCellSize(float CellSize) noexcept
+{
+	m_SpatialHashCellSize = CellSize;
+}
+
+void JWBroadPhase::SetLayerCollision(uint32_t LayerA, uint32_t LayerB, bool ShouldCollide) noexcept
+{
+	assert((LayerA < KMaxCollisionLayerCount) && (LayerB < KMaxCollisionLayerCount));
+	if ((LayerA >= KMaxCollisionLayerCount) || (LayerB >= KMaxCollisionLayerCount)) { return; }
+
+	// Symmetric
+	if (ShouldCollide)
+	{
+		m_LayerCollisionMasks[LayerA] |= (1u << LayerB);
+		m_LayerCollisionMasks[LayerB] |= (1u << LayerA);
+	}
+	else
+	{
+		m_LayerCollisionMasks[LayerA] &= ~(1u << LayerB);
+		m_LayerCollisionMasks[LayerB] &= ~(1u << LayerA);
+	}
+}
+
+auto JWBroadPhase::ShouldLayersCollide(uint32_t LayerA, uint32_t LayerB) const noexcept->bool
+{
+	if ((LayerA >= KMaxCollisionLayerCount) || (LayerB >= KMaxCollisionLayerCount)) { return false; }
+
+	return (m_LayerCollisionMasks[LayerA] & (1u << LayerB)) != 0;
+}
+
+void JWBroadPhase::BeginFrame() noexcept
+{
+	m_vProxies.clear();
+
+	// Query structures are rebuilt by GeneratePairs().
+	m_IsSortedListValid = false;
+	m_IsSpatialHashValid = false;
+}
+
+void JWBroadPhase::AddProxy(ComponentIndexType ComponentIndex, const XMVECTOR& WorldCenter, float Radius, uint32_t Layer) noexcept
+{
+	assert(Layer < KMaxCollisionLayerCount);
+	Layer = min(Layer, KMaxCollisionLayerCount - 1);
+
+	XMFLOAT3 center{};
+	XMStoreFloat3(&center, WorldCenter);
+
+	m_vProxies.emplace_back(ComponentIndex, center, Radius, 1u << Layer, m_LayerCollisionMasks[Layer]);
+}
+
+void JWBroadPhase::GeneratePairs(VECTOR<SCollisionPair>& OutPairs) noexcept
+{
+	auto start_time = STEADY_CLOCK::now();
+
+	OutPairs.clear();
+	m_CandidatePairCount = 0;
+	m_FilteredPairCount = 0;
+
+	switch (m_Type)
+	{
+	case EBroadPhaseType::BruteForce:
+		GeneratePairsBruteForce(OutPairs);
+		break;
+	case EBroadPhaseType::SweepAndPrune:
+		GeneratePairsSweepAndPrune(OutPairs);
+		break;
+	case EBroadPhaseType::SpatialHash:
+		GeneratePairsSpatialHash(OutPairs);
+		break;
+	default:
+		break;
+	}
+
+	m_PairGenerationTime = std::chrono::duration_cast<TIME_UNIT_mS>(STEADY_CLOCK::now() - start_time).count();
+}
+
+void JWBroadPhase::QueryAABB(const XMFLOAT3& Min, const XMFLOAT3& Max, uint32_t Layer, VECTOR<ComponentIndexType>& OutComponentIndices) const noexcept
+{
+	if (Layer >= KMaxCollisionLayerCount) { return; }
+
+	auto layer_mask = m_LayerCollisionMasks[Layer];
+
+	auto n = static_cast<uint32_t>(m_vProxies.size());
+
+	// Sweep-and-prune: only proxies that start before the box ends on the sweep axis
+	if (m_IsSortedListValid)
+	{
+		auto axis = m_SweepAxis;
+		auto box_max = GetAxis(Max, axis);
+		auto end = std::upper_bound(m_vSortedProxyIDs.begin(), m_vSortedProxyIDs.end(), box_max, [&](float value, uint32_t id)
+		{
+			return value < GetAxis(m_vProxies[id].Min, axis);
+		});
+
+		for (auto iter = m_vSortedProxyIDs.begin(); iter != end; ++iter)
+		{
+			if (IsProxyInQuery(*iter, Min, Max, layer_mask)) { OutComponentIndices.emplace_back(m_vProxies[*iter].ComponentIndex); }
+		}
+		return;
+	}
+
+	// Spatial hash: only the cells the box touches (a box that spans too many cells falls through to the scan)
+	if (m_IsSpatialHashValid)
+	{
+		auto min_x = ToCellCoordinate(Min.x, m_SpatialHashInverseCellSize);
+		auto min_y = ToCellCoordinate(Min.y, m_SpatialHashInverseCellSize);
+		auto min_z = ToCellCoordinate(Min.z, m_SpatialHashInverseCellSize);
+		auto max_x = ToCellCoordinate(Max.x, m_SpatialHashInverseCellSize);
+		auto max_y = ToCellCoordinate(Max.y, m_SpatialHashInverseCellSize);
+		auto max_z = ToCellCoordinate(Max.z, m_SpatialHashInverseCellSize);
+
+		auto cell_count = static_cast<uint64_t>(max_x - min_x + 1) * (max_y - min_y + 1) * (max_z - min_z + 1);
+		if (cell_count <= KSpatialHashMaxCellsPerProxy)
+		{
+			auto first_output = OutComponentIndices.size();
+
+			for (auto z = min_z; z <= max_z; ++z)
+			{
+				for (auto y = min_y; y <= max_y; ++y)
+				{
+					for (auto x = min_x; x <= max_x; ++x)
+					{
+						auto cell_key = GetCellKey(x, y, z);
+						auto range = std::equal_range(m_vSpatialHashEntries.begin(), m_vSpatialHashEntries.end(), SSpatialHashEntry(cell_key, 0),
+							[](const SSpatialHashEntry& a, const SSpatialHashEntry& b) { return a.CellKey < b.CellKey; });
+
+						for (auto iter = range.first; iter != range.second; ++iter)
+						{
+							if (IsProxyInQuery(iter->ProxyID, Min, Max, layer_mask)) { OutComponentIndices.emplace_back(m_vProxies[iter->ProxyID].ComponentIndex); }
+						}
+					}
+				}
+			}
+
+			for (auto large_id : m_vLargeProxyIDs)
+			{
+				if (IsProxyInQuery(large_id, Min, Max, layer_mask)) { OutComponentIndices.emplace_back(m_vProxies[large_id].ComponentIndex); }
+			}
+
+			// A proxy that spans several of the cells is found in each of them.
+			std::sort(OutComponentIndices.begin() + first_output, OutComponentIndices.end());
+			OutComponentIndices.erase(std::unique(OutComponentIndices.begin() + first_output, OutComponentIndices.end()), OutComponentIndices.end());
+			return;
+		}
+	}
+
+	for (uint32_t id = 0; id < n; ++id)
+	{
+		if (IsProxyInQuery(id, Min, Max, layer_mask)) { OutComponentIndices.emplace_back(m_vProxies[id].ComponentIndex); }
+	}
+}
+
+PRIVATE __forceinline auto JWBroadPhase::IsProxyInQuery(uint32_t ProxyID, const XMFLOAT3& Min, const XMFLOAT3& Max,
+	CollisionLayerMask LayerMask) const noexcept->bool
+{
+	const auto& proxy = m_vProxies[ProxyID];
+
+	if ((LayerMask & proxy.LayerBit) == 0) { return false; }
+
+	return (proxy.Min.x <= Max.x) && (Min.x <= proxy.Max.x) &&
+		(proxy.Min.y <= Max.y) && (Min.y <= proxy.Max.y) &&
+		(proxy.Min.z <= Max.z) && (Min.z <= proxy.Max.z);
+}
+
+PRIVATE __forceinline void JWBroadPhase::TestProxyPair(uint32_t ProxyIDA, uint32_t ProxyIDB, VECTOR<SCollisionPair>& OutPairs) noexcept
+{
+	const auto& a = m_vProxies[ProxyIDA];
+	const auto& b = m_vProxies[ProxyIDB];
+
+	// Layer filter (before any geometry)
+	if ((a.CollidesWithMask & b.LayerBit) == 0)
+	{
+		++m_FilteredPairCount;
+		return;
+	}
+
+	++m_CandidatePairCount;
+
+	auto dx = a.Center.x - b.Center.x;
+	auto dy = a.Center.y - b.Center.y;
+	auto dz = a.Center.z - b.Center.z;
+	auto r = a.Radius + b.Radius;
+
+	// Same test as IntersectSpheres(), without loading XMVECTORs.
+	if (dx * dx + dy * dy + dz * dz <= r * r)
+	{
+		if (a.ComponentIndex < b.ComponentIndex)
+		{
+			OutPairs.emplace_back(a.ComponentIndex, b.ComponentIndex);
+		}
+		else
+		{
+			OutPairs.emplace_back(b.ComponentIndex, a.ComponentIndex);
+		}
+	}
+}
+
+PRIVATE void JWBroadPhase::GeneratePairsBruteForce(VECTOR<SCollisionPair>& OutPairs) noexcept
+{
+	auto n = static_cast<uint32_t>(m_vProxies.size());
+
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		for (uint32_t j = i + 1; j < n; ++j)
+		{
+			TestProxyPair(i, j, OutPairs);
+		}
+	}
+}
+
+PRIVATE auto JWBroadPhase::GetLargestVarianceAxis() const noexcept->uint32_t
+{
+	if (m_vProxies.size() < 2) { return m_SweepAxis; }
+
+	float sum[3]{};
+	float sum_sq[3]{};
+	for (const auto& iter : m_vProxies)
+	{
+		for (uint32_t axis = 0; axis < 3; ++axis)
+		{
+			auto c = GetAxis(iter.Center, axis);
+			sum[axis] += c;
+			sum_sq[axis] += c * c;
+		}
+	}
+
+	auto inv_n = 1.0f / static_cast<float>(m_vProxies.size());
+	uint32_t result{};
+	float max_variance{ -1.0f };
+	for (uint32_t axis = 0; axis < 3; ++axis)
+	{
+		auto variance = sum_sq[axis] * inv_n - (sum[axis] * inv_n) * (sum[axis] * inv_n);
+		if (variance > max_variance)
+		{
+			max_variance = variance;
+			result = axis;
+		}
+	}
+
+	return result;
+}
+
+PRIVATE void JWBroadPhase::GeneratePairsSweepAndPrune(VECTOR<SCollisionPair>& OutPairs) noexcept
+{
+	auto n = static_cast<uint32_t>(m_vProxies.size());
+	if (n < 2)
+	{
+		m_vSortedProxyIDs.clear();
+		return;
+	}
+
+	// #1 Sync the persistent id list with the current proxy count.
+	// Ids are positions in m_vProxies. They don't rely on the order proxies are added in,
+	// because the sort below always reads the current bounds of each position.
+	// If that order changes (e.g. a destroyed component is replaced by the last one),
+	// the list is just less sorted than usual for a frame.
+	auto prev_n = static_cast<uint32_t>(m_vSortedProxyIDs.size());
+	if (prev_n > n)
+	{
+		m_vSortedProxyIDs.erase(
+			std::remove_if(m_vSortedProxyIDs.begin(), m_vSortedProxyIDs.end(), [n](uint32_t id) { return id >= n; }),
+			m_vSortedProxyIDs.end());
+	}
+	else
+	{
+		for (uint32_t id = prev_n; id < n; ++id)
+		{
+			m_vSortedProxyIDs.emplace_back(id);
+		}
+	}
+
+	// #2 Sort along the sweep axis.
+	auto axis = GetLargestVarianceAxis();
+	if ((axis != m_SweepAxis) || (prev_n == 0))
+	{
+		// The order from last frame is useless on a new axis.
+		m_SweepAxis = axis;
+
+		std::sort(m_vSortedProxyIDs.begin(), m_vSortedProxyIDs.end(), [&](uint32_t a, uint32_t b)
+		{
+			return GetAxis(m_vProxies[a].Min, axis) < GetAxis(m_vProxies[b].Min, axis);
+		});
+	}
+	else
+	{
+		// @important
+		// Temporal coherence: the list is almost sorted, insertion sort is ~O(n) here.
+		for (uint32_t i = 1; i < n; ++i)
+		{
+			auto id = m_vSortedProxyIDs[i];
+			auto key = GetAxis(m_vProxies[id].Min, axis);
+
+			auto j = i;
+			while ((j > 0) && (GetAxis(m_vProxies[m_vSortedProxyIDs[j - 1]].Min, axis) > key))
+			{
+				m_vSortedProxyIDs[j] = m_vSortedProxyIDs[j - 1];
+				--j;
+			}
+			m_vSortedProxyIDs[j] = id;
+		}
+	}
+
+	// #3 Sweep
+	auto axis_1 = (axis + 1) % 3;
+	auto axis_2 = (axis + 2) % 3;
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		const auto& a = m_vProxies[m_vSortedProxyIDs[i]];
+		auto a_max = GetAxis(a.Max, axis);
+
+		for (uint32_t j = i + 1; j < n; ++j)
+		{
+			const auto& b = m_vProxies[m_vSortedProxyIDs[j]];
+
+			// Every proxy after this one starts even further away.
+			if (GetAxis(b.Min, axis) > a_max) { break; }
+
+			// Reject on the other two axes before the sphere test.
+			if ((GetAxis(a.Max, axis_1) < GetAxis(b.Min, axis_1)) || (GetAxis(b.Max, axis_1) < GetAxis(a.Min, axis_1))) { continue; }
+			if ((GetAxis(a.Max, axis_2) < GetAxis(b.Min, axis_2)) || (GetAxis(b.Max, axis_2) < GetAxis(a.Min, axis_2))) { continue; }
+
+			TestProxyPair(m_vSortedProxyIDs[i], m_vSortedProxyIDs[j], OutPairs);
+		}
+	}
+
+	m_IsSortedListValid = true;
+}
+
+PRIVATE auto JWBroadPhase::GetCellSize() const noexcept->float
+{
+	if (m_SpatialHashCellSize > 0) { return m_SpatialHashCellSize; }
+
+	// Automatic cell size: average diameter of the proxies
+	float sum_radius{};
+	for (const auto& iter : m_vProxies)
+	{
+		sum_radius += iter.Radius;
+	}
+
+	auto result = 2.0f * sum_radius / static_cast<float>(max(m_vProxies.size(), (size_t)1));
+	return (result > 0) ? result : 1.0f;
+}
+
+PRIVATE void JWBroadPhase::GeneratePairsSpatialHash(VECTOR<SCollisionPair>& OutPairs) noexcept
+{
+	auto n = static_cast<uint32_t>(m_vProxies.size());
+	if (n < 2) { return; }
+
+	auto inv_cell_size = 1.0f / GetCellSize();
+	m_SpatialHashInverseCellSize = inv_cell_size;
+
+	m_vSpatialHashEntries.clear();
+	m_vLargeProxyIDs.clear();
+
+	// #1 Insert every proxy into all the cells its AABB touches.
+	for (uint32_t id = 0; id < n; ++id)
+	{
+		auto& proxy = m_vProxies[id];
+
+		auto min_x = ToCellCoordinate(proxy.Min.x, inv_cell_size);
+		auto min_y = ToCellCoordinate(proxy.Min.y, inv_cell_size);
+		auto min_z = ToCellCoordinate(proxy.Min.z, inv_cell_size);
+		auto max_x = ToCellCoordinate(proxy.Max.x, inv_cell_size);
+		auto max_y = ToCellCoordinate(proxy.Max.y, inv_cell_size);
+		auto max_z = ToCellCoordinate(proxy.Max.z, inv_cell_size);
+
+		auto cell_count = static_cast<uint64_t>(max_x - min_x + 1) * (max_y - min_y + 1) * (max_z - min_z + 1);
+		if (cell_count > KSpatialHashMaxCellsPerProxy)
+		{
+			proxy.IsLarge = true;
+			m_vLargeProxyIDs.emplace_back(id);
+			continue;
+		}
+
+		for (auto z = min_z; z <= max_z; ++z)
+		{
+			for (auto y = min_y; y <= max_y; ++y)
+			{
+				for (auto x = min_x; x <= max_x; ++x)
+				{
+					m_vSpatialHashEntries.emplace_back(GetCellKey(x, y, z), id);
+				}
+			}
+		}
+	}
+
+	// #2 Group entries by cell.
+	std::sort(m_vSpatialHashEntries.begin(), m_vSpatialHashEntries.end(), [](const SSpatialHashEntry& a, const SSpatialHashEntry& b)
+	{
+		return (a.CellKey < b.CellKey) || ((a.CellKey == b.CellKey) && (a.ProxyID < b.ProxyID));
+	});
+	m_IsSpatialHashValid = true;
+
+	// #3 Test pairs that share a cell.
+	auto entry_count = m_vSpatialHashEntries.size();
+	size_t cell_begin{};
+	while (cell_begin < entry_count)
+	{
+		auto cell_key = m_vSpatialHashEntries[cell_begin].CellKey;
+		auto cell_end = cell_begin + 1;
+		while ((cell_end < entry_count) && (m_vSpatialHashEntries[cell_end].CellKey == cell_key)) { ++cell_end; }
+
+		for (auto i = cell_begin; i < cell_end; ++i)
+		{
+			const auto& a = m_vProxies[m_vSpatialHashEntries[i].ProxyID];
+
+			for (auto j = i + 1; j < cell_end; ++j)
+			{
+				const auto& b = m_vProxies[m_vSpatialHashEntries[j].ProxyID];
+
+				if ((a.Max.x < b.Min.x) || (b.Max.x < a.Min.x) ||
+					(a.Max.y < b.Min.y) || (b.Max.y < a.Min.y) ||
+					(a.Max.z < b.Min.z) || (b.Max.z < a.Min.z)) { continue; }
+
+				// @important
+				// A pair can share many cells. Only the cell that holds the min corner of the AABB overlap reports it,
+				// so no pair is emitted twice.
+				auto owner_key = GetCellKey(
+					ToCellCoordinate(max(a.Min.x, b.Min.x), inv_cell_size),
+					ToCellCoordinate(max(a.Min.y, b.Min.y), inv_cell_size),
+					ToCellCoordinate(max(a.Min.z, b.Min.z), inv_cell_size));
+				if (owner_key != cell_key) { continue; }
+
+				TestProxyPair(m_vSpatialHashEntries[i].ProxyID, m_vSpatialHashEntries[j].ProxyID, OutPairs);
+			}
+		}
+
+		cell_begin = cell_end;
+	}
+
+	// #4 Large proxies against everything (large-large pairs only once).
+	for (auto large_id : m_vLargeProxyIDs)
+	{
+		for (uint32_t id = 0; id < n; ++id)
+		{
+			if ((m_vProxies[id].IsLarge) && (id <= large_id)) { continue; }
+
+			TestProxyPair(large_id, id, OutPairs);
+		}
+	}
+}
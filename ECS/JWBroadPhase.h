@@ -0,0 +1,165 @@
+#pragma once
+
+#include "../Core/JWCommon.h"
+
+namespace JWEngine
+{
+	// Default cell size of the uniform spatial hash
+	// (0 means the cell size is derived from the average proxy size every frame.)
+	static constexpr float		KDefaultSpatialHashCellSize{ 0.0f };
+
+	// Cell coordinates are packed into 21 bits per axis.
+	static constexpr int32_t	KSpatialHashCellBias{ 1 << 20 };
+	static constexpr uint64_t	KSpatialHashCellMask{ (1ull << 21) - 1 };
+
+	// Proxies that span more cells than this are kept out of the hash and tested against every proxy,
+	// so that one big body (e.g. terrain) doesn't flood the hash when the cell size is small.
+	static constexpr uint32_t	KSpatialHashMaxCellsPerProxy{ 64 };
+
+	// One bit per collision layer
+	using CollisionLayerMask = uint32_t;
+	static constexpr uint32_t				KMaxCollisionLayerCount{ 32 };
+	static constexpr uint32_t				KDefaultCollisionLayer{ 0 };
+	static constexpr CollisionLayerMask		KCollisionLayerMaskAll{ 0xFFFFFFFF };
+
+	enum class EBroadPhaseType
+	{
+		// O(n^2), every pair is tested.
+		BruteForce,
+
+		// Persistent sorted interval list along the axis of largest variance.
+		// Bodies barely move between frames, so an insertion sort keeps it ~O(n).
+		SweepAndPrune,
+
+		// Uniform grid, (cell key, proxy) entries are sorted and each cell is tested on its own.
+		SpatialHash,
+	};
+
+	struct SCollisionPair
+	{
+		SCollisionPair() {};
+		SCollisionPair(ComponentIndexType _A, ComponentIndexType _B) : A{ _A }, B{ _B } {};
+
+		ComponentIndexType A{};
+		ComponentIndexType B{};
+	};
+
+	// Bounding-sphere proxy that the broad phase works on.
+	// AABB is derived from the sphere, the sphere itself is used for the final overlap test.
+	struct SBroadPhaseProxy
+	{
+		SBroadPhaseProxy() {};
+		SBroadPhaseProxy(ComponentIndexType _ComponentIndex, const XMFLOAT3& _Center, float _Radius,
+			CollisionLayerMask _LayerBit, CollisionLayerMask _CollidesWithMask) :
+			ComponentIndex{ _ComponentIndex }, Center{ _Center }, Radius{ _Radius },
+			LayerBit{ _LayerBit }, CollidesWithMask{ _CollidesWithMask },
+			Min{ _Center.x - _Radius, _Center.y - _Radius, _Center.z - _Radius },
+			Max{ _Center.x + _Radius, _Center.y + _Radius, _Center.z + _Radius } {};
+
+		ComponentIndexType	ComponentIndex{ KInvalidComponentIndex };
+		XMFLOAT3			Center{};
+		float				Radius{};
+
+		// The layer matrix is symmetric, so (a.CollidesWithMask & b.LayerBit) is the whole filter.
+		CollisionLayerMask	LayerBit{ 1 };
+		CollisionLayerMask	CollidesWithMask{ KCollisionLayerMaskAll };
+
+		XMFLOAT3			Min{};
+		XMFLOAT3			Max{};
+
+		// Set by the spatial hash for proxies that are kept out of the cells
+		bool				IsLarge{};
+	};
+
+	struct SSpatialHashEntry
+	{
+		SSpatialHashEntry() {};
+		SSpatialHashEntry(uint64_t _CellKey, uint32_t _ProxyID) : CellKey{ _CellKey }, ProxyID{ _ProxyID } {};
+
+		uint64_t	CellKey{};
+		uint32_t	ProxyID{};
+	};
+
+	// @important: JWBroadPhase doesn't know about entities or transforms,
+	// so it can be driven (and measured) without JWECS.
+	class JWBroadPhase
+	{
+	public:
+		JWBroadPhase() noexcept;
+		~JWBroadPhase() = default;
+
+		void SetType(EBroadPhaseType Type) noexcept;
+		auto GetType() const noexcept { return m_Type; };
+
+		// CellSize <= 0 means automatic cell size.
+		void SetSpatialHashCellSize(float CellSize) noexcept;
+
+		// ### Collision layers ###
+		// Every layer collides with every layer by default.
+		void SetLayerCollision(uint32_t LayerA, uint32_t LayerB, bool ShouldCollide) noexcept;
+		auto ShouldLayersCollide(uint32_t LayerA, uint32_t LayerB) const noexcept->bool;
+
+		// ### Per-frame usage ###
+		// BeginFrame() -> AddProxy() for every body -> GeneratePairs()
+		void BeginFrame() noexcept;
+		void AddProxy(ComponentIndexType ComponentIndex, const XMVECTOR& WorldCenter, float Radius,
+			uint32_t Layer = KDefaultCollisionLayer) noexcept;
+
+		// Only pairs whose bounding spheres actually overlap are written.
+		// A is always the smaller component index.
+		void GeneratePairs(VECTOR<SCollisionPair>& OutPairs) noexcept;
+
+		auto GetProxyCount() const noexcept { return static_cast<uint32_t>(m_vProxies.size()); };
+
+		// Component indices of the proxies whose AABB overlaps the box and whose layer collides with Layer
+		// (OutComponentIndices is not cleared, every proxy is written at most once).
+		// Uses the structure of the last GeneratePairs() if there is one, so call it after GeneratePairs().
+		void QueryAABB(const XMFLOAT3& Min, const XMFLOAT3& Max, uint32_t Layer, VECTOR<ComponentIndexType>& OutComponentIndices) const noexcept;
+
+		// Number of candidate pairs that reached the sphere test during the last GeneratePairs().
+		auto GetCandidatePairCount() const noexcept { return m_CandidatePairCount; };
+
+		// Number of candidate pairs rejected by the layer matrix during the last GeneratePairs().
+		auto GetFilteredPairCount() const noexcept { return m_FilteredPairCount; };
+
+		// Time spent in the last GeneratePairs() in microseconds.
+		auto GetPairGenerationTime() const noexcept { return m_PairGenerationTime; };
+
+	private:
+		void GeneratePairsBruteForce(VECTOR<SCollisionPair>& OutPairs) noexcept;
+		void GeneratePairsSweepAndPrune(VECTOR<SCollisionPair>& OutPairs) noexcept;
+		void GeneratePairsSpatialHash(VECTOR<SCollisionPair>& OutPairs) noexcept;
+
+		__forceinline void TestProxyPair(uint32_t ProxyIDA, uint32_t ProxyIDB, VECTOR<SCollisionPair>& OutPairs) noexcept;
+
+		__forceinline auto IsProxyInQuery(uint32_t ProxyID, const XMFLOAT3& Min, const XMFLOAT3& Max, CollisionLayerMask LayerMask) const noexcept->bool;
+
+		auto GetLargestVarianceAxis() const noexcept->uint32_t;
+		auto GetCellSize() const noexcept->float;
+
+	private:
+		EBroadPhaseType				m_Type{ EBroadPhaseType::SweepAndPrune };
+
+		VECTOR<SBroadPhaseProxy>	m_vProxies{};
+
+		// Layer-pair matrix (row = layers that the layer collides with), filled in the constructor
+		CollisionLayerMask			m_LayerCollisionMasks[KMaxCollisionLayerCount]{};
+
+		// Sweep-and-prune
+		// Proxy ids sorted by min on m_SweepAxis, kept between frames.
+		VECTOR<uint32_t>			m_vSortedProxyIDs{};
+		uint32_t					m_SweepAxis{};
+		bool						m_IsSortedListValid{};
+
+		// Spatial hash
+		float						m_SpatialHashCellSize{ KDefaultSpatialHashCellSize };
+		VECTOR<SSpatialHashEntry>	m_vSpatialHashEntries{};
+		VECTOR<uint32_t>			m_vLargeProxyIDs{};
+		float						m_SpatialHashInverseCellSize{};
+		bool						m_IsSpatialHashValid{};
+
+		uint32_t					m_CandidatePairCount{};
+		uint32_t					m_FilteredPairCount{};
+		long long					m_PairGenerationTime{};
+	};
+};
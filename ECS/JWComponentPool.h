@@ -0,0 +1,147 @@
+#pragma once
+
+#include "../Core/JWCommon.h"
+
+namespace JWEngine
+{
+	// Sparse-set component storage shared by every system.
+	// Dense: packed components (iterated by systems), swap-and-pop on destruction.
+	// Sparse: entity index -> component index (KInvalidComponentIndex if the entity has no such component).
+	//
+	// @important
+	// ComponentType must have EntityIndex and ComponentIndex members,
+	// and a constructor whose first two parameters are (EntityIndexType, ComponentIndexType).
+	template <typename ComponentType>
+	class JWComponentPool
+	{
+	public:
+		JWComponentPool() = default;
+		~JWComponentPool() = default;
+
+		// Extra arguments are forwarded to the component's constructor.
+		template <typename... ArgTypes>
+		auto Create(EntityIndexType EntityIndex, ArgTypes&&... Args) noexcept->ComponentIndexType
+		{
+			if (HasEntity(EntityIndex))
+			{
+				JW_ERROR_ABORT("The entity already has this component.");
+			}
+
+			auto component_index{ static_cast<ComponentIndexType>(m_vDense.size()) };
+			m_vDense.emplace_back(EntityIndex, component_index, std::forward<ArgTypes>(Args)...);
+
+			if (EntityIndex >= m_vSparse.size())
+			{
+				m_vSparse.resize(static_cast<size_t>(EntityIndex) + 1, KInvalidComponentIndex);
+			}
+			m_vSparse[EntityIndex] = component_index;
+
+			return component_index;
+		}
+
+		void DestroyByEntity(EntityIndexType EntityIndex) noexcept
+		{
+			if (!HasEntity(EntityIndex))
+			{
+				JW_ERROR_ABORT("The entity doesn't have this component.");
+			}
+
+			auto component_index = m_vSparse[EntityIndex];
+			auto last_index = static_cast<ComponentIndexType>(m_vDense.size() - 1);
+
+			// Swap the last element of the vector and the deleted element if necessary
+			if (component_index < last_index)
+			{
+				m_vDense[component_index] = MOVE(m_vDense[last_index]);
+				m_vDense[component_index].ComponentIndex = component_index; // @important
+
+				m_vSparse[m_vDense[component_index].EntityIndex] = component_index; // @important
+			}
+
+			m_vSparse[EntityIndex] = KInvalidComponentIndex;
+
+			// Shrink the size of the vector.
+			m_vDense.pop_back();
+		}
+
+		auto HasEntity(EntityIndexType EntityIndex) const noexcept->bool
+		{
+			return (EntityIndex < m_vSparse.size()) && (m_vSparse[EntityIndex] != KInvalidComponentIndex);
+		}
+
+		auto GetComponentIndex(EntityIndexType EntityIndex) const noexcept->ComponentIndexType
+		{
+			return (EntityIndex < m_vSparse.size()) ? m_vSparse[EntityIndex] : KInvalidComponentIndex;
+		}
+
+		// Returns nullptr if the entity doesn't have this component.
+		auto GetByEntity(EntityIndexType EntityIndex) noexcept->ComponentType*
+		{
+			if (!HasEntity(EntityIndex)) { return nullptr; }
+
+			return &m_vDense[m_vSparse[EntityIndex]];
+		}
+
+		auto Get(ComponentIndexType ComponentIndex) noexcept->ComponentType*
+		{
+			if (ComponentIndex >= m_vDense.size()) { return nullptr; }
+
+			return &m_vDense[ComponentIndex];
+		}
+
+		auto GetCount() const noexcept { return static_cast<uint32_t>(m_vDense.size()); };
+
+		auto& operator[](ComponentIndexType ComponentIndex) noexcept { return m_vDense[ComponentIndex]; };
+		const auto& operator[](ComponentIndexType ComponentIndex) const noexcept { return m_vDense[ComponentIndex]; };
+
+		// For range-based for (packed array)
+		auto begin() noexcept { return m_vDense.begin(); };
+		auto end() noexcept { return m_vDense.end(); };
+		auto begin() const noexcept { return m_vDense.begin(); };
+		auto end() const noexcept { return m_vDense.end(); };
+
+	private:
+		VECTOR<ComponentType>		m_vDense{};
+		VECTOR<ComponentIndexType>	m_vSparse{};
+	};
+
+	inline auto AllPoolsHaveEntity(EntityIndexType) noexcept->bool
+	{
+		return true;
+	}
+
+	template <typename ComponentType, typename... OtherTypes>
+	inline auto AllPoolsHaveEntity(EntityIndexType EntityIndex, const JWComponentPool<ComponentType>& Pool,
+		const JWComponentPool<OtherTypes>&... OtherPools) noexcept->bool
+	{
+		return Pool.HasEntity(EntityIndex) && AllPoolsHaveEntity(EntityIndex, OtherPools...);
+	}
+
+	// ### Multi-component view ###
+	// Calls Function(Primary&, Others&...) for every entity that has all of the components.
+	// The view walks the packed array of Primary (pass the smallest pool first)
+	// and reaches the other components through the sparse arrays, never through JWEntity.
+	// [Begin, End) is a range of Primary's packed array, so views can be split into ParallelFor() chunks.
+	template <typename FunctionType, typename PrimaryType, typename... OtherTypes>
+	inline void ForEachEntityWith(uint32_t Begin, uint32_t End, const FunctionType& Function,
+		JWComponentPool<PrimaryType>& Primary, JWComponentPool<OtherTypes>&... Others) noexcept
+	{
+		End = min(End, Primary.GetCount());
+
+		for (uint32_t i = Begin; i < End; ++i)
+		{
+			auto& primary = Primary[i];
+
+			if (!AllPoolsHaveEntity(primary.EntityIndex, Others...)) { continue; }
+
+			Function(primary, *Others.GetByEntity(primary.EntityIndex)...);
+		}
+	}
+
+	template <typename FunctionType, typename PrimaryType, typename... OtherTypes>
+	inline void ForEachEntityWith(const FunctionType& Function,
+		JWComponentPool<PrimaryType>& Primary, JWComponentPool<OtherTypes>&... Others) noexcept
+	{
+		ForEachEntityWith(0, Primary.GetCount(), Function, Primary, Others...);
+	}
+};
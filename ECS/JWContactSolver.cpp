@@ -0,0 +1,494 @@
+#include "JWContactSolver.h"
+#include "../Core/JWJobSystem.h"
+#include <cfloat>
+
+// No FMA contraction (deterministic physics)
+#pragma fp_contract(off)
+
+using namespace JWEngine;
+
+static inline auto Dot3(const XMVECTOR& A, const XMVECTOR& B) noexcept->float
+{
+	return XMVectorGetX(XMVector3Dot(A, B));
+}
+
+// Orthonormal tangents of a unit normal
+static void GetTangents(const XMVECTOR& Normal, XMVECTOR* OutTangents) noexcept
+{
+	XMFLOAT3 n{};
+	XMStoreFloat3(&n, Normal);
+
+	if (fabsf(n.x) >= 0.57735f)
+	{
+		OutTangents[0] = XMVector3Normalize(XMVectorSet(n.y, -n.x, 0, 0));
+	}
+	else
+	{
+		OutTangents[0] = XMVector3Normalize(XMVectorSet(0, n.z, -n.y, 0));
+	}
+	OutTangents[1] = XMVector3Cross(Normal, OutTangents[0]);
+}
+
+// Area of the quad made of 4 points in any order (the largest of the 3 ways to pair them up as diagonals)
+static inline auto GetQuadArea(const XMVECTOR& P0, const XMVECTOR& P1, const XMVECTOR& P2, const XMVECTOR& P3) noexcept->float
+{
+	auto area_sq_0 = XMVectorGetX(XMVector3LengthSq(XMVector3Cross(P0 - P1, P2 - P3)));
+	auto area_sq_1 = XMVectorGetX(XMVector3LengthSq(XMVector3Cross(P0 - P2, P1 - P3)));
+	auto area_sq_2 = XMVectorGetX(XMVector3LengthSq(XMVector3Cross(P0 - P3, P1 - P2)));
+
+	return 0.5f * sqrtf(max(area_sq_0, max(area_sq_1, area_sq_2)));
+}
+
+static inline auto GetRelativeVelocity(const SSolverBody& A, const SSolverBody& B, const SContactPoint& Point) noexcept->XMVECTOR
+{
+	return (A.LinearVelocity + XMVector3Cross(A.AngularVelocity, Point.RA)) -
+		(B.LinearVelocity + XMVector3Cross(B.AngularVelocity, Point.RB));
+}
+
+// Effective mass along Direction: 1 / (1/mA + 1/mB + (IA^-1 (rA x d) x rA) . d + (IB^-1 (rB x d) x rB) . d)
+static inline auto GetEffectiveMass(const SSolverBody& A, const SSolverBody& B, const SContactPoint& Point,
+	const XMVECTOR& Direction) noexcept->float
+{
+	auto ra_x_d = XMVector3Cross(Point.RA, Direction);
+	auto rb_x_d = XMVector3Cross(Point.RB, Direction);
+	auto k = A.InverseMass + B.InverseMass +
+		Dot3(XMVector3Cross(XMVector3TransformNormal(ra_x_d, A.InverseInertiaWorld), Point.RA), Direction) +
+		Dot3(XMVector3Cross(XMVector3TransformNormal(rb_x_d, B.InverseInertiaWorld), Point.RB), Direction);
+
+	return (k > 0) ? 1.0f / k : 0.0f;
+}
+
+// Impulse is applied to A, and its negation to B.
+// @important: static bodies are never written, because they can be shared by islands that are being solved in parallel.
+static inline void ApplyImpulse(SSolverBody& A, SSolverBody& B, const SContactPoint& Point, const XMVECTOR& Impulse) noexcept
+{
+	if (A.InverseMass > 0)
+	{
+		A.LinearVelocity += Impulse * A.InverseMass;
+		A.AngularVelocity += XMVector3TransformNormal(XMVector3Cross(Point.RA, Impulse), A.InverseInertiaWorld);
+	}
+
+	if (B.InverseMass > 0)
+	{
+		B.LinearVelocity -= Impulse * B.InverseMass;
+		B.AngularVelocity -= XMVector3TransformNormal(XMVector3Cross(Point.RB, Impulse), B.InverseInertiaWorld);
+	}
+}
+
+void JWContactSolver::BeginFrame(uint32_t BodyCount) noexcept
+{
+	m_vPreviousManifolds.swap(m_vManifolds);
+	m_umapPreviousManifoldIndices.swap(m_umapManifoldIndices);
+
+	m_vManifolds.clear();
+	m_umapManifoldIndices.clear();
+
+	m_vIslandParents.clear();
+
+	m_vSolverBodies.resize(BodyCount);
+	for (auto& iter : m_vSolverBodies)
+	{
+		iter.IsInContact = false;
+	}
+}
+
+void JWContactSolver::AddContact(const SContactInput& Input) noexcept
+{
+	// @important
+	// The key must not depend on the order of the pair (which the broad phase may change between frames).
+	auto input{ Input };
+	if (input.EntityA > input.EntityB)
+	{
+		std::swap(input.BodyA, input.BodyB);
+		std::swap(input.EntityA, input.EntityB);
+		std::swap(input.WorldMatrixA, input.WorldMatrixB);
+		std::swap(input.PointA, input.PointB);
+		input.Normal = -input.Normal;
+	}
+	auto key = (static_cast<uint64_t>(input.EntityA) << 32) | static_cast<uint64_t>(input.EntityB);
+
+	// Find the manifold of this frame, or carry over the one of the last frame.
+	SContactManifold* ptr_manifold{};
+	auto find = m_umapManifoldIndices.find(key);
+	if (find != m_umapManifoldIndices.end())
+	{
+		ptr_manifold = &m_vManifolds[find->second];
+	}
+	else
+	{
+		m_umapManifoldIndices.insert(std::make_pair(key, static_cast<uint32_t>(m_vManifolds.size())));
+
+		auto find_previous = m_umapPreviousManifoldIndices.find(key);
+		if (find_previous != m_umapPreviousManifoldIndices.end())
+		{
+			m_vManifolds.emplace_back(m_vPreviousManifolds[find_previous->second]);
+		}
+		else
+		{
+			m_vManifolds.emplace_back();
+			m_vManifolds.back().Key = key;
+		}
+
+		ptr_manifold = &m_vManifolds.back();
+		ptr_manifold->Normal = input.Normal;
+		RefreshContactPoints(*ptr_manifold, input.WorldMatrixA, input.WorldMatrixB);
+	}
+
+	auto& manifold = *ptr_manifold;
+	manifold.BodyA = input.BodyA;
+	manifold.BodyB = input.BodyB;
+	manifold.Normal = input.Normal;
+	manifold.Friction = input.Friction;
+	manifold.Restitution = input.Restitution;
+	GetTangents(manifold.Normal, manifold.Tangents);
+
+	m_vSolverBodies[input.BodyA].IsInContact = true;
+	m_vSolverBodies[input.BodyB].IsInContact = true;
+
+	// @important
+	// Points are saved byte for byte in snapshots, so their padding must be zero too.
+	SContactPoint new_point{};
+	memset(&new_point, 0, sizeof(new_point));
+	new_point.PointA = input.PointA;
+	new_point.PointB = input.PointB;
+	new_point.PenetrationDepth = input.PenetrationDepth;
+	new_point.LocalPointA = XMVector3TransformCoord(input.PointA, XMMatrixInverse(nullptr, input.WorldMatrixA));
+	new_point.LocalPointB = XMVector3TransformCoord(input.PointB, XMMatrixInverse(nullptr, input.WorldMatrixB));
+
+	// Match with a cached point (it keeps its ID and accumulated impulses), or reduce to the best points if full.
+	uint32_t closest_index{};
+	float closest_distance_sq{ FLT_MAX };
+	for (uint32_t i = 0; i < manifold.PointCount; ++i)
+	{
+		auto diff = manifold.Points[i].PointA - new_point.PointA;
+		auto distance_sq = Dot3(diff, diff);
+		if (distance_sq < closest_distance_sq)
+		{
+			closest_index = i;
+			closest_distance_sq = distance_sq;
+		}
+	}
+
+	if ((manifold.PointCount) && (closest_distance_sq <= KContactBreakingThreshold * KContactBreakingThreshold))
+	{
+		auto& matched = manifold.Points[closest_index];
+		new_point.ID = matched.ID;
+		new_point.NormalImpulse = matched.NormalImpulse;
+		new_point.TangentImpulses[0] = matched.TangentImpulses[0];
+		new_point.TangentImpulses[1] = matched.TangentImpulses[1];
+
+		matched = new_point;
+	}
+	else
+	{
+		new_point.ID = m_NextContactID++;
+
+		if (manifold.PointCount < KMaxContactPointCount)
+		{
+			manifold.Points[manifold.PointCount] = new_point;
+			++manifold.PointCount;
+		}
+		else
+		{
+			// @important
+			// The deepest point is always kept, and of the rest the point whose removal leaves the largest contact area
+			// is dropped, so that a resting face keeps its corners instead of its latest points.
+			static_assert(KMaxContactPointCount == 4, "GetQuadArea() reduces to 4 points.");
+
+			SContactPoint candidates[KMaxContactPointCount + 1]{};
+			memcpy(candidates, manifold.Points, sizeof(SContactPoint) * KMaxContactPointCount);
+			candidates[KMaxContactPointCount] = new_point;
+
+			uint32_t deepest_index{};
+			for (uint32_t i = 1; i <= KMaxContactPointCount; ++i)
+			{
+				if (candidates[i].PenetrationDepth > candidates[deepest_index].PenetrationDepth) { deepest_index = i; }
+			}
+
+			uint32_t removed_index{ KMaxContactPointCount };
+			float largest_area{ -1.0f };
+			for (uint32_t removed = 0; removed <= KMaxContactPointCount; ++removed)
+			{
+				if (removed == deepest_index) { continue; }
+
+				XMVECTOR points[KMaxContactPointCount]{};
+				uint32_t point_count{};
+				for (uint32_t i = 0; i <= KMaxContactPointCount; ++i)
+				{
+					if (i != removed) { points[point_count++] = candidates[i].PointA; }
+				}
+
+				auto area = GetQuadArea(points[0], points[1], points[2], points[3]);
+				if (area > largest_area)
+				{
+					removed_index = removed;
+					largest_area = area;
+				}
+			}
+
+			uint32_t point_count{};
+			for (uint32_t i = 0; i <= KMaxContactPointCount; ++i)
+			{
+				if (i != removed_index) { manifold.Points[point_count++] = candidates[i]; }
+			}
+		}
+	}
+}
+
+void JWContactSolver::Solve(JWJobSystem& JobSystem, float DeltaTime) noexcept
+{
+	if (m_vManifolds.empty()) { return; }
+	if (DeltaTime <= 0) { return; }
+
+	BuildIslands();
+
+	// @important
+	// Islands don't share any dynamic body, so each one is solved on its own.
+	JobSystem.ParallelFor(static_cast<uint32_t>(m_vIslands.size()), 1,
+		[this, DeltaTime](uint32_t Begin, uint32_t End)
+		{
+			for (uint32_t i = Begin; i < End; ++i)
+			{
+				SolveIsland(m_vIslands[i], DeltaTime);
+			}
+		});
+}
+
+auto JWContactSolver::GetIslandRoot(ComponentIndexType Body) noexcept->ComponentIndexType
+{
+	// Solve() wasn't called, so every body is an island of its own.
+	if (Body >= static_cast<ComponentIndexType>(m_vIslandParents.size())) { return Body; }
+
+	return FindIslandRoot(Body);
+}
+
+auto JWContactSolver::GetStateSize() const noexcept->uint32_t
+{
+	return static_cast<uint32_t>(KContactSolverStateHeaderSize + sizeof(SContactManifold) * m_vManifolds.size());
+}
+
+STATIC auto JWContactSolver::GetSavedStateSize(const uint8_t* PtrSource) noexcept->uint32_t
+{
+	uint32_t manifold_count{};
+	memcpy(&manifold_count, PtrSource + sizeof(uint32_t), sizeof(uint32_t));
+
+	return static_cast<uint32_t>(KContactSolverStateHeaderSize + sizeof(SContactManifold) * manifold_count);
+}
+
+auto JWContactSolver::SaveState(uint8_t* PtrDest) const noexcept->uint32_t
+{
+	auto manifold_count = static_cast<uint32_t>(m_vManifolds.size());
+	memcpy(PtrDest, &m_NextContactID, sizeof(uint32_t));
+	memcpy(PtrDest + sizeof(uint32_t), &manifold_count, sizeof(uint32_t));
+	if (manifold_count)
+	{
+		memcpy(PtrDest + sizeof(uint32_t) * 2, m_vManifolds.data(), sizeof(SContactManifold) * manifold_count);
+	}
+
+	return GetStateSize();
+}
+
+auto JWContactSolver::RestoreState(const uint8_t* PtrSource) noexcept->uint32_t
+{
+	uint32_t manifold_count{};
+	memcpy(&m_NextContactID, PtrSource, sizeof(uint32_t));
+	memcpy(&manifold_count, PtrSource + sizeof(uint32_t), sizeof(uint32_t));
+
+	// @important
+	// Only the current manifolds are kept, the next BeginFrame() makes them the previous ones.
+	m_vManifolds.resize(manifold_count);
+	if (manifold_count)
+	{
+		memcpy(m_vManifolds.data(), PtrSource + sizeof(uint32_t) * 2, sizeof(SContactManifold) * manifold_count);
+	}
+
+	m_umapManifoldIndices.clear();
+	for (uint32_t i = 0; i < manifold_count; ++i)
+	{
+		m_umapManifoldIndices.insert(std::make_pair(m_vManifolds[i].Key, i));
+	}
+
+	m_vPreviousManifolds.clear();
+	m_umapPreviousManifoldIndices.clear();
+	m_vIslandParents.clear();
+	m_vIslands.clear();
+
+	return GetStateSize();
+}
+
+PRIVATE void JWContactSolver::RefreshContactPoints(SContactManifold& Manifold, const XMMATRIX& WorldMatrixA,
+	const XMMATRIX& WorldMatrixB) noexcept
+{
+	uint32_t kept_count{};
+	for (uint32_t i = 0; i < Manifold.PointCount; ++i)
+	{
+		auto point = Manifold.Points[i];
+		point.PointA = XMVector3TransformCoord(point.LocalPointA, WorldMatrixA);
+		point.PointB = XMVector3TransformCoord(point.LocalPointB, WorldMatrixB);
+
+		// Normal is in b-a direction, so a negative separation means penetration.
+		auto diff = point.PointA - point.PointB;
+		auto separation = Dot3(diff, Manifold.Normal);
+		auto drift = diff - Manifold.Normal * separation;
+
+		if ((separation > KContactBreakingThreshold) ||
+			(Dot3(drift, drift) > KContactBreakingThreshold * KContactBreakingThreshold))
+		{
+			continue;
+		}
+
+		point.PenetrationDepth = -separation;
+		Manifold.Points[kept_count] = point;
+		++kept_count;
+	}
+	Manifold.PointCount = kept_count;
+}
+
+PRIVATE auto JWContactSolver::FindIslandRoot(ComponentIndexType Body) noexcept->ComponentIndexType
+{
+	// Path halving
+	while (m_vIslandParents[Body] != Body)
+	{
+		m_vIslandParents[Body] = m_vIslandParents[m_vIslandParents[Body]];
+		Body = m_vIslandParents[Body];
+	}
+	return Body;
+}
+
+PRIVATE void JWContactSolver::BuildIslands() noexcept
+{
+	auto body_count = static_cast<ComponentIndexType>(m_vSolverBodies.size());
+	m_vIslandParents.resize(body_count);
+	for (ComponentIndexType i = 0; i < body_count; ++i)
+	{
+		m_vIslandParents[i] = i;
+	}
+
+	// @important
+	// Static bodies don't connect islands (they are never written during solving).
+	for (const auto& iter : m_vManifolds)
+	{
+		if ((m_vSolverBodies[iter.BodyA].InverseMass > 0) && (m_vSolverBodies[iter.BodyB].InverseMass > 0))
+		{
+			auto root_a = FindIslandRoot(iter.BodyA);
+			auto root_b = FindIslandRoot(iter.BodyB);
+			if (root_a != root_b)
+			{
+				m_vIslandParents[max(root_a, root_b)] = min(root_a, root_b);
+			}
+		}
+	}
+
+	m_vIslandManifoldIndices.clear();
+	for (uint32_t i = 0; i < static_cast<uint32_t>(m_vManifolds.size()); ++i)
+	{
+		auto& manifold = m_vManifolds[i];
+		if (manifold.PointCount == 0) { continue; }
+
+		if (m_vSolverBodies[manifold.BodyA].InverseMass > 0)
+		{
+			manifold.Island = FindIslandRoot(manifold.BodyA);
+		}
+		else if (m_vSolverBodies[manifold.BodyB].InverseMass > 0)
+		{
+			manifold.Island = FindIslandRoot(manifold.BodyB);
+		}
+		else
+		{
+			// Static vs static
+			continue;
+		}
+
+		m_vIslandManifoldIndices.emplace_back(i);
+	}
+
+	// Group manifolds by island (the order inside an island is kept, so the result is deterministic).
+	std::stable_sort(m_vIslandManifoldIndices.begin(), m_vIslandManifoldIndices.end(),
+		[this](uint32_t a, uint32_t b) { return m_vManifolds[a].Island < m_vManifolds[b].Island; });
+
+	m_vIslands.clear();
+	for (uint32_t i = 0; i < static_cast<uint32_t>(m_vIslandManifoldIndices.size()); ++i)
+	{
+		auto island = m_vManifolds[m_vIslandManifoldIndices[i]].Island;
+		if ((m_vIslands.empty()) || (m_vManifolds[m_vIslandManifoldIndices[m_vIslands.back().Begin]].Island != island))
+		{
+			m_vIslands.emplace_back(i, i);
+		}
+		m_vIslands.back().End = i + 1;
+	}
+}
+
+PRIVATE void JWContactSolver::SolveIsland(const SContactIsland& Island, float DeltaTime) noexcept
+{
+	auto inverse_delta_time = 1.0f / DeltaTime;
+
+	// #1 Prepare constraints and warm start with the impulses of the last frame
+	for (auto i = Island.Begin; i < Island.End; ++i)
+	{
+		auto& manifold = m_vManifolds[m_vIslandManifoldIndices[i]];
+		auto& a = m_vSolverBodies[manifold.BodyA];
+		auto& b = m_vSolverBodies[manifold.BodyB];
+
+		for (uint32_t j = 0; j < manifold.PointCount; ++j)
+		{
+			auto& point = manifold.Points[j];
+			auto contact_point = (point.PointA + point.PointB) * 0.5f;
+			point.RA = contact_point - a.Position;
+			point.RB = contact_point - b.Position;
+
+			point.NormalMass = GetEffectiveMass(a, b, point, manifold.Normal);
+			point.TangentMasses[0] = GetEffectiveMass(a, b, point, manifold.Tangents[0]);
+			point.TangentMasses[1] = GetEffectiveMass(a, b, point, manifold.Tangents[1]);
+
+			// Penetration is corrected through velocity (Baumgarte), positions are never moved directly.
+			point.Bias = KContactBaumgarteFactor * inverse_delta_time * max(point.PenetrationDepth - KContactPenetrationSlop, 0.0f);
+
+			auto normal_speed = Dot3(GetRelativeVelocity(a, b, point), manifold.Normal);
+			if (-normal_speed > KRestitutionVelocityThreshold)
+			{
+				point.Bias = max(point.Bias, -manifold.Restitution * normal_speed);
+			}
+
+			auto warm_start_impulse = manifold.Normal * point.NormalImpulse +
+				manifold.Tangents[0] * point.TangentImpulses[0] + manifold.Tangents[1] * point.TangentImpulses[1];
+			ApplyImpulse(a, b, point, warm_start_impulse);
+		}
+	}
+
+	// #2 Iterate
+	for (uint32_t iteration = 0; iteration < m_IterationCount; ++iteration)
+	{
+		for (auto i = Island.Begin; i < Island.End; ++i)
+		{
+			auto& manifold = m_vManifolds[m_vIslandManifoldIndices[i]];
+			auto& a = m_vSolverBodies[manifold.BodyA];
+			auto& b = m_vSolverBodies[manifold.BodyB];
+
+			for (uint32_t j = 0; j < manifold.PointCount; ++j)
+			{
+				auto& point = manifold.Points[j];
+
+				// Friction (Coulomb cone approximated by two clamped directions)
+				auto max_friction = manifold.Friction * point.NormalImpulse;
+				for (uint32_t k = 0; k < 2; ++k)
+				{
+					const auto& tangent = manifold.Tangents[k];
+					auto tangent_speed = Dot3(GetRelativeVelocity(a, b, point), tangent);
+					auto lambda = -tangent_speed * point.TangentMasses[k];
+
+					auto old_impulse = point.TangentImpulses[k];
+					point.TangentImpulses[k] = max(-max_friction, min(old_impulse + lambda, max_friction));
+					ApplyImpulse(a, b, point, tangent * (point.TangentImpulses[k] - old_impulse));
+				}
+
+				// Non-penetration (accumulated impulse is clamped, not each delta)
+				auto normal_speed = Dot3(GetRelativeVelocity(a, b, point), manifold.Normal);
+				auto lambda = point.NormalMass * (-normal_speed + point.Bias);
+
+				auto old_impulse = point.NormalImpulse;
+				point.NormalImpulse = max(old_impulse + lambda, 0.0f);
+				ApplyImpulse(a, b, point, manifold.Normal * (point.NormalImpulse - old_impulse));
+			}
+		}
+	}
+}
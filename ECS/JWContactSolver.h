@@ -0,0 +1,190 @@
+#pragma once
+
+#include "../Core/JWCommon.h"
+
+namespace JWEngine
+{
+	class JWJobSystem;
+
+	static constexpr uint32_t	KMaxContactPointCount{ 4 };
+	static constexpr uint32_t	KDefaultContactSolverIterationCount{ 8 };
+
+	// Fraction of the penetration that is corrected per step (as velocity, never by moving positions).
+	static constexpr float		KContactBaumgarteFactor{ 0.2f };
+
+	// [Unit]	m
+	// Penetration that is allowed to remain, so that resting contacts don't jitter.
+	static constexpr float		KContactPenetrationSlop{ 0.005f };
+
+	// [Unit]	m
+	// Cached contact points that drift further than this (along or across the normal) are dropped.
+	static constexpr float		KContactBreakingThreshold{ 0.02f };
+
+	// [Unit]	m/s
+	// Restitution is ignored below this closing speed, so that resting contacts don't bounce.
+	static constexpr float		KRestitutionVelocityThreshold{ 1.0f };
+
+	// Saved state = next contact ID + manifold count + manifolds
+	static constexpr uint32_t	KContactSolverStateHeaderSize{ sizeof(uint32_t) * 2 };
+
+	// Velocities and mass properties of a physics component during solving (indexed by component index).
+	struct SSolverBody
+	{
+		XMVECTOR	LinearVelocity{};
+		XMVECTOR	AngularVelocity{};
+
+		// Center of mass in world space
+		XMVECTOR	Position{};
+
+		// Zero for static (infinite-mass) bodies
+		float		InverseMass{};
+		XMMATRIX	InverseInertiaWorld{};
+
+		// Set when the body is in any manifold, only these are written back.
+		bool		IsInContact{};
+	};
+
+	struct SContactPoint
+	{
+		// Persistent across frames while the point is matched (see JWContactSolver::AddContact())
+		uint32_t	ID{};
+
+		// For refreshing the cached point with the bodies' new world matrices
+		XMVECTOR	LocalPointA{};
+		XMVECTOR	LocalPointB{};
+
+		XMVECTOR	PointA{};
+		XMVECTOR	PointB{};
+		float		PenetrationDepth{};
+
+		// Accumulated impulses (warm starting)
+		float		NormalImpulse{};
+		float		TangentImpulses[2]{};
+
+		// Solver data
+		XMVECTOR	RA{};
+		XMVECTOR	RB{};
+		float		NormalMass{};
+		float		TangentMasses[2]{};
+		float		Bias{};
+	};
+
+	// Up to KMaxContactPointCount points of one body pair, kept across frames.
+	// (The narrow phase gives one point per pair per frame, the manifold accumulates them.)
+	struct SContactManifold
+	{
+		uint64_t			Key{};
+		ComponentIndexType	BodyA{};
+		ComponentIndexType	BodyB{};
+
+		// @important: in b-a direction, same as SCollisionData::CollisionNormal.
+		XMVECTOR			Normal{};
+		XMVECTOR			Tangents[2]{};
+
+		float				Friction{};
+		float				Restitution{};
+
+		SContactPoint		Points[KMaxContactPointCount]{};
+		uint32_t			PointCount{};
+
+		// Root body of the island
+		ComponentIndexType	Island{};
+	};
+
+	struct SContactIsland
+	{
+		SContactIsland() {};
+		SContactIsland(uint32_t _Begin, uint32_t _End) : Begin{ _Begin }, End{ _End } {};
+
+		// Range of JWContactSolver::m_vIslandManifoldIndices
+		uint32_t	Begin{};
+		uint32_t	End{};
+	};
+
+	struct SContactInput
+	{
+		ComponentIndexType	BodyA{};
+		ComponentIndexType	BodyB{};
+		EntityHandleType	EntityA{ KInvalidEntityHandle };
+		EntityHandleType	EntityB{ KInvalidEntityHandle };
+
+		XMMATRIX			WorldMatrixA{};
+		XMMATRIX			WorldMatrixB{};
+
+		// In b-a direction
+		XMVECTOR			Normal{};
+		XMVECTOR			PointA{};
+		XMVECTOR			PointB{};
+		float				PenetrationDepth{};
+
+		float				Friction{};
+		float				Restitution{};
+	};
+
+	// Sequential-impulse contact solver.
+	// Bodies that touch each other (through non-static bodies) form an island,
+	// islands don't share any dynamic body, so they are solved in parallel.
+	// @important: JWContactSolver doesn't know about entities or transforms,
+	// so it can be driven (and measured) without JWECS.
+	class JWContactSolver
+	{
+	public:
+		JWContactSolver() = default;
+		~JWContactSolver() = default;
+
+		// Manifolds that don't get any contact in this frame are dropped.
+		void BeginFrame(uint32_t BodyCount) noexcept;
+
+		auto GetSolverBodies() noexcept->VECTOR<SSolverBody>& { return m_vSolverBodies; };
+
+		void AddContact(const SContactInput& Input) noexcept;
+
+		void Solve(JWJobSystem& JobSystem, float DeltaTime) noexcept;
+
+		void SetIterationCount(uint32_t IterationCount) noexcept { m_IterationCount = max(IterationCount, (uint32_t)1); };
+		auto GetIterationCount() const noexcept { return m_IterationCount; };
+
+		auto GetManifoldCount() const noexcept { return static_cast<uint32_t>(m_vManifolds.size()); };
+		auto GetIslandCount() const noexcept { return static_cast<uint32_t>(m_vIslands.size()); };
+		const auto& GetManifolds() const noexcept { return m_vManifolds; };
+
+		// Bodies with the same root are in the same island. (Valid after Solve() until the next BeginFrame())
+		auto GetIslandRoot(ComponentIndexType Body) noexcept->ComponentIndexType;
+
+		// ### State ###
+		// Contact cache that the next frame starts from (warm starting, contact IDs).
+		// Manifolds are trivially copyable, so the state is written as raw bytes.
+		auto GetStateSize() const noexcept->uint32_t;
+
+		// Size of a saved state, read from its first KContactSolverStateHeaderSize bytes.
+		static auto GetSavedStateSize(const uint8_t* PtrSource) noexcept->uint32_t;
+
+		// Returns the number of bytes written/read.
+		auto SaveState(uint8_t* PtrDest) const noexcept->uint32_t;
+		auto RestoreState(const uint8_t* PtrSource) noexcept->uint32_t;
+
+	private:
+		void RefreshContactPoints(SContactManifold& Manifold, const XMMATRIX& WorldMatrixA, const XMMATRIX& WorldMatrixB) noexcept;
+
+		auto FindIslandRoot(ComponentIndexType Body) noexcept->ComponentIndexType;
+		void BuildIslands() noexcept;
+		void SolveIsland(const SContactIsland& Island, float DeltaTime) noexcept;
+
+	private:
+		uint32_t						m_IterationCount{ KDefaultContactSolverIterationCount };
+		uint32_t						m_NextContactID{};
+
+		VECTOR<SSolverBody>				m_vSolverBodies{};
+
+		// Manifolds of this frame and of the last frame (key -> index)
+		VECTOR<SContactManifold>		m_vManifolds{};
+		VECTOR<SContactManifold>		m_vPreviousManifolds{};
+		UNORDERED_MAP<uint64_t, uint32_t>	m_umapManifoldIndices{};
+		UNORDERED_MAP<uint64_t, uint32_t>	m_umapPreviousManifoldIndices{};
+
+		// Union-find
+		VECTOR<ComponentIndexType>		m_vIslandParents{};
+		VECTOR<uint32_t>				m_vIslandManifoldIndices{};
+		VECTOR<SContactIsland>			m_vIslands{};
+	};
+};
@@ -0,0 +1,528 @@
+#include "JWDynamicAABBTree.h"
+#include "../Core/JWJobSystem.h"
+
+using namespace JWEngine;
+
+static inline auto IsSphereOverlappingAABB(const XMFLOAT3& Center, float Radius, const SAABB& AABB) noexcept->bool
+{
+	return !((Center.x + Radius < AABB.Min.x) || (Center.x - Radius > AABB.Max.x) ||
+		(Center.y + Radius < AABB.Min.y) || (Center.y - Radius > AABB.Max.y) ||
+		(Center.z + Radius < AABB.Min.z) || (Center.z - Radius > AABB.Max.z));
+}
+
+// The box is outside if its vertex farthest along the plane normal is behind the plane.
+static inline auto IsAABBOutsideFrustum(const SSceneFrustumQuery& Frustum, const SAABB& AABB) noexcept->bool
+{
+	auto box_min = XMLoadFloat3(&AABB.Min);
+	auto box_max = XMLoadFloat3(&AABB.Max);
+	for (const auto& plane : Frustum.Planes)
+	{
+		auto farthest = XMVectorSelect(box_min, box_max, XMVectorGreater(plane, KVectorZero));
+		if (XMVectorGetX(XMPlaneDotCoord(plane, farthest)) < 0) { return true; }
+	}
+	return false;
+}
+
+static inline auto IsSphereOutsideFrustum(const SSceneFrustumQuery& Frustum, const XMFLOAT3& Center, float Radius) noexcept->bool
+{
+	auto center = XMLoadFloat3(&Center);
+	for (const auto& plane : Frustum.Planes)
+	{
+		if (XMVectorGetX(XMPlaneDotCoord(plane, center)) < -Radius) { return true; }
+	}
+	return false;
+}
+
+auto JWDynamicAABBTree::CreateProxy(const XMVECTOR& Center, float Radius, uint32_t UserData) noexcept->uint32_t
+{
+	auto leaf_id = AllocateNode();
+	auto& leaf = m_vNodes[leaf_id];
+
+	XMStoreFloat3(&leaf.Center, Center);
+	leaf.Radius = Radius;
+	leaf.UserData = UserData;
+	leaf.Height = 0;
+	leaf.AABB = MakeAABB(leaf.Center, Radius + KAABBTreeMargin);
+
+	InsertLeaf(leaf_id);
+	++m_ProxyCount;
+
+	return leaf_id;
+}
+
+void JWDynamicAABBTree::DestroyProxy(uint32_t ProxyID) noexcept
+{
+	assert(ProxyID < m_vNodes.size());
+	assert(m_vNodes[ProxyID].IsLeaf());
+
+	RemoveLeaf(ProxyID);
+	FreeNode(ProxyID);
+	--m_ProxyCount;
+}
+
+auto JWDynamicAABBTree::MoveProxy(uint32_t ProxyID, const XMVECTOR& Center, float Radius) noexcept->bool
+{
+	assert(ProxyID < m_vNodes.size());
+	assert(m_vNodes[ProxyID].IsLeaf());
+
+	auto& leaf = m_vNodes[ProxyID];
+	XMStoreFloat3(&leaf.Center, Center);
+	leaf.Radius = Radius;
+
+	// @important
+	// Exact spheres are always updated (queries test them), the tree only when the fat AABB is left.
+	if (Contains(leaf.AABB, MakeAABB(leaf.Center, Radius))) { return false; }
+
+	RemoveLeaf(ProxyID);
+	m_vNodes[ProxyID].AABB = MakeAABB(m_vNodes[ProxyID].Center, Radius + KAABBTreeMargin);
+	InsertLeaf(ProxyID);
+
+	return true;
+}
+
+auto JWDynamicAABBTree::RayCast(const SSceneRayQuery& Query, SSceneRayHit& OutHit) const noexcept->bool
+{
+	OutHit = SSceneRayHit();
+
+	if (m_RootID == KInvalidAABBTreeNodeID) { return false; }
+
+	XMFLOAT3 origin{};
+	XMFLOAT3 inverse_direction{};
+	XMStoreFloat3(&origin, Query.Origin);
+	XMStoreFloat3(&inverse_direction, XMVectorReciprocal(Query.Direction));
+
+	// Nodes farther than the closest hit so far are skipped.
+	auto closest_t = XMVectorReplicate(Query.MaxT);
+
+	SAABBTreeStack stack{};
+	stack.Push(m_RootID);
+	while (!stack.IsEmpty())
+	{
+		const auto& node = m_vNodes[stack.Pop()];
+		if (!IntersectRayAABB(origin, inverse_direction, XMVectorGetX(closest_t), node.AABB)) { continue; }
+
+		if (node.IsLeaf())
+		{
+			if (IntersectRaySphere(Query.Origin, Query.Direction, node.Radius, XMLoadFloat3(&node.Center), &closest_t))
+			{
+				OutHit.IsHit = true;
+				OutHit.UserData = node.UserData;
+				OutHit.T = XMVectorGetX(closest_t);
+			}
+			continue;
+		}
+
+		stack.Push(node.Child0);
+		stack.Push(node.Child1);
+	}
+
+	return OutHit.IsHit;
+}
+
+void JWDynamicAABBTree::QuerySphere(const SSceneSphereQuery& Query, VECTOR<uint32_t>& OutUserData) const noexcept
+{
+	if (m_RootID == KInvalidAABBTreeNodeID) { return; }
+
+	XMFLOAT3 center{};
+	XMStoreFloat3(&center, Query.Center);
+
+	SAABBTreeStack stack{};
+	stack.Push(m_RootID);
+	while (!stack.IsEmpty())
+	{
+		const auto& node = m_vNodes[stack.Pop()];
+		if (!IsSphereOverlappingAABB(center, Query.Radius, node.AABB)) { continue; }
+
+		if (node.IsLeaf())
+		{
+			auto distance_sq = XMVectorGetX(XMVector3LengthSq(XMLoadFloat3(&node.Center) - Query.Center));
+			auto radius_sum = node.Radius + Query.Radius;
+			if (distance_sq <= radius_sum * radius_sum)
+			{
+				OutUserData.emplace_back(node.UserData);
+			}
+			continue;
+		}
+
+		stack.Push(node.Child0);
+		stack.Push(node.Child1);
+	}
+}
+
+void JWDynamicAABBTree::QueryFrustum(const SSceneFrustumQuery& Query, VECTOR<uint32_t>& OutUserData) const noexcept
+{
+	if (m_RootID == KInvalidAABBTreeNodeID) { return; }
+
+	SAABBTreeStack stack{};
+	stack.Push(m_RootID);
+	while (!stack.IsEmpty())
+	{
+		const auto& node = m_vNodes[stack.Pop()];
+		if (IsAABBOutsideFrustum(Query, node.AABB)) { continue; }
+
+		if (node.IsLeaf())
+		{
+			if (!IsSphereOutsideFrustum(Query, node.Center, node.Radius))
+			{
+				OutUserData.emplace_back(node.UserData);
+			}
+			continue;
+		}
+
+		stack.Push(node.Child0);
+		stack.Push(node.Child1);
+	}
+}
+
+void JWDynamicAABBTree::RayCastBatch(JWJobSystem& JobSystem, const VECTOR<SSceneRayQuery>& Queries, VECTOR<SSceneRayHit>& OutHits) noexcept
+{
+	auto start_time = STEADY_CLOCK::now();
+
+	OutHits.resize(Queries.size());
+	JobSystem.ParallelFor(static_cast<uint32_t>(Queries.size()), KSceneQueryBatchMinChunkSize,
+		[&](uint32_t Begin, uint32_t End)
+		{
+			for (uint32_t i = Begin; i < End; ++i)
+			{
+				RayCast(Queries[i], OutHits[i]);
+			}
+		});
+
+	m_LastBatchQueryCount = static_cast<uint32_t>(Queries.size());
+	m_LastBatchTime = std::chrono::duration_cast<TIME_UNIT_mS>(STEADY_CLOCK::now() - start_time).count();
+}
+
+void JWDynamicAABBTree::QuerySphereBatch(JWJobSystem& JobSystem, const VECTOR<SSceneSphereQuery>& Queries,
+	VECTOR<VECTOR<uint32_t>>& OutResults) noexcept
+{
+	auto start_time = STEADY_CLOCK::now();
+
+	OutResults.resize(Queries.size());
+	JobSystem.ParallelFor(static_cast<uint32_t>(Queries.size()), KSceneQueryBatchMinChunkSize,
+		[&](uint32_t Begin, uint32_t End)
+		{
+			for (uint32_t i = Begin; i < End; ++i)
+			{
+				OutResults[i].clear();
+				QuerySphere(Queries[i], OutResults[i]);
+			}
+		});
+
+	m_LastBatchQueryCount = static_cast<uint32_t>(Queries.size());
+	m_LastBatchTime = std::chrono::duration_cast<TIME_UNIT_mS>(STEADY_CLOCK::now() - start_time).count();
+}
+
+void JWDynamicAABBTree::QueryFrustumBatch(JWJobSystem& JobSystem, const VECTOR<SSceneFrustumQuery>& Queries,
+	VECTOR<VECTOR<uint32_t>>& OutResults) noexcept
+{
+	auto start_time = STEADY_CLOCK::now();
+
+	OutResults.resize(Queries.size());
+	JobSystem.ParallelFor(static_cast<uint32_t>(Queries.size()), 1,
+		[&](uint32_t Begin, uint32_t End)
+		{
+			for (uint32_t i = Begin; i < End; ++i)
+			{
+				OutResults[i].clear();
+				QueryFrustum(Queries[i], OutResults[i]);
+			}
+		});
+
+	m_LastBatchQueryCount = static_cast<uint32_t>(Queries.size());
+	m_LastBatchTime = std::chrono::duration_cast<TIME_UNIT_mS>(STEADY_CLOCK::now() - start_time).count();
+}
+
+auto JWDynamicAABBTree::GetLastBatchQueriesPerSecond() const noexcept->double
+{
+	if (m_LastBatchTime <= 0) { return 0; }
+
+	// m_LastBatchTime is in microseconds
+	return static_cast<double>(m_LastBatchQueryCount) * 1000000.0 / static_cast<double>(m_LastBatchTime);
+}
+
+PRIVATE auto JWDynamicAABBTree::AllocateNode() noexcept->uint32_t
+{
+	if (m_FreeListID == KInvalidAABBTreeNodeID)
+	{
+		m_vNodes.emplace_back();
+		return static_cast<uint32_t>(m_vNodes.size() - 1);
+	}
+
+	auto node_id = m_FreeListID;
+	m_FreeListID = m_vNodes[node_id].Parent;
+	m_vNodes[node_id] = SAABBTreeNode();
+	return node_id;
+}
+
+PRIVATE void JWDynamicAABBTree::FreeNode(uint32_t NodeID) noexcept
+{
+	m_vNodes[NodeID] = SAABBTreeNode();
+	m_vNodes[NodeID].Parent = m_FreeListID;
+	m_FreeListID = NodeID;
+}
+
+PRIVATE void JWDynamicAABBTree::InsertLeaf(uint32_t LeafID) noexcept
+{
+	if (m_RootID == KInvalidAABBTreeNodeID)
+	{
+		m_RootID = LeafID;
+		m_vNodes[LeafID].Parent = KInvalidAABBTreeNodeID;
+		return;
+	}
+
+	// #1 Find the best sibling (surface area heuristic)
+	auto leaf_aabb = m_vNodes[LeafID].AABB;
+	auto sibling_id = m_RootID;
+	while (!m_vNodes[sibling_id].IsLeaf())
+	{
+		const auto& node = m_vNodes[sibling_id];
+		auto area = GetSurfaceArea(node.AABB);
+		auto combined_area = GetSurfaceArea(Union(node.AABB, leaf_aabb));
+
+		// Cost of making a new parent of this node and the leaf
+		auto cost = 2.0f * combined_area;
+
+		// Minimum cost of pushing the leaf further down
+		auto inheritance_cost = 2.0f * (combined_area - area);
+		auto get_child_cost = [&](uint32_t ChildID)
+		{
+			const auto& child = m_vNodes[ChildID];
+			auto child_combined_area = GetSurfaceArea(Union(child.AABB, leaf_aabb));
+			if (child.IsLeaf()) { return child_combined_area + inheritance_cost; }
+			return child_combined_area - GetSurfaceArea(child.AABB) + inheritance_cost;
+		};
+		auto cost_0 = get_child_cost(node.Child0);
+		auto cost_1 = get_child_cost(node.Child1);
+
+		if ((cost < cost_0) && (cost < cost_1)) { break; }
+
+		sibling_id = (cost_0 < cost_1) ? node.Child0 : node.Child1;
+	}
+
+	// #2 New parent
+	// @important: AllocateNode() may reallocate m_vNodes, so no reference is kept across it.
+	auto old_parent_id = m_vNodes[sibling_id].Parent;
+	auto new_parent_id = AllocateNode();
+	{
+		auto& new_parent = m_vNodes[new_parent_id];
+		new_parent.Parent = old_parent_id;
+		new_parent.AABB = Union(leaf_aabb, m_vNodes[sibling_id].AABB);
+		new_parent.Height = m_vNodes[sibling_id].Height + 1;
+		new_parent.Child0 = sibling_id;
+		new_parent.Child1 = LeafID;
+	}
+
+	if (old_parent_id != KInvalidAABBTreeNodeID)
+	{
+		auto& old_parent = m_vNodes[old_parent_id];
+		if (old_parent.Child0 == sibling_id)
+		{
+			old_parent.Child0 = new_parent_id;
+		}
+		else
+		{
+			old_parent.Child1 = new_parent_id;
+		}
+	}
+	else
+	{
+		m_RootID = new_parent_id;
+	}
+	m_vNodes[sibling_id].Parent = new_parent_id;
+	m_vNodes[LeafID].Parent = new_parent_id;
+
+	// #3 Refit ancestors
+	Refit(new_parent_id);
+}
+
+PRIVATE void JWDynamicAABBTree::RemoveLeaf(uint32_t LeafID) noexcept
+{
+	if (LeafID == m_RootID)
+	{
+		m_RootID = KInvalidAABBTreeNodeID;
+		return;
+	}
+
+	auto parent_id = m_vNodes[LeafID].Parent;
+	auto grand_parent_id = m_vNodes[parent_id].Parent;
+	auto sibling_id = (m_vNodes[parent_id].Child0 == LeafID) ? m_vNodes[parent_id].Child1 : m_vNodes[parent_id].Child0;
+
+	if (grand_parent_id != KInvalidAABBTreeNodeID)
+	{
+		// The sibling takes the parent's place.
+		auto& grand_parent = m_vNodes[grand_parent_id];
+		if (grand_parent.Child0 == parent_id)
+		{
+			grand_parent.Child0 = sibling_id;
+		}
+		else
+		{
+			grand_parent.Child1 = sibling_id;
+		}
+		m_vNodes[sibling_id].Parent = grand_parent_id;
+		FreeNode(parent_id);
+
+		Refit(grand_parent_id);
+	}
+	else
+	{
+		m_RootID = sibling_id;
+		m_vNodes[sibling_id].Parent = KInvalidAABBTreeNodeID;
+		FreeNode(parent_id);
+	}
+
+	m_vNodes[LeafID].Parent = KInvalidAABBTreeNodeID;
+}
+
+PRIVATE void JWDynamicAABBTree::Refit(uint32_t NodeID) noexcept
+{
+	while (NodeID != KInvalidAABBTreeNodeID)
+	{
+		NodeID = Balance(NodeID);
+
+		auto& node = m_vNodes[NodeID];
+		const auto& child_0 = m_vNodes[node.Child0];
+		const auto& child_1 = m_vNodes[node.Child1];
+		node.Height = 1 + max(child_0.Height, child_1.Height);
+		node.AABB = Union(child_0.AABB, child_1.AABB);
+
+		NodeID = node.Parent;
+	}
+}
+
+// Rotates the taller child up if the children's heights differ by more than 1.
+// Returns the node that took the place of NodeID.
+PRIVATE auto JWDynamicAABBTree::Balance(uint32_t NodeID) noexcept->uint32_t
+{
+	auto& a = m_vNodes[NodeID];
+	if ((a.IsLeaf()) || (a.Height < 2)) { return NodeID; }
+
+	auto b_id = a.Child0;
+	auto c_id = a.Child1;
+	auto& b = m_vNodes[b_id];
+	auto& c = m_vNodes[c_id];
+
+	auto balance = c.Height - b.Height;
+
+	// Rotate c up
+	if (balance > 1)
+	{
+		auto f_id = c.Child0;
+		auto g_id = c.Child1;
+		auto& f = m_vNodes[f_id];
+		auto& g = m_vNodes[g_id];
+
+		c.Child0 = NodeID;
+		c.Parent = a.Parent;
+		a.Parent = c_id;
+
+		if (c.Parent != KInvalidAABBTreeNodeID)
+		{
+			auto& parent = m_vNodes[c.Parent];
+			if (parent.Child0 == NodeID) { parent.Child0 = c_id; } else { parent.Child1 = c_id; }
+		}
+		else
+		{
+			m_RootID = c_id;
+		}
+
+		if (f.Height > g.Height)
+		{
+			c.Child1 = f_id;
+			a.Child1 = g_id;
+			g.Parent = NodeID;
+			a.AABB = Union(b.AABB, g.AABB);
+			c.AABB = Union(a.AABB, f.AABB);
+			a.Height = 1 + max(b.Height, g.Height);
+			c.Height = 1 + max(a.Height, f.Height);
+		}
+		else
+		{
+			c.Child1 = g_id;
+			a.Child1 = f_id;
+			f.Parent = NodeID;
+			a.AABB = Union(b.AABB, f.AABB);
+			c.AABB = Union(a.AABB, g.AABB);
+			a.Height = 1 + max(b.Height, f.Height);
+			c.Height = 1 + max(a.Height, g.Height);
+		}
+
+		return c_id;
+	}
+
+	// Rotate b up
+	if (balance < -1)
+	{
+		auto d_id = b.Child0;
+		auto e_id = b.Child1;
+		auto& d = m_vNodes[d_id];
+		auto& e = m_vNodes[e_id];
+
+		b.Child0 = NodeID;
+		b.Parent = a.Parent;
+		a.Parent = b_id;
+
+		if (b.Parent != KInvalidAABBTreeNodeID)
+		{
+			auto& parent = m_vNodes[b.Parent];
+			if (parent.Child0 == NodeID) { parent.Child0 = b_id; } else { parent.Child1 = b_id; }
+		}
+		else
+		{
+			m_RootID = b_id;
+		}
+
+		if (d.Height > e.Height)
+		{
+			b.Child1 = d_id;
+			a.Child0 = e_id;
+			e.Parent = NodeID;
+			a.AABB = Union(c.AABB, e.AABB);
+			b.AABB = Union(a.AABB, d.AABB);
+			a.Height = 1 + max(c.Height, e.Height);
+			b.Height = 1 + max(a.Height, d.Height);
+		}
+		else
+		{
+			b.Child1 = e_id;
+			a.Child0 = d_id;
+			d.Parent = NodeID;
+			a.AABB = Union(c.AABB, d.AABB);
+			b.AABB = Union(a.AABB, e.AABB);
+			a.Height = 1 + max(c.Height, d.Height);
+			b.Height = 1 + max(a.Height, e.Height);
+		}
+
+		return b_id;
+	}
+
+	return NodeID;
+}
+
+PRIVATE auto JWDynamicAABBTree::Union(const SAABB& A, const SAABB& B) noexcept->SAABB
+{
+	return SAABB(
+		XMFLOAT3(min(A.Min.x, B.Min.x), min(A.Min.y, B.Min.y), min(A.Min.z, B.Min.z)),
+		XMFLOAT3(max(A.Max.x, B.Max.x), max(A.Max.y, B.Max.y), max(A.Max.z, B.Max.z)));
+}
+
+PRIVATE auto JWDynamicAABBTree::GetSurfaceArea(const SAABB& AABB) noexcept->float
+{
+	auto dx = AABB.Max.x - AABB.Min.x;
+	auto dy = AABB.Max.y - AABB.Min.y;
+	auto dz = AABB.Max.z - AABB.Min.z;
+	return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+PRIVATE auto JWDynamicAABBTree::Contains(const SAABB& Outer, const SAABB& Inner) noexcept->bool
+{
+	return (Outer.Min.x <= Inner.Min.x) && (Outer.Min.y <= Inner.Min.y) && (Outer.Min.z <= Inner.Min.z) &&
+		(Inner.Max.x <= Outer.Max.x) && (Inner.Max.y <= Outer.Max.y) && (Inner.Max.z <= Outer.Max.z);
+}
+
+PRIVATE auto JWDynamicAABBTree::MakeAABB(const XMFLOAT3& Center, float Radius) noexcept->SAABB
+{
+	return SAABB(
+		XMFLOAT3(Center.x - Radius, Center.y - Radius, Center.z - Radius),
+		XMFLOAT3(Center.x + Radius, Center.y + Radius, Center.z + Radius));
+}
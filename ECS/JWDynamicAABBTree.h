@@ -0,0 +1,246 @@
+#pragma once
+
+#include "../Core/JWCommon.h"
+#include "../Core/JWMath.h"
+#include <cfloat>
+
+namespace JWEngine
+{
+	class JWJobSystem;
+
+	static constexpr uint32_t	KInvalidAABBTreeNodeID{ UINT32_MAX };
+
+	// [Unit]	m
+	// Leaf AABBs are fattened by this, so that small motions don't change the tree.
+	static constexpr float		KAABBTreeMargin{ 0.1f };
+
+	// Inline depth of the traversal stack (the tree is kept balanced, so it's rarely exceeded).
+	static constexpr uint32_t	KAABBTreeStackSize{ 128 };
+
+	// Queries per ParallelFor() chunk in the batched queries
+	static constexpr uint32_t	KSceneQueryBatchMinChunkSize{ 16 };
+
+	struct SAABB
+	{
+		SAABB() {};
+		SAABB(const XMFLOAT3& _Min, const XMFLOAT3& _Max) : Min{ _Min }, Max{ _Max } {};
+
+		XMFLOAT3	Min{};
+		XMFLOAT3	Max{};
+	};
+
+	// Traversal stack, spills into the heap only past KAABBTreeStackSize entries.
+	struct SAABBTreeStack
+	{
+		void Push(uint32_t NodeID) noexcept
+		{
+			if (Size < KAABBTreeStackSize)
+			{
+				Inline[Size] = NodeID;
+			}
+			else
+			{
+				vOverflow.emplace_back(NodeID);
+			}
+			++Size;
+		}
+
+		auto Pop() noexcept->uint32_t
+		{
+			--Size;
+			if (Size < KAABBTreeStackSize) { return Inline[Size]; }
+
+			auto node_id = vOverflow.back();
+			vOverflow.pop_back();
+			return node_id;
+		}
+
+		auto IsEmpty() const noexcept { return (Size == 0); };
+
+		uint32_t			Inline[KAABBTreeStackSize];
+		uint32_t			Size{};
+		VECTOR<uint32_t>	vOverflow{};
+	};
+
+	struct SAABBTreeNode
+	{
+		SAABB		AABB{};
+
+		// Next free node if the node is free
+		uint32_t	Parent{ KInvalidAABBTreeNodeID };
+		uint32_t	Child0{ KInvalidAABBTreeNodeID };
+		uint32_t	Child1{ KInvalidAABBTreeNodeID };
+
+		// Leaf = 0, free = -1
+		int32_t		Height{ -1 };
+
+		// Leaf only (the exact bounding sphere, the AABB is the fat one)
+		uint32_t	UserData{};
+		XMFLOAT3	Center{};
+		float		Radius{};
+
+		auto IsLeaf() const noexcept { return (Child0 == KInvalidAABBTreeNodeID); };
+	};
+
+	struct SSceneRayQuery
+	{
+		SSceneRayQuery() {};
+		SSceneRayQuery(const XMVECTOR& _Origin, const XMVECTOR& _Direction, float _MaxT = FLT_MAX) :
+			Origin{ _Origin }, Direction{ _Direction }, MaxT{ _MaxT } {};
+
+		XMVECTOR	Origin{};
+
+		// T is in units of Direction (it doesn't need to be normalized).
+		XMVECTOR	Direction{};
+		float		MaxT{ FLT_MAX };
+	};
+
+	struct SSceneRayHit
+	{
+		bool		IsHit{};
+		uint32_t	UserData{};
+		float		T{};
+	};
+
+	struct SSceneSphereQuery
+	{
+		SSceneSphereQuery() {};
+		SSceneSphereQuery(const XMVECTOR& _Center, float _Radius) : Center{ _Center }, Radius{ _Radius } {};
+
+		XMVECTOR	Center{};
+		float		Radius{};
+	};
+
+	// Planes are (a, b, c, d) with inward normals, so a point is inside if Dot(N, P) + d >= 0 for every plane.
+	struct SSceneFrustumQuery
+	{
+		XMVECTOR	Planes[6]{};
+	};
+
+	// Dynamic AABB tree (incremental insertion with the surface area heuristic, AVL-like rotations).
+	// Leaves carry a bounding sphere and user data, queries are tested against the spheres in the end.
+	// @important
+	// Queries don't modify the tree, so any number of them can run at the same time,
+	// but not while proxies are created, moved or destroyed.
+	class JWDynamicAABBTree
+	{
+	public:
+		JWDynamicAABBTree() = default;
+		~JWDynamicAABBTree() = default;
+
+		// Returns proxy ID, which stays valid until DestroyProxy().
+		auto CreateProxy(const XMVECTOR& Center, float Radius, uint32_t UserData) noexcept->uint32_t;
+		void DestroyProxy(uint32_t ProxyID) noexcept;
+
+		// Returns true if the proxy had to be reinserted (it left its fat AABB).
+		auto MoveProxy(uint32_t ProxyID, const XMVECTOR& Center, float Radius) noexcept->bool;
+
+		auto GetUserData(uint32_t ProxyID) const noexcept { return m_vNodes[ProxyID].UserData; };
+		auto GetProxyCount() const noexcept { return m_ProxyCount; };
+		auto GetHeight() const noexcept { return (m_RootID == KInvalidAABBTreeNodeID) ? 0 : m_vNodes[m_RootID].Height; };
+
+		// ### Single queries ###
+		// Closest bounding sphere hit by the ray
+		auto RayCast(const SSceneRayQuery& Query, SSceneRayHit& OutHit) const noexcept->bool;
+
+		// Calls Function(UserData, T) for every bounding sphere hit by the ray (in no particular order).
+		template <typename FunctionType>
+		void ForEachRayHit(const SSceneRayQuery& Query, const FunctionType& Function) const noexcept;
+
+		// User data of every bounding sphere that overlaps (OutUserData is not cleared).
+		void QuerySphere(const SSceneSphereQuery& Query, VECTOR<uint32_t>& OutUserData) const noexcept;
+		void QueryFrustum(const SSceneFrustumQuery& Query, VECTOR<uint32_t>& OutUserData) const noexcept;
+
+		// ### Batched queries ###
+		// Queries are split into ParallelFor() chunks, every query writes only its own result.
+		void RayCastBatch(JWJobSystem& JobSystem, const VECTOR<SSceneRayQuery>& Queries, VECTOR<SSceneRayHit>& OutHits) noexcept;
+		void QuerySphereBatch(JWJobSystem& JobSystem, const VECTOR<SSceneSphereQuery>& Queries, VECTOR<VECTOR<uint32_t>>& OutResults) noexcept;
+		void QueryFrustumBatch(JWJobSystem& JobSystem, const VECTOR<SSceneFrustumQuery>& Queries, VECTOR<VECTOR<uint32_t>>& OutResults) noexcept;
+
+		// Throughput of the last batched query (for comparing against linear scans)
+		auto GetLastBatchQueryCount() const noexcept { return m_LastBatchQueryCount; };
+		auto GetLastBatchTime() const noexcept { return m_LastBatchTime; };
+		auto GetLastBatchQueriesPerSecond() const noexcept->double;
+
+	private:
+		auto AllocateNode() noexcept->uint32_t;
+		void FreeNode(uint32_t NodeID) noexcept;
+
+		void InsertLeaf(uint32_t LeafID) noexcept;
+		void RemoveLeaf(uint32_t LeafID) noexcept;
+
+		// Walks up from NodeID, rebalancing and refitting.
+		void Refit(uint32_t NodeID) noexcept;
+		auto Balance(uint32_t NodeID) noexcept->uint32_t;
+
+		static auto Union(const SAABB& A, const SAABB& B) noexcept->SAABB;
+		static auto GetSurfaceArea(const SAABB& AABB) noexcept->float;
+		static auto Contains(const SAABB& Outer, const SAABB& Inner) noexcept->bool;
+		static auto MakeAABB(const XMFLOAT3& Center, float Radius) noexcept->SAABB;
+
+	private:
+		VECTOR<SAABBTreeNode>	m_vNodes{};
+		uint32_t				m_RootID{ KInvalidAABBTreeNodeID };
+		uint32_t				m_FreeListID{ KInvalidAABBTreeNodeID };
+		uint32_t				m_ProxyCount{};
+
+		uint32_t				m_LastBatchQueryCount{};
+		long long				m_LastBatchTime{};
+	};
+
+	// Slab test, returns false if the ray misses the box within [0, MaxT].
+	static inline auto IntersectRayAABB(const XMFLOAT3& Origin, const XMFLOAT3& InverseDirection, float MaxT, const SAABB& AABB) noexcept->bool
+	{
+		auto t_min = 0.0f;
+		auto t_max = MaxT;
+
+		const float origin[3]{ Origin.x, Origin.y, Origin.z };
+		const float inverse_direction[3]{ InverseDirection.x, InverseDirection.y, InverseDirection.z };
+		const float box_min[3]{ AABB.Min.x, AABB.Min.y, AABB.Min.z };
+		const float box_max[3]{ AABB.Max.x, AABB.Max.y, AABB.Max.z };
+		for (uint32_t axis = 0; axis < 3; ++axis)
+		{
+			auto t0 = (box_min[axis] - origin[axis]) * inverse_direction[axis];
+			auto t1 = (box_max[axis] - origin[axis]) * inverse_direction[axis];
+			if (t0 > t1) { std::swap(t0, t1); }
+
+			// (NaN from 0 * inf is ignored by these comparisons)
+			t_min = (t0 > t_min) ? t0 : t_min;
+			t_max = (t1 < t_max) ? t1 : t_max;
+			if (t_min > t_max) { return false; }
+		}
+		return true;
+	}
+
+	template <typename FunctionType>
+	inline void JWDynamicAABBTree::ForEachRayHit(const SSceneRayQuery& Query, const FunctionType& Function) const noexcept
+	{
+		if (m_RootID == KInvalidAABBTreeNodeID) { return; }
+
+		XMFLOAT3 origin{};
+		XMFLOAT3 inverse_direction{};
+		XMStoreFloat3(&origin, Query.Origin);
+		XMStoreFloat3(&inverse_direction, XMVectorReciprocal(Query.Direction));
+
+		SAABBTreeStack stack{};
+		stack.Push(m_RootID);
+		while (!stack.IsEmpty())
+		{
+			const auto& node = m_vNodes[stack.Pop()];
+			if (!IntersectRayAABB(origin, inverse_direction, Query.MaxT, node.AABB)) { continue; }
+
+			if (node.IsLeaf())
+			{
+				auto t = XMVectorReplicate(Query.MaxT);
+				if (IntersectRaySphere(Query.Origin, Query.Direction, node.Radius, XMLoadFloat3(&node.Center), &t))
+				{
+					Function(node.UserData, XMVectorGetX(t));
+				}
+				continue;
+			}
+
+			stack.Push(node.Child0);
+			stack.Push(node.Child1);
+		}
+	}
+};
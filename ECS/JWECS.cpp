@@ -7,20 +7,57 @@ void JWECS::Create(JWDX& DX, HWND hWnd, const SSize2& WindowSize, STRING BaseDir
 	m_pDX = &DX;
 	m_BaseDirectory = BaseDirectory;
 
+	// @important: JobSystem must be created before the systems.
+	m_JobSystem.Create();
+
 	m_SystemTransform.Create(*this);
 	m_SystemLight.Create(*this, DX);
 	m_SystemPhysics.Create(*this, hWnd, WindowSize);
 	m_SystemCamera.Create(*this, DX, WindowSize);
 	m_SystemRender.Create(*this, DX, WindowSize, BaseDirectory);
+
+	// @important
+	// The order of nodes is the order of serial execution,
+	// a system always runs after every former system it conflicts with.
+	AddSystemExecutionNode("Transform", 0, JWFlagECSResource_Transform,
+		[this]() { m_SystemTransform.Execute(); });
+	AddSystemExecutionNode("Camera", JWFlagECSResource_Transform, JWFlagECSResource_Camera | JWFlagECSResource_DeviceContext,
+		[this]() { m_SystemCamera.Execute(); });
+	AddSystemExecutionNode("Light", 0, JWFlagECSResource_Light | JWFlagECSResource_DeviceContext,
+		[this]() { m_SystemLight.Execute(); });
+	AddSystemExecutionNode("Physics", JWFlagECSResource_Transform,
+		JWFlagECSResource_Transform | JWFlagECSResource_Physics | JWFlagECSResource_BoundingSphereInstances,
+		[this]() { m_SystemPhysics.Execute(); });
+
+	// Render must be the last one to be executed
+	AddSystemExecutionNode("Render",
+		JWFlagECSResource_Transform | JWFlagECSResource_Camera | JWFlagECSResource_Light |
+		JWFlagECSResource_Physics | JWFlagECSResource_BoundingSphereInstances,
+		JWFlagECSResource_Render | JWFlagECSResource_DeviceContext,
+		[this]() { m_SystemRender.Execute(); });
+
+	BuildExecutionLevels();
 }
 
 void JWECS::Destroy() noexcept
 {
+	// Commands that were never flushed are discarded.
+	m_CommandBuffer.TakeSortedCommands(m_vFlushingCommands);
+	m_vFlushingCommands.clear();
+
 	// Destroy entities and free them
-	for (auto& iter : m_vEntities)
+	for (auto& iter : m_vEntitySlots)
 	{
-		iter.Destroy();
+		if (iter.IsAlive)
+		{
+			iter.PtrEntity->Destroy();
+		}
 	}
+	m_vEntitySlots.clear();
+	m_vFreeEntityIndices.clear();
+	m_umapEntityNames.clear();
+	m_umapEntityTypes.clear();
+	m_EntityCount = 0;
 
 	// @important
 	// Destroy systems
@@ -29,73 +66,103 @@ void JWECS::Destroy() noexcept
 	m_SystemPhysics.Destroy();
 	m_SystemLight.Destroy();
 	m_SystemTransform.Destroy();
+
+	m_vSystemExecutionNodes.clear();
+	m_ExecutionLevelCount = 0;
+
+	// JobSystem must be destroyed last.
+	m_JobSystem.Destroy();
 }
 
-auto JWECS::CreateEntity(STRING EntityName) noexcept->JWEntity*
+PRIVATE auto JWECS::AllocateEntitySlot() noexcept->JWEntity*
 {
-	if (m_vEntities.size())
+	EntityIndexType entity_index{};
+
+	if (m_vFreeEntityIndices.size())
+	{
+		entity_index = m_vFreeEntityIndices.back();
+		m_vFreeEntityIndices.pop_back();
+	}
+	else
 	{
-		for (auto& iter : m_vEntities)
+		if (m_vEntitySlots.size() >= KMaxEntityCount)
 		{
-			if (iter.GetEntityName().compare(EntityName) == 0)
-			{
-				// Duplicate name cannot be used!
-				JW_ERROR_ABORT("This entity name is duplicated. (" + EntityName + ")");
-			}
+			JW_ERROR_ABORT("Too many entities.");
 		}
+
+		entity_index = static_cast<EntityIndexType>(m_vEntitySlots.size());
+		m_vEntitySlots.emplace_back();
+		m_vEntitySlots.back().PtrEntity = MAKE_UNIQUE(JWEntity)(entity_index);
 	}
 
-	auto entity_index{ static_cast<EntityIndexType>(m_vEntities.size()) };
-	m_vEntities.emplace_back(entity_index);
+	auto& slot = m_vEntitySlots[entity_index];
+	slot.IsAlive = true;
+	slot.PtrEntity->SetEntityHandle(MakeEntityHandle(entity_index, slot.Generation));
+
+	++m_EntityCount;
+
+	return slot.PtrEntity.get();
+}
+
+auto JWECS::CreateEntity(STRING EntityName) noexcept->JWEntity*
+{
+	if (m_IsExecutingSystems)
+	{
+		JW_ERROR_ABORT("Entities can't be created while systems are being executed. (Use CommandBuffer())");
+	}
+
+	if (m_umapEntityNames.find(EntityName) != m_umapEntityNames.end())
+	{
+		// Duplicate name cannot be used!
+		JW_ERROR_ABORT("This entity name is duplicated. (" + EntityName + ")");
+	}
 
-	auto& entity = m_vEntities[entity_index];
-	entity.Create(this, EntityName);
+	auto entity = AllocateEntitySlot();
+	entity->Create(this, EntityName);
 
-	m_mapEntityNames.insert(std::make_pair(EntityName, entity_index));
+	m_umapEntityNames.insert(std::make_pair(EntityName, entity->GetEntityIndex()));
 
-	return &entity;
+	return entity;
 }
 
 auto JWECS::CreateEntity(EEntityType Type) noexcept->JWEntity*
 {
+	if (m_IsExecutingSystems)
+	{
+		JW_ERROR_ABORT("Entities can't be created while systems are being executed. (Use CommandBuffer())");
+	}
+
 	if (Type == EEntityType::UserDefined)
 	{
 		JW_ERROR_ABORT("You can't make a user-defined entity by this method.");
 	}
 
-	if (m_vEntities.size())
+	if (m_umapEntityTypes.find(Type) != m_umapEntityTypes.end())
 	{
-		for (auto& iter : m_vEntities)
-		{
-			if (iter.GetEntityType() == Type)
-			{
-				// It must be unique
-				JW_ERROR_ABORT("The entity of the type already exists.");
-			}
-		}
+		// It must be unique
+		JW_ERROR_ABORT("The entity of the type already exists.");
 	}
 
 	STRING entity_name{ "UniqueEntity" };
 	uint32_t type_id = static_cast<uint32_t>(Type);
 	entity_name += TO_STRING(type_id);
 
-	auto entity_index{ static_cast<EntityIndexType>(m_vEntities.size()) };
-	m_vEntities.emplace_back(entity_index);
+	auto entity = AllocateEntitySlot();
+	entity->Create(this, entity_name, Type);
 
-	auto& entity = m_vEntities[entity_index];
-	entity.Create(this, entity_name, Type);
-	m_mapEntityNames.insert(std::make_pair(entity_name, entity_index));
+	m_umapEntityNames.insert(std::make_pair(entity_name, entity->GetEntityIndex()));
+	m_umapEntityTypes.insert(std::make_pair(Type, entity->GetEntityIndex()));
 
-	return &entity;
+	return entity;
 }
 
 auto JWECS::GetEntityByIndex(EntityIndexType Index) noexcept->JWEntity*
 {
 	JWEntity* result{};
 
-	if (Index < m_vEntities.size())
+	if ((Index < m_vEntitySlots.size()) && (m_vEntitySlots[Index].IsAlive))
 	{
-		result = &m_vEntities[Index];
+		result = m_vEntitySlots[Index].PtrEntity.get();
 	}
 	else
 	{
@@ -109,14 +176,14 @@ auto JWECS::GetEntityByName(const STRING& EntityName) noexcept->JWEntity*
 {
 	JWEntity* result{};
 
-	if (m_vEntities.size())
+	if (m_EntityCount)
 	{
-		auto find = m_mapEntityNames.find(EntityName);
-		if (find != m_mapEntityNames.end())
+		auto find = m_umapEntityNames.find(EntityName);
+		if (find != m_umapEntityNames.end())
 		{
 			auto entity_index = find->second;
 
-			result = &m_vEntities[entity_index];
+			result = m_vEntitySlots[entity_index].PtrEntity.get();
 		}
 		else
 		{
@@ -136,36 +203,66 @@ auto JWECS::GetEntityByType(EEntityType Type) noexcept->JWEntity*
 		JW_ERROR_ABORT("Impossible to get the entity of user defined type by calling this method.");
 	}
 
-	if (m_vEntities.size())
+	auto find = m_umapEntityTypes.find(Type);
+	if (find != m_umapEntityTypes.end())
 	{
-		for (auto& iter : m_vEntities)
-		{
-			if (iter.GetEntityType() == Type)
-			{
-				result = &iter;
-			}
-		}
+		result = m_vEntitySlots[find->second].PtrEntity.get();
 	}
 
 	return result;
 }
 
+auto JWECS::GetEntityByHandle(EntityHandleType Handle) noexcept->JWEntity*
+{
+	if (!IsEntityHandleValid(Handle)) { return nullptr; }
+
+	return m_vEntitySlots[GetEntityHandleIndex(Handle)].PtrEntity.get();
+}
+
+auto JWECS::IsEntityHandleValid(EntityHandleType Handle) const noexcept->bool
+{
+	if (Handle == KInvalidEntityHandle) { return false; }
+
+	auto entity_index = GetEntityHandleIndex(Handle);
+	if (entity_index >= m_vEntitySlots.size()) { return false; }
+
+	const auto& slot = m_vEntitySlots[entity_index];
+	return (slot.IsAlive) && ((slot.Generation & KEntityHandleGenerationMask) == GetEntityHandleGeneration(Handle));
+}
+
 void JWECS::DestroyEntityByIndex(EntityIndexType Index) noexcept
 {
-	if (Index < m_vEntities.size())
+	if ((Index < m_vEntitySlots.size()) && (m_vEntitySlots[Index].IsAlive))
 	{
-		m_mapEntityNames.erase(m_vEntities[Index].GetEntityName());
+		auto& slot = m_vEntitySlots[Index];
+		auto& entity = *slot.PtrEntity;
 
-		m_vEntities[Index].Destroy();
+		// @important
+		// Component vectors must not be swapped in the middle of system execution, so it's deferred.
+		if (m_IsExecutingSystems)
+		{
+			m_CommandBuffer.DestroyEntity(entity.GetEntityHandle());
+			return;
+		}
 
-		auto last_Index = static_cast<EntityIndexType>(m_vEntities.size() - 1);
-		if (Index < last_Index)
+		m_umapEntityNames.erase(entity.GetEntityName());
+		if (entity.GetEntityType() != EEntityType::UserDefined)
 		{
-			m_vEntities[Index] = std::move(m_vEntities[last_Index]);
-			m_vEntities[Index].SetEntityIndex(Index);
+			m_umapEntityTypes.erase(entity.GetEntityType());
 		}
 
-		m_vEntities.pop_back();
+		entity.Destroy();
+
+		// @important
+		// The slot is reset and its generation is increased, so every handle to this entity becomes stale.
+		// (JWEntity objects are never moved, other entities' indices don't change.)
+		entity = JWEntity(Index);
+		slot.IsAlive = false;
+		++slot.Generation;
+
+		m_vFreeEntityIndices.emplace_back(Index);
+
+		--m_EntityCount;
 	}
 	else
 	{
@@ -175,10 +272,10 @@ void JWECS::DestroyEntityByIndex(EntityIndexType Index) noexcept
 
 void JWECS::DestroyEntityByName(const STRING& EntityName) noexcept
 {
-	if (m_vEntities.size())
+	if (m_EntityCount)
 	{
-		auto find = m_mapEntityNames.find(EntityName);
-		if (find != m_mapEntityNames.end())
+		auto find = m_umapEntityNames.find(EntityName);
+		if (find != m_umapEntityNames.end())
 		{
 			auto entity_index = find->second;
 
@@ -198,20 +295,19 @@ void JWECS::DestroyEntityByType(EEntityType Type) noexcept
 		JW_ERROR_ABORT("Impossible to destroy the entity of user defined type by calling this method.");
 	}
 
-	if (m_vEntities.size())
+	auto find = m_umapEntityTypes.find(Type);
+	if (find != m_umapEntityTypes.end())
 	{
-		for (auto& iter : m_vEntities)
-		{
-			if (iter.GetEntityType() == Type)
-			{
-				auto entity_index = iter.GetEntityIndex();
+		DestroyEntityByIndex(find->second);
+	}
+}
 
-				DestroyEntityByIndex(entity_index);
+void JWECS::DestroyEntityByHandle(EntityHandleType Handle) noexcept
+{
+	// Destroying through a stale handle is a no-op.
+	if (!IsEntityHandleValid(Handle)) { return; }
 
-				return;
-			}
-		}
-	}
+	DestroyEntityByIndex(GetEntityHandleIndex(Handle));
 }
 
 void JWECS::UpdateDeltaTime(long long dt) noexcept
@@ -224,17 +320,146 @@ auto JWECS::GetDeltaTime() noexcept->float
 	return m_DeltaTime;
 }
 
+PRIVATE void JWECS::AddSystemExecutionNode(const STRING& Name, JWFlagECSResource Read, JWFlagECSResource Write,
+	JobFunction Execute) noexcept
+{
+	m_vSystemExecutionNodes.emplace_back(Name, Read, Write, MOVE(Execute));
+}
+
+PRIVATE void JWECS::BuildExecutionLevels() noexcept
+{
+	m_ExecutionLevelCount = 0;
+
+	for (size_t i = 0; i < m_vSystemExecutionNodes.size(); ++i)
+	{
+		auto& curr = m_vSystemExecutionNodes[i];
+		curr.Level = 0;
+
+		for (size_t j = 0; j < i; ++j)
+		{
+			const auto& prev = m_vSystemExecutionNodes[j];
+
+			// Write-write, write-read and read-write are conflicts.
+			bool is_conflicting{
+				((curr.Write & (prev.Read | prev.Write)) != 0) ||
+				((curr.Read & prev.Write) != 0) };
+
+			if (is_conflicting)
+			{
+				curr.Level = max(curr.Level, prev.Level + 1);
+			}
+		}
+
+		m_ExecutionLevelCount = max(m_ExecutionLevelCount, curr.Level + 1);
+	}
+}
+
 void JWECS::ExecuteSystems() noexcept
 {
-	m_SystemTransform.Execute();
+	m_IsExecutingSystems = true;
 
-	// Camera must be executed before Light and Phyiscs
-	m_SystemCamera.Execute();
+	for (uint32_t level = 0; level < m_ExecutionLevelCount; ++level)
+	{
+		SJobCounter counter{};
+		SSystemExecutionNode* ptr_first_node{};
 
-	m_SystemLight.Execute();
+		for (auto& iter : m_vSystemExecutionNodes)
+		{
+			if (iter.Level != level) { continue; }
 
-	m_SystemPhysics.Execute();
+			// The calling thread takes the first system of the level.
+			if (ptr_first_node == nullptr)
+			{
+				ptr_first_node = &iter;
+				continue;
+			}
 
-	// Render must be the last one to be executed
-	m_SystemRender.Execute();
-}
\ No newline at end of file
+			m_JobSystem.Run(iter.Execute, counter);
+		}
+
+		if (ptr_first_node) { ptr_first_node->Execute(); }
+
+		m_JobSystem.Wait(counter);
+	}
+
+	m_IsExecutingSystems = false;
+
+	// Sync point
+	FlushCommandBuffer();
+}
+
+void JWECS::FlushCommandBuffer() noexcept
+{
+	if (m_IsExecutingSystems)
+	{
+		JW_ERROR_ABORT("The command buffer can't be flushed while systems are being executed.");
+	}
+
+	m_CommandBuffer.TakeSortedCommands(m_vFlushingCommands);
+
+	for (auto& iter : m_vFlushingCommands)
+	{
+		ApplyCommand(iter);
+	}
+
+	m_LastFlushedCommandCount = static_cast<uint32_t>(m_vFlushingCommands.size());
+
+	// @important: clear() keeps the capacity, so flushing doesn't allocate every frame.
+	m_vFlushingCommands.clear();
+}
+
+PRIVATE void JWECS::ApplyCommand(SECSCommand& Command) noexcept
+{
+	switch (Command.Type)
+	{
+	case EECSCommandType::CreateEntity:
+	{
+		auto entity = (Command.EntityType == EEntityType::UserDefined) ?
+			CreateEntity(Command.EntityName) : CreateEntity(Command.EntityType);
+
+		if (Command.Initializer) { Command.Initializer(*entity); }
+		break;
+	}
+	case EECSCommandType::AddComponent:
+	{
+		// The entity might have been destroyed after the command was recorded.
+		auto entity = GetEntityByHandle(Command.Entity);
+		if (entity == nullptr) { break; }
+
+		AddComponent(*entity, Command.Component);
+
+		if (Command.Initializer) { Command.Initializer(*entity); }
+		break;
+	}
+	case EECSCommandType::DestroyEntity:
+		// Duplicated destructions are no-ops (the handle is already stale).
+		DestroyEntityByHandle(Command.Entity);
+		break;
+	default:
+		break;
+	}
+}
+
+PRIVATE void JWECS::AddComponent(JWEntity& Entity, EComponentType Component) noexcept
+{
+	switch (Component)
+	{
+	case EComponentType::Transform:
+		if (!Entity.GetComponentTransform()) { Entity.CreateComponentTransform(); }
+		break;
+	case EComponentType::Light:
+		if (!Entity.GetComponentLight()) { Entity.CreateComponentLight(); }
+		break;
+	case EComponentType::Physics:
+		if (!Entity.GetComponentPhysics()) { Entity.CreateComponentPhysics(); }
+		break;
+	case EComponentType::Camera:
+		if (!Entity.GetComponentCamera()) { Entity.CreateComponentCamera(); }
+		break;
+	case EComponentType::Render:
+		if (!Entity.GetComponentRender()) { Entity.CreateComponentRender(); }
+		break;
+	default:
+		break;
+	}
+}
@@ -1,11 +1,49 @@
 #pragma once
 
-#include "JWEntity.h"
+#include "JWECSCommandBuffer.h"
 
 namespace JWEngine
 {
 	class JWDX;
 
+	// Data that systems read or write in their Execute().
+	enum EFLAGECSResource : uint16_t
+	{
+		JWFlagECSResource_Transform					= 0x01,
+		JWFlagECSResource_Camera					= 0x02,
+		JWFlagECSResource_Light						= 0x04,
+		JWFlagECSResource_Physics					= 0x08,
+		JWFlagECSResource_Render					= 0x10,
+		JWFlagECSResource_BoundingSphereInstances	= 0x20,
+
+		// D3D11 immediate context is not thread-safe, so every system that touches it must declare this.
+		JWFlagECSResource_DeviceContext				= 0x40,
+	};
+	using JWFlagECSResource = uint16_t;
+
+	// Entities live in stable slots, destroyed slots are reused through a free list.
+	struct SEntitySlot
+	{
+		UNIQUE_PTR<JWEntity>	PtrEntity{};
+		uint32_t				Generation{};
+		bool					IsAlive{};
+	};
+
+	struct SSystemExecutionNode
+	{
+		SSystemExecutionNode() {};
+		SSystemExecutionNode(const STRING& _Name, JWFlagECSResource _Read, JWFlagECSResource _Write, JobFunction _Execute) :
+			Name{ _Name }, Read{ _Read }, Write{ _Write }, Execute{ MOVE(_Execute) } {};
+
+		STRING				Name{};
+		JWFlagECSResource	Read{};
+		JWFlagECSResource	Write{};
+		JobFunction			Execute{};
+
+		// Systems of the same level don't conflict with each other, so they run concurrently.
+		uint32_t			Level{};
+	};
+
 	class JWECS final
 	{
 	public:
@@ -17,6 +55,8 @@ namespace JWEngine
 		void Destroy() noexcept;
 		
 		// ### Entity creator ###
+		// @important
+		// Entities can't be created while systems are being executed, use CommandBuffer() instead.
 		// Creates non-unique entity without specifying the type (user-defined type)
 		auto CreateEntity(STRING EntityName) noexcept->JWEntity*;
 		
@@ -28,36 +68,83 @@ namespace JWEngine
 		auto GetEntityByName(const STRING& EntityName) noexcept->JWEntity*;
 		auto GetEntityByType(EEntityType Type) noexcept->JWEntity*;
 
+		// Returns nullptr if the handle is stale (the entity was destroyed).
+		auto GetEntityByHandle(EntityHandleType Handle) noexcept->JWEntity*;
+		auto IsEntityHandleValid(EntityHandleType Handle) const noexcept->bool;
+
+		auto GetEntityCount() const noexcept { return m_EntityCount; };
+
 		// ### Entity destroyers ###
+		// While systems are being executed, these are recorded into CommandBuffer() and applied after the execution.
 		void DestroyEntityByIndex(EntityIndexType Index) noexcept;
 		void DestroyEntityByName(const STRING& EntityName) noexcept;
 		void DestroyEntityByType(EEntityType Type) noexcept;
+		void DestroyEntityByHandle(EntityHandleType Handle) noexcept;
 
 		void UpdateDeltaTime(long long dt) noexcept;
 		auto GetDeltaTime() noexcept->float;
 
 		// ### Execute ###
+		// Systems are executed level by level (see BuildExecutionLevels()).
 		void ExecuteSystems() noexcept;
 
+		// ### Command buffer ###
+		// Structural changes recorded during system execution (from any thread).
+		auto& CommandBuffer() noexcept { return m_CommandBuffer; };
+
+		// Applies every recorded command in one sorted pass. (Called at the end of ExecuteSystems())
+		void FlushCommandBuffer() noexcept;
+
+		auto IsExecutingSystems() const noexcept { return m_IsExecutingSystems.load(); };
+		auto GetLastFlushedCommandCount() const noexcept { return m_LastFlushedCommandCount; };
+
+		// Number of distinct execution levels (1 means every system runs serially).
+		auto GetExecutionLevelCount() const noexcept { return m_ExecutionLevelCount; };
+		auto& GetSystemExecutionNodes() const noexcept { return m_vSystemExecutionNodes; };
+
 		// ### Object getters ###
 		auto& SystemTransform() noexcept { return m_SystemTransform; }
 		auto& SystemLight() noexcept { return m_SystemLight; }
 		auto& SystemPhysics() noexcept { return m_SystemPhysics; }
 		auto& SystemCamera() noexcept { return m_SystemCamera; }
 		auto& SystemRender() noexcept { return m_SystemRender; }
+		auto& JobSystem() noexcept { return m_JobSystem; }
+
+	private:
+		auto AllocateEntitySlot() noexcept->JWEntity*;
+
+		void AddSystemExecutionNode(const STRING& Name, JWFlagECSResource Read, JWFlagECSResource Write, JobFunction Execute) noexcept;
+		void BuildExecutionLevels() noexcept;
+
+		void ApplyCommand(SECSCommand& Command) noexcept;
+		void AddComponent(JWEntity& Entity, EComponentType Component) noexcept;
 
 	private:
 		JWDX*					m_pDX{};
 		STRING					m_BaseDirectory{};
 
+		// @important: declared before the systems so that it outlives them.
+		JWJobSystem				m_JobSystem{};
+
 		JWSystemTransform		m_SystemTransform{};
 		JWSystemLight			m_SystemLight{};
 		JWSystemPhysics			m_SystemPhysics{};
 		JWSystemCamera			m_SystemCamera{};
 		JWSystemRender			m_SystemRender{};
 
-		VECTOR<JWEntity>				m_vEntities;
-		MAP<STRING, EntityIndexType>	m_mapEntityNames;
+		VECTOR<SEntitySlot>						m_vEntitySlots;
+		VECTOR<EntityIndexType>					m_vFreeEntityIndices;
+		uint32_t								m_EntityCount{};
+		UNORDERED_MAP<STRING, EntityIndexType>		m_umapEntityNames;
+		UNORDERED_MAP<EEntityType, EntityIndexType>	m_umapEntityTypes;
+
+		VECTOR<SSystemExecutionNode>	m_vSystemExecutionNodes;
+		uint32_t						m_ExecutionLevelCount{};
+
+		JWECSCommandBuffer				m_CommandBuffer{};
+		VECTOR<SECSCommand>				m_vFlushingCommands;
+		uint32_t						m_LastFlushedCommandCount{};
+		std::atomic<bool>				m_IsExecutingSystems{ false };
 
 		float					m_DeltaTime{};
 	};
@@ -0,0 +1,94 @@
+#include "JWECSCommandBuffer.h"
+
+using namespace JWEngine;
+
+void JWECSCommandBuffer::CreateEntity(const STRING& EntityName, EntityInitializer Initializer) noexcept
+{
+	SECSCommand command{ EECSCommandType::CreateEntity, 0 };
+	command.EntityName = EntityName;
+	command.Initializer = MOVE(Initializer);
+
+	Record(MOVE(command));
+}
+
+void JWECSCommandBuffer::CreateEntity(EEntityType Type, EntityInitializer Initializer) noexcept
+{
+	if (Type == EEntityType::UserDefined)
+	{
+		JW_ERROR_ABORT("You can't make a user-defined entity by this method.");
+	}
+
+	SECSCommand command{ EECSCommandType::CreateEntity, 0 };
+	command.EntityType = Type;
+	command.Initializer = MOVE(Initializer);
+
+	Record(MOVE(command));
+}
+
+void JWECSCommandBuffer::AddComponent(EntityHandleType Entity, EComponentType Component, EntityInitializer Initializer) noexcept
+{
+	SECSCommand command{ EECSCommandType::AddComponent, 0 };
+	command.Entity = Entity;
+	command.Component = Component;
+	command.Initializer = MOVE(Initializer);
+
+	Record(MOVE(command));
+}
+
+void JWECSCommandBuffer::DestroyEntity(EntityHandleType Entity) noexcept
+{
+	SECSCommand command{ EECSCommandType::DestroyEntity, 0 };
+	command.Entity = Entity;
+
+	Record(MOVE(command));
+}
+
+auto JWECSCommandBuffer::GetCommandCount() noexcept->uint32_t
+{
+	std::lock_guard<std::mutex> lock{ m_Mutex };
+
+	return static_cast<uint32_t>(m_vCommands.size());
+}
+
+void JWECSCommandBuffer::TakeSortedCommands(VECTOR<SECSCommand>& OutCommands) noexcept
+{
+	{
+		std::lock_guard<std::mutex> lock{ m_Mutex };
+
+		// Swapping hands the caller's (cleared) vector back to the recorder, so neither side loses its capacity.
+		OutCommands.swap(m_vCommands);
+		m_vCommands.clear();
+		m_NextSequence = 0;
+	}
+
+	// @important
+	// Destructions come first, then creations (in recorded order),
+	// then component additions grouped by component type (so each pool is appended to in one run).
+	// The sequence number keeps the result the same regardless of which thread recorded first into the vector.
+	std::sort(OutCommands.begin(), OutCommands.end(), [](const SECSCommand& a, const SECSCommand& b)
+		{
+			if (a.Type != b.Type) { return a.Type < b.Type; }
+
+			if (a.Type == EECSCommandType::AddComponent)
+			{
+				if (a.Component != b.Component) { return a.Component < b.Component; }
+			}
+
+			if (a.Type != EECSCommandType::CreateEntity)
+			{
+				auto a_index = GetEntityHandleIndex(a.Entity);
+				auto b_index = GetEntityHandleIndex(b.Entity);
+				if (a_index != b_index) { return a_index < b_index; }
+			}
+
+			return a.Sequence < b.Sequence;
+		});
+}
+
+PRIVATE void JWECSCommandBuffer::Record(SECSCommand&& Command) noexcept
+{
+	std::lock_guard<std::mutex> lock{ m_Mutex };
+
+	Command.Sequence = m_NextSequence++;
+	m_vCommands.emplace_back(MOVE(Command));
+}
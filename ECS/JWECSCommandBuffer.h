@@ -0,0 +1,81 @@
+#pragma once
+
+#include "JWEntity.h"
+#include "../Core/JWJobSystem.h"
+
+namespace JWEngine
+{
+	// @important
+	// The order of the enumerators is the order in which commands are applied.
+	// Destructions come first, so that a name or a unique entity type can be destroyed and re-created in one flush.
+	enum class EECSCommandType : uint8_t
+	{
+		DestroyEntity,
+		CreateEntity,
+		AddComponent,
+	};
+
+	// @important
+	// The order of the enumerators is the order in which components are added in a flush.
+	// (SystemPhysics reads the transform component when its component is created.)
+	enum class EComponentType : uint8_t
+	{
+		Transform,
+		Light,
+		Physics,
+		Camera,
+		Render,
+	};
+
+	// Called when the command is applied, for setting up the (newly created) entity or component.
+	using EntityInitializer = std::function<void(JWEntity&)>;
+
+	struct SECSCommand
+	{
+		SECSCommand() {};
+		SECSCommand(EECSCommandType _Type, uint32_t _Sequence) : Type{ _Type }, Sequence{ _Sequence } {};
+
+		EECSCommandType		Type{};
+		uint32_t			Sequence{};
+
+		// CreateEntity
+		STRING				EntityName{};
+		EEntityType			EntityType{ EEntityType::UserDefined };
+
+		// AddComponent, DestroyEntity
+		EntityHandleType	Entity{ KInvalidEntityHandle };
+		EComponentType		Component{};
+
+		EntityInitializer	Initializer{};
+	};
+
+	// Records structural changes (entity creation/destruction, component addition)
+	// so that they don't happen while systems are being executed.
+	// Recording is thread-safe, commands are applied by JWECS::FlushCommandBuffer().
+	class JWECSCommandBuffer final
+	{
+	public:
+		JWECSCommandBuffer() = default;
+		~JWECSCommandBuffer() = default;
+
+		void CreateEntity(const STRING& EntityName, EntityInitializer Initializer = nullptr) noexcept;
+		void CreateEntity(EEntityType Type, EntityInitializer Initializer = nullptr) noexcept;
+		void AddComponent(EntityHandleType Entity, EComponentType Component, EntityInitializer Initializer = nullptr) noexcept;
+
+		// Destroying the same entity more than once is allowed, (the handle becomes stale after the first one.)
+		void DestroyEntity(EntityHandleType Entity) noexcept;
+
+		auto GetCommandCount() noexcept->uint32_t;
+
+		// Moves every recorded command out of the buffer, sorted in the order they must be applied.
+		void TakeSortedCommands(VECTOR<SECSCommand>& OutCommands) noexcept;
+
+	private:
+		void Record(SECSCommand&& Command) noexcept;
+
+	private:
+		std::mutex				m_Mutex{};
+		VECTOR<SECSCommand>		m_vCommands{};
+		uint32_t				m_NextSequence{};
+	};
+};
@@ -18,88 +18,88 @@ void JWEntity::Create(JWECS* pECS, const STRING& EntityName, EEntityType EntityT
 
 void JWEntity::Destroy() noexcept
 {
-	if (m_ComponentTransformIndex != KInvalidComponentIndex)
+	if (GetComponentTransform())
 	{
-		m_pECS->SystemTransform().DestroyComponent(m_ComponentTransformIndex);
+		m_pECS->SystemTransform().DestroyComponent(m_EntityIndex);
 	}
 
-	if (m_ComponentLightIndex != KInvalidComponentIndex)
+	if (GetComponentLight())
 	{
-		m_pECS->SystemLight().DestroyComponent(m_ComponentLightIndex);
+		m_pECS->SystemLight().DestroyComponent(m_EntityIndex);
 	}
 
-	if (m_ComponentPhysicsIndex != KInvalidComponentIndex)
+	if (GetComponentPhysics())
 	{
-		m_pECS->SystemPhysics().DestroyComponent(m_ComponentPhysicsIndex);
+		m_pECS->SystemPhysics().DestroyComponent(m_EntityIndex);
 	}
 
-	if (m_ComponentCameraIndex != KInvalidComponentIndex)
+	if (GetComponentCamera())
 	{
-		m_pECS->SystemCamera().DestroyComponent(m_ComponentCameraIndex);
+		m_pECS->SystemCamera().DestroyComponent(m_EntityIndex);
 	}
 
-	if (m_ComponentRenderIndex != KInvalidComponentIndex)
+	if (GetComponentRender())
 	{
-		m_pECS->SystemRender().DestroyComponent(m_ComponentRenderIndex);
+		m_pECS->SystemRender().DestroyComponent(m_EntityIndex);
 	}
 }
 
 auto JWEntity::CreateComponentTransform() noexcept->SComponentTransform*
 {
-	m_ComponentTransformIndex = m_pECS->SystemTransform().CreateComponent(m_EntityIndex);
+	m_pECS->SystemTransform().CreateComponent(m_EntityIndex);
 
 	return GetComponentTransform();
 }
 
 inline auto JWEntity::GetComponentTransform() noexcept->SComponentTransform*
 {
-	return m_pECS->SystemTransform().GetComponentPtr(m_ComponentTransformIndex);
+	return m_pECS->SystemTransform().GetComponentPtr(m_EntityIndex);
 }
 
 auto JWEntity::CreateComponentLight() noexcept->SComponentLight*
 {
-	m_ComponentLightIndex = m_pECS->SystemLight().CreateComponent(m_EntityIndex);
+	m_pECS->SystemLight().CreateComponent(m_EntityIndex);
 
 	return GetComponentLight();
 }
 
 inline auto JWEntity::GetComponentLight() noexcept->SComponentLight*
 {
-	return m_pECS->SystemLight().GetComponentPtr(m_ComponentLightIndex);
+	return m_pECS->SystemLight().GetComponentPtr(m_EntityIndex);
 }
 
 auto JWEntity::CreateComponentPhysics() noexcept->SComponentPhysics*
 {
-	m_ComponentPhysicsIndex = m_pECS->SystemPhysics().CreateComponent(m_EntityIndex);
+	m_pECS->SystemPhysics().CreateComponent(m_EntityIndex);
 
 	return GetComponentPhysics();
 }
 
 inline auto JWEntity::GetComponentPhysics() noexcept->SComponentPhysics*
 {
-	return m_pECS->SystemPhysics().GetComponentPtr(m_ComponentPhysicsIndex);
+	return m_pECS->SystemPhysics().GetComponentPtr(m_EntityIndex);
 }
 
 auto JWEntity::CreateComponentCamera() noexcept->SComponentCamera*
 {
-	m_ComponentCameraIndex = m_pECS->SystemCamera().CreateComponent(m_EntityIndex);
+	m_pECS->SystemCamera().CreateComponent(m_EntityIndex);
 
 	return GetComponentCamera();
 }
 
 inline auto JWEntity::GetComponentCamera() noexcept->SComponentCamera*
 {
-	return m_pECS->SystemCamera().GetComponentPtr(m_ComponentCameraIndex);
+	return m_pECS->SystemCamera().GetComponentPtr(m_EntityIndex);
 }
 
 auto JWEntity::CreateComponentRender() noexcept->SComponentRender*
 {
-	m_ComponentRenderIndex = m_pECS->SystemRender().CreateComponent(m_EntityIndex);
+	m_pECS->SystemRender().CreateComponent(m_EntityIndex);
 
 	return GetComponentRender();
 }
 
 inline auto JWEntity::GetComponentRender() noexcept->SComponentRender*
 {
-	return m_pECS->SystemRender().GetComponentPtr(m_ComponentRenderIndex);
+	return m_pECS->SystemRender().GetComponentPtr(m_EntityIndex);
 }
\ No newline at end of file
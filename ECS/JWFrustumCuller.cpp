@@ -0,0 +1,95 @@
+#include "JWFrustumCuller.h"
+
+using namespace JWEngine;
+
+void JWFrustumCuller::SetPlanes(const XMVECTOR* Planes) noexcept
+{
+	for (uint32_t i = 0; i < KFrustumPlaneCount; ++i)
+	{
+		m_PlaneX[i] = XMVectorSplatX(Planes[i]);
+		m_PlaneY[i] = XMVectorSplatY(Planes[i]);
+		m_PlaneZ[i] = XMVectorSplatZ(Planes[i]);
+		m_PlaneW[i] = XMVectorSplatW(Planes[i]);
+	}
+}
+
+void JWFrustumCuller::ClearSpheres() noexcept
+{
+	m_vCenterX.clear();
+	m_vCenterY.clear();
+	m_vCenterZ.clear();
+	m_vRadius.clear();
+	m_SphereCount = 0;
+}
+
+auto JWFrustumCuller::AddSphere(const XMVECTOR& Center, float Radius) noexcept->uint32_t
+{
+	XMFLOAT3 center{};
+	XMStoreFloat3(&center, Center);
+
+	m_vCenterX.emplace_back(center.x);
+	m_vCenterY.emplace_back(center.y);
+	m_vCenterZ.emplace_back(center.z);
+	m_vRadius.emplace_back(Radius);
+
+	return m_SphereCount++;
+}
+
+void JWFrustumCuller::Cull() noexcept
+{
+	auto start_time = STEADY_CLOCK::now();
+
+	// Padding lanes are never visible (they are masked out below anyway).
+	auto padded_count = (m_SphereCount + KCullingLaneCount - 1) / KCullingLaneCount * KCullingLaneCount;
+	m_vCenterX.resize(padded_count);
+	m_vCenterY.resize(padded_count);
+	m_vCenterZ.resize(padded_count);
+	m_vRadius.resize(padded_count);
+
+	m_vVisibilityBits.assign((padded_count + 31) / 32, 0);
+	m_VisibleSphereCount = 0;
+
+	XMUINT4 outside{};
+	for (uint32_t i = 0; i < padded_count; i += KCullingLaneCount)
+	{
+		auto x = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_vCenterX[i]));
+		auto y = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_vCenterY[i]));
+		auto z = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_vCenterZ[i]));
+		auto negative_radius = -XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_vRadius[i]));
+
+		// A sphere is outside if it's entirely behind any of the planes.
+		auto is_outside = XMVectorFalseInt();
+		for (uint32_t plane = 0; plane < KFrustumPlaneCount; ++plane)
+		{
+			auto distance = x * m_PlaneX[plane] + y * m_PlaneY[plane] + z * m_PlaneZ[plane] + m_PlaneW[plane];
+			is_outside = XMVectorOrInt(is_outside, XMVectorLess(distance, negative_radius));
+		}
+		XMStoreUInt4(&outside, is_outside);
+
+		uint32_t visible_bits{};
+		visible_bits |= (outside.x) ? 0 : 1;
+		visible_bits |= (outside.y) ? 0 : 2;
+		visible_bits |= (outside.z) ? 0 : 4;
+		visible_bits |= (outside.w) ? 0 : 8;
+
+		// Lanes past the last sphere
+		if (i + KCullingLaneCount > m_SphereCount)
+		{
+			visible_bits &= (1u << (m_SphereCount - i)) - 1;
+		}
+
+		// (i is a multiple of 4, so the 4 bits never cross a word.)
+		m_vVisibilityBits[i >> 5] |= visible_bits << (i & 31);
+
+		m_VisibleSphereCount += (visible_bits & 1) + ((visible_bits >> 1) & 1) + ((visible_bits >> 2) & 1) + ((visible_bits >> 3) & 1);
+	}
+
+	m_LastCullTime = std::chrono::duration_cast<TIME_UNIT_mS>(STEADY_CLOCK::now() - start_time).count();
+}
+
+auto JWFrustumCuller::GetSpheresPerMillisecond() const noexcept->double
+{
+	if (m_LastCullTime <= 0) { return 0; }
+
+	return static_cast<double>(m_SphereCount) * 1000.0 / static_cast<double>(m_LastCullTime);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "../Core/JWCommon.h"
+#include "../Core/JWMath.h"
+
+namespace JWEngine
+{
+	static constexpr uint32_t	KInvalidCullingSphereID{ UINT32_MAX };
+
+	// Spheres are tested in groups of this many lanes (one XMVECTOR).
+	static constexpr uint32_t	KCullingLaneCount{ 4 };
+
+	// Sphere vs view frustum culling on SoA data.
+	// Spheres are added every frame, then Cull() tests KCullingLaneCount spheres at a time against all six planes
+	// and writes one visibility bit per sphere.
+	// @important: JWFrustumCuller doesn't know about entities or cameras, so it can be driven (and measured) without JWECS.
+	class JWFrustumCuller
+	{
+	public:
+		JWFrustumCuller() = default;
+		~JWFrustumCuller() = default;
+
+		// KFrustumPlaneCount planes with inward normals (see ExtractFrustumPlanes())
+		void SetPlanes(const XMVECTOR* Planes) noexcept;
+
+		void ClearSpheres() noexcept;
+
+		// Returns sphere ID (consecutive from 0, valid until ClearSpheres())
+		auto AddSphere(const XMVECTOR& Center, float Radius) noexcept->uint32_t;
+
+		void Cull() noexcept;
+
+		// Invalid IDs are always visible. (Valid after Cull())
+		auto IsVisible(uint32_t SphereID) const noexcept->bool
+		{
+			if (SphereID >= m_SphereCount) { return true; }
+
+			return (m_vVisibilityBits[SphereID >> 5] & (1u << (SphereID & 31))) != 0;
+		};
+
+		auto GetSphereCount() const noexcept { return m_SphereCount; };
+		auto GetVisibleSphereCount() const noexcept { return m_VisibleSphereCount; };
+
+		// Time spent in the last Cull() in microseconds
+		auto GetLastCullTime() const noexcept { return m_LastCullTime; };
+		auto GetSpheresPerMillisecond() const noexcept->double;
+
+	private:
+		// Plane components replicated to every lane
+		XMVECTOR		m_PlaneX[KFrustumPlaneCount]{};
+		XMVECTOR		m_PlaneY[KFrustumPlaneCount]{};
+		XMVECTOR		m_PlaneZ[KFrustumPlaneCount]{};
+		XMVECTOR		m_PlaneW[KFrustumPlaneCount]{};
+
+		// SoA spheres (padded to a multiple of KCullingLaneCount in Cull())
+		VECTOR<float>	m_vCenterX{};
+		VECTOR<float>	m_vCenterY{};
+		VECTOR<float>	m_vCenterZ{};
+		VECTOR<float>	m_vRadius{};
+		uint32_t		m_SphereCount{};
+
+		VECTOR<uint32_t>	m_vVisibilityBits{};
+		uint32_t			m_VisibleSphereCount{};
+
+		long long		m_LastCullTime{};
+	};
+};
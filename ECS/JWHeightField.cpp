@@ -0,0 +1,216 @@
+#include "JWHeightField.h"
+#include "../Core/JWMath.h"
+#include <cfloat>
+
+using namespace JWEngine;
+
+// Clips the ray to [0, Max] on one axis.
+static auto ClipRayToSlab(float Origin, float Direction, float Max, float& InOutEnter, float& InOutExit) noexcept->bool
+{
+	if (Direction == 0)
+	{
+		return ((Origin >= 0) && (Origin <= Max));
+	}
+
+	auto t0 = (0 - Origin) / Direction;
+	auto t1 = (Max - Origin) / Direction;
+	if (t0 > t1) { std::swap(t0, t1); }
+
+	InOutEnter = max(InOutEnter, t0);
+	InOutExit = min(InOutExit, t1);
+	return (InOutEnter <= InOutExit);
+}
+
+void JWHeightField::Create(const STerrainData& TerrainData) noexcept
+{
+	m_CellCountX = TerrainData.TerrainSizeX;
+	m_CellCountZ = TerrainData.TerrainSizeZ;
+	m_PointCountX = m_CellCountX + 1;
+	m_XYSizeFactor = (TerrainData.XYSizeFactor > 0) ? TerrainData.XYSizeFactor : 1.0f;
+
+	m_vHeights.clear();
+	if ((m_CellCountX == 0) || (m_CellCountZ == 0)) { return; }
+
+	m_vHeights.resize(static_cast<size_t>(m_PointCountX) * (m_CellCountZ + 1));
+
+	auto inverse_size = 1.0f / m_XYSizeFactor;
+	XMFLOAT3 position{};
+	for (const auto& node : TerrainData.QuadTree)
+	{
+		if (!node.HasMeshes) { continue; }
+
+		for (const auto& vertex : node.VertexData.vVerticesModel)
+		{
+			XMStoreFloat3(&position, vertex.Position);
+
+			auto x = static_cast<int32_t>(roundf(position.x * inverse_size));
+			auto z = static_cast<int32_t>(roundf(-position.z * inverse_size));
+			if ((x < 0) || (z < 0) || (x > static_cast<int32_t>(m_CellCountX)) || (z > static_cast<int32_t>(m_CellCountZ))) { continue; }
+
+			m_vHeights[x + z * m_PointCountX] = position.y;
+		}
+	}
+}
+
+auto JWHeightField::IsInside(float LocalX, float LocalZ) const noexcept->bool
+{
+	auto grid_x = LocalX / m_XYSizeFactor;
+	auto grid_z = -LocalZ / m_XYSizeFactor;
+
+	return ((grid_x >= 0) && (grid_z >= 0) &&
+		(grid_x <= static_cast<float>(m_CellCountX)) && (grid_z <= static_cast<float>(m_CellCountZ)));
+}
+
+PRIVATE void JWHeightField::GetCell(float LocalX, float LocalZ, uint32_t& OutCellX, uint32_t& OutCellZ, float& OutFX, float& OutFZ) const noexcept
+{
+	auto grid_x = min(max(LocalX / m_XYSizeFactor, 0.0f), static_cast<float>(m_CellCountX));
+	auto grid_z = min(max(-LocalZ / m_XYSizeFactor, 0.0f), static_cast<float>(m_CellCountZ));
+
+	OutCellX = min(static_cast<uint32_t>(grid_x), m_CellCountX - 1);
+	OutCellZ = min(static_cast<uint32_t>(grid_z), m_CellCountZ - 1);
+	OutFX = grid_x - static_cast<float>(OutCellX);
+	OutFZ = grid_z - static_cast<float>(OutCellZ);
+}
+
+auto JWHeightField::GetHeight(float LocalX, float LocalZ) const noexcept->float
+{
+	if (!IsCreated()) { return 0; }
+
+	uint32_t x{}, z{};
+	float fx{}, fz{};
+	GetCell(LocalX, LocalZ, x, z, fx, fz);
+
+	auto h00 = GetGridHeight(x, z);
+	auto h10 = GetGridHeight(x + 1, z);
+	auto h01 = GetGridHeight(x, z + 1);
+	auto h11 = GetGridHeight(x + 1, z + 1);
+
+	if (fx + fz <= 1.0f)
+	{
+		return h00 + (h10 - h00) * fx + (h01 - h00) * fz;
+	}
+	return h11 + (h01 - h11) * (1.0f - fx) + (h10 - h11) * (1.0f - fz);
+}
+
+auto JWHeightField::GetNormal(float LocalX, float LocalZ) const noexcept->XMVECTOR
+{
+	if (!IsCreated()) { return XMVectorSet(0, 1, 0, 0); }
+
+	uint32_t x{}, z{};
+	float fx{}, fz{};
+	GetCell(LocalX, LocalZ, x, z, fx, fz);
+
+	auto h00 = GetGridHeight(x, z);
+	auto h10 = GetGridHeight(x + 1, z);
+	auto h01 = GetGridHeight(x, z + 1);
+	auto h11 = GetGridHeight(x + 1, z + 1);
+
+	// @important
+	// Grid z goes toward local -z, so the sign of the z slope is flipped.
+	if (fx + fz <= 1.0f)
+	{
+		return XMVector3Normalize(XMVectorSet(-(h10 - h00), m_XYSizeFactor, (h01 - h00), 0));
+	}
+	return XMVector3Normalize(XMVectorSet(-(h11 - h01), m_XYSizeFactor, (h11 - h10), 0));
+}
+
+PRIVATE void JWHeightField::GetCellVertices(uint32_t CellX, uint32_t CellZ, XMVECTOR(&OutVertices)[4]) const noexcept
+{
+	auto x0 = static_cast<float>(CellX) * m_XYSizeFactor;
+	auto x1 = x0 + m_XYSizeFactor;
+	auto z0 = -static_cast<float>(CellZ) * m_XYSizeFactor;
+	auto z1 = z0 - m_XYSizeFactor;
+
+	OutVertices[0] = XMVectorSet(x0, GetGridHeight(CellX, CellZ), z0, 1);
+	OutVertices[1] = XMVectorSet(x1, GetGridHeight(CellX + 1, CellZ), z0, 1);
+	OutVertices[2] = XMVectorSet(x0, GetGridHeight(CellX, CellZ + 1), z1, 1);
+	OutVertices[3] = XMVectorSet(x1, GetGridHeight(CellX + 1, CellZ + 1), z1, 1);
+}
+
+auto JWHeightField::CastRay(const XMVECTOR& LocalOrigin, const XMVECTOR& LocalDirection, float MaxT,
+	float& OutT, XMVECTOR& OutNormal, XMVECTOR* PtrOutTriangle) const noexcept->bool
+{
+	if (!IsCreated()) { return false; }
+
+	// #1 Grid space (grid z goes toward local -z)
+	auto inverse_size = 1.0f / m_XYSizeFactor;
+	auto grid_x = XMVectorGetX(LocalOrigin) * inverse_size;
+	auto grid_z = -XMVectorGetZ(LocalOrigin) * inverse_size;
+	auto dir_x = XMVectorGetX(LocalDirection) * inverse_size;
+	auto dir_z = -XMVectorGetZ(LocalDirection) * inverse_size;
+
+	// #2 Clip the ray to the grid
+	float t_enter{};
+	float t_exit{ MaxT };
+	if (!ClipRayToSlab(grid_x, dir_x, static_cast<float>(m_CellCountX), t_enter, t_exit)) { return false; }
+	if (!ClipRayToSlab(grid_z, dir_z, static_cast<float>(m_CellCountZ), t_enter, t_exit)) { return false; }
+
+	// #3 DDA
+	auto enter_x = grid_x + dir_x * t_enter;
+	auto enter_z = grid_z + dir_z * t_enter;
+	auto cell_x = static_cast<int32_t>(min(max(floorf(enter_x), 0.0f), static_cast<float>(m_CellCountX - 1)));
+	auto cell_z = static_cast<int32_t>(min(max(floorf(enter_z), 0.0f), static_cast<float>(m_CellCountZ - 1)));
+
+	int32_t step_x = (dir_x > 0) ? 1 : -1;
+	int32_t step_z = (dir_z > 0) ? 1 : -1;
+	auto t_delta_x = (dir_x != 0) ? fabsf(1.0f / dir_x) : FLT_MAX;
+	auto t_delta_z = (dir_z != 0) ? fabsf(1.0f / dir_z) : FLT_MAX;
+	auto t_max_x = (dir_x > 0) ? t_enter + (static_cast<float>(cell_x + 1) - enter_x) / dir_x :
+		(dir_x < 0) ? t_enter + (static_cast<float>(cell_x) - enter_x) / dir_x : FLT_MAX;
+	auto t_max_z = (dir_z > 0) ? t_enter + (static_cast<float>(cell_z + 1) - enter_z) / dir_z :
+		(dir_z < 0) ? t_enter + (static_cast<float>(cell_z) - enter_z) / dir_z : FLT_MAX;
+
+	XMVECTOR v[4]{};
+	XMVECTOR point_on_plane{};
+	auto closest_t = XMVectorReplicate(MaxT);
+	while (true)
+	{
+		GetCellVertices(cell_x, cell_z, v);
+
+		// @important
+		// Cells are visited in the order of t, so the first cell that is hit has the closest hit.
+		int32_t hit_triangle{ -1 };
+		if (IntersectRayTriangle(point_on_plane, closest_t, LocalOrigin, LocalDirection, v[0], v[1], v[2])) { hit_triangle = 0; }
+		if (IntersectRayTriangle(point_on_plane, closest_t, LocalOrigin, LocalDirection, v[1], v[3], v[2])) { hit_triangle = 1; }
+
+		if (hit_triangle >= 0)
+		{
+			OutT = XMVectorGetX(closest_t);
+
+			auto hit_point = LocalOrigin + LocalDirection * OutT;
+			OutNormal = GetNormal(XMVectorGetX(hit_point), XMVectorGetZ(hit_point));
+
+			if (PtrOutTriangle)
+			{
+				PtrOutTriangle[0] = (hit_triangle == 0) ? v[0] : v[1];
+				PtrOutTriangle[1] = (hit_triangle == 0) ? v[1] : v[3];
+				PtrOutTriangle[2] = v[2];
+			}
+			return true;
+		}
+
+		// Next cell
+		if (t_max_x < t_max_z)
+		{
+			if (t_max_x > t_exit) { break; }
+
+			cell_x += step_x;
+			t_max_x += t_delta_x;
+		}
+		else
+		{
+			if (t_max_z > t_exit) { break; }
+
+			cell_z += step_z;
+			t_max_z += t_delta_z;
+		}
+
+		if ((cell_x < 0) || (cell_z < 0) ||
+			(cell_x >= static_cast<int32_t>(m_CellCountX)) || (cell_z >= static_cast<int32_t>(m_CellCountZ)))
+		{
+			break;
+		}
+	}
+
+	return false;
+}
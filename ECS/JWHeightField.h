@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../Core/JWCommon.h"
+
+namespace JWEngine
+{
+	// Terrain as a collision shape, one height per grid point in terrain local space.
+	// Grid point (x, z) is at (x * XYSizeFactor, height, -z * XYSizeFactor).
+	// Each cell is split into (x, z)-(x+1, z)-(x, z+1) and (x+1, z)-(x+1, z+1)-(x, z+1), same as JWTerrainGenerator.
+	// @important: JWHeightField doesn't know about entities or transforms, so every query is in local space.
+	class JWHeightField
+	{
+	public:
+		JWHeightField() = default;
+		~JWHeightField() = default;
+
+		// Heights are gathered from the vertices of the quad-tree nodes, so it works for any terrain source.
+		void Create(const STerrainData& TerrainData) noexcept;
+
+		auto IsCreated() const noexcept { return !m_vHeights.empty(); };
+
+		// Heights and normals are clamped to the border outside of the grid.
+		auto IsInside(float LocalX, float LocalZ) const noexcept->bool;
+
+		// O(1)
+		auto GetHeight(float LocalX, float LocalZ) const noexcept->float;
+		auto GetNormal(float LocalX, float LocalZ) const noexcept->XMVECTOR;
+
+		// Walks the cells under the ray (2D DDA) and tests only the 2 triangles of each cell.
+		// OutT is in units of LocalDirection (which doesn't need to be normalized), only hits in (0, MaxT) count.
+		auto CastRay(const XMVECTOR& LocalOrigin, const XMVECTOR& LocalDirection, float MaxT,
+			float& OutT, XMVECTOR& OutNormal, XMVECTOR* PtrOutTriangle = nullptr) const noexcept->bool;
+
+		// Calls Function(V0, V1, V2) for the 2 triangles of every cell under the local x-z rectangle.
+		template <typename FunctionType>
+		void ForEachTriangle(float MinLocalX, float MinLocalZ, float MaxLocalX, float MaxLocalZ, const FunctionType& Function) const noexcept;
+
+	private:
+		auto GetGridHeight(uint32_t X, uint32_t Z) const noexcept { return m_vHeights[X + Z * m_PointCountX]; };
+
+		// (x, z), (x+1, z), (x, z+1), (x+1, z+1)
+		void GetCellVertices(uint32_t CellX, uint32_t CellZ, XMVECTOR (&OutVertices)[4]) const noexcept;
+
+		// Cell index + position inside the cell in [0, 1]
+		void GetCell(float LocalX, float LocalZ, uint32_t& OutCellX, uint32_t& OutCellZ, float& OutFX, float& OutFZ) const noexcept;
+
+	private:
+		uint32_t		m_CellCountX{};
+		uint32_t		m_CellCountZ{};
+		uint32_t		m_PointCountX{};
+		float			m_XYSizeFactor{ 1.0f };
+
+		VECTOR<float>	m_vHeights{};
+	};
+
+	template <typename FunctionType>
+	void JWHeightField::ForEachTriangle(float MinLocalX, float MinLocalZ, float MaxLocalX, float MaxLocalZ, const FunctionType& Function) const noexcept
+	{
+		if (!IsCreated()) { return; }
+
+		// Entirely outside of the grid (grid z goes toward local -z)
+		if ((MaxLocalX < 0) || (MinLocalX > static_cast<float>(m_CellCountX) * m_XYSizeFactor)) { return; }
+		if ((MinLocalZ > 0) || (MaxLocalZ < -static_cast<float>(m_CellCountZ) * m_XYSizeFactor)) { return; }
+
+		uint32_t min_x{}, min_z{}, max_x{}, max_z{};
+		float fx{}, fz{};
+		GetCell(MinLocalX, MaxLocalZ, min_x, min_z, fx, fz);
+		GetCell(MaxLocalX, MinLocalZ, max_x, max_z, fx, fz);
+
+		XMVECTOR v[4]{};
+		for (auto z = min_z; z <= max_z; ++z)
+		{
+			for (auto x = min_x; x <= max_x; ++x)
+			{
+				GetCellVertices(x, z, v);
+
+				Function(v[0], v[1], v[2]);
+				Function(v[1], v[3], v[2]);
+			}
+		}
+	}
+};
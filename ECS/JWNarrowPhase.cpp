@@ -0,0 +1,617 @@
+#include "JWNarrowPhase.h"
+#include "../Core/JWModel.h"
+#include <cfloat>
+
+// No FMA contraction (deterministic physics)
+#pragma fp_contract(off)
+
+using namespace JWEngine;
+
+static inline auto Dot3(const XMVECTOR& A, const XMVECTOR& B) noexcept->float
+{
+	return XMVectorGetX(XMVector3Dot(A, B));
+}
+
+static inline void SetSimplex(SGJKSimplex& Out, const SSupportPoint& P0, float L0) noexcept
+{
+	Out.Points[0] = P0;
+	Out.Lambdas[0] = L0;
+	Out.Count = 1;
+}
+
+static inline void SetSimplex(SGJKSimplex& Out, const SSupportPoint& P0, float L0, const SSupportPoint& P1, float L1) noexcept
+{
+	Out.Points[0] = P0;
+	Out.Points[1] = P1;
+	Out.Lambdas[0] = L0;
+	Out.Lambdas[1] = L1;
+	Out.Count = 2;
+}
+
+static inline void SetSimplex(SGJKSimplex& Out, const SSupportPoint& P0, float L0, const SSupportPoint& P1, float L1,
+	const SSupportPoint& P2, float L2) noexcept
+{
+	Out.Points[0] = P0;
+	Out.Points[1] = P1;
+	Out.Points[2] = P2;
+	Out.Lambdas[0] = L0;
+	Out.Lambdas[1] = L1;
+	Out.Lambdas[2] = L2;
+	Out.Count = 3;
+}
+
+// Point of the simplex closest to the origin (in Minkowski space)
+static auto GetSimplexClosestPoint(const SGJKSimplex& Simplex) noexcept->XMVECTOR
+{
+	XMVECTOR result{ KVectorZero };
+	for (uint32_t i = 0; i < Simplex.Count; ++i)
+	{
+		result += Simplex.Points[i].W * Simplex.Lambdas[i];
+	}
+	return result;
+}
+
+// @important
+// Inputs are copied first, because they may point into Out.
+static void ClosestPointOnSegment(const SSupportPoint& _P0, const SSupportPoint& _P1, SGJKSimplex& Out) noexcept
+{
+	SSupportPoint p0{ _P0 };
+	SSupportPoint p1{ _P1 };
+
+	auto edge = p1.W - p0.W;
+	auto length_sq = Dot3(edge, edge);
+	auto t = (length_sq > 0) ? -Dot3(p0.W, edge) / length_sq : 0.0f;
+
+	if (t <= 0)
+	{
+		SetSimplex(Out, p0, 1.0f);
+	}
+	else if (t >= 1)
+	{
+		SetSimplex(Out, p1, 1.0f);
+	}
+	else
+	{
+		SetSimplex(Out, p0, 1.0f - t, p1, t);
+	}
+}
+
+// Voronoi region test (Real-Time Collision Detection, 5.1.5) with the origin as the query point
+static void ClosestPointOnTriangle(const SSupportPoint& _P0, const SSupportPoint& _P1, const SSupportPoint& _P2,
+	SGJKSimplex& Out) noexcept
+{
+	SSupportPoint p0{ _P0 };
+	SSupportPoint p1{ _P1 };
+	SSupportPoint p2{ _P2 };
+
+	const auto& a = p0.W;
+	const auto& b = p1.W;
+	const auto& c = p2.W;
+	auto ab = b - a;
+	auto ac = c - a;
+
+	auto d1 = Dot3(ab, -a);
+	auto d2 = Dot3(ac, -a);
+	if ((d1 <= 0) && (d2 <= 0)) { SetSimplex(Out, p0, 1.0f); return; }
+
+	auto d3 = Dot3(ab, -b);
+	auto d4 = Dot3(ac, -b);
+	if ((d3 >= 0) && (d4 <= d3)) { SetSimplex(Out, p1, 1.0f); return; }
+
+	auto vc = d1 * d4 - d3 * d2;
+	if ((vc <= 0) && (d1 >= 0) && (d3 <= 0))
+	{
+		auto v = d1 / (d1 - d3);
+		SetSimplex(Out, p0, 1.0f - v, p1, v);
+		return;
+	}
+
+	auto d5 = Dot3(ab, -c);
+	auto d6 = Dot3(ac, -c);
+	if ((d6 >= 0) && (d5 <= d6)) { SetSimplex(Out, p2, 1.0f); return; }
+
+	auto vb = d5 * d2 - d1 * d6;
+	if ((vb <= 0) && (d2 >= 0) && (d6 <= 0))
+	{
+		auto w = d2 / (d2 - d6);
+		SetSimplex(Out, p0, 1.0f - w, p2, w);
+		return;
+	}
+
+	auto va = d3 * d6 - d5 * d4;
+	if ((va <= 0) && ((d4 - d3) >= 0) && ((d5 - d6) >= 0))
+	{
+		auto w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		SetSimplex(Out, p1, 1.0f - w, p2, w);
+		return;
+	}
+
+	auto denom = 1.0f / (va + vb + vc);
+	auto v = vb * denom;
+	auto w = vc * denom;
+	SetSimplex(Out, p0, 1.0f - v - w, p1, v, p2, w);
+}
+
+// Returns true if the origin is inside the tetrahedron, otherwise reduces Simplex to the closest face's sub-simplex.
+static auto ClosestPointOnTetrahedron(SGJKSimplex& Simplex) noexcept->bool
+{
+	// Face (0, 1, 2) and the vertex opposite to it (3)
+	static constexpr uint32_t KFaces[4][4]{ { 0, 1, 2, 3 }, { 0, 2, 3, 1 }, { 0, 3, 1, 2 }, { 1, 3, 2, 0 } };
+
+	SSupportPoint points[4]{ Simplex.Points[0], Simplex.Points[1], Simplex.Points[2], Simplex.Points[3] };
+
+	SGJKSimplex closest{};
+	float closest_distance_sq{ FLT_MAX };
+	bool is_outside_any_face{ false };
+
+	for (const auto& face : KFaces)
+	{
+		const auto& a = points[face[0]].W;
+		auto n = XMVector3Cross(points[face[1]].W - a, points[face[2]].W - a);
+		auto sign_origin = Dot3(-a, n);
+		auto sign_opposite = Dot3(points[face[3]].W - a, n);
+
+		// Flat tetrahedron can't contain the origin.
+		bool is_outside{ (fabsf(sign_opposite) < FLT_EPSILON) || (sign_origin * sign_opposite < 0) };
+		if (!is_outside) { continue; }
+
+		is_outside_any_face = true;
+
+		SGJKSimplex candidate{};
+		ClosestPointOnTriangle(points[face[0]], points[face[1]], points[face[2]], candidate);
+
+		auto v = GetSimplexClosestPoint(candidate);
+		auto distance_sq = Dot3(v, v);
+		if (distance_sq < closest_distance_sq)
+		{
+			closest_distance_sq = distance_sq;
+			closest = candidate;
+		}
+	}
+
+	if (!is_outside_any_face) { return true; }
+
+	Simplex = closest;
+	return false;
+}
+
+// Barycentric coordinates of P (on the plane of the triangle)
+static void GetBarycentricCoordinates(const XMVECTOR& P, const XMVECTOR& A, const XMVECTOR& B, const XMVECTOR& C,
+	float& OutU, float& OutV, float& OutW) noexcept
+{
+	auto v0 = B - A;
+	auto v1 = C - A;
+	auto v2 = P - A;
+	auto d00 = Dot3(v0, v0);
+	auto d01 = Dot3(v0, v1);
+	auto d11 = Dot3(v1, v1);
+	auto d20 = Dot3(v2, v0);
+	auto d21 = Dot3(v2, v1);
+	auto denom = d00 * d11 - d01 * d01;
+
+	if (fabsf(denom) < FLT_EPSILON)
+	{
+		OutU = 1.0f;
+		OutV = OutW = 0.0f;
+		return;
+	}
+
+	OutV = (d11 * d20 - d01 * d21) / denom;
+	OutW = (d00 * d21 - d01 * d20) / denom;
+	OutU = 1.0f - OutV - OutW;
+}
+
+void JWNarrowPhase::BuildConvexHull(const JWModel& CollisionMesh, SConvexHull& OutHull) noexcept
+{
+	const auto& positions = CollisionMesh.vPositionVertex;
+	const auto& faces = CollisionMesh.ModelData.IndexData.vFaces;
+	const auto& v_to_pv = CollisionMesh.vPositionVertexIndexFromVertexIndex;
+
+	OutHull.vVertices = positions;
+	OutHull.vAdjacencyOffsets.clear();
+	OutHull.vAdjacency.clear();
+
+	VECTOR<VECTOR<uint32_t>> neighbors(positions.size());
+	auto link = [&](size_t A, size_t B)
+	{
+		if (A == B) { return; }
+		neighbors[A].emplace_back(static_cast<uint32_t>(B));
+		neighbors[B].emplace_back(static_cast<uint32_t>(A));
+	};
+
+	for (const auto& face : faces)
+	{
+		auto p0 = v_to_pv[face._0];
+		auto p1 = v_to_pv[face._1];
+		auto p2 = v_to_pv[face._2];
+
+		link(p0, p1);
+		link(p1, p2);
+		link(p2, p0);
+	}
+
+	// Flatten
+	OutHull.vAdjacencyOffsets.reserve(positions.size() + 1);
+	for (auto& iter : neighbors)
+	{
+		std::sort(iter.begin(), iter.end());
+		iter.erase(std::unique(iter.begin(), iter.end()), iter.end());
+
+		OutHull.vAdjacencyOffsets.emplace_back(static_cast<uint32_t>(OutHull.vAdjacency.size()));
+		OutHull.vAdjacency.insert(OutHull.vAdjacency.end(), iter.begin(), iter.end());
+	}
+	OutHull.vAdjacencyOffsets.emplace_back(static_cast<uint32_t>(OutHull.vAdjacency.size()));
+
+	// Convexity
+	OutHull.IsConvex = true;
+	if (positions.size() > 1)
+	{
+		for (const auto& iter : neighbors)
+		{
+			if (iter.empty())
+			{
+				// Hill climbing can't reach a vertex that isn't on any face.
+				OutHull.IsConvex = false;
+				return;
+			}
+		}
+	}
+
+	auto min_corner = XMVectorReplicate(FLT_MAX);
+	auto max_corner = XMVectorReplicate(-FLT_MAX);
+	for (const auto& position : positions)
+	{
+		min_corner = XMVectorMin(min_corner, position);
+		max_corner = XMVectorMax(max_corner, position);
+	}
+	auto tolerance = (positions.empty()) ? 0.0f : KConvexHullTolerance * XMVectorGetX(XMVector3Length(max_corner - min_corner));
+
+	for (const auto& face : faces)
+	{
+		const auto& p0 = positions[v_to_pv[face._0]];
+		auto normal = XMVector3Cross(positions[v_to_pv[face._1]] - p0, positions[v_to_pv[face._2]] - p0);
+		auto normal_length = XMVectorGetX(XMVector3Length(normal));
+		if (normal_length <= FLT_EPSILON) { continue; }
+		normal /= normal_length;
+
+		// Either side is fine, the winding of the faces doesn't matter.
+		bool is_any_above{ false };
+		bool is_any_below{ false };
+		for (const auto& position : positions)
+		{
+			auto distance = Dot3(position - p0, normal);
+			is_any_above |= (distance > tolerance);
+			is_any_below |= (distance < -tolerance);
+		}
+
+		if (is_any_above && is_any_below)
+		{
+			OutHull.IsConvex = false;
+			return;
+		}
+	}
+}
+
+auto JWNarrowPhase::Collide(SConvexShape& A, SConvexShape& B, SConvexContact& OutContact) noexcept->bool
+{
+	OutContact = SConvexContact();
+
+	if (!GJK(A, B, OutContact)) { return false; }
+
+	OutContact.IsIntersecting = true;
+
+	if (ExpandSimplexToTetrahedron(A, B))
+	{
+		EPA(A, B, OutContact);
+	}
+	else
+	{
+		// The Minkowski difference is flat (shapes are only touching).
+		auto center_ba = A.WorldMatrix.r[3] - B.WorldMatrix.r[3];
+		OutContact.Normal = (Dot3(center_ba, center_ba) > 0) ? XMVector3Normalize(center_ba) : XMVectorSet(0, 1, 0, 0);
+		OutContact.PenetrationDepth = 0;
+		OutContact.PointA = m_Simplex.Points[0].A;
+		OutContact.PointB = m_Simplex.Points[0].B;
+	}
+
+	return true;
+}
+
+PRIVATE auto JWNarrowPhase::Support(SConvexShape& Shape, const XMVECTOR& Direction) noexcept->XMVECTOR
+{
+	// World-space direction into local space (by the transpose of the world matrix)
+	auto local_direction = XMVector3TransformNormal(Direction, Shape.WorldMatrixTransposed);
+	uint32_t support_index{};
+
+	if ((Shape.PtrHull) && (Shape.PtrHull->IsConvex))
+	{
+		const auto& hull = *Shape.PtrHull;
+		if (hull.vVertices.empty()) { return Shape.WorldMatrix.r[3]; }
+
+		support_index = min(Shape.LastSupportIndex, static_cast<uint32_t>(hull.vVertices.size() - 1));
+		auto support_dot = Dot3(hull.vVertices[support_index], local_direction);
+
+		// @important
+		// Strictly greater, so that climbing always terminates.
+		bool has_moved{ true };
+		while (has_moved)
+		{
+			has_moved = false;
+
+			for (auto i = hull.vAdjacencyOffsets[support_index]; i < hull.vAdjacencyOffsets[support_index + 1]; ++i)
+			{
+				auto neighbor = hull.vAdjacency[i];
+				auto neighbor_dot = Dot3(hull.vVertices[neighbor], local_direction);
+				if (neighbor_dot > support_dot)
+				{
+					support_index = neighbor;
+					support_dot = neighbor_dot;
+					has_moved = true;
+				}
+			}
+		}
+
+		Shape.LastSupportIndex = support_index;
+		return XMVector3TransformCoord(hull.vVertices[support_index], Shape.WorldMatrix);
+	}
+
+	const auto& vertices = *Shape.PtrVertices;
+	if (vertices.empty()) { return Shape.WorldMatrix.r[3]; }
+
+	auto support_dot = -FLT_MAX;
+	for (uint32_t i = 0; i < static_cast<uint32_t>(vertices.size()); ++i)
+	{
+		auto curr_dot = Dot3(vertices[i], local_direction);
+		if (curr_dot > support_dot)
+		{
+			support_index = i;
+			support_dot = curr_dot;
+		}
+	}
+
+	return XMVector3TransformCoord(vertices[support_index], Shape.WorldMatrix);
+}
+
+PRIVATE auto JWNarrowPhase::SupportMinkowski(SConvexShape& A, SConvexShape& B, const XMVECTOR& Direction) noexcept->SSupportPoint
+{
+	return SSupportPoint(Support(A, Direction), Support(B, -Direction));
+}
+
+PRIVATE auto JWNarrowPhase::GJK(SConvexShape& A, SConvexShape& B, SConvexContact& OutContact) noexcept->bool
+{
+	// Start from the direction between the shapes' origins.
+	auto direction = A.WorldMatrix.r[3] - B.WorldMatrix.r[3];
+	if (Dot3(direction, direction) <= 0) { direction = XMVectorSet(1, 0, 0, 0); }
+
+	SetSimplex(m_Simplex, SupportMinkowski(A, B, direction), 1.0f);
+	auto v = m_Simplex.Points[0].W;
+
+	for (uint32_t iteration = 0; iteration < KGJKMaxIterationCount; ++iteration)
+	{
+		OutContact.GJKIterationCount = iteration + 1;
+
+		auto v_length_sq = Dot3(v, v);
+
+		// The origin is on the simplex.
+		if (v_length_sq <= KGJKTolerance * KGJKTolerance) { return true; }
+
+		auto w = SupportMinkowski(A, B, -v);
+
+		// Converged (w is no closer to the origin than v), so the shapes are separated.
+		if (v_length_sq - Dot3(v, w.W) <= KGJKTolerance * v_length_sq) { break; }
+
+		m_Simplex.Points[m_Simplex.Count] = w;
+		++m_Simplex.Count;
+
+		switch (m_Simplex.Count)
+		{
+		case 2:
+			ClosestPointOnSegment(m_Simplex.Points[0], m_Simplex.Points[1], m_Simplex);
+			break;
+		case 3:
+			ClosestPointOnTriangle(m_Simplex.Points[0], m_Simplex.Points[1], m_Simplex.Points[2], m_Simplex);
+			break;
+		case 4:
+			if (ClosestPointOnTetrahedron(m_Simplex)) { return true; }
+			break;
+		default:
+			break;
+		}
+
+		auto next_v = GetSimplexClosestPoint(m_Simplex);
+
+		// No progress (numerical limit)
+		if (Dot3(next_v, next_v) >= v_length_sq) { break; }
+
+		v = next_v;
+	}
+
+	// Separated
+	OutContact.Distance = sqrtf(Dot3(v, v));
+	OutContact.Normal = XMVector3Normalize(v);
+	OutContact.PointA = OutContact.PointB = KVectorZero;
+	for (uint32_t i = 0; i < m_Simplex.Count; ++i)
+	{
+		OutContact.PointA += m_Simplex.Points[i].A * m_Simplex.Lambdas[i];
+		OutContact.PointB += m_Simplex.Points[i].B * m_Simplex.Lambdas[i];
+	}
+
+	return false;
+}
+
+PRIVATE auto JWNarrowPhase::ExpandSimplexToTetrahedron(SConvexShape& A, SConvexShape& B) noexcept->bool
+{
+	static const XMVECTOR KAxes[6]{
+		XMVectorSet(1, 0, 0, 0), XMVectorSet(-1, 0, 0, 0),
+		XMVectorSet(0, 1, 0, 0), XMVectorSet(0, -1, 0, 0),
+		XMVectorSet(0, 0, 1, 0), XMVectorSet(0, 0, -1, 0) };
+
+	auto& points = m_Simplex.Points;
+
+	if (m_Simplex.Count == 1)
+	{
+		for (const auto& axis : KAxes)
+		{
+			auto w = SupportMinkowski(A, B, axis);
+			auto diff = w.W - points[0].W;
+			if (Dot3(diff, diff) > KEPATolerance * KEPATolerance)
+			{
+				points[m_Simplex.Count++] = w;
+				break;
+			}
+		}
+	}
+
+	if (m_Simplex.Count == 2)
+	{
+		auto edge = points[1].W - points[0].W;
+
+		// The axis least aligned with the edge
+		XMFLOAT3 abs_edge{};
+		XMStoreFloat3(&abs_edge, XMVectorAbs(edge));
+		auto axis = (abs_edge.x <= abs_edge.y && abs_edge.x <= abs_edge.z) ? KAxes[0] : (abs_edge.y <= abs_edge.z) ? KAxes[2] : KAxes[4];
+
+		auto n0 = XMVector3Normalize(XMVector3Cross(edge, axis));
+		auto n1 = XMVector3Normalize(XMVector3Cross(edge, n0));
+		const XMVECTOR directions[4]{ n0, -n0, n1, -n1 };
+
+		for (const auto& direction : directions)
+		{
+			auto w = SupportMinkowski(A, B, direction);
+			auto off_line = XMVector3Cross(w.W - points[0].W, edge);
+			if (Dot3(off_line, off_line) > KEPATolerance * KEPATolerance * Dot3(edge, edge))
+			{
+				points[m_Simplex.Count++] = w;
+				break;
+			}
+		}
+	}
+
+	if (m_Simplex.Count == 3)
+	{
+		auto n = XMVector3Normalize(XMVector3Cross(points[1].W - points[0].W, points[2].W - points[0].W));
+		const XMVECTOR directions[2]{ n, -n };
+
+		for (const auto& direction : directions)
+		{
+			auto w = SupportMinkowski(A, B, direction);
+			if (fabsf(Dot3(w.W - points[0].W, n)) > KEPATolerance)
+			{
+				points[m_Simplex.Count++] = w;
+				break;
+			}
+		}
+	}
+
+	return (m_Simplex.Count == 4);
+}
+
+PRIVATE void JWNarrowPhase::EPA(SConvexShape& A, SConvexShape& B, SConvexContact& OutContact) noexcept
+{
+	m_vPolytopeVertices.assign(m_Simplex.Points, m_Simplex.Points + 4);
+	m_vEPAFaces.clear();
+
+	m_EPAInteriorPoint = (m_vPolytopeVertices[0].W + m_vPolytopeVertices[1].W +
+		m_vPolytopeVertices[2].W + m_vPolytopeVertices[3].W) * 0.25f;
+
+	AddEPAFace(0, 1, 2);
+	AddEPAFace(0, 3, 1);
+	AddEPAFace(0, 2, 3);
+	AddEPAFace(1, 3, 2);
+
+	SEPAFace closest_face{};
+
+	for (uint32_t iteration = 0; iteration < KEPAMaxIterationCount; ++iteration)
+	{
+		if (m_vEPAFaces.empty()) { break; }
+
+		OutContact.EPAIterationCount = iteration + 1;
+
+		closest_face = *std::min_element(m_vEPAFaces.begin(), m_vEPAFaces.end(),
+			[](const SEPAFace& a, const SEPAFace& b) { return a.Distance < b.Distance; });
+
+		auto w = SupportMinkowski(A, B, closest_face.Normal);
+
+		// The polytope can't be expanded further in this direction.
+		if (Dot3(w.W, closest_face.Normal) - closest_face.Distance < KEPATolerance) { break; }
+
+		auto new_index = static_cast<uint32_t>(m_vPolytopeVertices.size());
+		m_vPolytopeVertices.emplace_back(w);
+
+		// Remove every face that can see the new vertex, and keep the boundary (horizon) of the hole.
+		m_vEPAHorizon.clear();
+		for (size_t i = 0; i < m_vEPAFaces.size();)
+		{
+			const auto& face = m_vEPAFaces[i];
+			if (Dot3(face.Normal, w.W - m_vPolytopeVertices[face.Indices[0]].W) > 0)
+			{
+				AddEPAHorizonEdge(face.Indices[0], face.Indices[1]);
+				AddEPAHorizonEdge(face.Indices[1], face.Indices[2]);
+				AddEPAHorizonEdge(face.Indices[2], face.Indices[0]);
+
+				m_vEPAFaces[i] = m_vEPAFaces.back();
+				m_vEPAFaces.pop_back();
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		// Fill the hole
+		for (const auto& edge : m_vEPAHorizon)
+		{
+			AddEPAFace(edge._0, edge._1, new_index);
+		}
+	}
+
+	const auto& v0 = m_vPolytopeVertices[closest_face.Indices[0]];
+	const auto& v1 = m_vPolytopeVertices[closest_face.Indices[1]];
+	const auto& v2 = m_vPolytopeVertices[closest_face.Indices[2]];
+
+	float u{}, v{}, w{};
+	GetBarycentricCoordinates(closest_face.Normal * closest_face.Distance, v0.W, v1.W, v2.W, u, v, w);
+
+	// @important
+	// Moving A by -Normal * Distance separates the shapes, so the b-a direction is -Normal.
+	OutContact.PenetrationDepth = closest_face.Distance;
+	OutContact.Normal = -closest_face.Normal;
+	OutContact.PointA = v0.A * u + v1.A * v + v2.A * w;
+	OutContact.PointB = v0.B * u + v1.B * v + v2.B * w;
+}
+
+PRIVATE void JWNarrowPhase::AddEPAFace(uint32_t I0, uint32_t I1, uint32_t I2) noexcept
+{
+	const auto& a = m_vPolytopeVertices[I0].W;
+	const auto& b = m_vPolytopeVertices[I1].W;
+	const auto& c = m_vPolytopeVertices[I2].W;
+
+	auto n = XMVector3Cross(b - a, c - a);
+	if (Dot3(n, n) < FLT_EPSILON * FLT_EPSILON) { return; }
+	n = XMVector3Normalize(n);
+
+	// Outward
+	if (Dot3(n, a - m_EPAInteriorPoint) < 0)
+	{
+		std::swap(I1, I2);
+		n = -n;
+	}
+
+	m_vEPAFaces.emplace_back(I0, I1, I2, n, max(Dot3(n, a), 0.0f));
+}
+
+PRIVATE void JWNarrowPhase::AddEPAHorizonEdge(uint32_t I0, uint32_t I1) noexcept
+{
+	// An edge shared by two removed faces (in reverse order) is not on the horizon.
+	for (auto& iter : m_vEPAHorizon)
+	{
+		if ((iter._0 == I1) && (iter._1 == I0))
+		{
+			iter = m_vEPAHorizon.back();
+			m_vEPAHorizon.pop_back();
+			return;
+		}
+	}
+
+	m_vEPAHorizon.emplace_back(I0, I1);
+}
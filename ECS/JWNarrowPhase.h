@@ -0,0 +1,176 @@
+#pragma once
+
+#include "../Core/JWCommon.h"
+
+namespace JWEngine
+{
+	class JWModel;
+
+	static constexpr uint32_t	KGJKMaxIterationCount{ 64 };
+	static constexpr uint32_t	KEPAMaxIterationCount{ 64 };
+
+	// Relative tolerance of GJK convergence and absolute tolerance of EPA expansion
+	static constexpr float		KGJKTolerance{ 0.0001f };
+	static constexpr float		KEPATolerance{ 0.0001f };
+
+	// Tolerance of the convexity check of BuildConvexHull(), relative to the size of the mesh
+	static constexpr float		KConvexHullTolerance{ 0.001f };
+
+	enum class ENarrowPhaseType
+	{
+		// Closest point/face classification over world-space faces (see JWSystemPhysics::DetectFineCollision()).
+		FaceSearch,
+
+		// GJK intersection test + EPA penetration depth on the collision mesh's position vertices.
+		// @important: the collision mesh must be convex.
+		GJK,
+	};
+
+	enum class ESupportMappingType
+	{
+		// O(n), every vertex is tested.
+		BruteForce,
+
+		// Walks the vertex adjacency of the (convex) hull from the last support vertex.
+		// Meshes that fail the convexity check of JWNarrowPhase::BuildConvexHull() use BruteForce instead.
+		// Support points of consecutive GJK/EPA iterations are close to each other, so only a few vertices are visited.
+		HillClimbing,
+	};
+
+	// Precomputed per collision mesh for hill-climbing support mapping.
+	// Neighbors of vertex i are vAdjacency[vAdjacencyOffsets[i], vAdjacencyOffsets[i + 1]).
+	struct SConvexHull
+	{
+		VECTOR<XMVECTOR>	vVertices{};
+		VECTOR<uint32_t>	vAdjacencyOffsets{};
+		VECTOR<uint32_t>	vAdjacency{};
+
+		// Hill climbing can stop at a local maximum of a concave mesh, so such meshes fall back to brute force.
+		bool				IsConvex{};
+	};
+
+	// Convex shape = local-space vertices + world matrix.
+	// Support points are searched in local space, so vertices are never transformed as a whole.
+	struct SConvexShape
+	{
+		SConvexShape() {};
+		SConvexShape(const VECTOR<XMVECTOR>& Vertices, const XMMATRIX& _WorldMatrix, const SConvexHull* _PtrHull = nullptr) :
+			PtrVertices{ &Vertices }, PtrHull{ _PtrHull },
+			WorldMatrix{ _WorldMatrix }, WorldMatrixTransposed{ XMMatrixTranspose(_WorldMatrix) } {};
+
+		const VECTOR<XMVECTOR>*	PtrVertices{};
+
+		// nullptr means brute-force support mapping.
+		const SConvexHull*		PtrHull{};
+
+		XMMATRIX				WorldMatrix{};
+		XMMATRIX				WorldMatrixTransposed{};
+
+		// Warm start of hill climbing
+		uint32_t				LastSupportIndex{};
+	};
+
+	// A point of the Minkowski difference (A - B) and the support points it came from.
+	struct SSupportPoint
+	{
+		SSupportPoint() {};
+		SSupportPoint(const XMVECTOR& _A, const XMVECTOR& _B) : W{ _A - _B }, A{ _A }, B{ _B } {};
+
+		XMVECTOR	W{};
+		XMVECTOR	A{};
+		XMVECTOR	B{};
+	};
+
+	struct SGJKSimplex
+	{
+		SSupportPoint	Points[4]{};
+
+		// Barycentric coordinates of the point closest to the origin
+		float			Lambdas[4]{};
+		uint32_t		Count{};
+	};
+
+	struct SEPAFace
+	{
+		SEPAFace() {};
+		SEPAFace(uint32_t __0, uint32_t __1, uint32_t __2, const XMVECTOR& _Normal, float _Distance) :
+			Indices{ __0, __1, __2 }, Normal{ _Normal }, Distance{ _Distance } {};
+
+		uint32_t	Indices[3]{};
+
+		// Outward normal and distance from the origin
+		XMVECTOR	Normal{};
+		float		Distance{};
+	};
+
+	struct SEPAEdge
+	{
+		SEPAEdge() {};
+		SEPAEdge(uint32_t __0, uint32_t __1) : _0{ __0 }, _1{ __1 } {};
+
+		uint32_t	_0{};
+		uint32_t	_1{};
+	};
+
+	struct SConvexContact
+	{
+		bool		IsIntersecting{};
+
+		// Only valid if it's not intersecting
+		float		Distance{};
+
+		// Only valid if it's intersecting
+		float		PenetrationDepth{};
+
+		// @important: in b-a direction (same as SCollisionData::CollisionNormal)
+		XMVECTOR	Normal{};
+
+		// Deepest points of each shape into the other (witness points if not intersecting)
+		XMVECTOR	PointA{};
+		XMVECTOR	PointB{};
+
+		uint32_t	GJKIterationCount{};
+		uint32_t	EPAIterationCount{};
+	};
+
+	// @important: JWNarrowPhase doesn't know about entities or transforms,
+	// so it can be driven (and measured) without JWECS.
+	class JWNarrowPhase
+	{
+	public:
+		JWNarrowPhase() = default;
+		~JWNarrowPhase() = default;
+
+		// Builds vertex adjacency from the collision mesh's faces and checks that the mesh is convex
+		// (every vertex is on one side of every face, and every vertex is on a face).
+		static void BuildConvexHull(const JWModel& CollisionMesh, SConvexHull& OutHull) noexcept;
+
+		// Returns true if the shapes are intersecting, and fills OutContact in both cases.
+		auto Collide(SConvexShape& A, SConvexShape& B, SConvexContact& OutContact) noexcept->bool;
+
+	private:
+		auto Support(SConvexShape& Shape, const XMVECTOR& Direction) noexcept->XMVECTOR;
+		auto SupportMinkowski(SConvexShape& A, SConvexShape& B, const XMVECTOR& Direction) noexcept->SSupportPoint;
+
+		// Returns true if the origin is inside the Minkowski difference.
+		auto GJK(SConvexShape& A, SConvexShape& B, SConvexContact& OutContact) noexcept->bool;
+
+		// Makes a tetrahedron out of a degenerate simplex that contains the origin.
+		auto ExpandSimplexToTetrahedron(SConvexShape& A, SConvexShape& B) noexcept->bool;
+
+		void EPA(SConvexShape& A, SConvexShape& B, SConvexContact& OutContact) noexcept;
+		void AddEPAFace(uint32_t I0, uint32_t I1, uint32_t I2) noexcept;
+		void AddEPAHorizonEdge(uint32_t I0, uint32_t I1) noexcept;
+
+	private:
+		SGJKSimplex				m_Simplex{};
+
+		// EPA scratch buffers (kept to avoid allocation per pair)
+		VECTOR<SSupportPoint>	m_vPolytopeVertices{};
+		VECTOR<SEPAFace>		m_vEPAFaces{};
+		VECTOR<SEPAEdge>		m_vEPAHorizon{};
+
+		// A point inside the polytope, for orienting EPA faces outward
+		XMVECTOR				m_EPAInteriorPoint{};
+	};
+};
@@ -18,64 +18,27 @@ void JWSystemCamera::Destroy() noexcept {}
 
 PRIVATE auto JWSystemCamera::CreateComponent(EntityIndexType EntityIndex) noexcept->ComponentIndexType
 {
-	auto component_index{ static_cast<ComponentIndexType>(m_vComponents.size()) };
-
 	// @important
-	// Save component ID & pointer to Entity & pointer to WindowSize
-	m_vComponents.emplace_back(EntityIndex, component_index, m_pWindowSize);
+	// Save component ID & entity index & pointer to WindowSize
+	auto component_index = m_Components.Create(EntityIndex, m_pWindowSize);
 
 	return component_index;
 }
 
-PRIVATE void JWSystemCamera::DestroyComponent(ComponentIndexType ComponentIndex) noexcept
+PRIVATE void JWSystemCamera::DestroyComponent(EntityIndexType EntityIndex) noexcept
 {
-	if (m_vComponents.size() == 0)
+	if (!m_Components.HasEntity(EntityIndex))
 	{
 		JW_ERROR_ABORT("There is no component to destroy.");
 	}
 
-	if (m_vComponents.size() == 1)
-	{
-		// Ʒ ڵ ϸ... α׷    Ѵٰ  !!
-		//JW_ERROR_RETURN("ī޶ Ʈ  .  鿡 ּ 1 ī޶ ʿմϴ.");
-	}
-
-	// Save the target component's index.
-	auto component_index{ ComponentIndex };
-
-	// Get the last index of the component vector.
-	auto last_index = static_cast<ComponentIndexType>(m_vComponents.size() - 1);
-	
-	// Get pointer to the entity with last_index's component.
-	auto ptr_entity_last_component = m_pECS->GetEntityByIndex(m_vComponents[last_index].EntityIndex);
-
-	// See if the component index is invalid.
-	if (component_index > last_index)
-	{
-		JW_ERROR_ABORT("Invalid component index.");
-	}
-
-	// Swap the last element of the vector and the deleted element if necessary
-	if (component_index < last_index)
-	{
-		m_vComponents[component_index] = std::move(m_vComponents[last_index]);
-		m_vComponents[component_index].ComponentIndex = component_index; // @important
-
-		ptr_entity_last_component->SetComponentCameraIndex(component_index); // @important
-	}
-
-	// Shrink the size of the vector.
-	m_vComponents.pop_back();
+	// Swap-and-pop (the pool fixes the moved component's index and its entity mapping).
+	m_Components.DestroyByEntity(EntityIndex);
 }
 
-PRIVATE auto JWSystemCamera::GetComponentPtr(ComponentIndexType ComponentIndex) noexcept->SComponentCamera*
+PRIVATE auto JWSystemCamera::GetComponentPtr(EntityIndexType EntityIndex) noexcept->SComponentCamera*
 {
-	if (ComponentIndex >= m_vComponents.size())
-	{
-		return nullptr;
-	}
-
-	return &m_vComponents[ComponentIndex];
+	return m_Components.GetByEntity(EntityIndex);
 }
 
 void JWSystemCamera::CaptureViewFrustum() noexcept
@@ -141,7 +104,7 @@ void JWSystemCamera::Execute() noexcept
 {
 	if (m_pCurrentCamera == nullptr)
 	{
-		if (m_vComponents.size())
+		if (m_Components.GetCount())
 		{
 			SetCurrentCamera(0);
 		}
@@ -157,18 +120,21 @@ void JWSystemCamera::Execute() noexcept
 	// Update current camera's position to PS for specular calculation.
 	auto transform = ptr_entity->GetComponentTransform();
 	m_pDX->UpdatePSCBCamera(transform->Position);
+
+	// For frustum culling
+	ExtractFrustumPlanes(CurrentViewProjectionMatrix(), m_CurrentViewFrustumPlanes);
 }
 
 void JWSystemCamera::SetCurrentCamera(size_t ComponentID) noexcept
 {
-	if (m_vComponents.size() == 0)
+	if (m_Components.GetCount() == 0)
 	{
 		JW_ERROR_ABORT("You didn't create any camera.");
 	}
 
-	ComponentID = min(ComponentID, m_vComponents.size() - 1);
+	ComponentID = min(ComponentID, m_Components.GetCount() - 1);
 
-	m_pCurrentCamera = &m_vComponents[ComponentID];
+	m_pCurrentCamera = &m_Components[static_cast<ComponentIndexType>(ComponentID)];
 
 	RotateCurrentCamera(0, 0, 0);
 	UpdateCurrentCameraViewMatrix();
@@ -176,9 +142,9 @@ void JWSystemCamera::SetCurrentCamera(size_t ComponentID) noexcept
 
 void JWSystemCamera::UpdateCamerasProjectionMatrix() noexcept
 {
-	if (m_vComponents.size())
+	if (m_Components.GetCount())
 	{
-		for (auto& iter : m_vComponents)
+		for (auto& iter : m_Components)
 		{
 			if (iter.Type == ECameraType::Orthographic)
 			{
@@ -400,6 +366,10 @@ PRIVATE inline void JWSystemCamera::UpdateCurrentCameraViewMatrix() noexcept
 	const auto& position = transform->Position;
 	const auto& up = transform->Up;
 
+	// @important
+	// Every camera function that moves the camera writes Position in place and ends up here.
+	transform->MarkWorldMatrixDirty();
+
 	const auto& lookat = m_pCurrentCamera->LookAt;
 	const auto& zoom = m_pCurrentCamera->Zoom;
 	
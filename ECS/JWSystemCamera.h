@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../Core/JWCommon.h"
+#include "../Core/JWMath.h"
+#include "JWComponentPool.h"
 
 namespace JWEngine
 {
@@ -124,8 +126,14 @@ namespace JWEngine
 		void CaptureViewFrustum() noexcept;
 		const auto& GetCapturedViewFrustum() const noexcept { return m_CapturedViewFrustumVertices; }
 
+		// KFrustumPlaneCount planes of the current camera, extracted once per frame in Execute().
+		auto GetCurrentViewFrustumPlanes() const noexcept->const XMVECTOR* { return m_CurrentViewFrustumPlanes; }
+
 		void Execute() noexcept;
 
+		// Packed components + entity mapping (for multi-component views)
+		auto& ComponentPool() noexcept { return m_Components; };
+
 		void SetCurrentCamera(size_t ComponentID) noexcept;
 		auto GetCurrentCamera() const noexcept { return m_pCurrentCamera; }
 		auto GetCurrentCameraComponentID() const noexcept { return m_pCurrentCamera->ComponentIndex; }
@@ -155,8 +163,8 @@ namespace JWEngine
 	// Only accesible for JWEntity
 	private:
 		auto CreateComponent(EntityIndexType EntityIndex) noexcept->ComponentIndexType;
-		void DestroyComponent(ComponentIndexType ComponentIndex) noexcept;
-		auto GetComponentPtr(ComponentIndexType ComponentIndex) noexcept->SComponentCamera*;
+		void DestroyComponent(EntityIndexType EntityIndex) noexcept;
+		auto GetComponentPtr(EntityIndexType EntityIndex) noexcept->SComponentCamera*;
 
 	private:
 		inline void MoveFreeLook(ECameraDirection Direction) noexcept;
@@ -171,7 +179,7 @@ namespace JWEngine
 		inline auto GetCurrentCameraViewFrustumFRU() const noexcept->XMVECTOR;
 
 	private:
-		VECTOR<SComponentCamera>	m_vComponents;
+		JWComponentPool<SComponentCamera>	m_Components;
 		
 		JWDX*						m_pDX{};
 		JWECS*						m_pECS{};
@@ -180,5 +188,6 @@ namespace JWEngine
 		SComponentCamera*			m_pCurrentCamera{};
 
 		SViewFrustumVertices		m_CapturedViewFrustumVertices{};
+		XMVECTOR					m_CurrentViewFrustumPlanes[KFrustumPlaneCount]{};
 	};
 };
\ No newline at end of file
@@ -16,67 +16,36 @@ void JWSystemLight::Destroy() noexcept {}
 
 PRIVATE auto JWSystemLight::CreateComponent(EntityIndexType EntityIndex) noexcept->ComponentIndexType
 {
-	auto component_index{ static_cast<ComponentIndexType>(m_vComponents.size()) };
-
 	// @important
-	// Save component ID & pointer to Entity
-	m_vComponents.emplace_back(EntityIndex, component_index);
+	// Save component ID & entity index
+	auto component_index = m_Components.Create(EntityIndex);
 
 	m_ShouldUpdateLights = true;
 
 	return component_index;
 }
 
-PRIVATE void JWSystemLight::DestroyComponent(ComponentIndexType ComponentIndex) noexcept
+PRIVATE void JWSystemLight::DestroyComponent(EntityIndexType EntityIndex) noexcept
 {
-	if (m_vComponents.size() == 0)
+	if (!m_Components.HasEntity(EntityIndex))
 	{
 		JW_ERROR_ABORT("There is no component to destroy.");
 	}
 
-	// Save the target component's index.
-	auto component_index{ ComponentIndex };
-
-	// Get the last index of the component vector.
-	auto last_index = static_cast<ComponentIndexType>(m_vComponents.size() - 1);
-
-	// Get pointer to the entity with last_index's component.
-	auto ptr_entity_last_component = m_pECS->GetEntityByIndex(m_vComponents[last_index].EntityIndex);
-
-	// See if the component index is invalid.
-	if (component_index > last_index)
-	{
-		JW_ERROR_ABORT("Invalid component index.");
-	}
-
-	// Swap the last element of the vector and the deleted element if necessary
-	if (component_index < last_index)
-	{
-		m_vComponents[component_index] = std::move(m_vComponents[last_index]);
-		m_vComponents[component_index].ComponentIndex = component_index; // @important
-
-		ptr_entity_last_component->SetComponentLightIndex(component_index); // @important
-	}
-
-	// Shrink the size of the vector.
-	m_vComponents.pop_back();
+	// Swap-and-pop (the pool fixes the moved component's index and its entity mapping).
+	m_Components.DestroyByEntity(EntityIndex);
 }
 
-PRIVATE auto JWSystemLight::GetComponentPtr(ComponentIndexType ComponentIndex) noexcept->SComponentLight*
+PRIVATE auto JWSystemLight::GetComponentPtr(EntityIndexType EntityIndex) noexcept->SComponentLight*
 {
-	if (ComponentIndex >= m_vComponents.size())
-	{
-		return nullptr;
-	}
-
-	return &m_vComponents[ComponentIndex];
+	return m_Components.GetByEntity(EntityIndex);
 }
 
 void JWSystemLight::Execute() noexcept
 {
 	if (m_ShouldUpdateLights)
 	{
-		for (auto& iter : m_vComponents)
+		for (auto& iter : m_Components)
 		{
 			auto& light_data = iter.LightData;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Core/JWCommon.h"
+#include "JWComponentPool.h"
 
 namespace JWEngine
 {
@@ -85,14 +86,17 @@ namespace JWEngine
 
 		void Execute() noexcept;
 
+		// Packed components + entity mapping (for multi-component views)
+		auto& ComponentPool() noexcept { return m_Components; };
+
 	// Only accesible for JWEntity
 	private:
 		auto CreateComponent(EntityIndexType EntityIndex) noexcept->ComponentIndexType;
-		void DestroyComponent(ComponentIndexType ComponentIndex) noexcept;
-		auto GetComponentPtr(ComponentIndexType ComponentIndex) noexcept->SComponentLight*;
+		void DestroyComponent(EntityIndexType EntityIndex) noexcept;
+		auto GetComponentPtr(EntityIndexType EntityIndex) noexcept->SComponentLight*;
 
 	private:
-		VECTOR<SComponentLight>	m_vComponents;
+		JWComponentPool<SComponentLight>	m_Components;
 
 		JWECS*					m_pECS{};
 		JWDX*					m_pDX{};
@@ -1,5 +1,18 @@
 #include "JWECS.h"
 #include "../Core/JWMath.h"
+#include <cfloat>
+
+// No FMA contraction, the results must be the same on every build (see SetDeterministicMode()).
+// @important
+// This only covers the compiler's own contraction of scalar math.
+// DirectXMath's explicit FMA3 path (_XM_FMA3_INTRINSICS_) is a build-wide choice, so it's recorded in snapshots instead.
+#pragma fp_contract(off)
+
+#if defined(_XM_FMA3_INTRINSICS_)
+static constexpr uint32_t KPhysicsMathPath{ 1 };
+#else
+static constexpr uint32_t KPhysicsMathPath{ 0 };
+#endif
 
 using namespace JWEngine;
 
@@ -17,18 +30,13 @@ void JWSystemPhysics::Destroy() noexcept {}
 
 PRIVATE auto JWSystemPhysics::CreateComponent(EntityIndexType EntityIndex) noexcept->ComponentIndexType
 {
-	auto component_index{ static_cast<ComponentIndexType>(m_vComponents.size()) };
-
 	// @important
-	// Save component ID & pointer to Entity
-	m_vComponents.emplace_back(EntityIndex, component_index);
-
-	// Get pointer to the entity.
-	auto ptr_entity = m_pECS->GetEntityByIndex(EntityIndex);
+	// Save component ID & entity index
+	auto component_index = m_Components.Create(EntityIndex);
 
 	// Set world matrix of bounding ellipsoid
-	auto transform = ptr_entity->GetComponentTransform();
-	const auto& bounding_sphere = m_vComponents[component_index].BoundingSphere;
+	auto transform = m_pECS->SystemTransform().ComponentPool().GetByEntity(EntityIndex);
+	const auto& bounding_sphere = m_Components[component_index].BoundingSphere;
 
 	auto temp_center = bounding_sphere.Center;
 	if (transform) { temp_center += transform->Position; }
@@ -45,55 +53,33 @@ PRIVATE auto JWSystemPhysics::CreateComponent(EntityIndexType EntityIndex) noexc
 	return component_index;
 }
 
-PRIVATE void JWSystemPhysics::DestroyComponent(ComponentIndexType ComponentIndex) noexcept
+PRIVATE void JWSystemPhysics::DestroyComponent(EntityIndexType EntityIndex) noexcept
 {
-	if (m_vComponents.size() == 0)
+	if (!m_Components.HasEntity(EntityIndex))
 	{
 		JW_ERROR_ABORT("There is no component to destroy.");
 	}
 
-	// Save the target component's index.
-	auto component_index{ ComponentIndex };
-
-	// Get the last index of the component vector.
-	auto last_index = static_cast<ComponentIndexType>(m_vComponents.size() - 1);
-
-	// Get pointer to the entity with last_index's component.
-	auto ptr_entity_last_component = m_pECS->GetEntityByIndex(m_vComponents[last_index].EntityIndex);
-
-	// See if the component index is invalid.
-	if (component_index > last_index)
-	{
-		JW_ERROR_ABORT("Invalid component index.");
-	}
-
 	/// Erase bounding ellipsoid instance in JWSystemRender
 	///m_pECS->SystemRender().EraseBoundingEllipsoidInstance(component_index);
 
 	// Erase bounding sphere instance in JWSystemRender
-	m_pECS->SystemRender().EraseBoundingSphereInstance(component_index);
+	m_pECS->SystemRender().EraseBoundingSphereInstance(m_Components.GetComponentIndex(EntityIndex));
 
-	// Swap the last element of the vector and the deleted element if necessary
-	if (component_index < last_index)
+	auto& proxy_id = m_Components.GetByEntity(EntityIndex)->SceneQueryProxyID;
+	if (proxy_id != KInvalidAABBTreeNodeID)
 	{
-		m_vComponents[component_index] = std::move(m_vComponents[last_index]);
-		m_vComponents[component_index].ComponentIndex = component_index; // @important
-
-		ptr_entity_last_component->SetComponentPhysicsIndex(component_index); // @important
+		m_SceneQueryTree.DestroyProxy(proxy_id);
+		proxy_id = KInvalidAABBTreeNodeID;
 	}
 
-	// Shrink the size of the vector.
-	m_vComponents.pop_back();
+	// Swap-and-pop (the pool fixes the moved component's index and its entity mapping).
+	m_Components.DestroyByEntity(EntityIndex);
 }
 
-PRIVATE auto JWSystemPhysics::GetComponentPtr(ComponentIndexType ComponentIndex) noexcept->SComponentPhysics*
+PRIVATE auto JWSystemPhysics::GetComponentPtr(EntityIndexType EntityIndex) noexcept->SComponentPhysics*
 {
-	if (ComponentIndex >= m_vComponents.size())
-	{
-		return nullptr;
-	}
-
-	return &m_vComponents[ComponentIndex];
+	return m_Components.GetByEntity(EntityIndex);
 }
 
 void JWSystemPhysics::AddMaterialFrictionData(const STRING& MaterialName, float StaticFrictionConstant, float KineticFrictionConstant)
@@ -131,13 +117,13 @@ auto JWSystemPhysics::GetMaterialFrictionData(EPhysicsMaterial Material)->const
 
 auto JWSystemPhysics::PickEntity() noexcept->bool
 {
-	m_pPickedEntity = nullptr;
+	m_PickedEntityHandle = KInvalidEntityHandle;
 	m_pPickedTerrainEntity = nullptr;
 	m_pPickedNonTerrainEntity = nullptr;
 	
 	CastPickingRay();
 
-	if (m_vComponents.size() == 0)
+	if (m_Components.GetCount() == 0)
 	{
 		return false;
 	}
@@ -162,7 +148,7 @@ auto JWSystemPhysics::PickEntity() noexcept->bool
 		if (XMVector3Less(m_PickedNonTerrainDistance, m_PickedTerrainDistance))
 		{
 			m_PickedDistance = m_PickedNonTerrainDistance;
-			m_pPickedEntity = m_pPickedNonTerrainEntity;
+			if (m_pPickedNonTerrainEntity) { m_PickedEntityHandle = m_pPickedNonTerrainEntity->GetEntityHandle(); }
 
 			m_PickedTriangle[0] = KVectorZero;
 			m_PickedTriangle[1] = KVectorZero;
@@ -171,10 +157,10 @@ auto JWSystemPhysics::PickEntity() noexcept->bool
 		else
 		{
 			m_PickedDistance = m_PickedTerrainDistance;
-			m_pPickedEntity = m_pPickedTerrainEntity;
+			if (m_pPickedTerrainEntity) { m_PickedEntityHandle = m_pPickedTerrainEntity->GetEntityHandle(); }
 		}
 
-		if (m_pPickedEntity)
+		if (m_PickedEntityHandle != KInvalidEntityHandle)
 		{
 			m_PickedPoint = m_PickingRayOrigin + m_PickedDistance * m_PickingRayDirection;
 		}
@@ -223,7 +209,7 @@ PRIVATE __forceinline void JWSystemPhysics::CastPickingRay() noexcept
 /*
 PRIVATE auto JWSystemPhysics::PickEntityByEllipsoid() noexcept->bool
 {
-	for (auto iter : m_vComponents)
+	for (auto iter : m_Components)
 	{
 		auto ptr_entity = m_pECS->GetEntityByIndex(iter.EntityIndex);
 
@@ -289,64 +275,66 @@ PRIVATE auto JWSystemPhysics::PickEntityByEllipsoid() noexcept->bool
 
 PRIVATE auto JWSystemPhysics::PickEntityBySphere() noexcept->bool
 {
-	for (auto iter : m_vComponents)
-	{
-		auto ptr_entity = m_pECS->GetEntityByIndex(iter.EntityIndex);
-
-		auto transform{ ptr_entity->GetComponentTransform() };
-		auto type{ ptr_entity->GetEntityType() };
-
-		if (type != EEntityType::UserDefined)
+	// Only the bounding spheres that the picking ray hits are visited.
+	m_SceneQueryTree.ForEachRayHit(SSceneRayQuery(m_PickingRayOrigin, m_PickingRayDirection),
+		[this](uint32_t EntityIndex, float)
 		{
-			// MainSprite, MainTerrain need to be picked
-			if (!(
-				(type == EEntityType::MainSprite) ||
-				(type == EEntityType::MainTerrain)
-				))
-			{
-				continue;
-			}
-		}
+			auto ptr_entity = m_pECS->GetEntityByIndex(EntityIndex);
 
-		if (transform)
-		{
-			auto camera{ ptr_entity->GetComponentCamera() };
-			if (camera)
+			auto transform{ ptr_entity->GetComponentTransform() };
+			auto type{ ptr_entity->GetEntityType() };
+
+			if (type != EEntityType::UserDefined)
 			{
-				// @important
-				// You must be UNABLE to pick the current camera!
-				if (m_pECS->SystemCamera().GetCurrentCameraComponentID() == camera->ComponentIndex)
+				// MainSprite, MainTerrain need to be picked
+				if (!(
+					(type == EEntityType::MainSprite) ||
+					(type == EEntityType::MainTerrain)
+					))
 				{
-					continue;
+					return;
 				}
 			}
 
-			auto physics = ptr_entity->GetComponentPhysics();
-			if (physics)
+			if (transform)
 			{
-				auto world_center = physics->BoundingSphere.Center;
-				if (transform)
-				{
-					world_center += transform->Position;
-				}
-				if (type == EEntityType::MainTerrain)
+				auto camera{ ptr_entity->GetComponentCamera() };
+				if (camera)
 				{
-					if (IntersectRaySphere(m_PickingRayOrigin, m_PickingRayDirection, physics->BoundingSphere.Radius, world_center))
+					// @important
+					// You must be UNABLE to pick the current camera!
+					if (m_pECS->SystemCamera().GetCurrentCameraComponentID() == camera->ComponentIndex)
 					{
-						m_pPickedTerrainEntity = ptr_entity;
+						return;
 					}
 				}
-				else
+
+				auto physics = ptr_entity->GetComponentPhysics();
+				if (physics)
 				{
-					if (IntersectRaySphere(m_PickingRayOrigin, m_PickingRayDirection, physics->BoundingSphere.Radius, world_center,
-						&m_PickedNonTerrainDistance))
+					auto world_center = physics->BoundingSphere.Center;
+					if (transform)
+					{
+						world_center += transform->Position;
+					}
+					if (type == EEntityType::MainTerrain)
 					{
-						m_pPickedNonTerrainEntity = ptr_entity;
+						if (IntersectRaySphere(m_PickingRayOrigin, m_PickingRayDirection, physics->BoundingSphere.Radius, world_center))
+						{
+							m_pPickedTerrainEntity = ptr_entity;
+						}
+					}
+					else
+					{
+						if (IntersectRaySphere(m_PickingRayOrigin, m_PickingRayDirection, physics->BoundingSphere.Radius, world_center,
+							&m_PickedNonTerrainDistance))
+						{
+							m_pPickedNonTerrainEntity = ptr_entity;
+						}
 					}
 				}
 			}
-		}
-	}
+		});
 
 	if ((m_pPickedTerrainEntity) || (m_pPickedNonTerrainEntity))
 	{
@@ -438,50 +426,40 @@ PRIVATE void JWSystemPhysics::PickTerrainTriangle() noexcept
 		if (ptr_terrain == nullptr) { return; }
 
 		auto transform = m_pPickedTerrainEntity->GetComponentTransform();
-		
-		XMVECTOR v[3]{};
-		auto picked_distance{ KVectorMax };
-
-		for (auto& bs : m_vPickedSubBoundingSphereID)
+		auto world_matrix = (transform) ? transform->WorldMatrix : XMMatrixIdentity();
+
+		// @important
+		// The ray is cast in terrain local space (t is the same in both spaces), so no vertex is transformed.
+		auto inverse_world_matrix = XMMatrixInverse(nullptr, world_matrix);
+		auto local_origin = XMVector3TransformCoord(m_PickingRayOrigin, inverse_world_matrix);
+		auto local_direction = XMVector3TransformNormal(m_PickingRayDirection, inverse_world_matrix);
+
+		float t{};
+		XMVECTOR normal{};
+		XMVECTOR triangle[3]{};
+		if (GetHeightField(ptr_terrain)->CastRay(local_origin, local_direction, FLT_MAX, t, normal, triangle))
 		{
-			for (auto& node : ptr_terrain->QuadTree)
-			{
-				if (node.SubBoundingVolumeID == bs)
-				{
-					const auto& faces{ node.IndexData.vFaces };
-					const auto& vertices{ node.VertexData.vVerticesModel };
-					for (auto triangle : faces)
-					{
-						if (transform)
-						{
-							// Move vertices from local space to world space!
-							v[0] = XMVector3TransformCoord(vertices[triangle._0].Position, transform->WorldMatrix);
-							v[1] = XMVector3TransformCoord(vertices[triangle._1].Position, transform->WorldMatrix);
-							v[2] = XMVector3TransformCoord(vertices[triangle._2].Position, transform->WorldMatrix);
-						}
+			m_PickedPoint = m_PickingRayOrigin + t * m_PickingRayDirection;
+			m_PickedTriangle[0] = XMVector3TransformCoord(triangle[0], world_matrix);
+			m_PickedTriangle[1] = XMVector3TransformCoord(triangle[1], world_matrix);
+			m_PickedTriangle[2] = XMVector3TransformCoord(triangle[2], world_matrix);
 
-						if (IntersectRayTriangle(m_PickedPoint, picked_distance,
-							m_PickingRayOrigin, m_PickingRayDirection,
-							v[0], v[1], v[2]))
-						{
-							m_PickedTriangle[0] = v[0];
-							m_PickedTriangle[1] = v[1];
-							m_PickedTriangle[2] = v[2];
-						}
-					}
-				}
-			}
+			m_PickedTerrainDistance = XMVectorReplicate(t);
 		}
-
-		m_PickedTerrainDistance = picked_distance;
 	}
 }
 
+auto JWSystemPhysics::GetPickedEntity() const noexcept->JWEntity*
+{
+	return m_pECS->GetEntityByHandle(m_PickedEntityHandle);
+}
+
 auto JWSystemPhysics::GetPickedEntityName() const noexcept->const STRING&
 {
-	if (m_pPickedEntity) 
+	auto picked_entity = GetPickedEntity();
+	if (picked_entity)
 	{
-		return m_pPickedEntity->GetEntityName();
+		return picked_entity->GetEntityName();
 	}
 
 	return KNoName;
@@ -497,6 +475,207 @@ void JWSystemPhysics::ToggleSystemPhysicsFlag(JWFlagSystemPhysicsOption Flag) no
 	m_FlagSystemPhyscisOption ^= Flag;
 }
 
+void JWSystemPhysics::SetBroadPhaseType(EBroadPhaseType Type) noexcept
+{
+	m_BroadPhase.SetType(Type);
+}
+
+void JWSystemPhysics::SetTimeStepMode(EPhysicsTimeStepMode Mode) noexcept
+{
+	// Variable time step depends on the frame rate.
+	assert(!((m_IsDeterministicMode) && (Mode == EPhysicsTimeStepMode::Variable)));
+	if ((m_IsDeterministicMode) && (Mode == EPhysicsTimeStepMode::Variable)) { return; }
+
+	m_TimeStepMode = Mode;
+	m_TimeAccumulator = 0;
+	m_InterpolationAlpha = 0;
+
+	if (m_TimeStepMode == EPhysicsTimeStepMode::Variable)
+	{
+		ClearInterpolatedWorldMatrices();
+	}
+}
+
+void JWSystemPhysics::SetFixedStepFrequency(float Hz) noexcept
+{
+	assert(Hz > 0);
+
+	if (Hz > 0)
+	{
+		m_FixedDeltaTime = 1.0f / Hz;
+	}
+}
+
+void JWSystemPhysics::SetDeterministicMode(bool IsDeterministic) noexcept
+{
+	if (IsDeterministic)
+	{
+		SetTimeStepMode(EPhysicsTimeStepMode::Fixed);
+	}
+
+	m_IsDeterministicMode = IsDeterministic;
+}
+
+void JWSystemPhysics::Simulate(uint32_t StepCount) noexcept
+{
+	if (m_TimeStepMode == EPhysicsTimeStepMode::Variable) { return; }
+
+	for (uint32_t i = 0; i < StepCount; ++i)
+	{
+		// World matrices must be up to date for the collision detection of every step.
+		m_pECS->SystemTransform().Execute();
+
+		SavePreviousStates();
+		Step(m_FixedDeltaTime);
+	}
+
+	UpdateSceneQueryTree();
+}
+
+auto JWSystemPhysics::GetSnapshotSize() const noexcept->uint32_t
+{
+	return static_cast<uint32_t>(sizeof(SPhysicsSnapshotHeader) + sizeof(SPhysicsBodyState) * m_Components.GetCount() +
+		m_ContactSolver.GetStateSize());
+}
+
+void JWSystemPhysics::SaveSnapshot(SPhysicsSnapshot& Snapshot) noexcept
+{
+	Snapshot.Size = GetSnapshotSize();
+	if (Snapshot.vData.size() < Snapshot.Size)
+	{
+		Snapshot.vData.resize(Snapshot.Size);
+	}
+
+	auto ptr_dest = Snapshot.vData.data();
+
+	SPhysicsSnapshotHeader header{};
+	header.MathPath = KPhysicsMathPath;
+	header.ComponentCount = m_Components.GetCount();
+	header.StepIndex = m_StepIndex;
+	header.LastSleepIslandID = m_LastSleepIslandID;
+	header.TimeAccumulator = m_TimeAccumulator;
+	memcpy(ptr_dest, &header, sizeof(header));
+	ptr_dest += sizeof(header);
+
+	auto& transform_pool = m_pECS->SystemTransform().ComponentPool();
+	SPhysicsBodyState state{};
+	for (const auto& iter : m_Components)
+	{
+		// @important
+		// Padding and the transform of bodies without one are written too,
+		// so they must be zero for identical states to give identical bytes.
+		memset(&state, 0, sizeof(state));
+
+		state.EntityIndex = iter.EntityIndex;
+		state.Velocity = iter.Velocity;
+		state.LinearAcceleration = iter.LinearAcceleration;
+		state.AngularVelocity = iter.AngularVelocity;
+		state.AngularAcceleration = iter.AngularAcceleration;
+		state.AccumulatedForce = iter.AccumulatedForce;
+		state.PreviousPosition = iter.PreviousPosition;
+		state.PreviousPitchYawRoll = iter.PreviousPitchYawRoll;
+		state.CCDHitNormal = iter.CCDHitNormal;
+		state.CCDTimeOfImpact = iter.CCDTimeOfImpact;
+		state.SleepTimer = iter.SleepTimer;
+		state.SleepIslandID = iter.SleepIslandID;
+		state.SleepWorldMatrixVersion = iter.SleepWorldMatrixVersion;
+		state.HasPreviousState = iter.HasPreviousState;
+		state.IsSleeping = iter.IsSleeping;
+
+		auto transform = transform_pool.GetByEntity(iter.EntityIndex);
+		state.HasTransform = (transform != nullptr);
+		if (transform)
+		{
+			state.IsWorldMatrixDirty = transform->IsWorldMatrixDirty;
+			state.WorldMatrixVersion = transform->WorldMatrixVersion;
+			state.Position = transform->Position;
+			state.PitchYawRoll = transform->PitchYawRoll;
+			state.Forward = transform->Forward;
+			state.Right = transform->Right;
+			state.WorldMatrix = transform->WorldMatrix;
+		}
+
+		memcpy(ptr_dest, &state, sizeof(state));
+		ptr_dest += sizeof(state);
+	}
+
+	m_ContactSolver.SaveState(ptr_dest);
+}
+
+auto JWSystemPhysics::RestoreSnapshot(const SPhysicsSnapshot& Snapshot) noexcept->bool
+{
+	// #1 Validate everything before anything is read into the system
+	// (the contact solver's part depends on the manifold count saved in the snapshot, not on the current one).
+	if ((Snapshot.Size > Snapshot.vData.size()) || (Snapshot.Size < sizeof(SPhysicsSnapshotHeader))) { return false; }
+
+	auto ptr_source = Snapshot.vData.data();
+
+	SPhysicsSnapshotHeader header{};
+	memcpy(&header, ptr_source, sizeof(header));
+	ptr_source += sizeof(header);
+
+	if (header.MathPath != KPhysicsMathPath) { return false; }
+	if (header.ComponentCount != m_Components.GetCount()) { return false; }
+
+	auto solver_offset = static_cast<uint32_t>(sizeof(SPhysicsSnapshotHeader) + sizeof(SPhysicsBodyState) * header.ComponentCount);
+	if (Snapshot.Size < solver_offset + KContactSolverStateHeaderSize) { return false; }
+	if (Snapshot.Size != solver_offset + JWContactSolver::GetSavedStateSize(Snapshot.vData.data() + solver_offset)) { return false; }
+
+	// Components must be the same ones (in the same order) before anything is overwritten.
+	SPhysicsBodyState state{};
+	for (uint32_t i = 0; i < header.ComponentCount; ++i)
+	{
+		memcpy(&state, ptr_source + sizeof(SPhysicsBodyState) * i, sizeof(state));
+		if (state.EntityIndex != m_Components[i].EntityIndex) { return false; }
+	}
+
+	auto& transform_pool = m_pECS->SystemTransform().ComponentPool();
+	for (auto& iter : m_Components)
+	{
+		memcpy(&state, ptr_source, sizeof(state));
+		ptr_source += sizeof(state);
+
+		iter.Velocity = state.Velocity;
+		iter.LinearAcceleration = state.LinearAcceleration;
+		iter.AngularVelocity = state.AngularVelocity;
+		iter.AngularAcceleration = state.AngularAcceleration;
+		iter.AccumulatedForce = state.AccumulatedForce;
+		iter.PreviousPosition = state.PreviousPosition;
+		iter.PreviousPitchYawRoll = state.PreviousPitchYawRoll;
+		iter.CCDHitNormal = state.CCDHitNormal;
+		iter.CCDTimeOfImpact = state.CCDTimeOfImpact;
+		iter.SleepTimer = state.SleepTimer;
+		iter.SleepIslandID = state.SleepIslandID;
+		iter.SleepWorldMatrixVersion = state.SleepWorldMatrixVersion;
+		iter.HasPreviousState = state.HasPreviousState;
+		iter.IsSleeping = state.IsSleeping;
+
+		auto transform = transform_pool.GetByEntity(iter.EntityIndex);
+		if ((transform) && (state.HasTransform))
+		{
+			// @important
+			// WorldMatrixVersion is restored together with WorldMatrix,
+			// so caches that were built from this matrix (world-space hulls, sleep checks) are still valid.
+			transform->IsWorldMatrixDirty = state.IsWorldMatrixDirty;
+			transform->WorldMatrixVersion = state.WorldMatrixVersion;
+			transform->Position = state.Position;
+			transform->PitchYawRoll = state.PitchYawRoll;
+			transform->Forward = state.Forward;
+			transform->Right = state.Right;
+			transform->WorldMatrix = state.WorldMatrix;
+		}
+	}
+
+	m_ContactSolver.RestoreState(ptr_source);
+
+	m_StepIndex = header.StepIndex;
+	m_LastSleepIslandID = header.LastSleepIslandID;
+	m_TimeAccumulator = header.TimeAccumulator;
+
+	UpdateSceneQueryTree(true);
+	return true;
+}
+
 void JWSystemPhysics::ApplyUniversalGravity() noexcept
 {
 	if (m_FlagSystemPhyscisOption & JWFlagSystemPhysicsOption_ApplyForces)
@@ -507,9 +686,9 @@ void JWSystemPhysics::ApplyUniversalGravity() noexcept
 
 void JWSystemPhysics::ApplyUniversalAcceleration(const XMVECTOR& _Acceleration) noexcept
 {
-	for (auto& iter : m_vComponents)
+	for (auto& iter : m_Components)
 	{
-		if (iter.InverseMass > 0)
+		if ((iter.InverseMass > 0) && (iter.IsSimulated) && (!iter.IsSleeping))
 		{
 			iter.AccumulatedForce += _Acceleration / iter.InverseMass;
 		}
@@ -518,7 +697,7 @@ void JWSystemPhysics::ApplyUniversalAcceleration(const XMVECTOR& _Acceleration)
 
 void JWSystemPhysics::ZeroAllVelocities() noexcept
 {
-	for (auto& iter : m_vComponents)
+	for (auto& iter : m_Components)
 	{
 		if (iter.InverseMass > 0)
 		{
@@ -529,99 +708,231 @@ void JWSystemPhysics::ZeroAllVelocities() noexcept
 
 void JWSystemPhysics::Execute() noexcept
 {
+	auto delta_time = m_pECS->GetDeltaTime();
+
+	if (m_TimeStepMode == EPhysicsTimeStepMode::Variable)
+	{
+		assert(delta_time > 0);
+
+		// FOR DEBUGGING ?????
+		delta_time = min(delta_time, 0.1f);
+
+		Step(delta_time);
+		m_SubstepCount = 1;
+
+		UpdateSceneQueryTree();
+		return;
+	}
+
+	// @important
+	// Every step uses the same delta time, so the simulation doesn't depend on the frame rate.
+	m_TimeAccumulator += delta_time;
+	m_SubstepCount = 0;
+	while ((m_TimeAccumulator >= m_FixedDeltaTime) && (m_SubstepCount < m_MaxSubstepCount))
+	{
+		// SystemTransform is executed before SystemPhysics only once per frame,
+		// so world matrices must be rebuilt for the collision detection of the next substep.
+		if (m_SubstepCount)
+		{
+			m_pECS->SystemTransform().Execute();
+		}
+
+		SavePreviousStates();
+		Step(m_FixedDeltaTime);
+
+		m_TimeAccumulator -= m_FixedDeltaTime;
+		++m_SubstepCount;
+	}
+
+	// Too slow to catch up, drop the time that is left.
+	if (m_TimeAccumulator >= m_FixedDeltaTime)
+	{
+		m_TimeAccumulator = fmodf(m_TimeAccumulator, m_FixedDeltaTime);
+	}
+
+	m_InterpolationAlpha = m_TimeAccumulator / m_FixedDeltaTime;
+	UpdateInterpolatedWorldMatrices();
+
+	UpdateSceneQueryTree();
+}
+
+PRIVATE void JWSystemPhysics::Step(float DeltaTime) noexcept
+{
+	++m_StepIndex;
+
+	// Bodies woken up since the last step (by forces, velocities or transforms) wake up their islands.
+	WakeUpSleepIslands();
+
 	// Collision #1
 	DetectCoarseCollision();
 
 	// Collision #2
+	auto fine_collision_start_time = STEADY_CLOCK::now();
 	DetectFineCollision();
+	m_FineCollisionTime = std::chrono::duration_cast<TIME_UNIT_mS>(STEADY_CLOCK::now() - fine_collision_start_time).count();
+
+	// @important
+	// Velocities are integrated before solving contacts, positions after it.
+	IntegrateVelocities(DeltaTime);
 
 	// Collision #3
-	ProcessCollision();
+	ProcessCollision(DeltaTime);
 
-	for (auto& iter : m_vComponents)
-	{
-		// Get pointer to the entity.
-		auto ptr_entity = m_pECS->GetEntityByIndex(iter.EntityIndex);
+	UpdateSleepStates(DeltaTime);
 
-		auto transform{ ptr_entity->GetComponentTransform() };
-		if (transform)
+	// Collision #4
+	DetectContinuousCollision(DeltaTime);
+
+	// @important
+	// Each physics component only touches its own transform and its own bounding-sphere instance,
+	// so chunks are independent. (Instances are uploaded to GPU later by SystemRender.)
+	auto& transform_pool = m_pECS->SystemTransform().ComponentPool();
+	m_pECS->JobSystem().ParallelFor(m_Components.GetCount(), KJobSystemDefaultMinChunkSize,
+		[this, &transform_pool, DeltaTime](uint32_t Begin, uint32_t End)
 		{
-			if (iter.InverseMass > 0)
-			{
-				auto delta_time = m_pECS->GetDeltaTime();
-				assert(delta_time > 0);
+			// Physics + Transform view (no JWEntity lookups)
+			ForEachEntityWith(Begin, End, [this, DeltaTime](SComponentPhysics& iter, SComponentTransform& transform)
+				{
+					if ((iter.InverseMass > 0) && (iter.IsSimulated))
+					{
+						if (iter.IsSleeping)
+						{
+							// Sleeping bodies don't move, so their bounding spheres are still valid.
+							if ((transform.WorldMatrixVersion == iter.SleepWorldMatrixVersion) && (!transform.IsWorldMatrixDirty)) { return; }
 
-				// FOR DEBUGGING ?????
-				delta_time = min(delta_time, 0.1f);
+							// The transform was changed from outside.
+							iter.WakeUp();
+						}
 
-				// a = 1/m * f
-				iter.LinearAcceleration = iter.InverseMass * iter.AccumulatedForce;
+						// meet my world floor
+						if (XMVectorGetY(transform.Position) < KPhysicsWorldFloor)
+						{
+							iter.Velocity = KVectorZero;
+						}
 
-				// v' = v + at
-				iter.Velocity += iter.LinearAcceleration * delta_time;
+						// p' = p + vt
+						// (CCD stops fast bodies at their time of impact)
+						transform.Translate(iter.Velocity * DeltaTime * iter.CCDTimeOfImpact);
+						if (iter.CCDTimeOfImpact < 1.0f)
+						{
+							// Don't move into the surface any more
+							iter.Velocity -= iter.CCDHitNormal * min(XMVectorGetX(XMVector3Dot(iter.Velocity, iter.CCDHitNormal)), 0.0f);
+							iter.CCDTimeOfImpact = 1.0f;
+						}
 
-				// apply linear damping
-				iter.Velocity *= powf(iter.LinearDamping, delta_time);
+						// update angular speed
+						transform.RotatePitchYawRoll(iter.AngularVelocity * DeltaTime);
+
+						// DEBUGGING
+						/*
+						std::cout
+							<< "Position = { " 
+							<< TO_STRING(XMVectorGetX(transform.Position)) << " , "
+							<< TO_STRING(XMVectorGetY(transform.Position)) << " , "
+							<< TO_STRING(XMVectorGetZ(transform.Position)) << " }"
+							<< std::endl;
+						*/
+					}
 
-				// apply angular damping
-				iter.AngularVelocity *= powf(iter.AngularDamping, delta_time);
+					/// Update bounding ellipsoid
+					///UpdateBoundingEllipsoid(iter);
 
-				// killing micro-collisions ...?
-				auto velocity_x = XMVectorGetX(iter.Velocity);
-				auto velocity_y = XMVectorGetY(iter.Velocity);
-				auto velocity_z = XMVectorGetZ(iter.Velocity);
-				if (fabsf(velocity_x) <= 0.02f)
-				{
-					XMVectorSetX(iter.Velocity, 0.0f);
-				}
-				if (fabsf(velocity_y) <= 0.02f)
+					/// Update sub-bounding ellipsoids
+					///UpdateSubBoundingEllipsoids(iter);
+
+					// Update bounding sphere
+					UpdateBoundingSphere(iter, transform);
+
+					// Update sub-bounding spheres
+					UpdateSubBoundingSpheres(iter, transform);
+				}, m_Components, transform_pool);
+		});
+}
+
+PRIVATE void JWSystemPhysics::SavePreviousStates() noexcept
+{
+	auto& transform_pool = m_pECS->SystemTransform().ComponentPool();
+	m_pECS->JobSystem().ParallelFor(m_Components.GetCount(), KJobSystemDefaultMinChunkSize,
+		[&transform_pool, this](uint32_t Begin, uint32_t End)
+		{
+			ForEachEntityWith(Begin, End, [](SComponentPhysics& iter, SComponentTransform& transform)
 				{
-					XMVectorSetY(iter.Velocity, 0.0f);
-				}
-				if (fabsf(velocity_z) <= 0.02f)
+					iter.PreviousPosition = transform.Position;
+					iter.PreviousPitchYawRoll = transform.PitchYawRoll;
+					iter.HasPreviousState = true;
+				}, m_Components, transform_pool);
+		});
+}
+
+PRIVATE void JWSystemPhysics::UpdateInterpolatedWorldMatrices() noexcept
+{
+	auto alpha = m_InterpolationAlpha;
+	auto& transform_pool = m_pECS->SystemTransform().ComponentPool();
+	m_pECS->JobSystem().ParallelFor(m_Components.GetCount(), KJobSystemDefaultMinChunkSize,
+		[&transform_pool, alpha, this](uint32_t Begin, uint32_t End)
+		{
+			ForEachEntityWith(Begin, End, [alpha](SComponentPhysics& iter, SComponentTransform& transform)
 				{
-					XMVectorSetZ(iter.Velocity, 0.0f);
-				}
+					// Static bodies never move, their world matrices are exact.
+					transform.IsWorldMatrixInterpolated = ((iter.InverseMass > 0) && (iter.HasPreviousState));
+					if (!transform.IsWorldMatrixInterpolated) { return; }
+
+					auto position = XMVectorLerp(iter.PreviousPosition, transform.Position, alpha);
+
+					// @important
+					// Pitch/yaw/roll must not be lerped (angles wrap around), so slerp their quaternions.
+					const auto& prev = iter.PreviousPitchYawRoll;
+					const auto& curr = transform.PitchYawRoll;
+					auto rotation = XMQuaternionSlerp(
+						XMQuaternionRotationRollPitchYaw(prev.x, prev.y, prev.z),
+						XMQuaternionRotationRollPitchYaw(curr.x, curr.y, curr.z), alpha);
+
+					transform.InterpolatedWorldMatrix = ComposeWorldMatrix(XMMatrixTranslationFromVector(position),
+						XMMatrixRotationQuaternion(rotation), XMMatrixScalingFromVector(transform.ScalingFactor),
+						transform.WorldMatrixCalculationOrder);
+				}, m_Components, transform_pool);
+		});
+}
 
-				// meet my world floor
-				if (XMVectorGetY(transform->Position) < KPhysicsWorldFloor)
+PRIVATE void JWSystemPhysics::ClearInterpolatedWorldMatrices() noexcept
+{
+	ForEachEntityWith([](SComponentPhysics&, SComponentTransform& transform)
+		{
+			transform.IsWorldMatrixInterpolated = false;
+		}, m_Components, m_pECS->SystemTransform().ComponentPool());
+}
+
+PRIVATE void JWSystemPhysics::IntegrateVelocities(float DeltaTime) noexcept
+{
+	m_pECS->JobSystem().ParallelFor(m_Components.GetCount(), KJobSystemDefaultMinChunkSize,
+		[this, DeltaTime](uint32_t Begin, uint32_t End)
+		{
+			for (uint32_t i = Begin; i < End; ++i)
+			{
+				auto& iter = m_Components[i];
+				if ((iter.InverseMass <= 0) || (!iter.IsSimulated)) { continue; }
+				if (iter.IsSleeping)
 				{
-					iter.Velocity = KVectorZero;
+					iter.ClearAccumulation();
+					continue;
 				}
 
-				// p' = p + vt
-				transform->Position += iter.Velocity * delta_time;
+				// a = 1/m * f
+				iter.LinearAcceleration = iter.InverseMass * iter.AccumulatedForce;
+
+				// v' = v + at
+				iter.Velocity += iter.LinearAcceleration * DeltaTime;
 
-				// update angular speed
-				transform->RotatePitchYawRoll(iter.AngularVelocity * delta_time);
+				// apply linear damping
+				iter.Velocity *= powf(iter.LinearDamping, DeltaTime);
 
-				// DEBUGGING
-				/*
-				std::cout
-					<< "Position = { " 
-					<< TO_STRING(XMVectorGetX(transform->Position)) << " , "
-					<< TO_STRING(XMVectorGetY(transform->Position)) << " , "
-					<< TO_STRING(XMVectorGetZ(transform->Position)) << " }"
-					<< std::endl;
-				*/
+				// apply angular damping
+				iter.AngularVelocity *= powf(iter.AngularDamping, DeltaTime);
 
 				// Clear accumulations
 				iter.ClearAccumulation();
 			}
-
-			/// Update bounding ellipsoid
-			///UpdateBoundingEllipsoid(iter);
-
-			/// Update sub-bounding ellipsoids
-			///UpdateSubBoundingEllipsoids(iter);
-
-			// Update bounding sphere
-			UpdateBoundingSphere(iter);
-
-			// Update sub-bounding spheres
-			UpdateSubBoundingSpheres(iter);
-		}
-	}
+		});
 }
 
 /*
@@ -637,164 +948,539 @@ PRIVATE void JWSystemPhysics::UpdateBoundingEllipsoid(SComponentPhysics& Physics
 	auto temp_center = bounding_ellipsoid.Offset;
 	if (transform) { temp_center += transform->Position; }
 
-	auto mat_scaling = XMMatrixScaling(bounding_ellipsoid.RadiusX, bounding_ellipsoid.RadiusY, bounding_ellipsoid.RadiusZ);
-	auto mat_translation = XMMatrixTranslationFromVector(temp_center);
-	bounding_ellipsoid.EllipsoidWorld = mat_scaling * mat_translation;
+	auto mat_scaling = XMMatrixScaling(bounding_ellipsoid.RadiusX, bounding_ellipsoid.RadiusY, bounding_ellipsoid.RadiusZ);
+	auto mat_translation = XMMatrixTranslationFromVector(temp_center);
+	bounding_ellipsoid.EllipsoidWorld = mat_scaling * mat_translation;
+
+	// Update the data into SystemRender
+	m_pECS->SystemRender().UpdateBoundingEllipsoidInstance(Physics.ComponentIndex, bounding_ellipsoid.EllipsoidWorld);
+}
+
+PRIVATE void JWSystemPhysics::UpdateSubBoundingEllipsoids(SComponentPhysics& Physics) noexcept
+{
+	// Get pointer to the entity.
+	auto ptr_entity = m_pECS->GetEntityByIndex(Physics.EntityIndex);
+
+	// Calculate world matrix of the sub-bounding ellipsoids
+	auto transform = ptr_entity->GetComponentTransform();
+	auto entity_position = transform->Position;
+	for (auto& curr_sub_be : Physics.SubBoundingEllipsoids)
+	{
+		auto mat_scaling = XMMatrixScaling(curr_sub_be.RadiusX, curr_sub_be.RadiusY, curr_sub_be.RadiusZ);
+		auto mat_translation = XMMatrixTranslationFromVector(entity_position + curr_sub_be.Offset);
+		curr_sub_be.EllipsoidWorld = mat_scaling * mat_translation;
+	}
+}
+*/
+
+PRIVATE void JWSystemPhysics::UpdateBoundingSphere(SComponentPhysics& Physics, const SComponentTransform& Transform) noexcept
+{
+	// Calculate world matrix of the bounding ellipsoid
+	auto& bounding_sphere = Physics.BoundingSphere;
+
+	auto temp_center = bounding_sphere.Center + Transform.Position;
+
+	auto mat_scaling = XMMatrixScaling(bounding_sphere.Radius, bounding_sphere.Radius, bounding_sphere.Radius);
+	auto mat_translation = XMMatrixTranslationFromVector(temp_center);
+
+	// Update the data into SystemRender
+	m_pECS->SystemRender().UpdateBoundingSphereInstance(Physics.ComponentIndex, mat_scaling * mat_translation);
+}
+
+PRIVATE void JWSystemPhysics::UpdateSubBoundingSpheres(SComponentPhysics& Physics, const SComponentTransform& Transform) noexcept
+{
+	// Calculate world matrix of the sub-bounding ellipsoids
+	auto entity_position = Transform.Position;
+	for (auto& curr_sub_bs : Physics.SubBoundingSpheres)
+	{
+		auto mat_scaling = XMMatrixScaling(curr_sub_bs.Radius, curr_sub_bs.Radius, curr_sub_bs.Radius);
+		auto mat_translation = XMMatrixTranslationFromVector(entity_position + curr_sub_bs.Center);
+	}
+}
+
+PRIVATE void JWSystemPhysics::DetectCoarseCollision() noexcept
+{
+	m_BroadPhase.BeginFrame();
+
+	// Transform is fetched once per body here, not once per pair.
+	auto& transform_pool = m_pECS->SystemTransform().ComponentPool();
+	for (const auto& iter : m_Components)
+	{
+		if (iter.IsCollidable())
+		{
+			auto transform = transform_pool.GetByEntity(iter.EntityIndex);
+			auto world_center = iter.BoundingSphere.Center;
+			if (transform)
+			{
+				world_center += transform->Position;
+			}
+
+			m_BroadPhase.AddProxy(iter.ComponentIndex, world_center, iter.BoundingSphere.Radius, iter.CollisionLayer);
+		}
+	}
+
+	m_BroadPhase.GeneratePairs(m_CoarseCollisionList);
+
+	// @important
+	// The pair order of the broad phase depends on its history (e.g. sweep-and-prune's sorted list),
+	// which isn't part of snapshots, and the contact solver's results depend on the order of contacts.
+	if (m_IsDeterministicMode)
+	{
+		for (auto& iter : m_CoarseCollisionList)
+		{
+			if (iter.A > iter.B) { std::swap(iter.A, iter.B); }
+		}
+		std::sort(m_CoarseCollisionList.begin(), m_CoarseCollisionList.end(), [](const SCollisionPair& a, const SCollisionPair& b)
+			{
+				return (a.A < b.A) || ((a.A == b.A) && (a.B < b.B));
+			});
+	}
+
+	// Pairs where neither body can move (static or sleeping on both sides) are excluded from the narrow phase.
+	m_CoarseCollisionList.erase(std::remove_if(m_CoarseCollisionList.begin(), m_CoarseCollisionList.end(),
+		[this](const SCollisionPair& Pair)
+		{
+			const auto& a = m_Components[Pair.A];
+			const auto& b = m_Components[Pair.B];
+			auto is_a_moving = ((a.InverseMass > 0) && (!a.IsSleeping));
+			auto is_b_moving = ((b.InverseMass > 0) && (!b.IsSleeping));
+			return (!is_a_moving) && (!is_b_moving);
+		}), m_CoarseCollisionList.end());
+}
+
+bool ClosestPointPred(const SClosestPoint& a, const SClosestPoint& b)
+{
+	return a.Distance < b.Distance;
+}
+
+bool ClosestFacePredAbsDist(const SClosestFace& a, const SClosestFace& b)
+{
+	return fabsf(a.Dist) < fabsf(b.Dist);
+}
+
+bool ClosestFacePredDist(const SClosestFace& a, const SClosestFace& b)
+{
+	return a.Dist < b.Dist;
+}
+
+bool ClosestFacePredDot(const SClosestFace& a, const SClosestFace& b)
+{
+	return a.Dot > b.Dot;
+}
+
+// True if the sphere swept from Origin by Motion * [0, MaxT] touches the sphere at Center.
+// (Radius is the sum of both radii.)
+static auto IsSweptSphereTouchingSphere(const XMVECTOR& Origin, const XMVECTOR& Motion, float Radius,
+	const XMVECTOR& Center, float MaxT) noexcept->bool
+{
+	if (XMVectorGetX(XMVector3LengthSq(Origin - Center)) <= Radius * Radius) { return true; }
+
+	auto t = XMVectorReplicate(MaxT);
+	return IntersectRaySphere(Origin, Motion, Radius, Center, &t);
+}
+
+// First time in [0, InOutT) the sphere swept from Origin by Motion * t touches the triangle,
+// tested against the face, then the 3 edges (capsules) and the 3 vertices (spheres).
+// OutNormal points from the triangle toward the sphere's center at that time.
+// @important: A sphere that already touches the triangle is ignored (that's a contact for the discrete step).
+static auto SweepSphereTriangle(const XMVECTOR& Origin, const XMVECTOR& Motion, float Radius,
+	const XMVECTOR& V0, const XMVECTOR& V1, const XMVECTOR& V2, float& InOutT, XMVECTOR& OutNormal) noexcept->bool
+{
+	auto radius_sq = Radius * Radius;
+	auto nn = XMVectorGetX(XMVector3Dot(Motion, Motion));
+	if (nn <= 0) { return false; }
+
+	// #1 Face
+	auto face_normal = XMVector3Cross(V1 - V0, V2 - V0);
+	if (XMVectorGetX(XMVector3LengthSq(face_normal)) > 0)
+	{
+		auto n = XMVector3Normalize(face_normal);
+		auto distance = XMVectorGetX(XMVector3Dot(Origin - V0, n));
+		auto speed = XMVectorGetX(XMVector3Dot(Motion, n));
+
+		// The side the sphere is on
+		if (distance < 0)
+		{
+			n = -n;
+			distance = -distance;
+			speed = -speed;
+		}
+
+		if ((distance > Radius) && (speed < 0))
+		{
+			auto t = (distance - Radius) / -speed;
+			if (t < InOutT)
+			{
+				auto contact = Origin + Motion * t - n * Radius;
+				auto is_inside =
+					(XMVectorGetX(XMVector3Dot(XMVector3Cross(V1 - V0, contact - V0), face_normal)) >= 0) &&
+					(XMVectorGetX(XMVector3Dot(XMVector3Cross(V2 - V1, contact - V1), face_normal)) >= 0) &&
+					(XMVectorGetX(XMVector3Dot(XMVector3Cross(V0 - V2, contact - V2), face_normal)) >= 0);
+
+				// Touching the inside of the face comes before touching any edge or vertex.
+				if (is_inside)
+				{
+					InOutT = t;
+					OutNormal = n;
+					return true;
+				}
+			}
+		}
+	}
+
+	bool is_hit{};
+
+	// #2 Edges (moving point against the infinite cylinder around the edge, then clamped to the segment)
+	const XMVECTOR* vertices[3]{ &V0, &V1, &V2 };
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		const auto& a = *vertices[i];
+		const auto& b = *vertices[(i + 1) % 3];
+
+		auto d = b - a;
+		auto m = Origin - a;
+		auto dd = XMVectorGetX(XMVector3Dot(d, d));
+		auto nd = XMVectorGetX(XMVector3Dot(Motion, d));
+		auto md = XMVectorGetX(XMVector3Dot(m, d));
+		auto mn = XMVectorGetX(XMVector3Dot(m, Motion));
+		auto mm = XMVectorGetX(XMVector3Dot(m, m));
+
+		auto qa = dd * nn - nd * nd;
+		auto qb = dd * mn - nd * md;
+		auto qc = dd * (mm - radius_sq) - md * md;
+
+		// Parallel to the edge (the vertices catch it), already inside the cylinder or moving away
+		if ((qa <= 0) || (qc <= 0) || (qb >= 0)) { continue; }
+
+		auto discriminant = qb * qb - qa * qc;
+		if (discriminant < 0) { continue; }
+
+		auto t = (-qb - sqrtf(discriminant)) / qa;
+		if ((t < 0) || (t >= InOutT)) { continue; }
+
+		auto s = (md + t * nd) / dd;
+		if ((s < 0) || (s > 1.0f)) { continue; }
+
+		InOutT = t;
+		OutNormal = XMVector3Normalize(Origin + Motion * t - (a + d * s));
+		is_hit = true;
+	}
+
+	// #3 Vertices
+	for (auto ptr_vertex : vertices)
+	{
+		auto m = Origin - *ptr_vertex;
+		auto qb = XMVectorGetX(XMVector3Dot(m, Motion));
+		auto qc = XMVectorGetX(XMVector3Dot(m, m)) - radius_sq;
+
+		// Already touching or moving away
+		if ((qc <= 0) || (qb >= 0)) { continue; }
+
+		auto discriminant = qb * qb - nn * qc;
+		if (discriminant < 0) { continue; }
+
+		auto t = (-qb - sqrtf(discriminant)) / nn;
+		if ((t < 0) || (t >= InOutT)) { continue; }
 
-	// Update the data into SystemRender
-	m_pECS->SystemRender().UpdateBoundingEllipsoidInstance(Physics.ComponentIndex, bounding_ellipsoid.EllipsoidWorld);
+		InOutT = t;
+		OutNormal = XMVector3Normalize(Origin + Motion * t - *ptr_vertex);
+		is_hit = true;
+	}
+
+	return is_hit;
 }
 
-PRIVATE void JWSystemPhysics::UpdateSubBoundingEllipsoids(SComponentPhysics& Physics) noexcept
+PRIVATE void JWSystemPhysics::DetectContinuousCollision(float DeltaTime) noexcept
 {
-	// Get pointer to the entity.
-	auto ptr_entity = m_pECS->GetEntityByIndex(Physics.EntityIndex);
+	m_CCDBodyCount = 0;
+	m_CCDHitCount = 0;
 
-	// Calculate world matrix of the sub-bounding ellipsoids
-	auto transform = ptr_entity->GetComponentTransform();
-	auto entity_position = transform->Position;
-	for (auto& curr_sub_be : Physics.SubBoundingEllipsoids)
+	// #1 Fast bodies
+	m_vCCDComponentIndices.clear();
+	for (const auto& iter : m_Components)
 	{
-		auto mat_scaling = XMMatrixScaling(curr_sub_be.RadiusX, curr_sub_be.RadiusY, curr_sub_be.RadiusZ);
-		auto mat_translation = XMMatrixTranslationFromVector(entity_position + curr_sub_be.Offset);
-		curr_sub_be.EllipsoidWorld = mat_scaling * mat_translation;
+		if ((!iter.IsCCDEnabled) || (iter.InverseMass <= 0) || (!iter.IsSimulated) || (iter.IsSleeping)) { continue; }
+
+		auto motion_length = XMVectorGetX(XMVector3Length(iter.Velocity)) * DeltaTime;
+		if (motion_length <= iter.BoundingSphere.Radius * KCCDMotionThresholdRatio) { continue; }
+
+		m_vCCDComponentIndices.emplace_back(iter.ComponentIndex);
 	}
-}
-*/
 
-PRIVATE void JWSystemPhysics::UpdateBoundingSphere(SComponentPhysics& Physics) noexcept
-{
-	// Get pointer to the entity.
-	auto ptr_entity = m_pECS->GetEntityByIndex(Physics.EntityIndex);
+	// Early out
+	if (m_vCCDComponentIndices.empty()) { return; }
 
-	// Calculate world matrix of the bounding ellipsoid
-	auto transform = ptr_entity->GetComponentTransform();
-	auto& bounding_sphere = Physics.BoundingSphere;
+	// #2 Time-of-impact budget (the ones that move the most relative to their size first)
+	if (m_vCCDComponentIndices.size() > m_CCDBodyBudget)
+	{
+		std::sort(m_vCCDComponentIndices.begin(), m_vCCDComponentIndices.end(), [this](ComponentIndexType a, ComponentIndexType b)
+			{
+				const auto& physics_a = m_Components[a];
+				const auto& physics_b = m_Components[b];
+				auto ratio_a = XMVectorGetX(XMVector3Length(physics_a.Velocity)) / max(physics_a.BoundingSphere.Radius, 0.0001f);
+				auto ratio_b = XMVectorGetX(XMVector3Length(physics_b.Velocity)) / max(physics_b.BoundingSphere.Radius, 0.0001f);
+				if (ratio_a != ratio_b) { return ratio_a > ratio_b; }
+				return a < b;
+			});
+		m_vCCDComponentIndices.resize(m_CCDBodyBudget);
+	}
 
-	auto temp_center = bounding_sphere.Center;
-	if (transform) { temp_center += transform->Position; }
+	// #3 Sweep
+	// @important
+	// Candidates come from the broad-phase proxies of this step (built in DetectCoarseCollision()),
+	// which are at the same positions as the sweep origins since nothing has been integrated yet.
+	auto& transform_pool = m_pECS->SystemTransform().ComponentPool();
+	for (auto component_index : m_vCCDComponentIndices)
+	{
+		auto& iter = m_Components[component_index];
+		auto transform = transform_pool.GetByEntity(iter.EntityIndex);
+		if (transform == nullptr) { continue; }
+
+		auto origin = iter.BoundingSphere.Center + transform->Position;
+		auto motion = iter.Velocity * DeltaTime;
+		auto radius = XMVectorReplicate(iter.BoundingSphere.Radius);
+
+		// Swept AABB
+		XMFLOAT3 sweep_min{}, sweep_max{};
+		XMStoreFloat3(&sweep_min, XMVectorMin(origin, origin + motion) - radius);
+		XMStoreFloat3(&sweep_max, XMVectorMax(origin, origin + motion) + radius);
+
+		m_vCCDCandidateIndices.clear();
+		m_BroadPhase.QueryAABB(sweep_min, sweep_max, iter.CollisionLayer, m_vCCDCandidateIndices);
+
+		float toi{ 1.0f };
+		XMVECTOR hit_normal{};
+		bool is_hit{};
+		for (auto other_index : m_vCCDCandidateIndices)
+		{
+			if (other_index == component_index) { continue; }
 
-	auto mat_scaling = XMMatrixScaling(bounding_sphere.Radius, bounding_sphere.Radius, bounding_sphere.Radius);
-	auto mat_translation = XMMatrixTranslationFromVector(temp_center);
+			if (SweepSphereAgainstBody(origin, motion, iter.BoundingSphere.Radius, m_Components[other_index], toi, hit_normal))
+			{
+				is_hit = true;
+			}
+		}
+		++m_CCDBodyCount;
 
-	// Update the data into SystemRender
-	m_pECS->SystemRender().UpdateBoundingSphereInstance(Physics.ComponentIndex, mat_scaling * mat_translation);
+		if (!is_hit) { continue; }
+
+		// The sphere touches the other body at toi.
+		iter.CCDTimeOfImpact = toi;
+		iter.CCDHitNormal = hit_normal;
+		++m_CCDHitCount;
+	}
 }
 
-PRIVATE void JWSystemPhysics::UpdateSubBoundingSpheres(SComponentPhysics& Physics) noexcept
+PRIVATE auto JWSystemPhysics::SweepSphereAgainstBody(const XMVECTOR& Origin, const XMVECTOR& Motion, float Radius,
+	const SComponentPhysics& Other, float& InOutTOI, XMVECTOR& OutNormal) noexcept->bool
 {
-	// Get pointer to the entity.
-	auto ptr_entity = m_pECS->GetEntityByIndex(Physics.EntityIndex);
+	auto other_transform = m_pECS->SystemTransform().ComponentPool().GetByEntity(Other.EntityIndex);
+	if (other_transform == nullptr) { return false; }
 
-	// Calculate world matrix of the sub-bounding ellipsoids
-	auto transform = ptr_entity->GetComponentTransform();
-	auto entity_position = transform->Position;
-	for (auto& curr_sub_bs : Physics.SubBoundingSpheres)
+	// #1 Bounding spheres
+	auto other_center = Other.BoundingSphere.Center + other_transform->Position;
+	if (!IsSweptSphereTouchingSphere(Origin, Motion, Radius + Other.BoundingSphere.Radius, other_center, InOutTOI))
 	{
-		auto mat_scaling = XMMatrixScaling(curr_sub_bs.Radius, curr_sub_bs.Radius, curr_sub_bs.Radius);
-		auto mat_translation = XMMatrixTranslationFromVector(entity_position + curr_sub_bs.Center);
+		return false;
+	}
+
+	bool is_hit{};
+	auto sweep_triangle = [&](const XMVECTOR& V0, const XMVECTOR& V1, const XMVECTOR& V2)
+	{
+		if (SweepSphereTriangle(Origin, Motion, Radius, V0, V1, V2, InOutTOI, OutNormal)) { is_hit = true; }
+	};
+
+	// #2 Collision mesh (world-space hull is reused if it's up to date)
+	if (Other.PtrCollisionMesh)
+	{
+		const SWorldSpaceHull* ptr_hull{};
+		if (Other.ComponentIndex < static_cast<ComponentIndexType>(m_vWorldSpaceHulls.size()))
+		{
+			const auto& hull = m_vWorldSpaceHulls[Other.ComponentIndex];
+			if ((hull.vFaces.size()) && (hull.EntityIndex == Other.EntityIndex) &&
+				(hull.TransformVersion == other_transform->WorldMatrixVersion) && (hull.PtrCollisionMesh == Other.PtrCollisionMesh))
+			{
+				ptr_hull = &hull;
+			}
+		}
+
+		if (ptr_hull)
+		{
+			for (const auto& face : ptr_hull->vFaces)
+			{
+				sweep_triangle(face.V0, face.V1, face.V2);
+			}
+		}
+		else
+		{
+			const auto& positions = Other.PtrCollisionMesh->vPositionVertex;
+			const auto& faces = Other.PtrCollisionMesh->ModelData.IndexData.vFaces;
+			const auto& v_to_pv = Other.PtrCollisionMesh->vPositionVertexIndexFromVertexIndex;
+			for (const auto& face : faces)
+			{
+				sweep_triangle(
+					XMVector3TransformCoord(positions[v_to_pv[face._0]], other_transform->WorldMatrix),
+					XMVector3TransformCoord(positions[v_to_pv[face._1]], other_transform->WorldMatrix),
+					XMVector3TransformCoord(positions[v_to_pv[face._2]], other_transform->WorldMatrix));
+			}
+		}
+	}
+
+	// #3 Heightfield
+	// Only the cells under the swept AABB are visited, their triangles are swept in world space
+	// so that scaled terrains keep a round sphere.
+	if (Other.PtrHeightFieldTerrain)
+	{
+		auto radius = XMVectorReplicate(Radius);
+		auto sweep_min = XMVectorMin(Origin, Origin + Motion * InOutTOI) - radius;
+		auto sweep_max = XMVectorMax(Origin, Origin + Motion * InOutTOI) + radius;
+
+		// Local-space bounds of the swept AABB's 8 corners
+		auto inverse_world_matrix = XMMatrixInverse(nullptr, other_transform->WorldMatrix);
+		auto local_min = XMVectorReplicate(FLT_MAX);
+		auto local_max = XMVectorReplicate(-FLT_MAX);
+		for (uint32_t i = 0; i < 8; ++i)
+		{
+			auto corner = XMVectorSelect(sweep_min, sweep_max, XMVectorSelectControl(i & 1, (i >> 1) & 1, (i >> 2) & 1, 0));
+			auto local_corner = XMVector3TransformCoord(corner, inverse_world_matrix);
+			local_min = XMVectorMin(local_min, local_corner);
+			local_max = XMVectorMax(local_max, local_corner);
+		}
+
+		const auto& world_matrix = other_transform->WorldMatrix;
+		GetHeightField(Other.PtrHeightFieldTerrain)->ForEachTriangle(
+			XMVectorGetX(local_min), XMVectorGetZ(local_min), XMVectorGetX(local_max), XMVectorGetZ(local_max),
+			[&](const XMVECTOR& V0, const XMVECTOR& V1, const XMVECTOR& V2)
+			{
+				sweep_triangle(
+					XMVector3TransformCoord(V0, world_matrix),
+					XMVector3TransformCoord(V1, world_matrix),
+					XMVector3TransformCoord(V2, world_matrix));
+			});
 	}
+
+	return is_hit;
 }
 
-PRIVATE void JWSystemPhysics::DetectCoarseCollision() noexcept
+PRIVATE void JWSystemPhysics::UpdateWorldSpaceHulls() noexcept
 {
-	auto n = m_vComponents.size();
-	if (n == 0) { return; }
+	auto& transform_pool = m_pECS->SystemTransform().ComponentPool();
 
-	auto max_capacity = n * (n - 1) / 2;
-	if (m_CoarseCollisionList.capacity() < max_capacity)
+	if (m_vWorldSpaceHulls.size() < m_Components.GetCount())
 	{
-		m_CoarseCollisionList.reserve(max_capacity);
+		m_vWorldSpaceHulls.resize(m_Components.GetCount());
 	}
-	m_CoarseCollisionList.clear();
 
-	for (auto i = m_vComponents.cbegin(); i != m_vComponents.cend(); ++i)
+	// Collect bodies whose cached hull is stale.
+	// (Only bodies that appear in the coarse list, each of them once.)
+	m_vHullComponentIndices.clear();
+	for (const auto& iter : m_CoarseCollisionList)
 	{
-		if (i->InverseMass != KNonPhysicalObjectInverseMass)
+		// GJK and heightfield pairs don't need world-space faces.
+		if ((IsGJKPair(iter)) || (IsHeightFieldPair(iter))) { continue; }
+
+		for (auto component_index : { iter.A, iter.B })
 		{
-			auto i_entity = m_pECS->GetEntityByIndex(i->EntityIndex);
-			auto i_transform = i_entity->GetComponentTransform();
-			auto i_world_center = i->BoundingSphere.Center;
-			if (i_transform)
+			const auto& physics = m_Components[component_index];
+			if (physics.PtrCollisionMesh == nullptr)
 			{
-				i_world_center += i_transform->Position;
+				JW_ERROR_ABORT("Collision mesh is missing.");
 			}
 
-			for (auto j = i + 1; j != m_vComponents.cend(); ++j)
-			{
-				if (j->InverseMass != KNonPhysicalObjectInverseMass)
-				{
-					auto j_entity = m_pECS->GetEntityByIndex(j->EntityIndex);
-					auto j_transform = j_entity->GetComponentTransform();
-					auto j_world_center = j->BoundingSphere.Center;
-					if (j_transform)
-					{
-						j_world_center += j_transform->Position;
-					}
+			const auto& transform = transform_pool.GetByEntity(physics.EntityIndex);
+			auto& hull = m_vWorldSpaceHulls[component_index];
 
-					if (IntersectSpheres(i->BoundingSphere.Radius, i_world_center, j->BoundingSphere.Radius, j_world_center))
-					{
-						m_CoarseCollisionList.emplace_back(i->ComponentIndex, j->ComponentIndex);
-					}
-				}
+			if ((hull.EntityIndex == physics.EntityIndex) && (hull.PtrCollisionMesh == physics.PtrCollisionMesh) &&
+				(hull.TransformVersion == transform->WorldMatrixVersion))
+			{
+				continue;
 			}
+
+			// @important: the key is updated here, so a body in several pairs is queued only once.
+			hull.EntityIndex = physics.EntityIndex;
+			hull.PtrCollisionMesh = physics.PtrCollisionMesh;
+			hull.TransformVersion = transform->WorldMatrixVersion;
+
+			m_vHullComponentIndices.emplace_back(component_index);
 		}
 	}
-}
+	m_RebuiltWorldSpaceHullCount = static_cast<uint32_t>(m_vHullComponentIndices.size());
 
-bool ClosestPointPred(const SClosestPoint& a, const SClosestPoint& b)
-{
-	return a.Distance < b.Distance;
-}
+	// Each chunk writes only its own hulls.
+	m_pECS->JobSystem().ParallelFor(m_RebuiltWorldSpaceHullCount, 1,
+		[this, &transform_pool](uint32_t Begin, uint32_t End)
+		{
+			for (uint32_t i = Begin; i < End; ++i)
+			{
+				auto component_index = m_vHullComponentIndices[i];
+				const auto& physics = m_Components[component_index];
+				const auto& transform = transform_pool.GetByEntity(physics.EntityIndex);
+				auto& hull = m_vWorldSpaceHulls[component_index];
+
+				const auto& positions = physics.PtrCollisionMesh->vPositionVertex;
+				const auto& faces = physics.PtrCollisionMesh->ModelData.IndexData.vFaces;
+				const auto& v_to_pv = physics.PtrCollisionMesh->vPositionVertexIndexFromVertexIndex;
+
+				hull.vFaces.clear();
+				hull.vFaces.reserve(faces.size());
+				for (const auto& face : faces)
+				{
+					auto v0 = XMVector3TransformCoord(positions[v_to_pv[face._0]], transform->WorldMatrix);
+					auto v1 = XMVector3TransformCoord(positions[v_to_pv[face._1]], transform->WorldMatrix);
+					auto v2 = XMVector3TransformCoord(positions[v_to_pv[face._2]], transform->WorldMatrix);
+					auto n = GetTriangleNormal(v0, v1, v2);
+					auto m = (v0 + v1 + v2) / 3.0f;
 
-bool ClosestFacePredAbsDist(const SClosestFace& a, const SClosestFace& b)
-{
-	return fabsf(a.Dist) < fabsf(b.Dist);
+					hull.vFaces.emplace_back(v0, v1, v2, n, m);
+				}
+			}
+		});
 }
 
-bool ClosestFacePredDist(const SClosestFace& a, const SClosestFace& b)
+PRIVATE void JWSystemPhysics::DetectFineCollision() noexcept
 {
-	return a.Dist < b.Dist;
-}
+	m_GJKPairCount = 0;
 
-bool ClosestFacePredDot(const SClosestFace& a, const SClosestFace& b)
-{
-	return a.Dot > b.Dot;
-}
+	// @important
+	// Cleared before the early out, otherwise the contacts of the last step would be solved again.
+	m_FineCollisionList.clear();
+	m_IsThereAnyActualCollision = false;
 
-PRIVATE void JWSystemPhysics::DetectFineCollision() noexcept
-{
 	// Early out
 	if (m_CoarseCollisionList.size() == 0) { return; }
 
-	m_FineCollisionList.clear();
-	m_IsThereAnyActualCollision = false;
+	auto& transform_pool = m_pECS->SystemTransform().ComponentPool();
+
+	// #0 Bring world-space hulls of every body in the coarse list up to date
+	UpdateWorldSpaceHulls();
 
 	for (const auto& iter : m_CoarseCollisionList)
 	{
-		const auto& a_physics = m_vComponents[iter.A];
-		const auto& b_physics = m_vComponents[iter.B];
+		const auto& a_physics = m_Components[iter.A];
+		const auto& b_physics = m_Components[iter.B];
 
-		auto& a_collision_mesh{ a_physics.PtrCollisionMesh };
-		auto& b_collision_mesh{ b_physics.PtrCollisionMesh };
-		if ((a_collision_mesh == nullptr) || (b_collision_mesh == nullptr))
+		// #0 Heightfield instead of #1 ~ #8
+		if (IsHeightFieldPair(iter))
 		{
-			JW_ERROR_ABORT("Collision mesh is missing.");
+			const auto& a_transform = transform_pool.GetByEntity(a_physics.EntityIndex);
+			const auto& b_transform = transform_pool.GetByEntity(b_physics.EntityIndex);
+			auto ba_dir = XMVector3Normalize(
+				(a_physics.BoundingSphere.Center + a_transform->Position) - (b_physics.BoundingSphere.Center + b_transform->Position));
+
+			DetectFineCollisionHeightField(iter, ba_dir);
+			continue;
 		}
+
+		auto& a_collision_mesh{ a_physics.PtrCollisionMesh };
+		auto& b_collision_mesh{ b_physics.PtrCollisionMesh };
 		
-		const auto& a_positions = a_collision_mesh->vPositionVertex;
-		const auto& b_positions = b_collision_mesh->vPositionVertex;
-		const auto& a_faces = a_collision_mesh->ModelData.IndexData.vFaces;
-		const auto& b_faces = b_collision_mesh->ModelData.IndexData.vFaces;
-		const auto& a_v_to_pv = a_collision_mesh->vPositionVertexIndexFromVertexIndex;
-		const auto& b_v_to_pv = b_collision_mesh->vPositionVertexIndexFromVertexIndex;
 		const auto& a_face_with_position = a_collision_mesh->vFaceWithPositionVertex;
 		const auto& b_face_with_position = b_collision_mesh->vFaceWithPositionVertex;
 		
 
 		// #1 Get world (mass) center of objects
-		const auto& a_transform = m_pECS->GetEntityByIndex(a_physics.EntityIndex)->GetComponentTransform();
-		const auto& b_transform = m_pECS->GetEntityByIndex(b_physics.EntityIndex)->GetComponentTransform();
+		const auto& a_transform = transform_pool.GetByEntity(a_physics.EntityIndex);
+		const auto& b_transform = transform_pool.GetByEntity(b_physics.EntityIndex);
 		auto a_center_world = a_physics.BoundingSphere.Center + a_transform->Position;
 		auto b_center_world = b_physics.BoundingSphere.Center + b_transform->Position;
 
@@ -803,43 +1489,25 @@ PRIVATE void JWSystemPhysics::DetectFineCollision() noexcept
 		auto ba_dir = XMVector3Normalize(a_center_world - b_center_world);
 		auto ab_dir = -ba_dir;
 
-
-		// #3 Transform objects' faces into world space
-		// #3-1 Transform object a's faces into world space
-		m_TransformedFacesA.clear();
-		m_TransformedFacesA.reserve(a_faces.size());
-		for (const auto& a_face : a_faces)
+		// #2-1 GJK/EPA instead of #3 ~ #8
+		if (IsGJKPair(iter))
 		{
-			auto a0 = XMVector3TransformCoord(a_positions[a_v_to_pv[a_face._0]], a_transform->WorldMatrix);
-			auto a1 = XMVector3TransformCoord(a_positions[a_v_to_pv[a_face._1]], a_transform->WorldMatrix);
-			auto a2 = XMVector3TransformCoord(a_positions[a_v_to_pv[a_face._2]], a_transform->WorldMatrix);
-			auto n = GetTriangleNormal(a0, a1, a2);
-			auto m = (a0 + a1 + a2) / 3.0f;
-
-			m_TransformedFacesA.emplace_back(a0, a1, a2, n, m);
+			DetectFineCollisionGJK(iter, ba_dir);
+			continue;
 		}
 
-		// #3-2 Transform object b's faces into world space
-		m_TransformedFacesB.clear();
-		m_TransformedFacesB.reserve(b_faces.size());
-		for (const auto& b_face : b_faces)
-		{
-			auto b0 = XMVector3TransformCoord(b_positions[b_v_to_pv[b_face._0]], b_transform->WorldMatrix);
-			auto b1 = XMVector3TransformCoord(b_positions[b_v_to_pv[b_face._1]], b_transform->WorldMatrix);
-			auto b2 = XMVector3TransformCoord(b_positions[b_v_to_pv[b_face._2]], b_transform->WorldMatrix);
-			auto n = GetTriangleNormal(b0, b1, b2);
-			auto m = (b0 + b1 + b2) / 3.0f;
 
-			m_TransformedFacesB.emplace_back(b0, b1, b2, n, m);
-		}
+		// #3 Get objects' faces in world space (cached, see UpdateWorldSpaceHulls())
+		const auto& transformed_faces_a = m_vWorldSpaceHulls[iter.A].vFaces;
+		const auto& transformed_faces_b = m_vWorldSpaceHulls[iter.B].vFaces;
 
 
 		// #4 Find the closest faces of each object to another
 		// #4-1 See if any plane of object a has projected center point of object b
 		m_ClosestFacesA.clear();
-		m_ClosestFacesA.reserve(m_TransformedFacesA.size());
+		m_ClosestFacesA.reserve(transformed_faces_a.size());
 		float dist{};
-		for (const auto& a_face : m_TransformedFacesA)
+		for (const auto& a_face : transformed_faces_a)
 		{
 			auto projected = ProjectPointOntoPlane(dist, b_center_world, a_face.V0, a_face.N);
 
@@ -851,8 +1519,8 @@ PRIVATE void JWSystemPhysics::DetectFineCollision() noexcept
 
 		// #4-2 See if any plane of object b has projected center point of object a
 		m_ClosestFacesB.clear();
-		m_ClosestFacesB.reserve(m_TransformedFacesB.size());
-		for (const auto& b_face : m_TransformedFacesB)
+		m_ClosestFacesB.reserve(transformed_faces_b.size());
+		for (const auto& b_face : transformed_faces_b)
 		{
 			auto projected = ProjectPointOntoPlane(dist, a_center_world, b_face.V0, b_face.N);
 
@@ -876,7 +1544,7 @@ PRIVATE void JWSystemPhysics::DetectFineCollision() noexcept
 			m_ClosestFaceA = m_ClosestFacesA.front();
 
 			m_ClosestFacesB.clear();
-			for (const auto& b_face : m_TransformedFacesB)
+			for (const auto& b_face : transformed_faces_b)
 			{
 				auto dist = XMVectorGetX(XMVector3Length(a_center_world - b_face.M));
 				auto dot = XMVectorGetX(XMVector3Dot(m_ClosestFaceA.N, -b_face.N));
@@ -896,7 +1564,7 @@ PRIVATE void JWSystemPhysics::DetectFineCollision() noexcept
 			m_ClosestFaceB = m_ClosestFacesB.front();
 
 			m_ClosestFacesA.clear();
-			for (const auto& a_face : m_TransformedFacesA)
+			for (const auto& a_face : transformed_faces_a)
 			{
 				auto dist = XMVectorGetX(XMVector3Length(m_ClosestFaceB.Projected - a_face.M));
 				auto dot = XMVectorGetX(XMVector3Dot(m_ClosestFaceB.N, a_face.N));
@@ -950,14 +1618,14 @@ PRIVATE void JWSystemPhysics::DetectFineCollision() noexcept
 		{
 			for (const auto& a_point : m_ClosestPointsA)
 			{
-				if (IsPointAInB(a_point.Point, m_TransformedFacesB))
+				if (IsPointAInB(a_point.Point, transformed_faces_b))
 				{
 					collision_type = ECollisionType::PointAFaceB;
 				}
 			}
 			/*
 			const auto& p_a = m_ClosestPointA.Point;
-			if (IsPointAInB_Improved(p_a, m_TransformedFacesB))
+			if (IsPointAInB_Improved(p_a, transformed_faces_b))
 			{
 				collision_type = ECollisionType::PointAFaceB;
 			}
@@ -969,14 +1637,14 @@ PRIVATE void JWSystemPhysics::DetectFineCollision() noexcept
 		{
 			for (const auto& b_point : m_ClosestPointsB)
 			{
-				if (IsPointAInB(b_point.Point, m_TransformedFacesA))
+				if (IsPointAInB(b_point.Point, transformed_faces_a))
 				{
 					collision_type = ECollisionType::PointBFaceA;
 				}
 			}
 			/*
 			const auto& p_b = m_ClosestPointB.Point;
-			if (IsPointAInB_Improved(p_b, m_TransformedFacesA))
+			if (IsPointAInB_Improved(p_b, transformed_faces_a))
 			{
 				collision_type = ECollisionType::PointBFaceA;
 			}
@@ -998,7 +1666,7 @@ PRIVATE void JWSystemPhysics::DetectFineCollision() noexcept
 			// Edge a V0-V1
 			if (ProjectPointOntoSegment(b_center_world, m_ClosestFaceA.V0, m_ClosestFaceA.V1, closest_point_of_edge_a_to_b))
 			{
-				if (IsPointAInB(closest_point_of_edge_a_to_b, m_TransformedFacesB))
+				if (IsPointAInB(closest_point_of_edge_a_to_b, transformed_faces_b))
 				{
 					edge_pair_a = EClosestEdgePair::V0V1;
 				}
@@ -1009,7 +1677,7 @@ PRIVATE void JWSystemPhysics::DetectFineCollision() noexcept
 			{
 				if (ProjectPointOntoSegment(b_center_world, m_ClosestFaceA.V0, m_ClosestFaceA.V2, closest_point_of_edge_a_to_b))
 				{
-					if (IsPointAInB(closest_point_of_edge_a_to_b, m_TransformedFacesB))
+					if (IsPointAInB(closest_point_of_edge_a_to_b, transformed_faces_b))
 					{
 						edge_pair_a = EClosestEdgePair::V0V2;
 					}
@@ -1021,7 +1689,7 @@ PRIVATE void JWSystemPhysics::DetectFineCollision() noexcept
 			{
 				if (ProjectPointOntoSegment(b_center_world, m_ClosestFaceA.V1, m_ClosestFaceA.V2, closest_point_of_edge_a_to_b))
 				{
-					if (IsPointAInB(closest_point_of_edge_a_to_b, m_TransformedFacesB))
+					if (IsPointAInB(closest_point_of_edge_a_to_b, transformed_faces_b))
 					{
 						edge_pair_a = EClosestEdgePair::V1V2;
 					}
@@ -1132,7 +1800,7 @@ PRIVATE void JWSystemPhysics::DetectFineCollision() noexcept
 			// Edge b V0-V1
 			if (ProjectPointOntoSegment(a_center_world, m_ClosestFaceB.V0, m_ClosestFaceB.V1, closest_point_of_edge_b_to_a))
 			{
-				if (IsPointAInB(closest_point_of_edge_b_to_a, m_TransformedFacesA))
+				if (IsPointAInB(closest_point_of_edge_b_to_a, transformed_faces_a))
 				{
 					edge_pair_b = EClosestEdgePair::V0V1;
 				}
@@ -1143,7 +1811,7 @@ PRIVATE void JWSystemPhysics::DetectFineCollision() noexcept
 			{
 				if (ProjectPointOntoSegment(a_center_world, m_ClosestFaceB.V0, m_ClosestFaceB.V2, closest_point_of_edge_b_to_a))
 				{
-					if (IsPointAInB(closest_point_of_edge_b_to_a, m_TransformedFacesA))
+					if (IsPointAInB(closest_point_of_edge_b_to_a, transformed_faces_a))
 					{
 						edge_pair_b = EClosestEdgePair::V0V2;
 					}
@@ -1155,7 +1823,7 @@ PRIVATE void JWSystemPhysics::DetectFineCollision() noexcept
 			{
 				if (ProjectPointOntoSegment(a_center_world, m_ClosestFaceB.V1, m_ClosestFaceB.V2, closest_point_of_edge_b_to_a))
 				{
-					if (IsPointAInB(closest_point_of_edge_b_to_a, m_TransformedFacesA))
+					if (IsPointAInB(closest_point_of_edge_b_to_a, transformed_faces_a))
 					{
 						edge_pair_b = EClosestEdgePair::V1V2;
 					}
@@ -1335,7 +2003,7 @@ PRIVATE void JWSystemPhysics::DetectFineCollision() noexcept
 
 			assert(XMVectorGetX(XMVector3LengthSq(collision_normal)) > 0.0f);
 
-			m_FineCollisionList.emplace_back(a_entity, b_entity, ba_dir, 
+			m_FineCollisionList.emplace_back(a_entity->GetEntityHandle(), b_entity->GetEntityHandle(), ba_dir, 
 				collision_normal, collision_point_a, collision_point_b,
 				penetration_depth, signed_closing_speed);
 		}
@@ -1343,6 +2011,166 @@ PRIVATE void JWSystemPhysics::DetectFineCollision() noexcept
 	}
 }
 
+PRIVATE auto JWSystemPhysics::IsGJKPair(const SCollisionPair& Pair) const noexcept->bool
+{
+	return (m_Components[Pair.A].NarrowPhaseType == ENarrowPhaseType::GJK) &&
+		(m_Components[Pair.B].NarrowPhaseType == ENarrowPhaseType::GJK);
+}
+
+PRIVATE auto JWSystemPhysics::GetConvexHull(const JWModel* PtrCollisionMesh) noexcept->const SConvexHull*
+{
+	auto find = m_umapConvexHulls.find(PtrCollisionMesh);
+	if (find != m_umapConvexHulls.end())
+	{
+		return &find->second;
+	}
+
+	// Built once per collision mesh, when it's first needed.
+	auto& hull = m_umapConvexHulls[PtrCollisionMesh];
+	JWNarrowPhase::BuildConvexHull(*PtrCollisionMesh, hull);
+
+	return &hull;
+}
+
+PRIVATE void JWSystemPhysics::DetectFineCollisionGJK(const SCollisionPair& Pair, const XMVECTOR& DirectionBA) noexcept
+{
+	const auto& a_physics = m_Components[Pair.A];
+	const auto& b_physics = m_Components[Pair.B];
+	if ((a_physics.PtrCollisionMesh == nullptr) || (b_physics.PtrCollisionMesh == nullptr))
+	{
+		JW_ERROR_ABORT("Collision mesh is missing.");
+	}
+
+	auto& transform_pool = m_pECS->SystemTransform().ComponentPool();
+	const auto& a_transform = transform_pool.GetByEntity(a_physics.EntityIndex);
+	const auto& b_transform = transform_pool.GetByEntity(b_physics.EntityIndex);
+
+	SConvexShape a_shape{ a_physics.PtrCollisionMesh->vPositionVertex, a_transform->WorldMatrix,
+		(a_physics.SupportMappingType == ESupportMappingType::HillClimbing) ? GetConvexHull(a_physics.PtrCollisionMesh) : nullptr };
+	SConvexShape b_shape{ b_physics.PtrCollisionMesh->vPositionVertex, b_transform->WorldMatrix,
+		(b_physics.SupportMappingType == ESupportMappingType::HillClimbing) ? GetConvexHull(b_physics.PtrCollisionMesh) : nullptr };
+
+	++m_GJKPairCount;
+
+	SConvexContact contact{};
+	if (!m_NarrowPhase.Collide(a_shape, b_shape, contact)) { return; }
+
+	m_IsThereAnyActualCollision = true;
+
+	auto relative_velocity_ba = b_physics.Velocity - a_physics.Velocity;
+	auto signed_closing_speed = XMVectorGetX(XMVector3Dot(relative_velocity_ba, DirectionBA));
+
+	const auto& a_entity = m_pECS->GetEntityByIndex(a_physics.EntityIndex);
+	const auto& b_entity = m_pECS->GetEntityByIndex(b_physics.EntityIndex);
+
+	// Collision normal from EPA is already in b-a direction.
+	m_FineCollisionList.emplace_back(a_entity->GetEntityHandle(), b_entity->GetEntityHandle(), DirectionBA,
+		contact.Normal, contact.PointA, contact.PointB,
+		contact.PenetrationDepth, signed_closing_speed);
+}
+
+PRIVATE auto JWSystemPhysics::GetHeightField(const STerrainData* PtrTerrainData) noexcept->const JWHeightField*
+{
+	auto find = m_umapHeightFields.find(PtrTerrainData);
+	if (find != m_umapHeightFields.end())
+	{
+		return &find->second;
+	}
+
+	auto& height_field = m_umapHeightFields[PtrTerrainData];
+	height_field.Create(*PtrTerrainData);
+
+	return &height_field;
+}
+
+PRIVATE auto JWSystemPhysics::IsHeightFieldPair(const SCollisionPair& Pair) const noexcept->bool
+{
+	return (m_Components[Pair.A].PtrHeightFieldTerrain) || (m_Components[Pair.B].PtrHeightFieldTerrain);
+}
+
+PRIVATE void JWSystemPhysics::DetectFineCollisionHeightField(const SCollisionPair& Pair, const XMVECTOR& DirectionBA) noexcept
+{
+	const auto& a_physics = m_Components[Pair.A];
+	const auto& b_physics = m_Components[Pair.B];
+
+	// Heightfield vs heightfield
+	if ((a_physics.PtrHeightFieldTerrain) && (b_physics.PtrHeightFieldTerrain)) { return; }
+
+	auto is_terrain_a = (a_physics.PtrHeightFieldTerrain != nullptr);
+	const auto& terrain_physics = (is_terrain_a) ? a_physics : b_physics;
+	const auto& body_physics = (is_terrain_a) ? b_physics : a_physics;
+
+	auto& transform_pool = m_pECS->SystemTransform().ComponentPool();
+	const auto& terrain_transform = transform_pool.GetByEntity(terrain_physics.EntityIndex);
+	const auto& body_transform = transform_pool.GetByEntity(body_physics.EntityIndex);
+
+	const auto& height_field = *GetHeightField(terrain_physics.PtrHeightFieldTerrain);
+	const auto& world_matrix = terrain_transform->WorldMatrix;
+	auto inverse_world_matrix = XMMatrixInverse(nullptr, world_matrix);
+	auto normal_matrix = XMMatrixTranspose(inverse_world_matrix);
+
+	// #1 Deepest point of the body under the heightfield (in world space)
+	float deepest_depth{};
+	XMVECTOR deepest_body_point{};
+	XMVECTOR deepest_surface_point{};
+	XMVECTOR deepest_normal{};
+	auto test_point = [&](const XMVECTOR& WorldPoint, float Radius)
+	{
+		auto local_point = XMVector3TransformCoord(WorldPoint, inverse_world_matrix);
+		auto local_x = XMVectorGetX(local_point);
+		auto local_z = XMVectorGetZ(local_point);
+		if (!height_field.IsInside(local_x, local_z)) { return; }
+
+		auto normal = XMVector3Normalize(XMVector3TransformNormal(height_field.GetNormal(local_x, local_z), normal_matrix));
+		auto surface_point = XMVector3TransformCoord(XMVectorSetY(local_point, height_field.GetHeight(local_x, local_z)), world_matrix);
+
+		// Distance along the normal (the surface is locally a plane)
+		auto depth = Radius - XMVectorGetX(XMVector3Dot(WorldPoint - surface_point, normal));
+		if (depth > deepest_depth)
+		{
+			deepest_depth = depth;
+			deepest_normal = normal;
+			deepest_body_point = WorldPoint - normal * Radius;
+			deepest_surface_point = deepest_body_point + normal * depth;
+		}
+	};
+
+	if (body_physics.PtrCollisionMesh)
+	{
+		for (const auto& position : body_physics.PtrCollisionMesh->vPositionVertex)
+		{
+			test_point(XMVector3TransformCoord(position, body_transform->WorldMatrix), 0);
+		}
+	}
+	else
+	{
+		test_point(body_physics.BoundingSphere.Center + body_transform->Position, body_physics.BoundingSphere.Radius);
+	}
+
+	if (deepest_depth <= 0) { return; }
+
+	m_IsThereAnyActualCollision = true;
+
+	auto relative_velocity_ba = b_physics.Velocity - a_physics.Velocity;
+	auto signed_closing_speed = XMVectorGetX(XMVector3Dot(relative_velocity_ba, DirectionBA));
+
+	const auto& a_entity = m_pECS->GetEntityByIndex(a_physics.EntityIndex);
+	const auto& b_entity = m_pECS->GetEntityByIndex(b_physics.EntityIndex);
+
+	// @important
+	// The heightfield normal points from the terrain to the body, the collision normal must be in b-a direction.
+	if (is_terrain_a)
+	{
+		m_FineCollisionList.emplace_back(a_entity->GetEntityHandle(), b_entity->GetEntityHandle(), DirectionBA,
+			-deepest_normal, deepest_surface_point, deepest_body_point, deepest_depth, signed_closing_speed);
+	}
+	else
+	{
+		m_FineCollisionList.emplace_back(a_entity->GetEntityHandle(), b_entity->GetEntityHandle(), DirectionBA,
+			deepest_normal, deepest_body_point, deepest_surface_point, deepest_depth, signed_closing_speed);
+	}
+}
+
 PRIVATE auto JWSystemPhysics::IsPointAInB(const XMVECTOR& PointA, const VECTOR<STransformedFace>& BTransformedFaces) noexcept->bool
 {
 	// return true if PointA is inside all faces of B
@@ -1367,134 +2195,227 @@ PRIVATE auto JWSystemPhysics::IsPointAInB(const XMVECTOR& PointA, const VECTOR<S
 	return result;
 }
 
-void JWSystemPhysics::ProcessCollision() noexcept
+PRIVATE void JWSystemPhysics::ProcessCollision(float DeltaTime) noexcept
 {
+	auto& transform_pool = m_pECS->SystemTransform().ComponentPool();
+
+	// @important
+	// BeginFrame() must be called even if there's no collision, so that old manifolds are dropped.
+	m_ContactSolver.BeginFrame(m_Components.GetCount());
+
 	// Early out
 	if (m_FineCollisionList.size() == 0) { return; }
 
+	// #00 Sleeping bodies touched by awake ones wake up (with their islands)
+	bool has_woken_up{};
 	for (const auto& iter : m_FineCollisionList)
 	{
-		auto a_physics{ iter.PtrEntityA->GetComponentPhysics() };
-		auto b_physics{ iter.PtrEntityB->GetComponentPhysics() };
+		auto a_entity{ m_pECS->GetEntityByHandle(iter.EntityA) };
+		auto b_entity{ m_pECS->GetEntityByHandle(iter.EntityB) };
+		if ((a_entity == nullptr) || (b_entity == nullptr)) { continue; }
 
+		auto a_physics{ a_entity->GetComponentPhysics() };
+		auto b_physics{ b_entity->GetComponentPhysics() };
+		if ((a_physics == nullptr) || (b_physics == nullptr)) { continue; }
 
-		// #01 Check collision direction
-		auto a_collision_dir = XMVector3Dot(XMVector3Normalize(a_physics->Velocity), -iter.CollisionNormal);
-		auto b_collision_dir = XMVector3Dot(XMVector3Normalize(b_physics->Velocity), iter.CollisionNormal);
-		if ( (XMVector3Less(a_collision_dir, KVectorZero)) || (XMVector3Less(b_collision_dir, KVectorZero)) )
+		if ((a_physics->IsSleeping) || (b_physics->IsSleeping))
 		{
-			// Not colliding, but separating.
-			//continue;
+			a_physics->WakeUp();
+			b_physics->WakeUp();
+			has_woken_up = true;
 		}
+	}
+	if (has_woken_up)
+	{
+		WakeUpSleepIslands();
+	}
 
+	// #01 Solver bodies
+	auto& solver_bodies = m_ContactSolver.GetSolverBodies();
+	for (const auto& iter : m_Components)
+	{
+		auto& body = solver_bodies[iter.ComponentIndex];
+		auto transform = transform_pool.GetByEntity(iter.EntityIndex);
+
+		body.LinearVelocity = iter.Velocity;
+		body.AngularVelocity = iter.AngularVelocity;
+		body.Position = (transform) ? transform->Position : KVectorZero;
+		body.InverseMass = max(iter.InverseMass, 0.0f);
+		body.InverseInertiaWorld = XMMATRIX(KVectorZero, KVectorZero, KVectorZero, KVectorZero);
+
+		// Bodies without inertia tensor don't rotate by contacts.
+		XMVECTOR determinant{};
+		auto inverse_inertia = XMMatrixInverse(&determinant, iter.InertiaTensor);
+		if ((body.InverseMass > 0) && (transform) && (XMVectorGetX(determinant) > 0))
+		{
+			// I^-1 (world) = R^T * I^-1 (local) * R
+			auto rotation = XMMatrixRotationRollPitchYaw(transform->PitchYawRoll.x, transform->PitchYawRoll.y, transform->PitchYawRoll.z);
+			body.InverseInertiaWorld = XMMatrixTranspose(rotation) * inverse_inertia * rotation;
+		}
+	}
 
-		// #02 Get delta velocity (in order to set post-collision-velocity)
-		auto a_collision_speed = XMVector3Dot(a_physics->Velocity, -iter.CollisionNormal);
-		auto a_collision_velocity = a_collision_speed * -iter.CollisionNormal;
-		auto a_separating_speed = a_collision_speed * (1.0f + a_physics->Restitution);
-		auto a_delta_velocity_restitution = a_separating_speed * iter.CollisionNormal;
-		auto a_delta_velocity_pure = a_collision_speed * (a_physics->Restitution) * iter.CollisionNormal;
-
-		auto b_collision_speed = XMVector3Dot(b_physics->Velocity, iter.CollisionNormal);
-		auto b_collision_velocity = b_collision_speed * iter.CollisionNormal;
-		auto b_separating_speed = b_collision_speed * (1.0f + b_physics->Restitution);
-		auto b_delta_velocity_restitution = b_separating_speed * -iter.CollisionNormal;
-		auto b_delta_velocity_pure = b_collision_speed * (b_physics->Restitution) * -iter.CollisionNormal;
+	// #02 Contact manifolds (points are cached across frames, matched points keep their impulses)
+	for (const auto& iter : m_FineCollisionList)
+	{
+		auto a_entity{ m_pECS->GetEntityByHandle(iter.EntityA) };
+		auto b_entity{ m_pECS->GetEntityByHandle(iter.EntityB) };
+		if ((a_entity == nullptr) || (b_entity == nullptr)) { continue; }
+
+		auto a_physics{ a_entity->GetComponentPhysics() };
+		auto b_physics{ b_entity->GetComponentPhysics() };
+		auto a_transform{ a_entity->GetComponentTransform() };
+		auto b_transform{ b_entity->GetComponentTransform() };
+		if ((a_physics == nullptr) || (b_physics == nullptr) || (a_transform == nullptr) || (b_transform == nullptr)) { continue; }
+
+		SContactInput input{};
+		input.BodyA = a_physics->ComponentIndex;
+		input.BodyB = b_physics->ComponentIndex;
+		input.EntityA = iter.EntityA;
+		input.EntityB = iter.EntityB;
+		input.WorldMatrixA = a_transform->WorldMatrix;
+		input.WorldMatrixB = b_transform->WorldMatrix;
+		input.Normal = iter.CollisionNormal;
+		input.PointA = iter.CollisionPointA;
+		input.PointB = iter.CollisionPointB;
+		input.PenetrationDepth = iter.PenetrationDepth;
+		// Same rule as the impulse response before the contact solver: the product of the kinetic friction constants.
+		// (Static friction constants aren't used, the solver has a single Coulomb cone per contact.)
+		input.Friction = a_physics->MaterialFriction.KineticFrictionConstant * b_physics->MaterialFriction.KineticFrictionConstant;
+		input.Restitution = max(a_physics->Restitution, b_physics->Restitution);
+
+		m_ContactSolver.AddContact(input);
+	}
 
+	// #03 Islands (union-find) are solved in parallel
+	m_ContactSolver.Solve(m_pECS->JobSystem(), DeltaTime);
 
-		// #03 Resolve penetration
-		float a_mass{ 0.0f };
-		float b_mass{ 0.0f };
-		if (a_physics->InverseMass > 0) { a_mass = 1.0f / a_physics->InverseMass; }
-		if (b_physics->InverseMass > 0) { b_mass = 1.0f / b_physics->InverseMass; }
+	// #04 Write back velocities
+	for (auto& iter : m_Components)
+	{
+		const auto& body = solver_bodies[iter.ComponentIndex];
+		if ((body.IsInContact) && (iter.InverseMass > 0))
+		{
+			iter.Velocity = body.LinearVelocity;
+			iter.AngularVelocity = body.AngularVelocity;
+		}
+	}
+}
 
-		auto a_transform{ iter.PtrEntityA->GetComponentTransform() };
-		auto a_penetration_resolution{ (a_mass / (a_mass + b_mass)) * iter.PenetrationDepth * iter.CollisionNormal };
-		a_transform->Position += a_penetration_resolution;
+PRIVATE void JWSystemPhysics::UpdateSleepStates(float DeltaTime) noexcept
+{
+	auto& transform_pool = m_pECS->SystemTransform().ComponentPool();
+	auto body_count = m_Components.GetCount();
 
-		auto b_transform{ iter.PtrEntityB->GetComponentTransform() };
-		auto b_penetration_resolution{ (b_mass / (a_mass + b_mass)) * iter.PenetrationDepth * -iter.CollisionNormal };
-		b_transform->Position += b_penetration_resolution;
+	m_vIslandSleepTimers.assign(body_count, KTimeToSleep);
+	m_vIslandSleepIDs.assign(body_count, 0);
 
+	// #1 Timers (an island sleeps only if all of its bodies are ready)
+	auto linear_threshold_sq = KSleepLinearVelocityThreshold * KSleepLinearVelocityThreshold;
+	auto angular_threshold_sq = KSleepAngularVelocityThreshold * KSleepAngularVelocityThreshold;
+	for (auto& iter : m_Components)
+	{
+		if ((iter.InverseMass <= 0) || (iter.IsSleeping)) { continue; }
 
-		// #04 Get friction velocity
-		auto a_sliding_velocity = a_physics->Velocity - a_collision_velocity;
-		auto b_sliding_velocity = b_physics->Velocity - b_collision_velocity;
+		if ((iter.CanSleep) &&
+			(XMVectorGetX(XMVector3LengthSq(iter.Velocity)) < linear_threshold_sq) &&
+			(XMVectorGetX(XMVector3LengthSq(iter.AngularVelocity)) < angular_threshold_sq))
+		{
+			iter.SleepTimer += DeltaTime;
+		}
+		else
+		{
+			iter.SleepTimer = 0;
+		}
 
-		///auto static_friction{ a_physics->MaterialFriction.StaticFrictionConstant * b_physics->MaterialFriction.StaticFrictionConstant };
-		auto kinetic_friction{ a_physics->MaterialFriction.KineticFrictionConstant * b_physics->MaterialFriction.KineticFrictionConstant };
+		auto root = m_ContactSolver.GetIslandRoot(iter.ComponentIndex);
+		m_vIslandSleepTimers[root] = min(m_vIslandSleepTimers[root], iter.SleepTimer);
+	}
 
-		auto a_friction_size = XMVectorGetX(XMVector3Length(a_collision_velocity * kinetic_friction));
-		auto a_friction_velocity = XMVector3Normalize(-a_sliding_velocity) * a_friction_size;
+	// #2 Islands fall asleep
+	m_SleepingBodyCount = 0;
+	for (auto& iter : m_Components)
+	{
+		if (iter.InverseMass <= 0) { continue; }
 
-		auto b_friction_size = XMVectorGetX(XMVector3Length(b_collision_velocity * kinetic_friction));
-		auto b_friction_velocity = XMVector3Normalize(-b_sliding_velocity) * b_friction_size;
+		if (!iter.IsSleeping)
+		{
+			auto root = m_ContactSolver.GetIslandRoot(iter.ComponentIndex);
+			if (m_vIslandSleepTimers[root] < KTimeToSleep) { continue; }
 
+			if (m_vIslandSleepIDs[root] == 0)
+			{
+				m_vIslandSleepIDs[root] = ++m_LastSleepIslandID;
+			}
 
-		// #05 Resolve collision
-		if (a_physics->InverseMass > 0)
-		{
-			// Linear impulse: g = m * v
-			auto a_linear_impulse{ a_delta_velocity_pure / a_physics->InverseMass };
-			
-			// Torque: t = r x F
-			// r = vector from center of mass to collision point
-			auto a_r{ iter.CollisionPointA - a_transform->Position };
+			auto transform = transform_pool.GetByEntity(iter.EntityIndex);
 
-			// Angular impulse: u = r X g
-			auto a_angular_impulse{ XMVector3Cross(a_r, a_linear_impulse) };
+			iter.IsSleeping = true;
+			iter.SleepIslandID = m_vIslandSleepIDs[root];
+			iter.SleepWorldMatrixVersion = (transform) ? transform->WorldMatrixVersion : 0;
+			iter.Velocity = KVectorZero;
+			iter.AngularVelocity = KVectorZero;
+		}
 
-			// Direction of torque == direction of impulse
-			auto a_rotation_axis{ XMVector3Normalize(a_angular_impulse) };
-			
-			// Scalar moment of inertia: i = DOT{ (n * InverseInertiaTensr), n }
-			// (n is a unit vector of an arbitrary axis)
-			auto i_0 = XMVector4Transform(a_rotation_axis, a_physics->InertiaTensor);
-			auto i_1 = XMVector3Dot(i_0, a_rotation_axis);
-			auto inverse_i = XMVectorGetX(i_1);
+		++m_SleepingBodyCount;
+	}
+}
 
-			//assert(inverse_i);
+PRIVATE void JWSystemPhysics::WakeUpSleepIslands() noexcept
+{
+	// @important
+	// An awake body that still has its sleep island ID was woken up since it fell asleep,
+	// so the bodies that fell asleep together with it must wake up too.
+	m_vWakingSleepIslandIDs.clear();
+	for (auto& iter : m_Components)
+	{
+		if ((!iter.IsSleeping) && (iter.SleepIslandID))
+		{
+			m_vWakingSleepIslandIDs.emplace_back(iter.SleepIslandID);
+			iter.SleepIslandID = 0;
+		}
+	}
 
-			// Update angular velocity w = I^-1 * u
-			a_physics->AngularVelocity += a_angular_impulse * inverse_i;
+	if (m_vWakingSleepIslandIDs.empty()) { return; }
 
-			// Update velocity dv = 1/m * g
-			a_physics->Velocity += a_delta_velocity_restitution + a_friction_velocity;
+	std::sort(m_vWakingSleepIslandIDs.begin(), m_vWakingSleepIslandIDs.end());
+	for (auto& iter : m_Components)
+	{
+		if ((iter.IsSleeping) && (std::binary_search(m_vWakingSleepIslandIDs.begin(), m_vWakingSleepIslandIDs.end(), iter.SleepIslandID)))
+		{
+			iter.WakeUp();
+			iter.SleepIslandID = 0;
 		}
+	}
+}
 
-		if (b_physics->InverseMass > 0)
+PRIVATE void JWSystemPhysics::UpdateSceneQueryTree(bool ShouldUpdateSleepingBodies) noexcept
+{
+	auto& transform_pool = m_pECS->SystemTransform().ComponentPool();
+	for (auto& iter : m_Components)
+	{
+		if (!iter.IsQueryable)
 		{
-			// Linear impulse: g = m * v
-			auto b_linear_impulse{ b_delta_velocity_pure / b_physics->InverseMass };
-
-			// Torque: t = r x F
-			// r = vector from center of mass to collision point (perpendicular to the force)
-			auto b_r_0{ iter.CollisionPointB - b_transform->Position };
-			auto b_r_perp{ XMVector3Normalize(XMVector3Cross(XMVector3Normalize(b_linear_impulse), XMVector3Normalize(b_r_0))) };
-			auto b_r_dir{ XMVector3Normalize(XMVector3Cross(XMVector3Normalize(b_linear_impulse), b_r_perp)) };
-			auto b_r{ XMVector3Dot(b_r_0, b_r_dir) * b_r_dir };
-
-			// Angular impulse: u = r X g
-			auto b_angular_impulse{ XMVector3Cross(b_r, b_linear_impulse) };
-
-			// Direction of torque == direction of impulse
-			auto b_rotation_axis{ XMVector3Normalize(b_angular_impulse) };
-
-			// Scalar moment of inertia: i = DOT{ (n * InverseInertiaTensr), n }
-			// (n is a unit vector of an arbitrary axis)
-			auto ni = XMVector3Transform(b_rotation_axis, b_physics->InertiaTensor);
-			auto i = XMVectorGetX(XMVector3Dot(ni, b_rotation_axis));
-			if (i)
+			if (iter.SceneQueryProxyID != KInvalidAABBTreeNodeID)
 			{
-				auto inverse_i = 1.0f / i;
+				m_SceneQueryTree.DestroyProxy(iter.SceneQueryProxyID);
+				iter.SceneQueryProxyID = KInvalidAABBTreeNodeID;
+			}
+			continue;
+		}
 
-				// Update angular velocity w = I^-1 * u
+		if ((iter.IsSleeping) && (!ShouldUpdateSleepingBodies) && (iter.SceneQueryProxyID != KInvalidAABBTreeNodeID)) { continue; }
 
-				b_physics->AngularVelocity += b_angular_impulse * inverse_i;
-			}
-			
-			// Update velocity dv = 1/m * g
-			b_physics->Velocity += b_delta_velocity_restitution + b_friction_velocity;
+		auto transform = transform_pool.GetByEntity(iter.EntityIndex);
+		auto world_center = iter.BoundingSphere.Center;
+		if (transform) { world_center += transform->Position; }
+
+		if (iter.SceneQueryProxyID == KInvalidAABBTreeNodeID)
+		{
+			iter.SceneQueryProxyID = m_SceneQueryTree.CreateProxy(world_center, iter.BoundingSphere.Radius, iter.EntityIndex);
+		}
+		else
+		{
+			m_SceneQueryTree.MoveProxy(iter.SceneQueryProxyID, world_center, iter.BoundingSphere.Radius);
 		}
 	}
 }
\ No newline at end of file
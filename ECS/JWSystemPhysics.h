@@ -1,6 +1,11 @@
 #pragma once
 
-#include "../Core/JWCommon.h"
+#include "JWBroadPhase.h"
+#include "JWComponentPool.h"
+#include "JWNarrowPhase.h"
+#include "JWContactSolver.h"
+#include "JWHeightField.h"
+#include "JWDynamicAABBTree.h"
 
 namespace JWEngine
 {
@@ -16,8 +21,83 @@ namespace JWEngine
 	//static constexpr XMVECTOR	KVectorGravityOnEarth{ KGravityOnEarth, 0, 0, 0 };
 	static const STRING			KNoName{ "" };
 
+	// [Unit]	Hz
+	static constexpr float		KDefaultPhysicsStepFrequency{ 60.0f };
+
+	// Steps taken in one Execute() at most, the rest of the accumulated time is dropped.
+	// (Otherwise a slow frame causes more steps in the next frame, which makes it slower, and so on.)
+	static constexpr uint32_t	KDefaultMaxPhysicsSubstepCount{ 4 };
+
+	// [Unit]	m/s
+	static constexpr float		KSleepLinearVelocityThreshold{ 0.05f };
+
+	// [Unit]	rad/s
+	static constexpr float		KSleepAngularVelocityThreshold{ 0.05f };
+
+	// [Unit]	s
+	// Every body of an island must stay under the thresholds this long for the island to fall asleep.
+	static constexpr float		KTimeToSleep{ 0.5f };
+
+	// CCD is done for a body when it moves more than this fraction of its bounding sphere's radius in one step.
+	static constexpr float		KCCDMotionThresholdRatio{ 0.5f };
+
+	// Swept-sphere (time-of-impact) queries in one step at most, the fastest bodies are swept first.
+	static constexpr uint32_t	KDefaultCCDBodyBudget{ 32 };
+
 	class JWEntity;
 	class JWECS;
+	struct SComponentTransform;
+
+	// Everything a physics step reads from the last step, of one component (and its transform).
+	// @important: trivially copyable, it's written into snapshots as raw bytes.
+	struct SPhysicsBodyState
+	{
+		EntityIndexType		EntityIndex{};
+
+		XMVECTOR	Velocity{};
+		XMVECTOR	LinearAcceleration{};
+		XMVECTOR	AngularVelocity{};
+		XMVECTOR	AngularAcceleration{};
+		XMVECTOR	AccumulatedForce{};
+
+		XMVECTOR	PreviousPosition{};
+		XMFLOAT3	PreviousPitchYawRoll{};
+		XMVECTOR	CCDHitNormal{};
+		float		CCDTimeOfImpact{};
+		float		SleepTimer{};
+		uint32_t	SleepIslandID{};
+		uint32_t	SleepWorldMatrixVersion{};
+		bool		HasPreviousState{};
+		bool		IsSleeping{};
+
+		// Transform
+		bool		HasTransform{};
+		bool		IsWorldMatrixDirty{};
+		uint32_t	WorldMatrixVersion{};
+		XMVECTOR	Position{};
+		XMFLOAT3	PitchYawRoll{};
+		XMVECTOR	Forward{};
+		XMVECTOR	Right{};
+		XMMATRIX	WorldMatrix{};
+	};
+
+	struct SPhysicsSnapshotHeader
+	{
+		// DirectXMath's FMA3 path rounds differently, so snapshots don't move between builds that differ in it.
+		uint32_t	MathPath{};
+		uint32_t	ComponentCount{};
+		uint32_t	StepIndex{};
+		uint32_t	LastSleepIslandID{};
+		float		TimeAccumulator{};
+	};
+
+	// Binary copy of the physics state (header, body states, contact solver state).
+	// vData only grows, so saving into the same snapshot again doesn't allocate.
+	struct SPhysicsSnapshot
+	{
+		VECTOR<uint8_t>	vData{};
+		uint32_t		Size{};
+	};
 	
 	enum class ECollisionType
 	{
@@ -27,6 +107,16 @@ namespace JWEngine
 		EdgeEdge,
 	};
 	
+	enum class EPhysicsTimeStepMode
+	{
+		// One step of the frame's delta time (results depend on the frame rate).
+		Variable,
+
+		// Accumulated frame time is consumed in fixed steps, and rendering interpolates between the last two steps.
+		// Same inputs always give the same results regardless of the frame rate.
+		Fixed,
+	};
+
 	enum class EClosestEdgePair
 	{
 		None,
@@ -59,6 +149,17 @@ namespace JWEngine
 		XMVECTOR	M{};
 	};
 	
+	// Collision mesh faces in world space, shared by every pair the body is in.
+	// Rebuilt only when the body's world matrix (or its collision mesh) has changed.
+	struct SWorldSpaceHull
+	{
+		VECTOR<STransformedFace>	vFaces{};
+
+		EntityIndexType				EntityIndex{};
+		uint32_t					TransformVersion{};
+		const JWModel*				PtrCollisionMesh{};
+	};
+
 	struct SClosestFace
 	{
 		SClosestFace() {};
@@ -89,27 +190,19 @@ namespace JWEngine
 		XMVECTOR M{};
 	};
 
-	struct SCollisionPair
-	{
-		SCollisionPair() {};
-		SCollisionPair(ComponentIndexType _A, ComponentIndexType _B) : A{ _A }, B{ _B } {};
-
-		ComponentIndexType A{};
-		ComponentIndexType B{};
-	};
-	
 	struct SCollisionData
 	{
 		SCollisionData() {};
-		SCollisionData(JWEntity* _PtrEntityA, JWEntity* _PtrEntityB, const XMVECTOR& _DirectionBA, 
+		SCollisionData(EntityHandleType _EntityA, EntityHandleType _EntityB, const XMVECTOR& _DirectionBA, 
 			const XMVECTOR& _CollisionNormal, const XMVECTOR& _CollisionPointA, const XMVECTOR& _CollisionPointB, 
 			float _PenetrationDepth, float _ClosingSpeed)
-			: PtrEntityA{ _PtrEntityA }, PtrEntityB{ _PtrEntityB }, DirectionBA{ _DirectionBA },
+			: EntityA{ _EntityA }, EntityB{ _EntityB }, DirectionBA{ _DirectionBA },
 			CollisionNormal{ _CollisionNormal }, CollisionPointA{ _CollisionPointA }, CollisionPointB{ _CollisionPointB },
 			PenetrationDepth{ _PenetrationDepth }, ClosingSpeed{ _ClosingSpeed } {};
 
-		JWEntity*	PtrEntityA{};
-		JWEntity*	PtrEntityB{};
+		// Handles (not pointers), so that destroyed entities are detected.
+		EntityHandleType	EntityA{ KInvalidEntityHandle };
+		EntityHandleType	EntityB{ KInvalidEntityHandle };
 		
 		XMVECTOR	DirectionBA{};
 
@@ -258,6 +351,56 @@ namespace JWEngine
 		// (NON_OWNING) Collision mesh
 		JWModel*	PtrCollisionMesh{};
 
+		// (NON_OWNING) Heightfield collider (terrain)
+		// Used instead of the collision mesh if it's set.
+		const STerrainData*	PtrHeightFieldTerrain{};
+
+		// Narrow phase of the pairs this body is in.
+		// GJK is used only if both bodies of the pair select it (their collision meshes must be convex).
+		ENarrowPhaseType	NarrowPhaseType{ ENarrowPhaseType::FaceSearch };
+		ESupportMappingType	SupportMappingType{ ESupportMappingType::BruteForce };
+
+		// State before the last fixed step (for interpolation)
+		XMVECTOR	PreviousPosition{};
+		XMFLOAT3	PreviousPitchYawRoll{};
+		bool		HasPreviousState{ false };
+
+		// [Property]	continuous collision detection
+		// For small fast bodies that would otherwise tunnel through thin meshes or terrain.
+		bool		IsCCDEnabled{ false };
+
+		// Fraction of this step's motion the body may move (set by CCD, reset in every step)
+		float		CCDTimeOfImpact{ 1.0f };
+		XMVECTOR	CCDHitNormal{};
+
+		// [Property]	collision layer
+		// Pairs of layers that don't collide (see JWSystemPhysics::SetLayerCollision()) are rejected in the broad phase.
+		uint32_t	CollisionLayer{ KDefaultCollisionLayer };
+
+		// Simulated: collides, and is moved by physics (if it has mass).
+		// Queryable: can be picked and found by scene queries.
+		// (Query-only bodies, e.g. cameras and lights, never generate any contact work.)
+		bool		IsSimulated{ true };
+		bool		IsQueryable{ true };
+
+		// Sleeping bodies are not integrated nor re-bounded,
+		// and their pairs with static or other sleeping bodies are excluded from the narrow phase.
+		bool		CanSleep{ true };
+		bool		IsSleeping{ false };
+
+		// [Unit]	s
+		// Time spent under the sleep velocity thresholds
+		float		SleepTimer{};
+
+		// Bounding sphere's proxy in the scene query tree
+		uint32_t	SceneQueryProxyID{ KInvalidAABBTreeNodeID };
+
+		// Bodies that fell asleep in the same island (they wake up together)
+		uint32_t	SleepIslandID{};
+
+		// If the transform changes while sleeping (e.g. SetPosition()), the body wakes up.
+		uint32_t	SleepWorldMatrixVersion{};
+
 		void SetMassByGram(float g)
 		{
 			assert(g > 0);
@@ -281,11 +424,38 @@ namespace JWEngine
 		void SetVelocity(const XMVECTOR& _Velocity) noexcept
 		{
 			Velocity = _Velocity;
+			WakeUp();
 		}
 
 		void AddForce(const XMVECTOR& Force) noexcept
 		{
 			AccumulatedForce += Force;
+			WakeUp();
+		}
+
+		// The rest of the sleep island is woken up in the next step.
+		void WakeUp() noexcept
+		{
+			IsSleeping = false;
+			SleepTimer = 0;
+		}
+
+		void SetCollisionLayer(uint32_t Layer) noexcept
+		{
+			assert(Layer < KMaxCollisionLayerCount);
+			CollisionLayer = min(Layer, KMaxCollisionLayerCount - 1);
+		}
+
+		void SetQueryOnly() noexcept
+		{
+			IsSimulated = false;
+			IsQueryable = true;
+		}
+
+		// In the broad phase
+		bool IsCollidable() const noexcept
+		{
+			return (IsSimulated) && (InverseMass != KNonPhysicalObjectInverseMass);
 		}
 
 		void ClearAccumulation() noexcept
@@ -298,6 +468,12 @@ namespace JWEngine
 			assert(PtrModel);
 			PtrCollisionMesh = PtrModel;
 		}
+
+		void SetHeightFieldCollider(const STerrainData* PtrTerrainData)
+		{
+			assert(PtrTerrainData);
+			PtrHeightFieldTerrain = PtrTerrainData;
+		}
 	};
 
 	class JWSystemPhysics
@@ -320,7 +496,85 @@ namespace JWEngine
 		void SetSystemPhysicsFlag(JWFlagSystemPhysicsOption Flag) noexcept;
 		void ToggleSystemPhysicsFlag(JWFlagSystemPhysicsOption Flag) noexcept;
 
-		const auto GetPickedEntity() const noexcept { return m_pPickedEntity; };
+		// ### Broad phase ###
+		void SetBroadPhaseType(EBroadPhaseType Type) noexcept;
+		auto GetBroadPhaseType() const noexcept { return m_BroadPhase.GetType(); };
+		const auto& GetBroadPhase() const noexcept { return m_BroadPhase; };
+		auto GetCoarseCollisionPairCount() const noexcept { return static_cast<uint32_t>(m_CoarseCollisionList.size()); };
+
+		// ### Collision layers ###
+		void SetLayerCollision(uint32_t LayerA, uint32_t LayerB, bool ShouldCollide) noexcept { m_BroadPhase.SetLayerCollision(LayerA, LayerB, ShouldCollide); };
+		auto ShouldLayersCollide(uint32_t LayerA, uint32_t LayerB) const noexcept { return m_BroadPhase.ShouldLayersCollide(LayerA, LayerB); };
+
+		// Number of world-space hulls rebuilt in the last frame (the rest were reused).
+		auto GetRebuiltWorldSpaceHullCount() const noexcept { return m_RebuiltWorldSpaceHullCount; };
+
+		// ### Narrow phase ###
+		// Time spent in fine collision detection in the last Execute() in microseconds.
+		// (For comparing ENarrowPhaseType on the same scene.)
+		auto GetFineCollisionTime() const noexcept { return m_FineCollisionTime; };
+		auto GetGJKPairCount() const noexcept { return m_GJKPairCount; };
+
+		// Contacts found in the last fixed step (before they were solved)
+		const auto& GetFineCollisionList() const noexcept { return m_FineCollisionList; };
+
+		// ### Contact solver ###
+		auto& ContactSolver() noexcept { return m_ContactSolver; };
+
+		// ### Scene queries ###
+		// Bounding spheres of every physics component (user data = entity index).
+		// It's brought up to date at the end of Execute(), so components created after that aren't in it yet.
+		auto& SceneQueryTree() noexcept { return m_SceneQueryTree; };
+
+		// ### Time step ###
+		void SetTimeStepMode(EPhysicsTimeStepMode Mode) noexcept;
+		auto GetTimeStepMode() const noexcept { return m_TimeStepMode; };
+		void SetFixedStepFrequency(float Hz) noexcept;
+		auto GetFixedDeltaTime() const noexcept { return m_FixedDeltaTime; };
+		void SetMaxSubstepCount(uint32_t Count) noexcept { m_MaxSubstepCount = max(Count, (uint32_t)1); };
+		auto GetMaxSubstepCount() const noexcept { return m_MaxSubstepCount; };
+
+		// ### Sleeping ###
+		auto GetSleepingBodyCount() const noexcept { return m_SleepingBodyCount; };
+
+		// ### Continuous collision detection ###
+		void SetCCDBodyBudget(uint32_t Budget) noexcept { m_CCDBodyBudget = Budget; };
+		auto GetCCDBodyBudget() const noexcept { return m_CCDBodyBudget; };
+
+		// Bodies swept / bodies stopped at their time of impact in the last step
+		auto GetCCDBodyCount() const noexcept { return m_CCDBodyCount; };
+		auto GetCCDHitCount() const noexcept { return m_CCDHitCount; };
+
+		// ### Determinism ###
+		// Fixed time step only, and collision pairs are processed in a stable order.
+		// Same initial state + same inputs per step = same results (also after RestoreSnapshot()).
+		void SetDeterministicMode(bool IsDeterministic) noexcept;
+		auto IsDeterministicMode() const noexcept { return m_IsDeterministicMode; };
+
+		// Fixed steps taken since Create() (restored with snapshots, e.g. as the lockstep frame number)
+		auto GetStepIndex() const noexcept { return m_StepIndex; };
+
+		// Takes StepCount fixed steps right away (for resimulation after RestoreSnapshot()).
+		// @important: forces must be applied again before each call, they are cleared in every step.
+		void Simulate(uint32_t StepCount) noexcept;
+
+		// ### Snapshots ###
+		auto GetSnapshotSize() const noexcept->uint32_t;
+		void SaveSnapshot(SPhysicsSnapshot& Snapshot) noexcept;
+
+		// Fails if physics components were created or destroyed since the snapshot was saved,
+		// if the snapshot is truncated or if it was saved by a build with a different math path (FMA3).
+		auto RestoreSnapshot(const SPhysicsSnapshot& Snapshot) noexcept->bool;
+
+		// Number of steps taken in the last Execute()
+		auto GetSubstepCount() const noexcept { return m_SubstepCount; };
+
+		// [0, 1) between the state before and after the last fixed step
+		auto GetInterpolationAlpha() const noexcept { return m_InterpolationAlpha; };
+
+		// Returns nullptr if the picked entity was destroyed.
+		auto GetPickedEntity() const noexcept->JWEntity*;
+		auto GetPickedEntityHandle() const noexcept { return m_PickedEntityHandle; };
 		auto GetPickedEntityName() const noexcept->const STRING&;
 
 		const auto& GetPickingRayOrigin() const noexcept { return m_PickingRayOrigin; };
@@ -353,11 +607,14 @@ namespace JWEngine
 		void ZeroAllVelocities() noexcept;
 		void Execute() noexcept;
 
+		// Packed components + entity mapping (for multi-component views)
+		auto& ComponentPool() noexcept { return m_Components; };
+
 	// Only accesible for JWEntity
 	private:
 		auto CreateComponent(EntityIndexType EntityIndex) noexcept->ComponentIndexType;
-		void DestroyComponent(ComponentIndexType ComponentIndex) noexcept;
-		auto GetComponentPtr(ComponentIndexType ComponentIndex) noexcept->SComponentPhysics*;
+		void DestroyComponent(EntityIndexType EntityIndex) noexcept;
+		auto GetComponentPtr(EntityIndexType EntityIndex) noexcept->SComponentPhysics*;
 
 	private:
 		// Picking
@@ -371,18 +628,51 @@ namespace JWEngine
 		///void UpdateBoundingEllipsoid(SComponentPhysics& Physics) noexcept;
 		///void UpdateSubBoundingEllipsoids(SComponentPhysics& Physics) noexcept;
 
-		void UpdateBoundingSphere(SComponentPhysics& Physics) noexcept;
-		void UpdateSubBoundingSpheres(SComponentPhysics& Physics) noexcept;
+		void UpdateBoundingSphere(SComponentPhysics& Physics, const SComponentTransform& Transform) noexcept;
+		void UpdateSubBoundingSpheres(SComponentPhysics& Physics, const SComponentTransform& Transform) noexcept;
 
 		void DetectCoarseCollision() noexcept;
+		void UpdateWorldSpaceHulls() noexcept;
 		void DetectFineCollision() noexcept;
 
+		auto IsGJKPair(const SCollisionPair& Pair) const noexcept->bool;
+		auto GetConvexHull(const JWModel* PtrCollisionMesh) noexcept->const SConvexHull*;
+		void DetectFineCollisionGJK(const SCollisionPair& Pair, const XMVECTOR& DirectionBA) noexcept;
+
+		// Built once per terrain, when it's first needed.
+		auto GetHeightField(const STerrainData* PtrTerrainData) noexcept->const JWHeightField*;
+		auto IsHeightFieldPair(const SCollisionPair& Pair) const noexcept->bool;
+
+		// Collision mesh vertices (or the bounding sphere if there's no collision mesh) vs heightfield
+		void DetectFineCollisionHeightField(const SCollisionPair& Pair, const XMVECTOR& DirectionBA) noexcept;
+
 		auto IsPointAInB(const XMVECTOR& PointA, const VECTOR<STransformedFace>& BTransformedFaces) noexcept->bool;
 
-		void ProcessCollision() noexcept;
+		// Collision detection + response + integration of one step
+		void Step(float DeltaTime) noexcept;
+		void SavePreviousStates() noexcept;
+		void UpdateInterpolatedWorldMatrices() noexcept;
+		void ClearInterpolatedWorldMatrices() noexcept;
+
+		void IntegrateVelocities(float DeltaTime) noexcept;
+
+		void UpdateSleepStates(float DeltaTime) noexcept;
+
+		// Sleeping bodies don't move, so they are skipped unless ShouldUpdateSleepingBodies is set.
+		void UpdateSceneQueryTree(bool ShouldUpdateSleepingBodies = false) noexcept;
+
+		// Bounding spheres swept against the triangles of the bodies found in the broad phase
+		// (other bodies are treated as not moving)
+		void DetectContinuousCollision(float DeltaTime) noexcept;
+		auto SweepSphereAgainstBody(const XMVECTOR& Origin, const XMVECTOR& Motion, float Radius,
+			const SComponentPhysics& Other, float& InOutTOI, XMVECTOR& OutNormal) noexcept->bool;
+		void WakeUpSleepIslands() noexcept;
+
+		// Contact manifolds -> islands -> sequential impulses
+		void ProcessCollision(float DeltaTime) noexcept;
 
 	private:
-		VECTOR<SComponentPhysics>	m_vComponents;
+		JWComponentPool<SComponentPhysics>	m_Components;
 
 		JWECS*						m_pECS{};
 		HWND						m_hWnd{};
@@ -400,7 +690,7 @@ namespace JWEngine
 		///VECTOR<uint32_t>			m_vPickedSubBoundingEllipsoidID{};
 		VECTOR<uint32_t>			m_vPickedSubBoundingSphereID{};
 
-		JWEntity*					m_pPickedEntity{};
+		EntityHandleType			m_PickedEntityHandle{ KInvalidEntityHandle };
 		JWEntity*					m_pPickedTerrainEntity{};
 		JWEntity*					m_pPickedNonTerrainEntity{};
 		XMVECTOR					m_PickedDistance{};
@@ -408,6 +698,7 @@ namespace JWEngine
 		XMVECTOR					m_PickedNonTerrainDistance{};
 
 		bool						m_IsThereAnyActualCollision{ false };
+		JWBroadPhase				m_BroadPhase{};
 		VECTOR<SCollisionPair>		m_CoarseCollisionList{};
 		VECTOR<SCollisionData>		m_FineCollisionList{};
 
@@ -420,8 +711,51 @@ namespace JWEngine
 		VECTOR<SClosestFace>		m_ClosestFacesB{};
 		SClosestFace				m_ClosestFaceA{};
 		SClosestFace				m_ClosestFaceB{};
-		VECTOR<STransformedFace>	m_TransformedFacesA{};
-		VECTOR<STransformedFace>	m_TransformedFacesB{};
+
+		// World-space hull cache (indexed by component index)
+		VECTOR<SWorldSpaceHull>		m_vWorldSpaceHulls{};
+		VECTOR<ComponentIndexType>	m_vHullComponentIndices{};
+		uint32_t					m_RebuiltWorldSpaceHullCount{};
+
+		// GJK/EPA narrow phase
+		JWNarrowPhase				m_NarrowPhase{};
+		UNORDERED_MAP<const JWModel*, SConvexHull>	m_umapConvexHulls{};
+
+		// Scene queries
+		JWDynamicAABBTree			m_SceneQueryTree{};
+
+		// Heightfield colliders (and picking)
+		UNORDERED_MAP<const STerrainData*, JWHeightField>	m_umapHeightFields{};
+		long long					m_FineCollisionTime{};
+		uint32_t					m_GJKPairCount{};
+
+		JWContactSolver				m_ContactSolver{};
+
+		// Fixed time step
+		EPhysicsTimeStepMode		m_TimeStepMode{ EPhysicsTimeStepMode::Fixed };
+		float						m_FixedDeltaTime{ 1.0f / KDefaultPhysicsStepFrequency };
+		uint32_t					m_MaxSubstepCount{ KDefaultMaxPhysicsSubstepCount };
+		float						m_TimeAccumulator{};
+		float						m_InterpolationAlpha{};
+		uint32_t					m_SubstepCount{};
+
+		// Determinism
+		bool						m_IsDeterministicMode{ false };
+		uint32_t					m_StepIndex{};
+
+		// Sleeping (indexed by island root component index)
+		VECTOR<float>				m_vIslandSleepTimers{};
+		VECTOR<uint32_t>			m_vIslandSleepIDs{};
+		VECTOR<uint32_t>			m_vWakingSleepIslandIDs{};
+		uint32_t					m_LastSleepIslandID{};
+		uint32_t					m_SleepingBodyCount{};
+
+		// Continuous collision detection
+		VECTOR<ComponentIndexType>	m_vCCDComponentIndices{};
+		VECTOR<ComponentIndexType>	m_vCCDCandidateIndices{};
+		uint32_t					m_CCDBodyBudget{ KDefaultCCDBodyBudget };
+		uint32_t					m_CCDBodyCount{};
+		uint32_t					m_CCDHitCount{};
 		XMVECTOR					m_CollisionPoint{};
 
 		// Friction data
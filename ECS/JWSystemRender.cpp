@@ -72,63 +72,38 @@ void JWSystemRender::Destroy() noexcept
 	m_TerrainGenerator.Destroy();
 
 	m_BoundingSphereModel.Destroy();
+
+	JW_RELEASE(m_InstanceBuffer);
+	m_InstanceBufferCapacity = 0;
 	///m_BoundingEllipsoid.Destroy();
 }
 
 PRIVATE auto JWSystemRender::CreateComponent(EntityIndexType EntityIndex) noexcept->ComponentIndexType
 {
-	auto component_index{ static_cast<ComponentIndexType>(m_vComponents.size()) };
-
 	// @important
-	// Save component ID & pointer to Entity
-	m_vComponents.emplace_back(EntityIndex, component_index);
+	// Save component ID & entity index
+	auto component_index = m_Components.Create(EntityIndex);
 	
 	return component_index;
 }
 
-PRIVATE void JWSystemRender::DestroyComponent(ComponentIndexType ComponentIndex) noexcept
+PRIVATE void JWSystemRender::DestroyComponent(EntityIndexType EntityIndex) noexcept
 {
-	if (m_vComponents.size() == 0)
+	if (!m_Components.HasEntity(EntityIndex))
 	{
 		JW_ERROR_ABORT("There is no component to destroy.");
 	}
 
-	// Save the target component's index.
-	auto component_index{ ComponentIndex };
-
-	// Get the last index of the component vector.
-	auto last_index = static_cast<ComponentIndexType>(m_vComponents.size() - 1);
-
-	// Get pointer to the entity with last_index's component.
-	auto ptr_entity_last_component = m_pECS->GetEntityByIndex(m_vComponents[last_index].EntityIndex);
-
-	// See if the component index is invalid.
-	if (component_index > last_index)
-	{
-		JW_ERROR_ABORT("Invalid component index.");
-	}
-
-	// Swap the last element of the vector and the deleted element if necessary
-	if (component_index < last_index)
-	{
-		m_vComponents[component_index] = std::move(m_vComponents[last_index]);
-		m_vComponents[component_index].ComponentIndex = component_index; // @important
+	// Give back the pose buffer slot.
+	ReleasePoseBufferSlot(m_Components.GetByEntity(EntityIndex)->PoseBufferSlot);
 
-		ptr_entity_last_component->SetComponentRenderIndex(component_index); // @important
-	}
-
-	// Shrink the size of the vector.
-	m_vComponents.pop_back();
+	// Swap-and-pop (the pool fixes the moved component's index and its entity mapping).
+	m_Components.DestroyByEntity(EntityIndex);
 }
 
-PRIVATE auto JWSystemRender::GetComponentPtr(ComponentIndexType ComponentIndex) noexcept->SComponentRender*
+PRIVATE auto JWSystemRender::GetComponentPtr(EntityIndexType EntityIndex) noexcept->SComponentRender*
 {
-	if (ComponentIndex >= m_vComponents.size())
-	{
-		return nullptr;
-	}
-
-	return &m_vComponents[ComponentIndex];
+	return m_Components.GetByEntity(EntityIndex);
 }
 
 void JWSystemRender::CreateSharedTexture(ESharedTextureType Type, STRING FileName) noexcept
@@ -177,6 +152,10 @@ void JWSystemRender::CreateSharedTexture(ESharedTextureType Type, STRING FileNam
 
 		m_vSharedTextureData.pop_back();
 	}
+	else
+	{
+		m_umapSharedTextureIndices[texture_srv] = static_cast<uint32_t>(m_vSharedTextureData.size() - 1);
+	}
 }
 
 void JWSystemRender::CreateSharedTextureFromSharedModel(const STRING& ModelName) noexcept
@@ -213,6 +192,10 @@ void JWSystemRender::CreateSharedTextureFromSharedModel(const STRING& ModelName)
 
 		m_vSharedTextureData.pop_back();
 	}
+	else
+	{
+		m_umapSharedTextureIndices[texture_srv] = static_cast<uint32_t>(m_vSharedTextureData.size() - 1);
+	}
 }
 
 auto JWSystemRender::GetSharedTexture(size_t Index) noexcept->ID3D11ShaderResourceView*
@@ -543,14 +526,15 @@ void JWSystemRender::AddBoundingSphereInstance(const XMMATRIX& WorldMatrix) noex
 	// Set the world matrix of the instance
 	instance->World = WorldMatrix;
 
-	UpdateBoundingSphereInstanceBuffer();
+	// Uploaded once per frame in DrawInstancedBoundingSpheres()
+	m_IsBoundingSphereInstanceBufferDirty = true;
 }
 
 void JWSystemRender::EraseBoundingSphereInstance(uint32_t InstanceID) noexcept
 {
 	m_pECS->SystemRender().BoundingSphereModel().ModelData.VertexData.EraseInstanceAt(InstanceID);
 
-	UpdateBoundingSphereInstanceBuffer();
+	m_IsBoundingSphereInstanceBufferDirty = true;
 }
 
 void JWSystemRender::UpdateBoundingSphereInstance(uint32_t InstanceID, const XMMATRIX& WorldMatrix) noexcept
@@ -560,11 +544,14 @@ void JWSystemRender::UpdateBoundingSphereInstance(uint32_t InstanceID, const XMM
 	// Set the world matrix of the instance
 	instance->World = WorldMatrix;
 
-	UpdateBoundingSphereInstanceBuffer();
+	m_IsBoundingSphereInstanceBufferDirty = true;
 }
 
 PRIVATE inline void JWSystemRender::UpdateBoundingSphereInstanceBuffer() noexcept
 {
+	if (!m_IsBoundingSphereInstanceBufferDirty) { return; }
+	m_IsBoundingSphereInstanceBufferDirty = false;
+
 	m_pDX->UpdateDynamicResource(m_BoundingSphereModel.ModelVertexBuffer[KVBIDInstancing],
 		m_BoundingSphereModel.ModelData.VertexData.GetInstancePtrData(),
 		m_BoundingSphereModel.ModelData.VertexData.GetInstanceByteSize());
@@ -575,19 +562,30 @@ void JWSystemRender::Execute() noexcept
 	m_FrustumCulledEntityCount = 0;
 	m_FrustumCulledTerrainNodeCount = 0;
 
+	if (m_FlagSystemRenderOption & JWFlagSystemRenderOption_UseFrustumCulling)
+	{
+		CullBoundingSpheres();
+	}
+
+	// Poses of CPU-animated components are evaluated on the job system before any drawing.
+	EvaluateCPUAnimationPoses();
+
+	// Opaque items come first in the queue, then transparent items.
+	BuildRenderQueue();
+	size_t queue_index{};
+
 
 	// #0 Opaque drawing
 	// Set OM blend state
+	// Components sharing a model (and material) are drawn as one instanced batch.
 	m_pDX->SetBlendState(EBlendState::Opaque);
-	for (auto& iter : m_vComponents)
+	m_InstancedBatchCount = 0;
+	m_InstancedComponentCount = 0;
+	while (queue_index < m_vRenderQueue.size())
 	{
-		// Check transparency
-		if (iter.FlagComponentRenderOption & JWFlagComponentRenderOption_UseTransparency)
-		{
-			continue;
-		}
+		if ((m_vRenderQueue[queue_index].Key >> KRenderKeyPassShift) != KRenderPassOpaque) { break; }
 
-		ExecuteComponent(iter);
+		queue_index = ExecuteOpaqueRun(queue_index);
 	}
 	
 
@@ -602,19 +600,150 @@ void JWSystemRender::Execute() noexcept
 	// #2 Transparent drawing
 	// Set OM blend state
 	m_pDX->SetBlendState(EBlendState::Transprent);
-	for (auto& iter : m_vComponents)
+	for (; queue_index < m_vRenderQueue.size(); ++queue_index)
+	{
+		ExecuteComponent(m_Components[m_vRenderQueue[queue_index].ComponentIndex]);
+	}
+}
+
+// 1 + index of Ptr in vShared, 0 if it's not one of them
+template <typename T>
+static auto GetSharedIndexKey(const T* Ptr, const VECTOR<T>& vShared) noexcept->uint64_t
+{
+	if ((Ptr == nullptr) || (vShared.empty()) || (Ptr < vShared.data()) || (Ptr >= vShared.data() + vShared.size())) { return 0; }
+
+	return min(static_cast<uint64_t>(Ptr - vShared.data()) + 1, KRenderKeyModelIndexMask);
+}
+
+PRIVATE auto JWSystemRender::MakeRenderQueueKey(const SComponentRender& Component) noexcept->uint64_t
+{
+	uint64_t pass = (Component.FlagComponentRenderOption & JWFlagComponentRenderOption_UseTransparency) ?
+		KRenderPassTransparent : KRenderPassOpaque;
+
+	auto order = ERenderOrder::World;
+	if (Component.VertexShader == EVertexShader::VSSkyMap)
+	{
+		order = ERenderOrder::Background;
+	}
+	else if ((Component.RenderType == ERenderType::Image_2D) || (Component.RenderType == ERenderType::Model_Line2D))
+	{
+		order = ERenderOrder::ScreenSpace;
+	}
+
+	// Shared resources are identified by their dense indices, so equal resources always share a key.
+	uint64_t model{};
+	if (Component.PtrTerrain)
+	{
+		model = (3ull << 14) | GetSharedIndexKey(Component.PtrTerrain, m_vSharedTerrain);
+	}
+	else if (Component.PtrLine)
+	{
+		model = (2ull << 14) | GetSharedIndexKey(Component.PtrLine, m_vSharedLineModel);
+	}
+	else if (Component.PtrImage)
+	{
+		model = (1ull << 14) | GetSharedIndexKey(Component.PtrImage, m_vSharedImage2D);
+	}
+	else
+	{
+		model = GetSharedIndexKey(Component.PtrModel, m_vSharedModel);
+	}
+
+	uint64_t texture{};
+	if (Component.PtrTextureDiffuse)
+	{
+		auto found = m_umapSharedTextureIndices.find(Component.PtrTextureDiffuse);
+		if (found != m_umapSharedTextureIndices.end()) { texture = min(static_cast<uint64_t>(found->second) + 1, 0xFFFFull); }
+	}
+
+	uint64_t vs = static_cast<uint64_t>(Component.VertexShader) & 0xF;
+	uint64_t ps = static_cast<uint64_t>(Component.PixelShader) & 0xF;
+
+	// Distance to the camera, quantized to KRenderKeyDepthBitCount bits
+	uint64_t depth{};
+	auto current_camera = m_pECS->SystemCamera().GetCurrentCamera();
+	auto transform = m_pECS->SystemTransform().ComponentPool().GetByEntity(Component.EntityIndex);
+	if ((current_camera) && (transform) && (order == ERenderOrder::World))
+	{
+		// The interpolated position (what is drawn), not the one of the last physics step
+		auto position = XMVectorSetW(transform->GetRenderWorldMatrix().r[3], 0.0f);
+		auto distance = XMVectorGetX(XMVector3Length(position - m_pECS->SystemCamera().GetCurrentCameraPosition()));
+		auto normalized = max(min(distance / current_camera->ZFar, 1.0f), 0.0f);
+
+		depth = static_cast<uint64_t>(normalized * static_cast<float>((1 << KRenderKeyDepthBitCount) - 1));
+	}
+
+	uint64_t key = (pass << KRenderKeyPassShift) | (static_cast<uint64_t>(order) << KRenderKeyOrderShift);
+	if (pass == KRenderPassOpaque)
+	{
+		// State first, then front to back (early z)
+		key |= (vs << 56) | (ps << 52) | (texture << 36) | (model << 20) | depth;
+	}
+	else
+	{
+		// Back to front first (blending), then state
+		auto inverted_depth = ((1ull << KRenderKeyDepthBitCount) - 1) - depth;
+		key |= (inverted_depth << 40) | (vs << 36) | (ps << 32) | (texture << 16) | model;
+	}
+	return key;
+}
+
+PRIVATE void JWSystemRender::BuildRenderQueue() noexcept
+{
+	m_vRenderQueue.clear();
+	for (const auto& iter : m_Components)
+	{
+		m_vRenderQueue.emplace_back(SRenderQueueItem{ MakeRenderQueueKey(iter), iter.ComponentIndex });
+	}
+
+	SortRenderQueue();
+}
+
+PRIVATE void JWSystemRender::SortRenderQueue() noexcept
+{
+	auto start_time = STEADY_CLOCK::now();
+
+	// LSD radix sort, 8 bits per pass (stable, so equal keys keep component order)
+	static constexpr uint32_t KByteCount{ sizeof(uint64_t) };
+	uint32_t histogram[KByteCount][256]{};
+
+	auto item_count = m_vRenderQueue.size();
+	for (const auto& item : m_vRenderQueue)
 	{
-		// Check transparency
-		if (!(iter.FlagComponentRenderOption & JWFlagComponentRenderOption_UseTransparency))
+		for (uint32_t byte = 0; byte < KByteCount; ++byte)
+		{
+			++histogram[byte][(item.Key >> (byte * 8)) & 0xFF];
+		}
+	}
+
+	m_vRenderQueueSortBuffer.resize(item_count);
+	for (uint32_t byte = 0; byte < KByteCount; ++byte)
+	{
+		auto& counts = histogram[byte];
+
+		// Every key has the same value in this byte, so this pass wouldn't move anything.
+		if (counts[(m_vRenderQueue.empty()) ? 0 : (m_vRenderQueue[0].Key >> (byte * 8)) & 0xFF] == item_count) { continue; }
+
+		uint32_t offset{};
+		for (auto& count : counts)
+		{
+			auto current = count;
+			count = offset;
+			offset += current;
+		}
+
+		for (const auto& item : m_vRenderQueue)
 		{
-			continue;
+			m_vRenderQueueSortBuffer[counts[(item.Key >> (byte * 8)) & 0xFF]++] = item;
 		}
 
-		ExecuteComponent(iter);
+		m_vRenderQueue.swap(m_vRenderQueueSortBuffer);
 	}
+
+	m_LastRenderQueueSortTime = std::chrono::duration_cast<TIME_UNIT_mS>(STEADY_CLOCK::now() - start_time).count();
 }
 
-PRIVATE void JWSystemRender::ExecuteComponent(SComponentRender& Component) noexcept
+PRIVATE auto JWSystemRender::ShouldDrawComponent(const SComponentRender& Component) noexcept->bool
 {
 	// Get pointer to the entity.
 	auto ptr_entity = m_pECS->GetEntityByIndex(Component.EntityIndex);
@@ -624,7 +753,7 @@ PRIVATE void JWSystemRender::ExecuteComponent(SComponentRender& Component) noexc
 	{
 		if (ptr_entity->GetEntityType() == EEntityType::ViewFrustum)
 		{
-			return;
+			return false;
 		}
 	}
 
@@ -636,47 +765,168 @@ PRIVATE void JWSystemRender::ExecuteComponent(SComponentRender& Component) noexc
 
 		if (!(m_FlagSystemRenderOption & JWFlagSystemRenderOption_DrawCameras))
 		{
-			return;
+			return false;
 		}
 
 		if (camera->ComponentIndex == m_pECS->SystemCamera().GetCurrentCameraComponentID())
 		{
-			return;
+			return false;
 		}
 	}
 
 	// Check flag - Frustum culling
 	if (m_FlagSystemRenderOption & JWFlagSystemRenderOption_UseFrustumCulling)
 	{
-		auto physics = ptr_entity->GetComponentPhysics();
-		if (physics)
+		if (!m_FrustumCuller.IsVisible(m_vCullingSphereIDs[Component.ComponentIndex]))
 		{
-			auto world_center = physics->BoundingSphere.Center;
-			auto transform = ptr_entity->GetComponentTransform();
-			if (transform)
-			{
-				world_center += transform->Position;
-			}
-			if (IsSphereCulledByViewFrustum(physics->BoundingSphere.Radius, world_center))
-			{
-				// Entity is culled!
-				++m_FrustumCulledEntityCount;
+			// Entity is culled!
+			++m_FrustumCulledEntityCount;
 
-				return;
-			}
+			return false;
+		}
+	}
 
-			/*
-			if (IsUnitSphereCulledByViewFrustum(physics->BoundingEllipsoid.EllipsoidWorld))
-			{
-				// Entity is culled!
-				++m_FrustumCulledEntityCount;
+	return true;
+}
 
-				return;
-			}
-			*/
+PRIVATE auto JWSystemRender::CanBeInstanced(const SComponentRender& Component) const noexcept->bool
+{
+	// Normals (GSNormal) and sub-bounding spheres are drawn per component by ExecuteVisibleComponent().
+	if (m_FlagSystemRenderOption & JWFlagSystemRenderOption_DrawNormals) { return false; }
+	if (m_FlagSystemRenderOption & JWFlagSystemRenderOption_DrawSubBoundingSpheres) { return false; }
+
+	if ((Component.RenderType != ERenderType::Model_Static) && (Component.RenderType != ERenderType::Model_Dynamic)) { return false; }
+	if (Component.VertexShader != EVertexShader::VSBase) { return false; }
+
+	// Transparent components must keep their back-to-front order.
+	return !(Component.FlagComponentRenderOption & JWFlagComponentRenderOption_UseTransparency);
+}
+
+PRIVATE auto JWSystemRender::AreInstancesOfSameBatch(const SComponentRender& A, const SComponentRender& B) const noexcept->bool
+{
+	return (A.PtrModel == B.PtrModel) && (A.RenderType == B.RenderType) &&
+		(A.VertexShader == B.VertexShader) && (A.PixelShader == B.PixelShader) &&
+		(A.PtrTextureDiffuse == B.PtrTextureDiffuse) && (A.PtrTextureNormal == B.PtrTextureNormal) &&
+		(A.DepthStencilState == B.DepthStencilState) && (A.FlagComponentRenderOption == B.FlagComponentRenderOption);
+}
+
+PRIVATE auto JWSystemRender::ExecuteOpaqueRun(size_t QueueIndex) noexcept->size_t
+{
+	auto& first = m_Components[m_vRenderQueue[QueueIndex].ComponentIndex];
+	if (!CanBeInstanced(first))
+	{
+		ExecuteComponent(first);
+
+		return QueueIndex + 1;
+	}
+
+	// Gather the visible components of the batch (the queue is sorted by shader, texture and model, so they are adjacent).
+	m_vInstanceBatch.clear();
+	auto end_index = QueueIndex;
+	for (; end_index < m_vRenderQueue.size(); ++end_index)
+	{
+		const auto& item = m_vRenderQueue[end_index];
+		if ((item.Key >> KRenderKeyPassShift) != KRenderPassOpaque) { break; }
+
+		auto& component = m_Components[item.ComponentIndex];
+		if (!AreInstancesOfSameBatch(first, component)) { break; }
+
+		if (ShouldDrawComponent(component))
+		{
+			m_vInstanceBatch.emplace_back(item.ComponentIndex);
 		}
 	}
 
+	if (m_vInstanceBatch.size() >= KMinInstanceBatchSize)
+	{
+		DrawInstancedBatch();
+	}
+	else
+	{
+		for (auto component_index : m_vInstanceBatch)
+		{
+			ExecuteVisibleComponent(m_Components[component_index]);
+		}
+	}
+
+	return end_index;
+}
+
+PRIVATE void JWSystemRender::DrawInstancedBatch() noexcept
+{
+	auto& first = m_Components[m_vInstanceBatch[0]];
+	auto& transform_pool = m_pECS->SystemTransform().ComponentPool();
+	auto instance_count = static_cast<uint32_t>(m_vInstanceBatch.size());
+
+	// Fill instance data
+	m_vInstanceData.resize(instance_count);
+	for (uint32_t i = 0; i < instance_count; ++i)
+	{
+		auto transform = transform_pool.GetByEntity(m_Components[m_vInstanceBatch[i]].EntityIndex);
+
+		m_vInstanceData[i].World = (transform) ? transform->GetRenderWorldMatrix() : KMatrixIdentity;
+	}
+
+	// Grow the instance buffer if the batch doesn't fit.
+	if (instance_count > m_InstanceBufferCapacity)
+	{
+		JW_RELEASE(m_InstanceBuffer);
+
+		m_InstanceBufferCapacity = max(m_InstanceBufferCapacity * 2, instance_count);
+		m_vInstanceData.resize(m_InstanceBufferCapacity);
+
+		m_pDX->CreateDynamicVertexBuffer(static_cast<UINT>(m_InstanceBufferCapacity * sizeof(SModelInstanceData)),
+			&m_vInstanceData[0], &m_InstanceBuffer);
+	}
+	m_pDX->UpdateDynamicResource(m_InstanceBuffer, &m_vInstanceData[0], instance_count * sizeof(SModelInstanceData));
+
+	// Check flag - Rasterizer state
+	if (first.FlagComponentRenderOption & JWFlagComponentRenderOption_AlwaysSolidNoCull)
+	{
+		m_pDX->SetRasterizerState(ERasterizerState::SolidNoCull);
+	}
+	else
+	{
+		m_pDX->SetRasterizerState(m_UniversalRasterizerState);
+	}
+
+	// Set depth stencil state for the batch
+	m_pDX->SetDepthStencilState(first.DepthStencilState);
+
+	SetShaders(first, true);
+
+	// Set IA primitive topology
+	m_pDX->SetPrimitiveTopology(EPrimitiveTopology::TriangleList);
+
+	// Set IA vertex buffers (model data + instance data)
+	auto& model = first.PtrModel;
+	m_pDX->SetVertexBuffers(
+		0, 1, model->ModelVertexBuffer, model->ModelData.VertexData.GetPtrStrides(), model->ModelData.VertexData.GetPtrOffsets());
+	m_pDX->SetVertexBuffers(KVBIDInstancing, 1, &m_InstanceBuffer,
+		&model->ModelData.VertexData.GetPtrStrides()[KVBIDInstancing], &model->ModelData.VertexData.GetPtrOffsets()[KVBIDInstancing]);
+
+	// Set IA index buffer
+	m_pDX->SetIndexBuffer(model->ModelIndexBuffer);
+
+	// Draw indexed instanced
+	m_pDX->DrawIndexedInstanced(model->ModelData.IndexData.GetCount(), instance_count);
+
+	++m_InstancedBatchCount;
+	m_InstancedComponentCount += instance_count;
+}
+
+PRIVATE void JWSystemRender::ExecuteComponent(SComponentRender& Component) noexcept
+{
+	if (!ShouldDrawComponent(Component)) { return; }
+
+	ExecuteVisibleComponent(Component);
+}
+
+PRIVATE void JWSystemRender::ExecuteVisibleComponent(SComponentRender& Component) noexcept
+{
+	// Get pointer to the entity.
+	auto ptr_entity = m_pECS->GetEntityByIndex(Component.EntityIndex);
+
 	// Check flag - Rasterizer state
 	if (Component.FlagComponentRenderOption & JWFlagComponentRenderOption_AlwaysSolidNoCull)
 	{
@@ -806,43 +1056,37 @@ PRIVATE auto JWSystemRender::IsUnitSphereCulledByViewFrustum(const XMMATRIX& Ell
 }
 */
 
-PRIVATE auto JWSystemRender::IsSphereCulledByViewFrustum(float Radius, const XMVECTOR& Center) const noexcept->bool
+PRIVATE void JWSystemRender::CullBoundingSpheres() noexcept
 {
-	// Get view frustum
-	m_pECS->SystemCamera().CaptureViewFrustum();
-	auto frustum = m_pECS->SystemCamera().GetCapturedViewFrustum();
+	m_FrustumCuller.SetPlanes(m_pECS->SystemCamera().GetCurrentViewFrustumPlanes());
+	m_FrustumCuller.ClearSpheres();
 
-	// Left plane
-	auto lp_v0 = XMVector3Normalize(frustum.FLU - frustum.NLU);
-	auto lp_v1 = XMVector3Normalize(frustum.FLD - frustum.NLU);
-	auto lp_vn = XMVector3Normalize(XMVector3Cross(lp_v1, lp_v0)); // @important (points to left-side)
+	auto& transform_pool = m_pECS->SystemTransform().ComponentPool();
+	auto& physics_pool = m_pECS->SystemPhysics().ComponentPool();
 
-	auto cmp_pos = Center + (-lp_vn) * Radius;
-	auto cmp_vec = XMVector3Normalize(cmp_pos - frustum.NLU);
-	auto distance = XMVector3Dot(cmp_vec, lp_vn);
-
-	if (XMVector3Greater(distance, XMVectorZero()))
+	// Components without physics have no bounding sphere, so they are never culled.
+	m_vCullingSphereIDs.assign(m_Components.GetCount(), KInvalidCullingSphereID);
+	for (const auto& iter : m_Components)
 	{
-		// Bounding sphere is out of the view frustum.
-		return true;
-	}
+		auto physics = physics_pool.GetByEntity(iter.EntityIndex);
+		if (physics == nullptr) { continue; }
 
-	// Right plane
-	auto rp_v0 = XMVector3Normalize(frustum.FRU - frustum.NRU);
-	auto rp_v1 = XMVector3Normalize(frustum.FRD - frustum.NRU);
-	auto rp_vn = XMVector3Normalize(XMVector3Cross(rp_v0, rp_v1)); // @important (points to right-side)
+		auto transform = transform_pool.GetByEntity(iter.EntityIndex);
+		// Spheres follow the interpolated world matrix, so that what is culled is what is drawn.
+		auto position = (transform) ? XMVectorSetW(transform->GetRenderWorldMatrix().r[3], 0.0f) : KVectorZero;
 
-	cmp_pos = Center + (-rp_vn) * Radius;
-	cmp_vec = XMVector3Normalize(cmp_pos - frustum.NRU);
-	distance = XMVector3Dot(cmp_vec, rp_vn);
+		m_vCullingSphereIDs[iter.ComponentIndex] = m_FrustumCuller.AddSphere(physics->BoundingSphere.Center + position, physics->BoundingSphere.Radius);
 
-	if (XMVector3Greater(distance, XMVectorZero()))
-	{
-		// Bounding sphere is out of the view frustum.
-		return true;
+		if (iter.RenderType == ERenderType::Terrain)
+		{
+			for (const auto& sub_bounding_sphere : physics->SubBoundingSpheres)
+			{
+				m_FrustumCuller.AddSphere(sub_bounding_sphere.Center + position, sub_bounding_sphere.Radius);
+			}
+		}
 	}
 
-	return false;
+	m_FrustumCuller.Cull();
 }
 
 void JWSystemRender::DrawInstancedBoundingSpheres() noexcept
@@ -860,6 +1104,10 @@ void JWSystemRender::DrawInstancedBoundingSpheres() noexcept
 		}
 	}
 
+	// @important
+	// Physics only writes instance data (it may run on worker threads), the upload happens here.
+	UpdateBoundingSphereInstanceBuffer();
+
 	// Set RS State
 	m_pDX->SetRasterizerState(ERasterizerState::WireFrame);
 
@@ -885,15 +1133,15 @@ void JWSystemRender::DrawInstancedBoundingSpheres() noexcept
 	m_pDX->SetPrimitiveTopology(EPrimitiveTopology::TriangleList);
 
 	// Set IA vertex buffer
-	m_pDX->GetDeviceContext()->IASetVertexBuffers(0, 3, m_BoundingSphereModel.ModelVertexBuffer,
+	m_pDX->SetVertexBuffers(0, 3, m_BoundingSphereModel.ModelVertexBuffer,
 		m_BoundingSphereModel.ModelData.VertexData.GetPtrStrides(), m_BoundingSphereModel.ModelData.VertexData.GetPtrOffsets());
 
 	// Set IA index buffer
-	m_pDX->GetDeviceContext()->IASetIndexBuffer(m_BoundingSphereModel.ModelIndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+	m_pDX->SetIndexBuffer(m_BoundingSphereModel.ModelIndexBuffer);
 
 	// Draw indexed instanced
-	m_pDX->GetDeviceContext()->DrawIndexedInstanced(
-		m_BoundingSphereModel.ModelData.IndexData.GetCount(), m_BoundingSphereModel.ModelData.VertexData.GetInstanceCount(), 0, 0, 0);
+	m_pDX->DrawIndexedInstanced(
+		m_BoundingSphereModel.ModelData.IndexData.GetCount(), m_BoundingSphereModel.ModelData.VertexData.GetInstanceCount());
 }
 
 void JWSystemRender::DrawNonInstancedBoundingSpheres(float Radius, const XMVECTOR& Center) noexcept
@@ -918,14 +1166,14 @@ void JWSystemRender::DrawNonInstancedBoundingSpheres(float Radius, const XMVECTO
 	m_pDX->SetPrimitiveTopology(EPrimitiveTopology::TriangleList);
 
 	// Set IA vertex buffer
-	m_pDX->GetDeviceContext()->IASetVertexBuffers(0, 1, m_BoundingSphereModel.ModelVertexBuffer,
+	m_pDX->SetVertexBuffers(0, 1, m_BoundingSphereModel.ModelVertexBuffer,
 		m_BoundingSphereModel.ModelData.VertexData.GetPtrStrides(), m_BoundingSphereModel.ModelData.VertexData.GetPtrOffsets());
 
 	// Set IA index buffer
-	m_pDX->GetDeviceContext()->IASetIndexBuffer(m_BoundingSphereModel.ModelIndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+	m_pDX->SetIndexBuffer(m_BoundingSphereModel.ModelIndexBuffer);
 
 	// Draw
-	m_pDX->GetDeviceContext()->DrawIndexed(m_BoundingSphereModel.ModelData.IndexData.GetCount(), 0, 0);
+	m_pDX->DrawIndexed(m_BoundingSphereModel.ModelData.IndexData.GetCount());
 }
 
 /*
@@ -969,15 +1217,15 @@ void JWSystemRender::DrawInstancedBoundingEllipsoids() noexcept
 	m_pDX->SetPrimitiveTopology(EPrimitiveTopology::TriangleList);
 
 	// Set IA vertex buffer
-	m_pDX->GetDeviceContext()->IASetVertexBuffers(0, 3, m_BoundingEllipsoid.ModelVertexBuffer,
+	m_pDX->SetVertexBuffers(0, 3, m_BoundingEllipsoid.ModelVertexBuffer,
 		m_BoundingEllipsoid.ModelData.VertexData.GetPtrStrides(), m_BoundingEllipsoid.ModelData.VertexData.GetPtrOffsets());
 
 	// Set IA index buffer
-	m_pDX->GetDeviceContext()->IASetIndexBuffer(m_BoundingEllipsoid.ModelIndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+	m_pDX->SetIndexBuffer(m_BoundingEllipsoid.ModelIndexBuffer);
 
 	// Draw indexed instanced
-	m_pDX->GetDeviceContext()->DrawIndexedInstanced(
-		m_BoundingEllipsoid.ModelData.IndexData.GetCount(), m_BoundingEllipsoid.ModelData.VertexData.GetInstanceCount(), 0, 0, 0);
+	m_pDX->DrawIndexedInstanced(
+		m_BoundingEllipsoid.ModelData.IndexData.GetCount(), m_BoundingEllipsoid.ModelData.VertexData.GetInstanceCount());
 }
 
 void JWSystemRender::DrawNonInstancedBoundingEllipsoids(const XMMATRIX& EllipsoidWorld) noexcept
@@ -1000,14 +1248,14 @@ void JWSystemRender::DrawNonInstancedBoundingEllipsoids(const XMMATRIX& Ellipsoi
 	m_pDX->SetPrimitiveTopology(EPrimitiveTopology::TriangleList);
 
 	// Set IA vertex buffer
-	m_pDX->GetDeviceContext()->IASetVertexBuffers(0, 1, m_BoundingEllipsoid.ModelVertexBuffer,
+	m_pDX->SetVertexBuffers(0, 1, m_BoundingEllipsoid.ModelVertexBuffer,
 		m_BoundingEllipsoid.ModelData.VertexData.GetPtrStrides(), m_BoundingEllipsoid.ModelData.VertexData.GetPtrOffsets());
 
 	// Set IA index buffer
-	m_pDX->GetDeviceContext()->IASetIndexBuffer(m_BoundingEllipsoid.ModelIndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+	m_pDX->SetIndexBuffer(m_BoundingEllipsoid.ModelIndexBuffer);
 
 	// Draw
-	m_pDX->GetDeviceContext()->DrawIndexed(m_BoundingEllipsoid.ModelData.IndexData.GetCount(), 0, 0);
+	m_pDX->DrawIndexed(m_BoundingEllipsoid.ModelData.IndexData.GetCount());
 }
 */
 
@@ -1020,7 +1268,7 @@ void JWSystemRender::AnimateOnGPU(SComponentRender& Component) noexcept
 	auto& model = Component.PtrModel;
 
 	// Set VS texture
-	m_pDX->GetDeviceContext()->VSSetShaderResources(0, 1, &Component.PtrAnimationTexture->TextureSRV);
+	m_pDX->SetVSShaderResource(0, Component.PtrAnimationTexture->TextureSRV);
 
 	if (anim_state.CurrAnimationID > 0)
 	{
@@ -1078,9 +1326,103 @@ void JWSystemRender::AnimateOnCPU(SComponentRender& Component) noexcept
 {
 	auto type = Component.RenderType;
 	if (type != ERenderType::Model_Rigged) { return; }
-	
+
+	// The pose was already evaluated in EvaluateCPUAnimationPoses().
+	if (Component.PoseBufferSlot == KInvalidPoseBufferSlot)
+	{
+		EvaluatePose(Component);
+	}
+
+	// Update bones' final transformations for shader's constant buffer
+	const auto palette = GetPoseBufferPalette(Component.PoseBufferSlot);
+	auto bone_count = min(Component.PtrModel->ModelData.BoneTree.vBones.size(), (size_t)KMaxBoneCount);
+	for (size_t iterator_bone_mat{}; iterator_bone_mat < bone_count; ++iterator_bone_mat)
+	{
+		m_VSCBCPUAnimation.TransformedBoneMatrices[iterator_bone_mat] = XMMatrixTranspose(palette[iterator_bone_mat]);
+	}
+}
+
+PRIVATE void JWSystemRender::EvaluateCPUAnimationPoses() noexcept
+{
+	// @important
+	// Slots are acquired serially first, because acquiring may reallocate m_vPoseBuffer.
+	for (auto& iter : m_Components)
+	{
+		if ((iter.RenderType == ERenderType::Model_Rigged) &&
+			!(iter.FlagComponentRenderOption & JWFlagComponentRenderOption_UseGPUAnimation) &&
+			(iter.PoseBufferSlot == KInvalidPoseBufferSlot))
+		{
+			iter.PoseBufferSlot = AcquirePoseBufferSlot();
+		}
+	}
+
+	// Every component writes only its own animation state, key cursors and palette.
+	m_pECS->JobSystem().ParallelFor(m_Components.GetCount(), KPoseEvaluationMinChunkSize,
+		[this](uint32_t Begin, uint32_t End)
+		{
+			for (uint32_t i = Begin; i < End; ++i)
+			{
+				auto& iter = m_Components[i];
+
+				if ((iter.RenderType == ERenderType::Model_Rigged) &&
+					!(iter.FlagComponentRenderOption & JWFlagComponentRenderOption_UseGPUAnimation))
+				{
+					EvaluatePose(iter);
+				}
+			}
+		});
+}
+
+PRIVATE auto JWSystemRender::AcquirePoseBufferSlot() noexcept->uint32_t
+{
+	if (m_vFreePoseBufferSlots.size())
+	{
+		auto slot = m_vFreePoseBufferSlots.back();
+		m_vFreePoseBufferSlots.pop_back();
+		return slot;
+	}
+
+	auto slot = static_cast<uint32_t>(m_vPoseBuffer.size() / KMaxBoneCount);
+	m_vPoseBuffer.resize(m_vPoseBuffer.size() + KMaxBoneCount, KMatrixIdentity);
+	return slot;
+}
+
+PRIVATE void JWSystemRender::ReleasePoseBufferSlot(uint32_t Slot) noexcept
+{
+	if (Slot == KInvalidPoseBufferSlot) { return; }
+
+	m_vFreePoseBufferSlots.emplace_back(Slot);
+}
+
+PRIVATE auto JWSystemRender::GetPoseBufferPalette(uint32_t Slot) noexcept->XMMATRIX*
+{
+	assert(Slot != KInvalidPoseBufferSlot);
+
+	return &m_vPoseBuffer[static_cast<size_t>(Slot) * KMaxBoneCount];
+}
+
+auto JWSystemRender::GetComponentBonePalette(ComponentIndexType ComponentIndex) const noexcept->const XMMATRIX*
+{
+	if (ComponentIndex >= m_Components.GetCount()) { return nullptr; }
+
+	auto slot = m_Components[ComponentIndex].PoseBufferSlot;
+	if (slot == KInvalidPoseBufferSlot) { return nullptr; }
+
+	return &m_vPoseBuffer[static_cast<size_t>(slot) * KMaxBoneCount];
+}
+
+PRIVATE void JWSystemRender::EvaluatePose(SComponentRender& Component) noexcept
+{
 	auto& anim_state = Component.AnimationState;
-	auto& model = Component.PtrModel;
+	// The shared model is read-only here.
+	const JWModel* model{ Component.PtrModel };
+
+	// Slots are handed out on first use, so non-animated components don't pay for a palette.
+	if (Component.PoseBufferSlot == KInvalidPoseBufferSlot)
+	{
+		Component.PoseBufferSlot = AcquirePoseBufferSlot();
+	}
+	auto palette = GetPoseBufferPalette(Component.PoseBufferSlot);
 
 	if ((Component.FlagComponentRenderOption & JWFlagComponentRenderOption_DrawTPose) || (anim_state.CurrAnimationID == 0))
 	{
@@ -1091,14 +1433,7 @@ void JWSystemRender::AnimateOnCPU(SComponentRender& Component) noexcept
 		anim_state.TweeningTime = 0.0f;
 
 		UpdateNodeTPoseIntoBones(anim_state.CurrAnimationTick, model->ModelData, model->ModelData.NodeTree.vNodes[0],
-			XMMatrixIdentity());
-
-		// Update bone's T-Pose transformation for shader's constant buffer
-		for (size_t iterator_bone_mat{}; iterator_bone_mat < model->ModelData.BoneTree.vBones.size(); ++iterator_bone_mat)
-		{
-			m_VSCBCPUAnimation.TransformedBoneMatrices[iterator_bone_mat] =
-				XMMatrixTranspose(model->ModelData.BoneTree.vBones[iterator_bone_mat].FinalTransformation);
-		}
+			XMMatrixIdentity(), palette);
 	}
 	else
 	{
@@ -1118,26 +1453,28 @@ void JWSystemRender::AnimateOnCPU(SComponentRender& Component) noexcept
 			Component.SetAnimation(anim_state.NextAnimationID);
 		}
 
-		// Update bones' transformations for the animation.
-		UpdateNodeAnimationIntoBones((Component.FlagComponentRenderOption & JWFlagComponentRenderOption_UseAnimationInterpolation),
-			anim_state, model->ModelData, model->ModelData.NodeTree.vNodes[0], XMMatrixIdentity());
-
-		// Update bone's final transformation for shader's constant buffer
-		for (size_t iterator_bone_mat{}; iterator_bone_mat < model->ModelData.BoneTree.vBones.size(); ++iterator_bone_mat)
+		// Key cursors are indexed by node ID.
+		auto& key_cursors = Component.vAnimationKeyCursors;
+		if (key_cursors.size() != model->ModelData.NodeTree.vNodes.size())
 		{
-			m_VSCBCPUAnimation.TransformedBoneMatrices[iterator_bone_mat] =
-				XMMatrixTranspose(model->ModelData.BoneTree.vBones[iterator_bone_mat].FinalTransformation);
+			key_cursors.resize(model->ModelData.NodeTree.vNodes.size());
 		}
+
+		// Update bones' transformations for the animation.
+		UpdateNodeAnimationIntoBones((Component.FlagComponentRenderOption & JWFlagComponentRenderOption_UseAnimationInterpolation),
+			anim_state, model->ModelData, model->ModelData.NodeTree.vNodes[0], XMMatrixIdentity(), key_cursors.data(), palette);
 	}
 }
 
-PRIVATE void JWSystemRender::UpdateNodeAnimationIntoBones(bool UseInterpolation, SAnimationState& AnimationState, SModelData& ModelData,
-	const SModelNode& CurrentNode, const XMMATRIX Accumulated) noexcept
+PRIVATE void JWSystemRender::UpdateNodeAnimationIntoBones(bool UseInterpolation, SAnimationState& AnimationState, const SModelData& ModelData,
+	const SModelNode& CurrentNode, const XMMATRIX Accumulated, SAnimationKeyCursor* KeyCursors, XMMATRIX* OutBonePalette) noexcept
 {
 	XMMATRIX global_transformation = CurrentNode.Transformation * Accumulated;
 
 	if (CurrentNode.BoneID >= 0)
 	{
+		assert(CurrentNode.BoneID < KMaxBoneCount);
+
 		auto& bone = ModelData.BoneTree.vBones[CurrentNode.BoneID];
 		auto& current_animation = ModelData.AnimationSet.vAnimations[AnimationState.CurrAnimationID - 1];
 
@@ -1157,88 +1494,76 @@ PRIVATE void JWSystemRender::UpdateNodeAnimationIntoBones(bool UseInterpolation,
 			AnimationState.NextFrameTime = 0;
 		}
 
-		for (const auto& CurrentNode_animation : current_animation.vNodeAnimation)
+		auto node_animation = current_animation.GetNodeAnimation(CurrentNode.ID);
+		if (node_animation)
 		{
-			if (CurrentNode_animation.NodeID == CurrentNode.ID)
+			auto& cursor = KeyCursors[CurrentNode.ID];
+
+			XMMATRIX matrix_scaling{};
+			XMVECTOR scaling_key_a{};
+			XMVECTOR scaling_key_b{};
+			XMVECTOR scaling_interpolated{};
+
+			XMMATRIX matrix_rotation{};
+			XMVECTOR rotation_key_a{};
+			XMVECTOR rotation_key_b{};
+			XMVECTOR rotation_interpolated{};
+
+			XMMATRIX matrix_translation{};
+			XMVECTOR translation_key_a{};
+			XMVECTOR translation_key_b{};
+			XMVECTOR translation_interpolated{};
+
+			// @important
+			// Key a is found from the cached cursor, key b from key a.
+			// #1. Find scaling keys
+			const auto& v_key_scaling = node_animation->vKeyScaling;
+			if (v_key_scaling.size())
 			{
-				XMMATRIX matrix_scaling{};
-				XMVECTOR scaling_key_a{};
-				XMVECTOR scaling_key_b{};
-				XMVECTOR scaling_interpolated{};
-
-				XMMATRIX matrix_rotation{};
-				XMVECTOR rotation_key_a{};
-				XMVECTOR rotation_key_b{};
-				XMVECTOR rotation_interpolated{};
-
-				XMMATRIX matrix_translation{};
-				XMVECTOR translation_key_a{};
-				XMVECTOR translation_key_b{};
-				XMVECTOR translation_interpolated{};
-
-				// #1. Find scaling keys
-				for (const auto& key : CurrentNode_animation.vKeyScaling)
-				{
-					if (key.TimeInTicks <= AnimationState.CurrFrameTime)
-					{
-						scaling_key_a = XMLoadFloat3(&key.Key);
-					}
-					if (key.TimeInTicks <= AnimationState.NextFrameTime)
-					{
-						scaling_key_b = XMLoadFloat3(&key.Key);
-					}
-				}
-				// Linear interpolation
-				scaling_interpolated = scaling_key_a + (AnimationState.TweeningTime * (scaling_key_b - scaling_key_a));
-
-				// #2. Find rotation keys
-				for (const auto& key : CurrentNode_animation.vKeyRotation)
-				{
-					if (key.TimeInTicks <= AnimationState.CurrFrameTime)
-					{
-						rotation_key_a = key.Key;
-					}
-					if (key.TimeInTicks <= AnimationState.NextFrameTime)
-					{
-						rotation_key_b = key.Key;
-					}
-				}
-				// Spherical linear interpolation!
-				rotation_interpolated = XMQuaternionSlerp(rotation_key_a, rotation_key_b, AnimationState.TweeningTime);
+				cursor.Scaling = FindAnimationKeyIndex(v_key_scaling, AnimationState.CurrFrameTime, cursor.Scaling);
+				scaling_key_a = XMLoadFloat3(&v_key_scaling[cursor.Scaling].Key);
+				scaling_key_b = XMLoadFloat3(&v_key_scaling[FindAnimationKeyIndex(v_key_scaling, AnimationState.NextFrameTime, cursor.Scaling)].Key);
+			}
+			// Linear interpolation
+			scaling_interpolated = scaling_key_a + (AnimationState.TweeningTime * (scaling_key_b - scaling_key_a));
 
-				// #3. Find translation keys
-				for (const auto& key : CurrentNode_animation.vKeyPosition)
-				{
-					if (key.TimeInTicks <= AnimationState.CurrFrameTime)
-					{
-						translation_key_a = XMLoadFloat3(&key.Key);
-					}
-					if (key.TimeInTicks <= AnimationState.NextFrameTime)
-					{
-						translation_key_b = XMLoadFloat3(&key.Key);
-					}
-				}
-				// Linear interpolation
-				translation_interpolated = translation_key_a + (AnimationState.TweeningTime * (translation_key_b - translation_key_a));
+			// #2. Find rotation keys
+			const auto& v_key_rotation = node_animation->vKeyRotation;
+			if (v_key_rotation.size())
+			{
+				cursor.Rotation = FindAnimationKeyIndex(v_key_rotation, AnimationState.CurrFrameTime, cursor.Rotation);
+				rotation_key_a = v_key_rotation[cursor.Rotation].Key;
+				rotation_key_b = v_key_rotation[FindAnimationKeyIndex(v_key_rotation, AnimationState.NextFrameTime, cursor.Rotation)].Key;
+			}
+			// Spherical linear interpolation!
+			rotation_interpolated = XMQuaternionSlerp(rotation_key_a, rotation_key_b, AnimationState.TweeningTime);
 
-				if (!UseInterpolation)
-				{
-					scaling_interpolated = scaling_key_a;
-					rotation_interpolated = rotation_key_a;
-					translation_interpolated = translation_key_a;
-				}
+			// #3. Find translation keys
+			const auto& v_key_position = node_animation->vKeyPosition;
+			if (v_key_position.size())
+			{
+				cursor.Position = FindAnimationKeyIndex(v_key_position, AnimationState.CurrFrameTime, cursor.Position);
+				translation_key_a = XMLoadFloat3(&v_key_position[cursor.Position].Key);
+				translation_key_b = XMLoadFloat3(&v_key_position[FindAnimationKeyIndex(v_key_position, AnimationState.NextFrameTime, cursor.Position)].Key);
+			}
+			// Linear interpolation
+			translation_interpolated = translation_key_a + (AnimationState.TweeningTime * (translation_key_b - translation_key_a));
 
-				matrix_scaling = XMMatrixScalingFromVector(scaling_interpolated);
-				matrix_rotation = XMMatrixRotationQuaternion(rotation_interpolated);
-				matrix_translation = XMMatrixTranslationFromVector(translation_interpolated);
+			if (!UseInterpolation)
+			{
+				scaling_interpolated = scaling_key_a;
+				rotation_interpolated = rotation_key_a;
+				translation_interpolated = translation_key_a;
+			}
 
-				global_transformation = matrix_scaling * matrix_rotation * matrix_translation * Accumulated;
+			matrix_scaling = XMMatrixScalingFromVector(scaling_interpolated);
+			matrix_rotation = XMMatrixRotationQuaternion(rotation_interpolated);
+			matrix_translation = XMMatrixTranslationFromVector(translation_interpolated);
 
-				break;
-			}
+			global_transformation = matrix_scaling * matrix_rotation * matrix_translation * Accumulated;
 		}
 
-		bone.FinalTransformation = bone.Offset * global_transformation;
+		OutBonePalette[CurrentNode.BoneID] = bone.Offset * global_transformation;
 	}
 
 	if (CurrentNode.vChildrenID.size())
@@ -1246,33 +1571,35 @@ PRIVATE void JWSystemRender::UpdateNodeAnimationIntoBones(bool UseInterpolation,
 		for (auto child_id : CurrentNode.vChildrenID)
 		{
 			UpdateNodeAnimationIntoBones(UseInterpolation, AnimationState, ModelData,
-				ModelData.NodeTree.vNodes[child_id], global_transformation);
+				ModelData.NodeTree.vNodes[child_id], global_transformation, KeyCursors, OutBonePalette);
 		}
 	}
 }
 
-PRIVATE void JWSystemRender::UpdateNodeTPoseIntoBones(float AnimationTime, SModelData& ModelData, const SModelNode& CurrentNode,
-	const XMMATRIX Accumulated) noexcept
+PRIVATE void JWSystemRender::UpdateNodeTPoseIntoBones(float AnimationTime, const SModelData& ModelData, const SModelNode& CurrentNode,
+	const XMMATRIX Accumulated, XMMATRIX* OutBonePalette) noexcept
 {
 	XMMATRIX accumulation = CurrentNode.Transformation * Accumulated;
 
 	if (CurrentNode.BoneID >= 0)
 	{
+		assert(CurrentNode.BoneID < KMaxBoneCount);
+
 		auto& bone = ModelData.BoneTree.vBones[CurrentNode.BoneID];
 
-		bone.FinalTransformation = bone.Offset * accumulation;
+		OutBonePalette[CurrentNode.BoneID] = bone.Offset * accumulation;
 	}
 
 	if (CurrentNode.vChildrenID.size())
 	{
 		for (auto child_id : CurrentNode.vChildrenID)
 		{
-			UpdateNodeTPoseIntoBones(AnimationTime, ModelData, ModelData.NodeTree.vNodes[child_id], accumulation);
+			UpdateNodeTPoseIntoBones(AnimationTime, ModelData, ModelData.NodeTree.vNodes[child_id], accumulation, OutBonePalette);
 		}
 	}
 }
 
-void JWSystemRender::SetShaders(SComponentRender& Component) noexcept
+void JWSystemRender::SetShaders(SComponentRender& Component, bool IsInstanced) noexcept
 {
 	// Get pointer to the entity.
 	auto ptr_entity = m_pECS->GetEntityByIndex(Component.EntityIndex);
@@ -1314,13 +1641,13 @@ void JWSystemRender::SetShaders(SComponentRender& Component) noexcept
 	if (Component.FlagComponentRenderOption & JWFlagComponentRenderOption_UseDiffuseTexture)
 	{
 		// Set PS texture (diffuse)
-		m_pDX->GetDeviceContext()->PSSetShaderResources(0, 1, &Component.PtrTextureDiffuse);
+		m_pDX->SetPSShaderResource(0, Component.PtrTextureDiffuse);
 	}
 
 	if (Component.FlagComponentRenderOption & JWFlagComponentRenderOption_UseNormalTexture)
 	{
 		// Set PS texture (normal)
-		m_pDX->GetDeviceContext()->PSSetShaderResources(1, 1, &Component.PtrTextureNormal);
+		m_pDX->SetPSShaderResource(1, Component.PtrTextureNormal);
 	}
 
 	// Set PS texture sampler
@@ -1340,9 +1667,9 @@ void JWSystemRender::SetShaders(SComponentRender& Component) noexcept
 	// Get transform component, if there is.
 	const auto& component_transform = ptr_entity->GetComponentTransform();
 	XMMATRIX component_world_matrix{ XMMatrixIdentity() };
-	if (component_transform)
+	if ((component_transform) && (!IsInstanced))
 	{
-		component_world_matrix = component_transform->WorldMatrix;
+		component_world_matrix = component_transform->GetRenderWorldMatrix();
 	}
 
 	// Update VS constant buffer
@@ -1353,10 +1680,10 @@ void JWSystemRender::SetShaders(SComponentRender& Component) noexcept
 	switch (Component.RenderType)
 	{
 	case ERenderType::Model_Static:
-		m_VSCBFlags.FlagVS = 0;
+		m_VSCBFlags.FlagVS = (IsInstanced) ? JWFlagVS_Instanced : 0;
 		break;
 	case ERenderType::Model_Dynamic:
-		m_VSCBFlags.FlagVS = 0;
+		m_VSCBFlags.FlagVS = (IsInstanced) ? JWFlagVS_Instanced : 0;
 		break;
 	case ERenderType::Model_Rigged:
 		if (Component.FlagComponentRenderOption & JWFlagComponentRenderOption_UseGPUAnimation)
@@ -1403,7 +1730,6 @@ PRIVATE void JWSystemRender::Draw(SComponentRender& Component) noexcept
 {
 	// Get pointer to the entity.
 	auto ptr_entity = m_pECS->GetEntityByIndex(Component.EntityIndex);
-	auto ptr_device_context = m_pDX->GetDeviceContext();
 
 	auto type = Component.RenderType;
 	auto& model = Component.PtrModel;
@@ -1429,72 +1755,72 @@ PRIVATE void JWSystemRender::Draw(SComponentRender& Component) noexcept
 	{
 	case ERenderType::Model_Static:
 		// Set IA vertex buffer
-		ptr_device_context->IASetVertexBuffers(
+		m_pDX->SetVertexBuffers(
 			0, 1, model->ModelVertexBuffer, model->ModelData.VertexData.GetPtrStrides(), model->ModelData.VertexData.GetPtrOffsets());
 
 		// Set IA index buffer
-		ptr_device_context->IASetIndexBuffer(model->ModelIndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+		m_pDX->SetIndexBuffer(model->ModelIndexBuffer);
 
 		// Draw indexed
-		ptr_device_context->DrawIndexed(model->ModelData.IndexData.GetCount(), 0, 0);
+		m_pDX->DrawIndexed(model->ModelData.IndexData.GetCount());
 		break;
 	case ERenderType::Model_Dynamic:
 		// Set IA vertex buffer
-		ptr_device_context->IASetVertexBuffers(
+		m_pDX->SetVertexBuffers(
 			0, 1, model->ModelVertexBuffer, model->ModelData.VertexData.GetPtrStrides(), model->ModelData.VertexData.GetPtrOffsets());
 
 		// Set IA index buffer
-		ptr_device_context->IASetIndexBuffer(model->ModelIndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+		m_pDX->SetIndexBuffer(model->ModelIndexBuffer);
 
 		// Draw indexed
-		ptr_device_context->DrawIndexed(model->ModelData.IndexData.GetCount(), 0, 0);
+		m_pDX->DrawIndexed(model->ModelData.IndexData.GetCount());
 		break;
 	case ERenderType::Model_Rigged:
 		//
 		// @important!! (Buffer count = 2)
 		// Set IA vertex buffer
-		ptr_device_context->IASetVertexBuffers(
+		m_pDX->SetVertexBuffers(
 			0, 2, model->ModelVertexBuffer, model->ModelData.VertexData.GetPtrStrides(), model->ModelData.VertexData.GetPtrOffsets());
 
 		// Set IA index buffer
-		ptr_device_context->IASetIndexBuffer(model->ModelIndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+		m_pDX->SetIndexBuffer(model->ModelIndexBuffer);
 
 		// Draw indexed
-		ptr_device_context->DrawIndexed(model->ModelData.IndexData.GetCount(), 0, 0);
+		m_pDX->DrawIndexed(model->ModelData.IndexData.GetCount());
 
 		break;
 	case ERenderType::Image_2D:
 		// Set IA vertex buffer
-		ptr_device_context->IASetVertexBuffers(
+		m_pDX->SetVertexBuffers(
 			0, 1, &image->m_VertexBuffer, image->m_VertexData.GetPtrStrides(), image->m_VertexData.GetPtrOffsets());
 
 		// Set IA index buffer
-		ptr_device_context->IASetIndexBuffer(image->m_IndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+		m_pDX->SetIndexBuffer(image->m_IndexBuffer);
 
 		// Draw indexed
-		ptr_device_context->DrawIndexed(image->m_IndexData.GetCount(), 0, 0);
+		m_pDX->DrawIndexed(image->m_IndexData.GetCount());
 		break;
 	case ERenderType::Model_Line3D:
 		// Set IA vertex buffer
-		ptr_device_context->IASetVertexBuffers(
+		m_pDX->SetVertexBuffers(
 			0, 1, &line->m_VertexBuffer, line->m_VertexData.GetPtrStrides(), line->m_VertexData.GetPtrOffsets());
 
 		// Set IA index buffer
-		ptr_device_context->IASetIndexBuffer(line->m_IndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+		m_pDX->SetIndexBuffer(line->m_IndexBuffer);
 
 		// Draw indexed
-		ptr_device_context->DrawIndexed(line->m_IndexData.GetCount(), 0, 0);
+		m_pDX->DrawIndexed(line->m_IndexData.GetCount());
 		break;
 	case ERenderType::Model_Line2D:
 		// Set IA vertex buffer
-		ptr_device_context->IASetVertexBuffers(
+		m_pDX->SetVertexBuffers(
 			0, 1, &line->m_VertexBuffer, line->m_VertexData.GetPtrStrides(), line->m_VertexData.GetPtrOffsets());
 
 		// Set IA index buffer
-		ptr_device_context->IASetIndexBuffer(line->m_IndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+		m_pDX->SetIndexBuffer(line->m_IndexBuffer);
 
 		// Draw indexed
-		ptr_device_context->DrawIndexed(line->m_IndexData.GetCount(), 0, 0);
+		m_pDX->DrawIndexed(line->m_IndexData.GetCount());
 		break;
 	case ERenderType::Terrain:
 		for (auto& iter : Component.PtrTerrain->QuadTree)
@@ -1518,15 +1844,11 @@ PRIVATE void JWSystemRender::Draw(SComponentRender& Component) noexcept
 					}
 					*/
 
-					if (physics->SubBoundingSpheres.size())
+					// Node spheres follow the entity's sphere (see CullBoundingSpheres()).
+					if ((m_FlagSystemRenderOption & JWFlagSystemRenderOption_UseFrustumCulling) && (physics->SubBoundingSpheres.size()) &&
+						(m_vCullingSphereIDs[Component.ComponentIndex] != KInvalidCullingSphereID))
 					{
-						auto world_center = physics->SubBoundingSpheres[iter.SubBoundingVolumeID].Center;
-						auto transform = ptr_entity->GetComponentTransform();
-						if (transform)
-						{
-							world_center += transform->Position;
-						}
-						if (IsSphereCulledByViewFrustum(physics->SubBoundingSpheres[iter.SubBoundingVolumeID].Radius, world_center))
+						if (!m_FrustumCuller.IsVisible(m_vCullingSphereIDs[Component.ComponentIndex] + 1 + iter.SubBoundingVolumeID))
 						{
 							should_cull = true;
 
@@ -1541,14 +1863,14 @@ PRIVATE void JWSystemRender::Draw(SComponentRender& Component) noexcept
 					// This quad tree is not culled. So draw it!
 
 					// Set IA vertex buffer
-					ptr_device_context->IASetVertexBuffers(
+					m_pDX->SetVertexBuffers(
 						0, 1, &iter.VertexBuffer, iter.VertexData.GetPtrStrides(), iter.VertexData.GetPtrOffsets());
 
 					// Set IA index buffer
-					ptr_device_context->IASetIndexBuffer(iter.IndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+					m_pDX->SetIndexBuffer(iter.IndexBuffer);
 
 					// Draw indexed
-					ptr_device_context->DrawIndexed(iter.IndexData.GetCount(), 0, 0);
+					m_pDX->DrawIndexed(iter.IndexData.GetCount());
 				}
 			}
 		}
@@ -1584,7 +1906,7 @@ PRIVATE void JWSystemRender::DrawNormals(SComponentRender& Component) noexcept
 	if (model)
 	{
 		// Draw
-		m_pDX->GetDeviceContext()->Draw(model->ModelData.VertexData.GetVertexCount() * 2, 0);
+		m_pDX->Draw(model->ModelData.VertexData.GetVertexCount() * 2);
 	}
 
 	if (terrain)
@@ -1594,11 +1916,11 @@ PRIVATE void JWSystemRender::DrawNormals(SComponentRender& Component) noexcept
 			if (iter.HasMeshes)
 			{
 				// Set IA vertex buffer
-				m_pDX->GetDeviceContext()->IASetVertexBuffers(
+				m_pDX->SetVertexBuffers(
 					0, 1, &iter.VertexBuffer, iter.VertexData.GetPtrStrides(), iter.VertexData.GetPtrOffsets());
 
 				// Draw
-				m_pDX->GetDeviceContext()->Draw(iter.VertexData.GetVertexCount() * 2, 0);
+				m_pDX->Draw(iter.VertexData.GetVertexCount() * 2);
 			}
 		}
 	}
@@ -1609,9 +1931,9 @@ PRIVATE void JWSystemRender::DrawNormals(SComponentRender& Component) noexcept
 
 void JWSystemRender::UpdateImage2Ds() noexcept
 {
-	if (m_vComponents.size())
+	if (m_Components.GetCount())
 	{
-		for (auto& iter : m_vComponents)
+		for (auto& iter : m_Components)
 		{
 			if (iter.RenderType == ERenderType::Image_2D)
 			{
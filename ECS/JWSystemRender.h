@@ -6,6 +6,9 @@
 #include "../Core/JWImage.h"
 #include "../Core/JWPrimitiveMaker.h"
 #include "../Core/JWTerrainGenerator.h"
+#include <atomic>
+#include "JWComponentPool.h"
+#include "JWFrustumCuller.h"
 
 namespace JWEngine
 {
@@ -57,6 +60,41 @@ namespace JWEngine
 	};
 	using JWFlagSystemRenderOption = uint16_t;
 
+	// Each slot of the pose buffer holds KMaxBoneCount bone matrices.
+	static constexpr uint32_t KInvalidPoseBufferSlot{ (uint32_t)-1 };
+
+	// Evaluating a pose walks the whole node tree, so small chunks are already worth a job.
+	static constexpr uint32_t KPoseEvaluationMinChunkSize{ 4 };
+
+	// Render queue sort key (most significant bits first)
+	// Opaque:      [pass 2][order 2][VS 4][PS 4][texture 16][model 16][depth 20] (front to back)
+	// Transparent: [pass 2][order 2][depth 20][VS 4][PS 4][texture 16][model 16] (back to front)
+	static constexpr uint32_t KRenderKeyPassShift{ 62 };
+	static constexpr uint32_t KRenderKeyOrderShift{ 60 };
+	static constexpr uint32_t KRenderKeyDepthBitCount{ 20 };
+	// texture = 1 + index into the shared textures, model = [kind 2][1 + index into the shared models of the kind 14]
+	// (0 for resources that aren't shared ones)
+	static constexpr uint64_t KRenderKeyModelIndexMask{ 0x3FFF };
+	static constexpr uint64_t KRenderPassOpaque{ 0 };
+	static constexpr uint64_t KRenderPassTransparent{ 1 };
+
+	// Items of the same pass are drawn in this order before the rest of the key is considered.
+	enum class ERenderOrder : uint64_t
+	{
+		Background,		// Sky
+		World,
+		ScreenSpace,	// Image_2D, Model_Line2D
+	};
+
+	// Smaller runs of the same model are drawn one by one.
+	static constexpr size_t KMinInstanceBatchSize{ 2 };
+
+	struct SRenderQueueItem
+	{
+		uint64_t			Key{};
+		ComponentIndexType	ComponentIndex{};
+	};
+
 	struct SAnimationState
 	{
 		// If no animation is set, CurrAnimationID is 0 (TPose)
@@ -100,6 +138,12 @@ namespace JWEngine
 		STextureData*				PtrAnimationTexture{};
 		SAnimationState				AnimationState{};
 
+		// Slot in JWSystemRender's pose buffer (only rigged models animated on CPU get one)
+		uint32_t					PoseBufferSlot{ KInvalidPoseBufferSlot };
+
+		// Key cursors of the current animation (indexed by node ID)
+		VECTOR<SAnimationKeyCursor>	vAnimationKeyCursors{};
+
 		JWFlagComponentRenderOption	FlagComponentRenderOption{};
 
 		auto SetVertexShader(EVertexShader Shader) noexcept { VertexShader = Shader; return this; }
@@ -282,6 +326,9 @@ namespace JWEngine
 
 		void Execute() noexcept;
 
+		// Packed components + entity mapping (for multi-component views)
+		auto& ComponentPool() noexcept { return m_Components; };
+
 		// @important:
 		// This function must be called when DisplayMode has been changed.
 		void UpdateImage2Ds() noexcept;
@@ -291,9 +338,23 @@ namespace JWEngine
 		void ToggleSystemRenderFlag(JWFlagSystemRenderOption Flag) noexcept;
 		void ToggleWireFrame() noexcept;
 
+		// Bone palette of the component's current pose (nullptr if it has no pose yet)
+		auto GetComponentBonePalette(ComponentIndexType ComponentIndex) const noexcept->const XMMATRIX*;
+
 		// Frustum culling
 		auto GetFrustumCulledEntityCount() const noexcept { return m_FrustumCulledEntityCount; }
 		auto GetFrustumCulledTerrainNodeCount() const noexcept { return m_FrustumCulledTerrainNodeCount; }
+		const auto& GetFrustumCuller() const noexcept { return m_FrustumCuller; }
+
+		// Render queue (rebuilt and sorted every Execute())
+		auto GetRenderQueueSize() const noexcept { return static_cast<uint32_t>(m_vRenderQueue.size()); }
+		const auto& GetRenderQueue() const noexcept { return m_vRenderQueue; }
+		// Time spent in the last sort in microseconds
+		auto GetLastRenderQueueSortTime() const noexcept { return m_LastRenderQueueSortTime; }
+
+		// Automatic instancing (counted in the last Execute())
+		auto GetInstancedBatchCount() const noexcept { return m_InstancedBatchCount; }
+		auto GetInstancedComponentCount() const noexcept { return m_InstancedComponentCount; }
 
 		// Object getter
 		///auto& BoundingEllipsoid() noexcept { return m_BoundingEllipsoid; }
@@ -304,21 +365,36 @@ namespace JWEngine
 	// Only accesible for JWEntity
 	private:
 		auto CreateComponent(EntityIndexType EntityIndex) noexcept->ComponentIndexType;
-		void DestroyComponent(ComponentIndexType ComponentIndex) noexcept;
-		auto GetComponentPtr(ComponentIndexType ComponentIndex) noexcept->SComponentRender*;
+		void DestroyComponent(EntityIndexType EntityIndex) noexcept;
+		auto GetComponentPtr(EntityIndexType EntityIndex) noexcept->SComponentRender*;
 
 	private:
 		void CreateCollisionMeshData(JWModel& Model) noexcept;
 
-		void SetShaders(SComponentRender& Component) noexcept;
+		// If IsInstanced is true, world matrices come from the instance buffer.
+		void SetShaders(SComponentRender& Component, bool IsInstanced = false) noexcept;
 
 		void AnimateOnGPU(SComponentRender& Component) noexcept;
 		void AnimateOnCPU(SComponentRender& Component) noexcept;
 
+		// Evaluates poses of every CPU-animated component in parallel (with JWJobSystem).
+		void EvaluateCPUAnimationPoses() noexcept;
+
+		// Pose buffer
+		auto AcquirePoseBufferSlot() noexcept->uint32_t;
+		void ReleasePoseBufferSlot(uint32_t Slot) noexcept;
+		auto GetPoseBufferPalette(uint32_t Slot) noexcept->XMMATRIX*;
+
+		// @important
+		// Only reads the shared model and writes into the component's own state and bone palette,
+		// so components can be evaluated independently.
+		void EvaluatePose(SComponentRender& Component) noexcept;
+
 		void UpdateNodeAnimationIntoBones(bool UseInterpolation, SAnimationState& AnimationState,
-			SModelData& ModelData, const SModelNode& CurrentNode, const XMMATRIX Accumulated) noexcept;
-		void UpdateNodeTPoseIntoBones(float AnimationTime, SModelData& ModelData,
-			const SModelNode& CurrentNode, const XMMATRIX Accumulated) noexcept;
+			const SModelData& ModelData, const SModelNode& CurrentNode, const XMMATRIX Accumulated,
+			SAnimationKeyCursor* KeyCursors, XMMATRIX* OutBonePalette) noexcept;
+		void UpdateNodeTPoseIntoBones(float AnimationTime, const SModelData& ModelData,
+			const SModelNode& CurrentNode, const XMMATRIX Accumulated, XMMATRIX* OutBonePalette) noexcept;
 
 		/// Bounding ellipsoid
 		///inline void UpdateBoundingEllipsoidInstanceBuffer() noexcept;
@@ -329,10 +405,26 @@ namespace JWEngine
 		/// Frustum culling with bounding ellipsoid
 		///auto IsUnitSphereCulledByViewFrustum(const XMMATRIX& EllipsoidWorld) const noexcept->bool;
 
-		// Frustum culling with bounding sphere
-		auto IsSphereCulledByViewFrustum(float Radius, const XMVECTOR& Center) const noexcept->bool;
+		// Frustum culling with bounding spheres (entities and terrain nodes, once per frame)
+		void CullBoundingSpheres() noexcept;
+
+		// Render queue
+		auto MakeRenderQueueKey(const SComponentRender& Component) noexcept->uint64_t;
+		void BuildRenderQueue() noexcept;
+		void SortRenderQueue() noexcept;
+
+		// Checks entity type, camera flags and frustum culling.
+		auto ShouldDrawComponent(const SComponentRender& Component) noexcept->bool;
+
+		// Automatic instancing
+		auto CanBeInstanced(const SComponentRender& Component) const noexcept->bool;
+		auto AreInstancesOfSameBatch(const SComponentRender& A, const SComponentRender& B) const noexcept->bool;
+		// Draws the run of opaque items starting at QueueIndex and returns the index after it.
+		auto ExecuteOpaqueRun(size_t QueueIndex) noexcept->size_t;
+		void DrawInstancedBatch() noexcept;
 
 		void ExecuteComponent(SComponentRender& Component) noexcept;
+		void ExecuteVisibleComponent(SComponentRender& Component) noexcept;
 
 		void Draw(SComponentRender& Component) noexcept;
 		void DrawNormals(SComponentRender& Component) noexcept;
@@ -344,7 +436,7 @@ namespace JWEngine
 		///void DrawNonInstancedBoundingEllipsoids(const XMMATRIX& EllipsoidWorld) noexcept;
 		
 	private:
-		VECTOR<SComponentRender>	m_vComponents;
+		JWComponentPool<SComponentRender>	m_Components;
 
 		JWECS*						m_pECS{};
 		JWDX*						m_pDX{};
@@ -357,8 +449,13 @@ namespace JWEngine
 		SVSCBGPUAnimationData		m_VSCBGPUAnimation{};
 		SPSCBFlags					m_PSCBFlags{};
 
+		// Pose buffer (bone palettes of all animated components, KMaxBoneCount matrices per slot)
+		VECTOR<XMMATRIX>			m_vPoseBuffer;
+		VECTOR<uint32_t>			m_vFreePoseBufferSlots;
+
 		// Shared resources(texture, model data, animation texture)
 		VECTOR<STextureData>		m_vSharedTextureData;
+		UNORDERED_MAP<ID3D11ShaderResourceView*, uint32_t>	m_umapSharedTextureIndices;
 		VECTOR<STextureData>		m_vAnimationTextureData;
 		VECTOR<JWModel>				m_vSharedModel;
 		VECTOR<JWLineModel>			m_vSharedLineModel;
@@ -373,6 +470,7 @@ namespace JWEngine
 
 		// Bounding sphere
 		JWModel						m_BoundingSphereModel{};
+		std::atomic<bool>			m_IsBoundingSphereInstanceBufferDirty{ false };
 
 		ERasterizerState			m_UniversalRasterizerState{ ERasterizerState::SolidNoCull };
 		ERasterizerState			m_OldUniversalRasterizerState{ ERasterizerState::SolidNoCull };
@@ -382,6 +480,24 @@ namespace JWEngine
 		mutable uint32_t			m_FrustumCulledEntityCount{};
 		mutable uint32_t			m_FrustumCulledTerrainNodeCount{};
 
+		// First culling sphere of each component (indexed by component index).
+		// Terrain node spheres follow the entity's sphere in SubBoundingVolumeID order.
+		JWFrustumCuller				m_FrustumCuller{};
+		VECTOR<uint32_t>			m_vCullingSphereIDs{};
+
+		// Render queue (m_vRenderQueueSortBuffer is the radix sort's scratch)
+		VECTOR<SRenderQueueItem>	m_vRenderQueue{};
+		VECTOR<SRenderQueueItem>	m_vRenderQueueSortBuffer{};
+		long long					m_LastRenderQueueSortTime{};
+
+		// Automatic instancing (the instance buffer grows to fit the largest batch)
+		VECTOR<ComponentIndexType>	m_vInstanceBatch{};
+		VECTOR<SModelInstanceData>	m_vInstanceData{};
+		ID3D11Buffer*				m_InstanceBuffer{};
+		uint32_t					m_InstanceBufferCapacity{};
+		uint32_t					m_InstancedBatchCount{};
+		uint32_t					m_InstancedComponentCount{};
+
 		// Terrain
 		JWTerrainGenerator			m_TerrainGenerator{};
 	};
@@ -12,94 +12,215 @@ void JWSystemTransform::Destroy() noexcept {}
 
 PRIVATE auto JWSystemTransform::CreateComponent(EntityIndexType EntityIndex) noexcept->ComponentIndexType
 {
-	auto component_index{ static_cast<ComponentIndexType>(m_vComponents.size()) };
-	
 	// @important
-	// Save component ID & pointer to Entity
-	m_vComponents.emplace_back(EntityIndex, component_index);
+	// Save component ID & entity index
+	auto component_index = m_Components.Create(EntityIndex);
 
 	return component_index;
 }
 
-PRIVATE void JWSystemTransform::DestroyComponent(ComponentIndexType ComponentIndex) noexcept
+PRIVATE void JWSystemTransform::DestroyComponent(EntityIndexType EntityIndex) noexcept
 {
-	if (m_vComponents.size() == 0)
+	if (!m_Components.HasEntity(EntityIndex))
 	{
 		JW_ERROR_ABORT("There is no component to destroy.");
 	}
 
-	// Save the target component's index.
-	auto component_index{ ComponentIndex };
+	// Swap-and-pop (the pool fixes the moved component's index and its entity mapping).
+	m_Components.DestroyByEntity(EntityIndex);
+}
 
-	// Get the last index of the component vector.
-	auto last_index = static_cast<ComponentIndexType>(m_vComponents.size() - 1);
+PRIVATE auto JWSystemTransform::GetComponentPtr(EntityIndexType EntityIndex) noexcept->SComponentTransform*
+{
+	return m_Components.GetByEntity(EntityIndex);
+}
 
-	// Get pointer to the entity with last_index's component.
-	auto ptr_entity_last_component = m_pECS->GetEntityByIndex(m_vComponents[last_index].EntityIndex);
+void JWSystemTransform::Execute() noexcept
+{
+	auto start_time = STEADY_CLOCK::now();
 
-	// See if the component index is invalid.
-	if (component_index > last_index)
+	// Collect dirty components (flags are cleared here, before any chunk runs).
+	m_vDirtyComponentIndices.clear();
+	for (auto& iter : m_Components)
 	{
-		JW_ERROR_ABORT("Invalid component index.");
+		if (iter.IsWorldMatrixDirty)
+		{
+			iter.IsWorldMatrixDirty = false;
+			iter.WorldMatrixVersion = ++m_LastWorldMatrixVersion;
+
+			m_vDirtyComponentIndices.emplace_back(iter.ComponentIndex);
+		}
 	}
+	m_RecomputedWorldMatrixCount = static_cast<uint32_t>(m_vDirtyComponentIndices.size());
 
-	// Swap the last element of the vector and the deleted element if necessary
-	if (component_index < last_index)
+	if (m_WorldMatrixBuildPath == EWorldMatrixBuildPath::SoA)
 	{
-		m_vComponents[component_index] = std::move(m_vComponents[last_index]);
-		m_vComponents[component_index].ComponentIndex = component_index; // @important
-
-		ptr_entity_last_component->SetComponentTransformIndex(component_index); // @important
+		BuildWorldMatricesSoA();
+	}
+	else
+	{
+		BuildWorldMatricesAoS();
 	}
 
-	// Shrink the size of the vector.
-	m_vComponents.pop_back();
+	m_WorldMatrixBuildTime = std::chrono::duration_cast<TIME_UNIT_mS>(STEADY_CLOCK::now() - start_time).count();
+}
+
+PRIVATE void JWSystemTransform::BuildWorldMatricesAoS() noexcept
+{
+	// Every component only writes its own world matrix, so chunks are independent.
+	m_pECS->JobSystem().ParallelFor(static_cast<uint32_t>(m_vDirtyComponentIndices.size()), KJobSystemDefaultMinChunkSize,
+		[this](uint32_t Begin, uint32_t End)
+		{
+			XMMATRIX matrix_translation{};
+			XMMATRIX matrix_scaling{};
+			XMMATRIX matrix_rotation{};
+
+			for (uint32_t i = Begin; i < End; ++i)
+			{
+				auto& iter = m_Components[m_vDirtyComponentIndices[i]];
+
+				matrix_translation = XMMatrixTranslationFromVector(iter.Position);
+				matrix_scaling = XMMatrixScalingFromVector(iter.ScalingFactor);
+				matrix_rotation = XMMatrixRotationRollPitchYaw(iter.PitchYawRoll.x, iter.PitchYawRoll.y, iter.PitchYawRoll.z);
+
+				iter.WorldMatrix = ComposeWorldMatrix(matrix_translation, matrix_rotation, matrix_scaling, iter.WorldMatrixCalculationOrder);
+			}
+		});
 }
 
-PRIVATE auto JWSystemTransform::GetComponentPtr(ComponentIndexType ComponentIndex) noexcept->SComponentTransform*
+PRIVATE void JWSystemTransform::BuildWorldMatricesSoA() noexcept
 {
-	if (ComponentIndex >= m_vComponents.size())
+	// #1 Bucket dirty components by calculation order
+	for (auto& iter : m_SoABuckets)
 	{
-		return nullptr;
+		iter.vComponentIndices.clear();
 	}
+	for (auto component_index : m_vDirtyComponentIndices)
+	{
+		const auto& component = m_Components[component_index];
 
-	return &m_vComponents[ComponentIndex];
+		m_SoABuckets[static_cast<uint32_t>(component.WorldMatrixCalculationOrder)].vComponentIndices.emplace_back(component_index);
+	}
+
+	// #2 Gather inputs and build world matrices batch by batch
+	for (uint32_t order = 0; order < KWorldMatrixCalculationOrderCount; ++order)
+	{
+		auto& bucket = m_SoABuckets[order];
+		auto count = static_cast<uint32_t>(bucket.vComponentIndices.size());
+		if (count == 0) { continue; }
+
+		bucket.ResizePadded(count);
+
+		auto batch_count = (count + KTransformBatchSize - 1) / KTransformBatchSize;
+		auto calculation_order = static_cast<EWorldMatrixCalculationOrder>(order);
+
+		// Chunks own disjoint ranges of the bucket, so they gather and build independently.
+		m_pECS->JobSystem().ParallelFor(batch_count, KJobSystemDefaultMinChunkSize / KTransformBatchSize,
+			[this, &bucket, count, calculation_order](uint32_t Begin, uint32_t End)
+			{
+				GatherSoABucket(bucket, Begin * KTransformBatchSize, min(End * KTransformBatchSize, count));
+
+				for (uint32_t batch = Begin; batch < End; ++batch)
+				{
+					BuildWorldMatrixBatch(bucket, batch * KTransformBatchSize, calculation_order);
+				}
+			});
+	}
 }
 
-void JWSystemTransform::Execute() noexcept
+PRIVATE void JWSystemTransform::GatherSoABucket(STransformSoABucket& Bucket, uint32_t Begin, uint32_t End) noexcept
 {
-	XMMATRIX matrix_translation{};
-	XMMATRIX matrix_scaling{};
-	XMMATRIX matrix_rotation{};
+	XMFLOAT3 position{};
+	XMFLOAT3 scaling{};
 
-	for (auto& iter : m_vComponents)
+	for (uint32_t i = Begin; i < End; ++i)
 	{
-		matrix_translation = XMMatrixTranslationFromVector(iter.Position);
-		matrix_scaling = XMMatrixScalingFromVector(iter.ScalingFactor);
-		matrix_rotation = XMMatrixRotationRollPitchYaw(iter.PitchYawRoll.x, iter.PitchYawRoll.y, iter.PitchYawRoll.z);
+		const auto& component = m_Components[Bucket.vComponentIndices[i]];
+
+		XMStoreFloat3(&position, component.Position);
+		XMStoreFloat3(&scaling, component.ScalingFactor);
+
+		Bucket.vPositionX[i] = position.x;
+		Bucket.vPositionY[i] = position.y;
+		Bucket.vPositionZ[i] = position.z;
+		Bucket.vScalingX[i] = scaling.x;
+		Bucket.vScalingY[i] = scaling.y;
+		Bucket.vScalingZ[i] = scaling.z;
+		Bucket.vPitch[i] = component.PitchYawRoll.x;
+		Bucket.vYaw[i] = component.PitchYawRoll.y;
+		Bucket.vRoll[i] = component.PitchYawRoll.z;
+	}
+}
 
-		switch (iter.WorldMatrixCalculationOrder)
+PRIVATE void JWSystemTransform::BuildWorldMatrixBatch(const STransformSoABucket& Bucket, uint32_t First,
+	EWorldMatrixCalculationOrder Order) noexcept
+{
+	// Lanes past the end of the bucket hold stale (but finite) values, their results are discarded.
+	XMVECTOR position[3]{
+		XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&Bucket.vPositionX[First])),
+		XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&Bucket.vPositionY[First])),
+		XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&Bucket.vPositionZ[First])) };
+	XMVECTOR scaling[3]{
+		XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&Bucket.vScalingX[First])),
+		XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&Bucket.vScalingY[First])),
+		XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&Bucket.vScalingZ[First])) };
+
+	XMVECTOR sin_pitch{}, cos_pitch{};
+	XMVECTOR sin_yaw{}, cos_yaw{};
+	XMVECTOR sin_roll{}, cos_roll{};
+	XMVectorSinCos(&sin_pitch, &cos_pitch, XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&Bucket.vPitch[First])));
+	XMVectorSinCos(&sin_yaw, &cos_yaw, XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&Bucket.vYaw[First])));
+	XMVectorSinCos(&sin_roll, &cos_roll, XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&Bucket.vRoll[First])));
+
+	// Same as XMMatrixRotationRollPitchYaw() (Roll -> Pitch -> Yaw)
+	auto sr_sp = XMVectorMultiply(sin_roll, sin_pitch);
+	auto cr_sp = XMVectorMultiply(cos_roll, sin_pitch);
+	XMVECTOR rotation[3][3]{
 		{
-		case JWEngine::EWorldMatrixCalculationOrder::TransRotScale:
-			iter.WorldMatrix = matrix_translation * matrix_rotation * matrix_scaling;
-			break;
-		case JWEngine::EWorldMatrixCalculationOrder::TransScaleRot:
-			iter.WorldMatrix = matrix_translation * matrix_scaling * matrix_rotation;
-			break;
-		case JWEngine::EWorldMatrixCalculationOrder::RotTransScale:
-			iter.WorldMatrix = matrix_rotation * matrix_translation * matrix_scaling;
-			break;
-		case JWEngine::EWorldMatrixCalculationOrder::RotScaleTrans:
-			iter.WorldMatrix = matrix_rotation * matrix_scaling * matrix_translation;
+			XMVectorMultiplyAdd(sr_sp, sin_yaw, XMVectorMultiply(cos_roll, cos_yaw)),
+			XMVectorMultiply(sin_roll, cos_pitch),
+			XMVectorNegativeMultiplySubtract(cos_roll, sin_yaw, XMVectorMultiply(sr_sp, cos_yaw)),
+		},
+		{
+			XMVectorNegativeMultiplySubtract(sin_roll, cos_yaw, XMVectorMultiply(cr_sp, sin_yaw)),
+			XMVectorMultiply(cos_roll, cos_pitch),
+			XMVectorMultiplyAdd(cr_sp, cos_yaw, XMVectorMultiply(sin_roll, sin_yaw)),
+		},
+		{
+			XMVectorMultiply(cos_pitch, sin_yaw),
+			XMVectorNegate(sin_pitch),
+			XMVectorMultiply(cos_pitch, cos_yaw),
+		} };
+
+	SWorldMatrixBatch world{};
+	for (auto step : KWorldMatrixCalculationSteps[static_cast<uint32_t>(Order)])
+	{
+		switch (step)
+		{
+		case ETransformStep::Scale:
+			world.Scale(scaling);
 			break;
-		case JWEngine::EWorldMatrixCalculationOrder::ScaleTransRot:
-			iter.WorldMatrix = matrix_scaling * matrix_translation * matrix_rotation;
+		case ETransformStep::Rotate:
+			world.Rotate(rotation);
 			break;
-		case JWEngine::EWorldMatrixCalculationOrder::ScaleRotTrans:
-			iter.WorldMatrix = matrix_scaling * matrix_rotation * matrix_translation;
+		case ETransformStep::Translate:
+			world.Translate(position);
 			break;
 		default:
 			break;
 		}
 	}
+
+	// Lanes -> rows (each transpose yields one row of the 4 matrices)
+	auto row_0 = XMMatrixTranspose(XMMATRIX(world.L[0][0], world.L[0][1], world.L[0][2], KVectorZero));
+	auto row_1 = XMMatrixTranspose(XMMATRIX(world.L[1][0], world.L[1][1], world.L[1][2], KVectorZero));
+	auto row_2 = XMMatrixTranspose(XMMATRIX(world.L[2][0], world.L[2][1], world.L[2][2], KVectorZero));
+	auto row_3 = XMMatrixTranspose(XMMATRIX(world.T[0], world.T[1], world.T[2], XMVectorSplatOne()));
+
+	auto lane_count = min(KTransformBatchSize, static_cast<uint32_t>(Bucket.vComponentIndices.size()) - First);
+	for (uint32_t lane = 0; lane < lane_count; ++lane)
+	{
+		m_Components[Bucket.vComponentIndices[First + lane]].WorldMatrix =
+			XMMATRIX(row_0.r[lane], row_1.r[lane], row_2.r[lane], row_3.r[lane]);
+	}
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "../Core/JWCommon.h"
 #include "../Core/JWMath.h"
+#include "JWComponentPool.h"
 
 namespace JWEngine
 {
@@ -10,6 +11,147 @@ namespace JWEngine
 
 	static const XMVECTOR	KDefUp{ XMVectorSet(0, 1, 0, 0) };
 
+	// World matrices are built 4 at a time, one XMVECTOR lane per component.
+	static constexpr uint32_t KTransformBatchSize{ 4 };
+	static constexpr uint32_t KWorldMatrixCalculationOrderCount{ 6 };
+
+	enum class EWorldMatrixBuildPath
+	{
+		// Per-component XMMatrix*() calls (reference implementation)
+		AoS,
+
+		// Components are bucketed by calculation order and built in SIMD batches.
+		SoA,
+	};
+
+	enum class ETransformStep
+	{
+		Scale,
+		Rotate,
+		Translate,
+	};
+
+	// Indexed by EWorldMatrixCalculationOrder (e.g. TransRotScale = T * R * S)
+	static constexpr ETransformStep KWorldMatrixCalculationSteps[KWorldMatrixCalculationOrderCount][3]
+	{
+		{ ETransformStep::Translate, ETransformStep::Rotate, ETransformStep::Scale },
+		{ ETransformStep::Translate, ETransformStep::Scale, ETransformStep::Rotate },
+		{ ETransformStep::Rotate, ETransformStep::Translate, ETransformStep::Scale },
+		{ ETransformStep::Rotate, ETransformStep::Scale, ETransformStep::Translate },
+		{ ETransformStep::Scale, ETransformStep::Translate, ETransformStep::Rotate },
+		{ ETransformStep::Scale, ETransformStep::Rotate, ETransformStep::Translate },
+	};
+
+	inline auto ComposeWorldMatrix(const XMMATRIX& Translation, const XMMATRIX& Rotation, const XMMATRIX& Scaling,
+		EWorldMatrixCalculationOrder Order) noexcept->XMMATRIX
+	{
+		switch (Order)
+		{
+		case EWorldMatrixCalculationOrder::TransRotScale:
+			return Translation * Rotation * Scaling;
+		case EWorldMatrixCalculationOrder::TransScaleRot:
+			return Translation * Scaling * Rotation;
+		case EWorldMatrixCalculationOrder::RotTransScale:
+			return Rotation * Translation * Scaling;
+		case EWorldMatrixCalculationOrder::RotScaleTrans:
+			return Rotation * Scaling * Translation;
+		case EWorldMatrixCalculationOrder::ScaleTransRot:
+			return Scaling * Translation * Rotation;
+		case EWorldMatrixCalculationOrder::ScaleRotTrans:
+		default:
+			return Scaling * Rotation * Translation;
+		}
+	}
+
+	// SoA inputs of the world-matrix kernel for one calculation order.
+	// Arrays are padded to a multiple of KTransformBatchSize.
+	struct STransformSoABucket
+	{
+		VECTOR<ComponentIndexType>	vComponentIndices;
+
+		VECTOR<float>				vPositionX;
+		VECTOR<float>				vPositionY;
+		VECTOR<float>				vPositionZ;
+		VECTOR<float>				vScalingX;
+		VECTOR<float>				vScalingY;
+		VECTOR<float>				vScalingZ;
+		VECTOR<float>				vPitch;
+		VECTOR<float>				vYaw;
+		VECTOR<float>				vRoll;
+
+		void ResizePadded(size_t Count)
+		{
+			auto padded_count = (Count + KTransformBatchSize - 1) / KTransformBatchSize * KTransformBatchSize;
+
+			vPositionX.resize(padded_count);
+			vPositionY.resize(padded_count);
+			vPositionZ.resize(padded_count);
+			vScalingX.resize(padded_count);
+			vScalingY.resize(padded_count);
+			vScalingZ.resize(padded_count);
+			vPitch.resize(padded_count);
+			vYaw.resize(padded_count);
+			vRoll.resize(padded_count);
+		}
+	};
+
+	// KTransformBatchSize affine matrices in SoA form (row-vector convention, like XMMATRIX).
+	// L is the 3x3 linear part, T is the translation row.
+	struct SWorldMatrixBatch
+	{
+		// @important: KVectorOne can't be used here, its w is 0 and every lane is a component.
+		XMVECTOR L[3][3]{
+			{ XMVectorSplatOne(), KVectorZero, KVectorZero },
+			{ KVectorZero, XMVectorSplatOne(), KVectorZero },
+			{ KVectorZero, KVectorZero, XMVectorSplatOne() } };
+		XMVECTOR T[3]{ KVectorZero, KVectorZero, KVectorZero };
+
+		// this = this * Scaling
+		inline void Scale(const XMVECTOR(&S)[3])
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				for (int j = 0; j < 3; ++j)
+				{
+					L[i][j] = XMVectorMultiply(L[i][j], S[j]);
+				}
+			}
+			for (int j = 0; j < 3; ++j)
+			{
+				T[j] = XMVectorMultiply(T[j], S[j]);
+			}
+		}
+
+		// this = this * Rotation
+		inline void Rotate(const XMVECTOR(&R)[3][3])
+		{
+			// Each row is multiplied by R (the translation row included).
+			for (int i = 0; i < 4; ++i)
+			{
+				auto& row = (i < 3) ? L[i] : T;
+
+				auto x = row[0];
+				auto y = row[1];
+				auto z = row[2];
+				for (int j = 0; j < 3; ++j)
+				{
+					row[j] = XMVectorMultiply(x, R[0][j]);
+					row[j] = XMVectorMultiplyAdd(y, R[1][j], row[j]);
+					row[j] = XMVectorMultiplyAdd(z, R[2][j], row[j]);
+				}
+			}
+		}
+
+		// this = this * Translation
+		inline void Translate(const XMVECTOR(&P)[3])
+		{
+			for (int j = 0; j < 3; ++j)
+			{
+				T[j] = XMVectorAdd(T[j], P[j]);
+			}
+		}
+	};
+
 	struct SComponentTransform
 	{
 		SComponentTransform(EntityIndexType _EntityIndex, ComponentIndexType _ComponentIndex) :
@@ -31,6 +173,54 @@ namespace JWEngine
 		XMMATRIX	WorldMatrix{};
 		EWorldMatrixCalculationOrder	WorldMatrixCalculationOrder{ EWorldMatrixCalculationOrder::ScaleRotTrans };
 
+		// @important
+		// WorldMatrix is rebuilt only when this is set.
+		// Write Position/ScalingFactor through the setters below, or call MarkWorldMatrixDirty() after writing in place.
+		bool		IsWorldMatrixDirty{ true };
+
+		// Changes every time WorldMatrix is rebuilt, and is never reused by another component.
+		// (Systems compare it to see if their world-space caches are still valid.)
+		uint32_t	WorldMatrixVersion{};
+
+		// World matrix between the last two fixed physics steps (see JWSystemPhysics::Execute()).
+		// Only valid if IsWorldMatrixInterpolated is set. Rendering must use GetRenderWorldMatrix().
+		XMMATRIX	InterpolatedWorldMatrix{};
+		bool		IsWorldMatrixInterpolated{ false };
+
+		inline const XMMATRIX& GetRenderWorldMatrix() const
+		{
+			return (IsWorldMatrixInterpolated) ? InterpolatedWorldMatrix : WorldMatrix;
+		}
+
+		inline void MarkWorldMatrixDirty()
+		{
+			IsWorldMatrixDirty = true;
+		}
+
+		inline void SetPosition(const XMVECTOR& _Position)
+		{
+			Position = _Position;
+			IsWorldMatrixDirty = true;
+		}
+
+		inline void Translate(const XMVECTOR& Delta)
+		{
+			Position += Delta;
+			IsWorldMatrixDirty = true;
+		}
+
+		inline void SetScalingFactor(const XMVECTOR& _ScalingFactor)
+		{
+			ScalingFactor = _ScalingFactor;
+			IsWorldMatrixDirty = true;
+		}
+
+		inline void SetWorldMatrixCalculationOrder(EWorldMatrixCalculationOrder Order)
+		{
+			WorldMatrixCalculationOrder = Order;
+			IsWorldMatrixDirty = true;
+		}
+
 		inline void SetPitchYawRoll(const XMFLOAT3& _PitchYawRoll, bool IsCamera = false)
 		{
 			PitchYawRoll = _PitchYawRoll;
@@ -44,6 +234,8 @@ namespace JWEngine
 			auto rotation_matrix = XMMatrixRotationRollPitchYaw(PitchYawRoll.x, PitchYawRoll.y, PitchYawRoll.z);
 			Forward = XMVector3TransformNormal(Up, rotation_matrix);
 			Right = XMVector3Normalize(XMVector3Cross(Up, Forward));
+
+			IsWorldMatrixDirty = true;
 		}
 
 		inline void SetPitchYawRoll(float Pitch, float Yaw, float Roll, bool IsCamera = false)
@@ -74,6 +266,8 @@ namespace JWEngine
 			auto rotation_matrix = XMMatrixRotationRollPitchYaw(PitchYawRoll.x, PitchYawRoll.y, PitchYawRoll.z);
 			Forward = XMVector3TransformNormal(Up, rotation_matrix);
 			Right = XMVector3Normalize(XMVector3Cross(Up, Forward));
+
+			IsWorldMatrixDirty = true;
 		}
 
 		inline void RotatePitchYawRoll(const XMVECTOR& _PitchYawRoll, bool IsCamera = false)
@@ -98,15 +292,44 @@ namespace JWEngine
 
 		void Execute() noexcept;
 
+		// Packed components + entity mapping (for multi-component views)
+		auto& ComponentPool() noexcept { return m_Components; };
+
+		// ### World-matrix build path ###
+		// The AoS path is kept as the reference for comparing results and timings.
+		void SetWorldMatrixBuildPath(EWorldMatrixBuildPath Path) noexcept { m_WorldMatrixBuildPath = Path; };
+		auto GetWorldMatrixBuildPath() const noexcept { return m_WorldMatrixBuildPath; };
+
+		// Time spent building world matrices in the last Execute() in microseconds.
+		auto GetWorldMatrixBuildTime() const noexcept { return m_WorldMatrixBuildTime; };
+
+		// Number of world matrices rebuilt in the last Execute() (only dirty ones are rebuilt).
+		auto GetRecomputedWorldMatrixCount() const noexcept { return m_RecomputedWorldMatrixCount; };
+
 	// Only accesible for JWEntity
 	private:
 		auto CreateComponent(EntityIndexType EntityIndex) noexcept->ComponentIndexType;
-		void DestroyComponent(ComponentIndexType ComponentIndex) noexcept;
-		auto GetComponentPtr(ComponentIndexType ComponentIndex) noexcept->SComponentTransform*;
+		void DestroyComponent(EntityIndexType EntityIndex) noexcept;
+		auto GetComponentPtr(EntityIndexType EntityIndex) noexcept->SComponentTransform*;
 
 	private:
-		VECTOR<SComponentTransform>	m_vComponents;
+		void BuildWorldMatricesAoS() noexcept;
+		void BuildWorldMatricesSoA() noexcept;
+
+		void GatherSoABucket(STransformSoABucket& Bucket, uint32_t Begin, uint32_t End) noexcept;
+		void BuildWorldMatrixBatch(const STransformSoABucket& Bucket, uint32_t First, EWorldMatrixCalculationOrder Order) noexcept;
+
+	private:
+		JWComponentPool<SComponentTransform>	m_Components;
 
 		JWECS*						m_pECS{};
+
+		EWorldMatrixBuildPath		m_WorldMatrixBuildPath{ EWorldMatrixBuildPath::SoA };
+		STransformSoABucket			m_SoABuckets[KWorldMatrixCalculationOrderCount]{};
+		long long					m_WorldMatrixBuildTime{};
+
+		VECTOR<ComponentIndexType>	m_vDirtyComponentIndices;
+		uint32_t					m_RecomputedWorldMatrixCount{};
+		uint32_t					m_LastWorldMatrixVersion{};
 	};
 };
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../Core/JWCommon.h"
+
+namespace JWEngine
+{
+	static constexpr const char* KTestProjectName{ "JWEngineTest" };
+
+	// Failed checks of the current test (reset by the runner before each test)
+	extern uint32_t ex_FailedCheckCount;
+
+	// Set by --update-golden, tests write their golden files instead of comparing with them.
+	extern bool ex_ShouldUpdateGoldenFiles;
+
+	// Unlike assert(), checks are also evaluated in Release (benchmarks are only meaningful there).
+#define JW_TEST_CHECK(Expression) if (!(Expression)) { ++JWEngine::ex_FailedCheckCount;\
+	std::cout << "  [FAILED] " << __FILE__ << "(" << __LINE__ << "): " << #Expression << std::endl; }
+
+	// Repository root with a trailing backslash (as JWGame::GetBaseDirectory())
+	auto GetTestBaseDirectory() noexcept->STRING;
+
+	// Average time of one call in microseconds
+	template <typename FunctionType>
+	auto MeasureAverageTime(uint32_t RepeatCount, const FunctionType& Function) noexcept->double
+	{
+		STEADY_CLOCK clock{};
+		auto start = clock.now();
+		for (uint32_t iter = 0; iter < RepeatCount; ++iter)
+		{
+			Function();
+		}
+		auto elapsed = std::chrono::duration_cast<TIME_UNIT_NS>(clock.now() - start).count();
+		return static_cast<double>(elapsed) / 1000.0 / static_cast<double>(max(RepeatCount, 1u));
+	}
+
+	// Tests (one file per engine module)
+	void TestNullGraphicsBackend() noexcept;
+	void TestBroadPhase() noexcept;
+	void TestTerrainTRN() noexcept;
+	void TestAnimation() noexcept;
+	void TestJobSystem() noexcept;
+	void TestTransform() noexcept;
+	void TestNarrowPhase() noexcept;
+	void TestSceneQuery() noexcept;
+	void TestFrustumCuller() noexcept;
+	void TestRenderQueue() noexcept;
+	void TestSoftwareRasterizer() noexcept;
+	void TestContactSolver() noexcept;
+	void TestCCD() noexcept;
+	void TestPhysicsSnapshot() noexcept;
+	void TestECS() noexcept;
+};
@@ -0,0 +1,187 @@
+#include "JWTest.h"
+#include "../Core/JWAssimpLoader.h"
+#include <random>
+
+using namespace JWEngine;
+
+// Reference: the last key whose TimeInTicks <= TimeInTicks (0 if there's no such key), found with a linear scan.
+template <typename KeyType>
+static auto FindAnimationKeyIndexLinear(const VECTOR<KeyType>& vKeys, float TimeInTicks) noexcept->uint32_t
+{
+	uint32_t result{};
+	for (uint32_t iter = 0; iter < vKeys.size(); ++iter)
+	{
+		if (vKeys[iter].TimeInTicks <= TimeInTicks) { result = iter; }
+	}
+	return result;
+}
+
+// Reference: node animation found with a linear scan over vNodeAnimation.
+static auto GetNodeAnimationLinear(const SModelAnimation& Animation, size_t NodeID) noexcept->const SModelNodeAnimation*
+{
+	for (const auto& node_animation : Animation.vNodeAnimation)
+	{
+		if (node_animation.NodeID == NodeID) { return &node_animation; }
+	}
+	return nullptr;
+}
+
+// Samples every node of the clip at TimeInTicks (sums the key indices so that the work can't be optimized out).
+static auto SampleClipLinear(const SModelAnimation& Animation, size_t NodeCount, float TimeInTicks) noexcept->uint32_t
+{
+	uint32_t result{};
+	for (size_t node_id = 0; node_id < NodeCount; ++node_id)
+	{
+		if (auto node_animation = GetNodeAnimationLinear(Animation, node_id))
+		{
+			result += FindAnimationKeyIndexLinear(node_animation->vKeyPosition, TimeInTicks);
+			result += FindAnimationKeyIndexLinear(node_animation->vKeyRotation, TimeInTicks);
+			result += FindAnimationKeyIndexLinear(node_animation->vKeyScaling, TimeInTicks);
+		}
+	}
+	return result;
+}
+
+static auto SampleClipCursor(const SModelAnimation& Animation, VECTOR<SAnimationKeyCursor>& vCursors, float TimeInTicks) noexcept->uint32_t
+{
+	uint32_t result{};
+	for (size_t node_id = 0; node_id < vCursors.size(); ++node_id)
+	{
+		if (auto node_animation = Animation.GetNodeAnimation(node_id))
+		{
+			auto& cursor = vCursors[node_id];
+			cursor.Position = FindAnimationKeyIndex(node_animation->vKeyPosition, TimeInTicks, cursor.Position);
+			cursor.Rotation = FindAnimationKeyIndex(node_animation->vKeyRotation, TimeInTicks, cursor.Rotation);
+			cursor.Scaling = FindAnimationKeyIndex(node_animation->vKeyScaling, TimeInTicks, cursor.Scaling);
+			result += cursor.Position + cursor.Rotation + cursor.Scaling;
+		}
+	}
+	return result;
+}
+
+// Key search must match a linear scan for forward playback, seeks, loops and stale hints.
+static void CheckKeySearch() noexcept
+{
+	static constexpr uint32_t KKeyCounts[]{ 1, 2, 5, 64, 1'000 };
+	static constexpr uint32_t KQueryCount{ 2'000 };
+
+	std::mt19937 random{ 1 };
+
+	for (auto key_count : KKeyCounts)
+	{
+		// Uneven key spacing, first key after time 0 (so times before it are tested too)
+		VECTOR<SModelAnimationKeyPosition> keys(key_count);
+		std::uniform_real_distribution<float> spacing{ 0.1f, 3.0f };
+		float time{ 1.0f };
+		for (auto& key : keys)
+		{
+			key.TimeInTicks = time;
+			time += spacing(random);
+		}
+		auto end_time = time;
+
+		std::uniform_real_distribution<float> any_time{ -1.0f, end_time + 1.0f };
+		std::uniform_int_distribution<uint32_t> any_hint{ 0, key_count + 2 };
+
+		bool is_correct{ true };
+
+		// Forward playback with a cursor (wraps around like a looping clip)
+		uint32_t cursor{};
+		float play_time{};
+		for (uint32_t iter = 0; iter < KQueryCount; ++iter)
+		{
+			play_time += 0.37f;
+			if (play_time > end_time) { play_time -= end_time; }
+
+			cursor = FindAnimationKeyIndex(keys, play_time, cursor);
+			is_correct &= (cursor == FindAnimationKeyIndexLinear(keys, play_time));
+		}
+
+		// Random seeks with random (possibly out-of-range) hints
+		for (uint32_t iter = 0; iter < KQueryCount; ++iter)
+		{
+			auto seek_time = any_time(random);
+			is_correct &= (FindAnimationKeyIndex(keys, seek_time, any_hint(random)) == FindAnimationKeyIndexLinear(keys, seek_time));
+		}
+
+		// Exactly on every key
+		for (uint32_t iter = 0; iter < key_count; ++iter)
+		{
+			is_correct &= (FindAnimationKeyIndex(keys, keys[iter].TimeInTicks) == iter);
+		}
+
+		JW_TEST_CHECK(is_correct);
+	}
+}
+
+// Shipped Ezreal clips: node lookup and key search must match the linear scans at every frame,
+// and sampling a whole clip is timed both ways.
+static void CheckEzrealClips() noexcept
+{
+	static constexpr const char* KAdditionalClipFileNames[]{ "Ezreal_Punching.X", "Ezreal_Walk.X" };
+
+	auto asset_directory = GetTestBaseDirectory() + KAssetDirectory;
+
+	JWAssimpLoader loader{};
+	auto model_data = loader.LoadRiggedModel(asset_directory, "Ezreal_Idle.X");
+	for (auto file_name : KAdditionalClipFileNames)
+	{
+		loader.LoadAdditionalAnimationIntoRiggedModel(model_data, asset_directory, file_name);
+	}
+
+	auto node_count = model_data.NodeTree.vNodes.size();
+	JW_TEST_CHECK(node_count > 0);
+	JW_TEST_CHECK(model_data.AnimationSet.vAnimations.size() == 3);
+
+	for (const auto& animation : model_data.AnimationSet.vAnimations)
+	{
+		JW_TEST_CHECK(animation.vNodeAnimationIndexFromNodeID.size() == node_count);
+
+		bool is_node_lookup_correct{ true };
+		for (size_t node_id = 0; node_id < node_count; ++node_id)
+		{
+			is_node_lookup_correct &= (animation.GetNodeAnimation(node_id) == GetNodeAnimationLinear(animation, node_id));
+		}
+		JW_TEST_CHECK(is_node_lookup_correct);
+
+		// Every game tick of the clip, as JWSystemRender plays it
+		if (animation.AnimationTicksPerGameTick <= 0) { continue; }
+
+		VECTOR<float> frame_times{};
+		for (float time = 0; time < animation.TotalAnimationTicks; time += animation.AnimationTicksPerGameTick)
+		{
+			frame_times.emplace_back(time);
+		}
+		if (frame_times.empty()) { continue; }
+
+		VECTOR<SAnimationKeyCursor> cursors(node_count);
+		bool is_sampling_correct{ true };
+		for (auto time : frame_times)
+		{
+			is_sampling_correct &= (SampleClipCursor(animation, cursors, time) == SampleClipLinear(animation, node_count, time));
+		}
+		JW_TEST_CHECK(is_sampling_correct);
+
+		static constexpr uint32_t KRepeatCount{ 20 };
+		volatile uint32_t sink{};
+
+		auto linear_time = MeasureAverageTime(KRepeatCount, [&]()
+			{
+				for (auto time : frame_times) { sink += SampleClipLinear(animation, node_count, time); }
+			});
+
+		auto cursor_time = MeasureAverageTime(KRepeatCount, [&]()
+			{
+				for (auto time : frame_times) { sink += SampleClipCursor(animation, cursors, time); }
+			});
+
+		std::cout << "  " << animation.Name << " (" << frame_times.size() << " frames, " << animation.vNodeAnimation.size()
+			<< " animated nodes): linear " << linear_time << " us, cursor " << cursor_time << " us" << std::endl;
+	}
+}
+
+void JWEngine::TestAnimation() noexcept
+{
+	CheckKeySearch();
+	CheckEzrealClips();
+}
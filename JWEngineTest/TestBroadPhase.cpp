@@ -0,0 +1,156 @@
+#include "JWTest.h"
+#include "../ECS/JWBroadPhase.h"
+#include <random>
+
+using namespace JWEngine;
+
+static void FillProxies(JWBroadPhase& BroadPhase, const VECTOR<XMFLOAT4>& vSpheres) noexcept
+{
+	BroadPhase.BeginFrame();
+	for (ComponentIndexType iter = 0; iter < vSpheres.size(); ++iter)
+	{
+		const auto& sphere = vSpheres[iter];
+		BroadPhase.AddProxy(iter, XMVectorSet(sphere.x, sphere.y, sphere.z, 1.0f), sphere.w);
+	}
+}
+
+static void SortPairs(VECTOR<SCollisionPair>& vPairs) noexcept
+{
+	std::sort(vPairs.begin(), vPairs.end(),
+		[](const SCollisionPair& a, const SCollisionPair& b) { return (a.A != b.A) ? (a.A < b.A) : (a.B < b.B); });
+}
+
+static auto ArePairsEqual(const VECTOR<SCollisionPair>& vA, const VECTOR<SCollisionPair>& vB) noexcept->bool
+{
+	if (vA.size() != vB.size()) { return false; }
+	for (size_t iter = 0; iter < vA.size(); ++iter)
+	{
+		if ((vA[iter].A != vB[iter].A) || (vA[iter].B != vB[iter].B)) { return false; }
+	}
+	return true;
+}
+
+// Every broad phase must produce the same overlapping pairs on every frame while bodies move
+// (brute force is the reference up to 10k bodies), and pair generation cost is reported at 1k/10k/50k bodies.
+// Sweep-and-prune keeps its sorted list between frames, so the later frames check its insertion-sort path.
+void JWEngine::TestBroadPhase() noexcept
+{
+	static constexpr uint32_t KBodyCounts[]{ 1'000, 10'000, 50'000 };
+	static constexpr uint32_t KBruteForceMaxBodyCount{ 10'000 };
+	static constexpr uint32_t KLargeBodyCount{ 4 };
+	static constexpr uint32_t KFrameCount{ 8 };
+	static constexpr EBroadPhaseType KTypes[]{ EBroadPhaseType::BruteForce, EBroadPhaseType::SweepAndPrune, EBroadPhaseType::SpatialHash };
+	static constexpr const char* KTypeNames[]{ "BruteForce", "SweepAndPrune", "SpatialHash" };
+
+	std::mt19937 random{ 1 };
+	std::uniform_real_distribution<float> step{ -0.5f, 0.5f };
+
+	for (auto body_count : KBodyCounts)
+	{
+		// Keep the density constant (about 4 bodies per 10x10x10 volume).
+		auto half_extent = 0.5f * 10.0f * powf(static_cast<float>(body_count) / 4.0f, 1.0f / 3.0f);
+		std::uniform_real_distribution<float> position{ -half_extent, half_extent };
+		std::uniform_real_distribution<float> radius{ 0.5f, 2.0f };
+
+		// A few bodies are big enough to be kept out of the spatial hash's cells.
+		VECTOR<XMFLOAT4> spheres(body_count);
+		for (uint32_t iter = 0; iter < body_count; ++iter)
+		{
+			auto sphere_radius = (iter < KLargeBodyCount) ? 0.3f * half_extent : radius(random);
+			spheres[iter] = XMFLOAT4(position(random), position(random), position(random), sphere_radius);
+		}
+
+		JWBroadPhase broad_phases[3]{};
+		for (uint32_t type = 0; type < 3; ++type)
+		{
+			broad_phases[type].SetType(KTypes[type]);
+		}
+
+		bool are_pairs_equal{ true };
+		bool are_pairs_ordered{ true };
+		size_t pair_count{};
+		long long total_times[3]{};
+		for (uint32_t frame = 0; frame < KFrameCount; ++frame)
+		{
+			// Most bodies drift a little, every 16th one jumps across the world.
+			if (frame)
+			{
+				for (uint32_t iter = 0; iter < body_count; ++iter)
+				{
+					auto& sphere = spheres[iter];
+					if ((iter + frame) % 16 == 0)
+					{
+						sphere.x = position(random);
+						sphere.y = position(random);
+						sphere.z = position(random);
+					}
+					else
+					{
+						sphere.x += step(random);
+						sphere.y += step(random);
+						sphere.z += step(random);
+					}
+				}
+			}
+
+			VECTOR<SCollisionPair> reference_pairs{};
+			bool has_reference{ false };
+			for (uint32_t type = 0; type < 3; ++type)
+			{
+				if ((KTypes[type] == EBroadPhaseType::BruteForce) && (body_count > KBruteForceMaxBodyCount)) { continue; }
+
+				VECTOR<SCollisionPair> pairs{};
+				FillProxies(broad_phases[type], spheres);
+				broad_phases[type].GeneratePairs(pairs);
+				total_times[type] += broad_phases[type].GetPairGenerationTime();
+
+				for (const auto& pair : pairs)
+				{
+					are_pairs_ordered &= (pair.A < pair.B);
+				}
+
+				SortPairs(pairs);
+				if (!has_reference)
+				{
+					reference_pairs = std::move(pairs);
+					has_reference = true;
+				}
+				else
+				{
+					are_pairs_equal &= ArePairsEqual(pairs, reference_pairs);
+				}
+			}
+			pair_count = reference_pairs.size();
+		}
+		JW_TEST_CHECK(are_pairs_equal);
+		JW_TEST_CHECK(are_pairs_ordered);
+
+		for (uint32_t type = 0; type < 3; ++type)
+		{
+			if ((KTypes[type] == EBroadPhaseType::BruteForce) && (body_count > KBruteForceMaxBodyCount)) { continue; }
+
+			std::cout << "  " << body_count << " bodies, " << KTypeNames[type] << ": "
+				<< pair_count << " pairs (last frame), " << (total_times[type] / KFrameCount) << " us" << std::endl;
+		}
+	}
+
+	// Layers that don't collide produce no pair, and queries honor the same filter.
+	{
+		JWBroadPhase broad_phase{};
+		broad_phase.SetLayerCollision(0, 1, false);
+
+		broad_phase.BeginFrame();
+		broad_phase.AddProxy(0, XMVectorSet(0, 0, 0, 1), 1.0f, 0);
+		broad_phase.AddProxy(1, XMVectorSet(0.5f, 0, 0, 1), 1.0f, 1);
+		broad_phase.AddProxy(2, XMVectorSet(-0.5f, 0, 0, 1), 1.0f, 0);
+
+		VECTOR<SCollisionPair> pairs{};
+		broad_phase.GeneratePairs(pairs);
+		JW_TEST_CHECK((pairs.size() == 1) && (pairs[0].A == 0) && (pairs[0].B == 2));
+		JW_TEST_CHECK(broad_phase.GetFilteredPairCount() == 2);
+
+		VECTOR<ComponentIndexType> query{};
+		broad_phase.QueryAABB(XMFLOAT3(-4, -4, -4), XMFLOAT3(4, 4, 4), 1, query);
+		JW_TEST_CHECK((query.size() == 1) && (query[0] == 1));
+	}
+}
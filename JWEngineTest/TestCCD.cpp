@@ -0,0 +1,169 @@
+#include "JWTest.h"
+#include "../JWGame/JWGame.h"
+#include "../Core/JWNullGraphicsBackend.h"
+
+using namespace JWEngine;
+
+static JWGame* gs_pCCDGame{};
+
+JW_FUNCTION_ON_RENDER(OnCCDRender)
+{
+	gs_pCCDGame->ECS().ExecuteSystems();
+}
+
+// Flat terrain at y = 0, one node of (SizeX + 1) x (SizeZ + 1) vertices
+static auto MakeFlatTestTerrain(uint32_t Size) noexcept->STerrainData
+{
+	STerrainData terrain{};
+	terrain.TerrainSizeX = terrain.TerrainSizeZ = Size;
+	terrain.HeightFactor = 1.0f;
+	terrain.XYSizeFactor = 1.0f;
+	terrain.WholeBoundingSphere = SBoundingSphereData(Size * 0.75f, Size * 0.5f, 0.0f, -(Size * 0.5f));
+
+	terrain.QuadTree.emplace_back(0);
+	auto& node = terrain.QuadTree[0];
+	node.SizeX = node.SizeZ = Size;
+	node.HasMeshes = true;
+	for (uint32_t z = 0; z <= Size; ++z)
+	{
+		for (uint32_t x = 0; x <= Size; ++x)
+		{
+			node.VertexData.AddVertex(SVertexModel(static_cast<float>(x), 0.0f, -static_cast<float>(z),
+				static_cast<float>(x) / Size, static_cast<float>(z) / Size));
+		}
+	}
+
+	return terrain;
+}
+
+static auto CreateCCDTestBody(JWECS& ECS, JWModel* PtrBoxMesh, const XMVECTOR& Position, const XMVECTOR& Scaling) noexcept->JWEntity*
+{
+	auto body = ECS.CreateEntity("body_" + TO_STRING(ECS.GetEntityCount()));
+
+	auto transform = body->CreateComponentTransform();
+	transform->SetWorldMatrixCalculationOrder(EWorldMatrixCalculationOrder::ScaleRotTrans);
+	transform->SetPosition(Position);
+	transform->SetScalingFactor(Scaling);
+
+	auto physics = body->CreateComponentPhysics();
+	physics->BoundingSphere = SBoundingSphereData(XMVectorGetX(XMVector3Length(Scaling * 0.5f)));
+	physics->SetCollisionMesh(PtrBoxMesh);
+	physics->Restitution = 0;
+
+	return body;
+}
+
+// A small body falling at 60 m/s (a metre per step) is dropped onto a 2 cm thick collision mesh and onto a heightfield.
+// With CCD, both must be stopped at their time of impact (touching the surface) in the first step and never pass through.
+// Without CCD, the same step must carry the body through the thin mesh, which is what this guards against.
+void JWEngine::TestCCD() noexcept
+{
+	static constexpr uint32_t KStepCount{ 60 };
+	static constexpr uint32_t KTerrainSize{ 8 };
+	static constexpr float KPlateThickness{ 0.02f };
+	static constexpr float KDropHeight{ 0.7f };
+	static constexpr float KDropSpeed{ 60.0f };
+	static constexpr float KMaxTouchError{ 0.005f };
+
+	// @important: declared before the game so that it outlives the physics components that point to it.
+	auto terrain = MakeFlatTestTerrain(KTerrainSize);
+
+	JWNullGraphicsBackend backend{};
+	backend.SetPayloadRecording(false);
+
+	auto game = MAKE_UNIQUE(JWGame)();
+	gs_pCCDGame = game.get();
+
+	game->CreateHeadless(SSize2(800, 600), GetTestBaseDirectory(), &backend);
+	game->SetFunctionOnRender(OnCCDRender);
+
+	auto& ecs = game->ECS();
+	auto& system_render = ecs.SystemRender();
+	auto& system_physics = ecs.SystemPhysics();
+
+	{
+		auto camera_0 = ecs.CreateEntity("camera_0");
+		camera_0->CreateComponentTransform()->SetPosition(XMVectorSet(0.0f, 2.0f, -10.0f, 1.0f));
+		camera_0->CreateComponentCamera()->CreatePerspectiveCamera(ECameraType::FreeLook);
+	}
+
+	system_render.CreateSharedModelFromModelData(ESharedModelType::CollisionMesh, system_render.PrimitiveMaker().MakeCube(1.0f), "CM_box");
+	auto box_mesh = system_render.GetSharedModelByName("CM_box");
+
+	// Thin plate around the origin, its top face is at y = KPlateThickness / 2.
+	auto plate = CreateCCDTestBody(ecs, box_mesh, XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), XMVectorSet(4.0f, KPlateThickness, 4.0f, 0.0f));
+	plate->GetComponentPhysics()->SetMassToInfinite();
+
+	// Terrain centered at (20, 0, 0)
+	auto terrain_entity = ecs.CreateEntity("terrain");
+	{
+		terrain_entity->CreateComponentTransform()->SetPosition(XMVectorSet(20.0f - KTerrainSize * 0.5f, 0.0f, KTerrainSize * 0.5f, 1.0f));
+
+		auto physics = terrain_entity->CreateComponentPhysics();
+		physics->SetMassToInfinite();
+		physics->BoundingSphere = terrain.WholeBoundingSphere;
+		physics->SetHeightFieldCollider(&terrain);
+		physics->Restitution = 0;
+	}
+
+	static constexpr float KSurfaceYs[]{ KPlateThickness * 0.5f, 0.0f };
+	JWEntity* bodies[2]{
+		CreateCCDTestBody(ecs, box_mesh, XMVectorSet(0.3f, KDropHeight, -0.2f, 1.0f), XMVectorSet(0.1f, 0.1f, 0.1f, 0.0f)),
+		CreateCCDTestBody(ecs, box_mesh, XMVectorSet(20.3f, KDropHeight, -0.2f, 1.0f), XMVectorSet(0.1f, 0.1f, 0.1f, 0.0f)) };
+	for (auto body : bodies)
+	{
+		auto physics = body->GetComponentPhysics();
+		physics->SetMassByKilogram(0.1f);
+		physics->SetVelocity(XMVectorSet(0.0f, -KDropSpeed, 0.0f, 0.0f));
+		physics->IsCCDEnabled = true;
+	}
+
+	system_physics.SetDeterministicMode(true);
+	ecs.SystemTransform().Execute();
+
+	SPhysicsSnapshot snapshot{};
+	system_physics.SaveSnapshot(snapshot);
+
+	// #1 CCD
+	system_physics.ApplyUniversalGravity();
+	system_physics.Simulate(1);
+	JW_TEST_CHECK(system_physics.GetCCDHitCount() == 2);
+
+	float times_of_impact[2]{};
+	for (uint32_t iter = 0; iter < 2; ++iter)
+	{
+		auto physics = bodies[iter]->GetComponentPhysics();
+		auto y = XMVectorGetY(bodies[iter]->GetComponentTransform()->Position);
+		JW_TEST_CHECK(fabsf(y - (KSurfaceYs[iter] + physics->BoundingSphere.Radius)) < KMaxTouchError);
+
+		// The body moves by (velocity * dt * TOI) in the step it hits.
+		times_of_impact[iter] = (KDropHeight - y) / (KDropSpeed * system_physics.GetFixedDeltaTime());
+	}
+
+	bool is_above_surfaces{ true };
+	for (uint32_t step = 1; step < KStepCount; ++step)
+	{
+		system_physics.ApplyUniversalGravity();
+		system_physics.Simulate(1);
+
+		for (uint32_t iter = 0; iter < 2; ++iter)
+		{
+			is_above_surfaces &= (XMVectorGetY(bodies[iter]->GetComponentTransform()->Position) > KSurfaceYs[iter]);
+		}
+	}
+	JW_TEST_CHECK(is_above_surfaces);
+
+	// #2 Without CCD the thin plate is tunneled through.
+	JW_TEST_CHECK(system_physics.RestoreSnapshot(snapshot));
+	for (auto body : bodies)
+	{
+		body->GetComponentPhysics()->IsCCDEnabled = false;
+	}
+	system_physics.ApplyUniversalGravity();
+	system_physics.Simulate(1);
+	JW_TEST_CHECK(XMVectorGetY(bodies[0]->GetComponentTransform()->Position) < -KPlateThickness * 0.5f);
+
+	std::cout << "  time of impact: thin mesh " << times_of_impact[0] << ", heightfield " << times_of_impact[1] << std::endl;
+
+	game->RunHeadless(1, 16'666);
+}
@@ -0,0 +1,115 @@
+#include "JWTest.h"
+#include "../JWGame/JWGame.h"
+#include "../Core/JWNullGraphicsBackend.h"
+
+using namespace JWEngine;
+
+static JWGame* gs_pContactSolverGame{};
+
+JW_FUNCTION_ON_RENDER(OnContactSolverRender)
+{
+	gs_pContactSolverGame->ECS().ExecuteSystems();
+}
+
+static auto CreateStackBox(JWECS& ECS, JWModel* PtrBoxMesh, const XMVECTOR& Position, const XMVECTOR& Scaling) noexcept->JWEntity*
+{
+	auto box = ECS.CreateEntity("box_" + TO_STRING(ECS.GetEntityCount()));
+
+	auto transform = box->CreateComponentTransform();
+	transform->SetWorldMatrixCalculationOrder(EWorldMatrixCalculationOrder::ScaleRotTrans);
+	transform->SetPosition(Position);
+	transform->SetScalingFactor(Scaling);
+
+	auto physics = box->CreateComponentPhysics();
+	physics->BoundingSphere = SBoundingSphereData(XMVectorGetX(XMVector3Length(Scaling * 0.5f)));
+	physics->SetCollisionMesh(PtrBoxMesh);
+	physics->NarrowPhaseType = ENarrowPhaseType::GJK;
+	physics->Restitution = 0;
+
+	return box;
+}
+
+// Unit boxes are dropped onto a static floor from a small gap and must settle into a stack:
+// every box ends up on the one below (within the penetration slop), doesn't slide sideways
+// and stops moving. The time per step is reported.
+void JWEngine::TestContactSolver() noexcept
+{
+	static constexpr uint32_t KBoxCount{ 5 };
+	static constexpr uint32_t KSettleStepCount{ 600 };
+	static constexpr uint32_t KDriftStepCount{ 120 };
+	static constexpr float KGap{ 0.01f };
+	static constexpr float KMaxHeightError{ 0.05f };
+	static constexpr float KMaxDrift{ 0.01f };
+
+	JWNullGraphicsBackend backend{};
+	backend.SetPayloadRecording(false);
+
+	auto game = MAKE_UNIQUE(JWGame)();
+	gs_pContactSolverGame = game.get();
+
+	game->CreateHeadless(SSize2(800, 600), GetTestBaseDirectory(), &backend);
+	game->SetFunctionOnRender(OnContactSolverRender);
+
+	auto& ecs = game->ECS();
+	auto& system_render = ecs.SystemRender();
+	auto& system_physics = ecs.SystemPhysics();
+
+	{
+		auto camera_0 = ecs.CreateEntity("camera_0");
+		camera_0->CreateComponentTransform()->SetPosition(XMVectorSet(0.0f, 2.0f, -10.0f, 1.0f));
+		camera_0->CreateComponentCamera()->CreatePerspectiveCamera(ECameraType::FreeLook);
+	}
+
+	system_render.CreateSharedModelFromModelData(ESharedModelType::CollisionMesh, system_render.PrimitiveMaker().MakeCube(1.0f), "CM_box");
+	auto box_mesh = system_render.GetSharedModelByName("CM_box");
+
+	// The floor's top face is at y = 0.
+	auto floor = CreateStackBox(ecs, box_mesh, XMVectorSet(0.0f, -0.5f, 0.0f, 1.0f), XMVectorSet(20.0f, 1.0f, 20.0f, 0.0f));
+	floor->GetComponentPhysics()->SetMassToInfinite();
+
+	VECTOR<JWEntity*> boxes{};
+	for (uint32_t iter = 0; iter < KBoxCount; ++iter)
+	{
+		auto y = 0.5f + iter * (1.0f + KGap) + KGap;
+		boxes.emplace_back(CreateStackBox(ecs, box_mesh, XMVectorSet(0.0f, y, 0.0f, 1.0f), XMVectorSet(1.0f, 1.0f, 1.0f, 0.0f)));
+		boxes.back()->GetComponentPhysics()->SetMassByKilogram(1.0f);
+	}
+
+	system_physics.SetDeterministicMode(true);
+	ecs.SystemTransform().Execute();
+
+	VECTOR<XMVECTOR> settled_positions(KBoxCount);
+	auto start_time = STEADY_CLOCK::now();
+	for (uint32_t step = 0; step < KSettleStepCount; ++step)
+	{
+		if (step == KSettleStepCount - KDriftStepCount)
+		{
+			for (uint32_t iter = 0; iter < KBoxCount; ++iter)
+			{
+				settled_positions[iter] = boxes[iter]->GetComponentTransform()->Position;
+			}
+		}
+
+		system_physics.ApplyUniversalGravity();
+		system_physics.Simulate(1);
+	}
+	auto step_time = std::chrono::duration_cast<TIME_UNIT_mS>(STEADY_CLOCK::now() - start_time).count() / KSettleStepCount;
+
+	bool is_stacked{ true };
+	bool is_drift_free{ true };
+	for (uint32_t iter = 0; iter < KBoxCount; ++iter)
+	{
+		const auto& position = boxes[iter]->GetComponentTransform()->Position;
+
+		is_stacked &= (fabsf(XMVectorGetY(position) - (0.5f + iter)) < KMaxHeightError);
+		is_drift_free &= (fabsf(XMVectorGetX(position)) < KMaxDrift) && (fabsf(XMVectorGetZ(position)) < KMaxDrift);
+		is_drift_free &= (XMVectorGetX(XMVector3Length(position - settled_positions[iter])) < KMaxDrift);
+	}
+	JW_TEST_CHECK(is_stacked);
+	JW_TEST_CHECK(is_drift_free);
+
+	std::cout << "  " << KBoxCount << " stacked boxes, " << KSettleStepCount << " steps: " << step_time << " us/step, "
+		<< system_physics.GetSleepingBodyCount() << " sleeping" << std::endl;
+
+	game->RunHeadless(1, 16'666);
+}
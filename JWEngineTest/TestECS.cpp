@@ -0,0 +1,125 @@
+#include "JWTest.h"
+#include "../JWGame/JWGame.h"
+#include "../Core/JWNullGraphicsBackend.h"
+
+using namespace JWEngine;
+
+static JWGame* gs_pECSGame{};
+
+JW_FUNCTION_ON_RENDER(OnECSRender)
+{
+	gs_pECSGame->ECS().ExecuteSystems();
+}
+
+// A handle must become stale when its entity is destroyed, and stay stale after the slot is reused.
+// 100k entities are created, destroyed and created again (reusing the freed slots), and the times are reported.
+void JWEngine::TestECS() noexcept
+{
+	static constexpr uint32_t KEntityCount{ 100'000 };
+
+	JWNullGraphicsBackend backend{};
+	backend.SetPayloadRecording(false);
+
+	auto game = MAKE_UNIQUE(JWGame)();
+	gs_pECSGame = game.get();
+
+	game->CreateHeadless(SSize2(800, 600), GetTestBaseDirectory(), &backend);
+	game->SetFunctionOnRender(OnECSRender);
+
+	auto& ecs = game->ECS();
+
+	{
+		auto camera_0 = ecs.CreateEntity("camera_0");
+		camera_0->CreateComponentTransform()->SetPosition(XMVectorSet(0.0f, 0.0f, -10.0f, 1.0f));
+		camera_0->CreateComponentCamera()->CreatePerspectiveCamera(ECameraType::FreeLook);
+	}
+
+	auto base_entity_count = ecs.GetEntityCount();
+
+	// #1 Stale handles
+	{
+		auto stale_handle = ecs.CreateEntity("stale")->GetEntityHandle();
+		JW_TEST_CHECK(ecs.IsEntityHandleValid(stale_handle));
+
+		ecs.DestroyEntityByHandle(stale_handle);
+		JW_TEST_CHECK(!ecs.IsEntityHandleValid(stale_handle));
+		JW_TEST_CHECK(ecs.GetEntityByHandle(stale_handle) == nullptr);
+
+		// The freed slot is reused with the next generation.
+		auto reused = ecs.CreateEntity("reused");
+		auto reused_handle = reused->GetEntityHandle();
+		JW_TEST_CHECK(GetEntityHandleIndex(reused_handle) == GetEntityHandleIndex(stale_handle));
+		JW_TEST_CHECK(reused_handle != stale_handle);
+		JW_TEST_CHECK(!ecs.IsEntityHandleValid(stale_handle));
+		JW_TEST_CHECK(ecs.GetEntityByHandle(stale_handle) == nullptr);
+		JW_TEST_CHECK(ecs.GetEntityByHandle(reused_handle) == reused);
+
+		// Destroying through the stale handle must not destroy the new entity.
+		ecs.DestroyEntityByHandle(stale_handle);
+		JW_TEST_CHECK(ecs.IsEntityHandleValid(reused_handle));
+		JW_TEST_CHECK(ecs.GetEntityByName("reused") == reused);
+
+		ecs.DestroyEntityByHandle(reused_handle);
+		JW_TEST_CHECK(ecs.GetEntityCount() == base_entity_count);
+	}
+
+	// #2 Create/destroy cycles
+	VECTOR<EntityHandleType> first_handles(KEntityCount);
+	VECTOR<EntityHandleType> second_handles(KEntityCount);
+	long long times[3]{};
+
+	auto create_entities = [&](VECTOR<EntityHandleType>& OutHandles)
+	{
+		auto start_time = STEADY_CLOCK::now();
+		for (uint32_t iter = 0; iter < KEntityCount; ++iter)
+		{
+			OutHandles[iter] = ecs.CreateEntity("entity_" + TO_STRING(iter))->GetEntityHandle();
+		}
+		return std::chrono::duration_cast<TIME_UNIT_mS>(STEADY_CLOCK::now() - start_time).count();
+	};
+
+	times[0] = create_entities(first_handles);
+	JW_TEST_CHECK(ecs.GetEntityCount() == base_entity_count + KEntityCount);
+
+	auto destroy_start_time = STEADY_CLOCK::now();
+	for (auto handle : first_handles)
+	{
+		ecs.DestroyEntityByHandle(handle);
+	}
+	times[1] = std::chrono::duration_cast<TIME_UNIT_mS>(STEADY_CLOCK::now() - destroy_start_time).count();
+	JW_TEST_CHECK(ecs.GetEntityCount() == base_entity_count);
+
+	times[2] = create_entities(second_handles);
+	JW_TEST_CHECK(ecs.GetEntityCount() == base_entity_count + KEntityCount);
+
+	// Every slot was reused, so no index goes past the first cycle's, and every old handle is stale.
+	EntityIndexType max_first_index{};
+	for (auto handle : first_handles)
+	{
+		max_first_index = max(max_first_index, GetEntityHandleIndex(handle));
+	}
+
+	bool are_old_handles_stale{ true };
+	bool are_slots_reused{ true };
+	bool are_new_handles_valid{ true };
+	for (uint32_t iter = 0; iter < KEntityCount; ++iter)
+	{
+		are_old_handles_stale &= (ecs.GetEntityByHandle(first_handles[iter]) == nullptr);
+		are_slots_reused &= (GetEntityHandleIndex(second_handles[iter]) <= max_first_index);
+		auto entity = ecs.GetEntityByHandle(second_handles[iter]);
+		are_new_handles_valid &= (entity != nullptr) && (entity == ecs.GetEntityByName("entity_" + TO_STRING(iter)));
+	}
+	JW_TEST_CHECK(are_old_handles_stale);
+	JW_TEST_CHECK(are_slots_reused);
+	JW_TEST_CHECK(are_new_handles_valid);
+
+	for (auto handle : second_handles)
+	{
+		ecs.DestroyEntityByHandle(handle);
+	}
+
+	std::cout << "  " << KEntityCount << " entities: create " << times[0] << " us, destroy " << times[1]
+		<< " us, create into freed slots " << times[2] << " us" << std::endl;
+
+	game->RunHeadless(1, 16'666);
+}
@@ -0,0 +1,111 @@
+#include "JWTest.h"
+#include "../ECS/JWFrustumCuller.h"
+#include <random>
+
+using namespace JWEngine;
+
+// Reference: one sphere at a time against the six planes
+// (same operation order as the batch, so spheres touching a plane get the same result)
+static auto IsSphereVisibleScalar(const XMFLOAT4* Planes, const XMFLOAT3& Center, float Radius) noexcept->bool
+{
+	for (uint32_t plane = 0; plane < KFrustumPlaneCount; ++plane)
+	{
+		const auto& p = Planes[plane];
+		if (Center.x * p.x + Center.y * p.y + Center.z * p.z + p.w < -Radius) { return false; }
+	}
+	return true;
+}
+
+// The SoA batch must give every sphere the same visibility as the per-sphere test
+// (also for counts that aren't a multiple of KCullingLaneCount), and both are timed in spheres per millisecond.
+void JWEngine::TestFrustumCuller() noexcept
+{
+	static constexpr uint32_t KSphereCounts[]{ 1, 3, 5, 1'000, 100'003 };
+	static constexpr uint32_t KCameraCount{ 8 };
+	static constexpr float KWorldHalfExtent{ 100.0f };
+
+	std::mt19937 random{ 1 };
+	std::uniform_real_distribution<float> position{ -KWorldHalfExtent, KWorldHalfExtent };
+	std::uniform_real_distribution<float> radius{ 0.1f, 5.0f };
+	std::uniform_real_distribution<float> angle{ -XM_PI, XM_PI };
+
+	auto projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, 150.0f);
+
+	JWFrustumCuller culler{};
+
+	for (auto sphere_count : KSphereCounts)
+	{
+		VECTOR<XMFLOAT3> centers(sphere_count);
+		VECTOR<float> radii(sphere_count);
+		for (uint32_t iter = 0; iter < sphere_count; ++iter)
+		{
+			centers[iter] = XMFLOAT3(position(random), position(random), position(random));
+			radii[iter] = radius(random);
+		}
+
+		bool is_correct{ true };
+		long long cull_time{};
+		double scalar_time{};
+		uint32_t visible_count{};
+
+		for (uint32_t camera = 0; camera < KCameraCount; ++camera)
+		{
+			auto view = XMMatrixInverse(nullptr, XMMatrixRotationRollPitchYaw(angle(random), angle(random), 0) *
+				XMMatrixTranslation(position(random), position(random), position(random)));
+
+			XMVECTOR planes[KFrustumPlaneCount]{};
+			ExtractFrustumPlanes(view * projection, planes);
+
+			XMFLOAT4 scalar_planes[KFrustumPlaneCount]{};
+			for (uint32_t plane = 0; plane < KFrustumPlaneCount; ++plane)
+			{
+				XMStoreFloat4(&scalar_planes[plane], planes[plane]);
+			}
+
+			culler.SetPlanes(planes);
+			culler.ClearSpheres();
+			for (uint32_t iter = 0; iter < sphere_count; ++iter)
+			{
+				is_correct &= (culler.AddSphere(XMLoadFloat3(&centers[iter]), radii[iter]) == iter);
+			}
+			culler.Cull();
+			cull_time += culler.GetLastCullTime();
+
+			VECTOR<uint8_t> scalar_visibility(sphere_count);
+			scalar_time += MeasureAverageTime(1, [&]()
+				{
+					for (uint32_t iter = 0; iter < sphere_count; ++iter)
+					{
+						scalar_visibility[iter] = IsSphereVisibleScalar(scalar_planes, centers[iter], radii[iter]) ? 1 : 0;
+					}
+				});
+
+			uint32_t scalar_visible_count{};
+			for (uint32_t iter = 0; iter < sphere_count; ++iter)
+			{
+				is_correct &= (culler.IsVisible(iter) == (scalar_visibility[iter] != 0));
+				scalar_visible_count += scalar_visibility[iter];
+			}
+			is_correct &= (culler.GetVisibleSphereCount() == scalar_visible_count);
+			visible_count += scalar_visible_count;
+
+			// Invalid IDs (and IDs past the last sphere) are always visible.
+			is_correct &= culler.IsVisible(KInvalidCullingSphereID);
+			is_correct &= culler.IsVisible(sphere_count);
+		}
+
+		JW_TEST_CHECK(is_correct);
+		JW_TEST_CHECK(culler.GetSphereCount() == sphere_count);
+
+		if (sphere_count >= 1'000)
+		{
+			JW_TEST_CHECK(visible_count > 0);
+			JW_TEST_CHECK(visible_count < sphere_count * KCameraCount);
+
+			auto total_sphere_count = static_cast<double>(sphere_count) * KCameraCount;
+			std::cout << "  " << sphere_count << " spheres x " << KCameraCount << " cameras: batch "
+				<< static_cast<uint64_t>(total_sphere_count / (max(cull_time, 1ll) / 1000.0)) << " spheres/ms, per sphere "
+				<< static_cast<uint64_t>(total_sphere_count / (max(scalar_time, 1.0) / 1000.0)) << " spheres/ms" << std::endl;
+		}
+	}
+}
@@ -0,0 +1,84 @@
+#include "JWTest.h"
+#include "../JWGame/JWGame.h"
+#include "../Core/JWNullGraphicsBackend.h"
+
+using namespace JWEngine;
+
+static JWGame* gs_pHeadlessGame{};
+
+JW_FUNCTION_ON_RENDER(OnHeadlessRender)
+{
+	gs_pHeadlessGame->ECS().ExecuteSystems();
+}
+
+// Drives one frame of a headless game (camera + lit box) through JWNullGraphicsBackend.
+void JWEngine::TestNullGraphicsBackend() noexcept
+{
+	JWNullGraphicsBackend backend{};
+	backend.SetPayloadRecording(false);
+
+	auto game = MAKE_UNIQUE(JWGame)();
+	gs_pHeadlessGame = game.get();
+
+	game->CreateHeadless(SSize2(800, 600), GetTestBaseDirectory(), &backend);
+	game->SetFunctionOnRender(OnHeadlessRender);
+
+	auto& ecs = game->ECS();
+	ecs.SystemRender().CreateSharedModelFromModelData(ESharedModelType::StaticModel,
+		ecs.SystemRender().PrimitiveMaker().MakeCube(1.0f), "box");
+
+	{
+		auto camera_0 = ecs.CreateEntity("camera_0");
+
+		auto transform = camera_0->CreateComponentTransform();
+		transform->SetPosition(XMVectorSet(0.0f, 0.0f, -10.0f, 1.0f));
+
+		auto camera = camera_0->CreateComponentCamera();
+		camera->CreatePerspectiveCamera(ECameraType::FreeLook);
+	}
+
+	{
+		auto box = ecs.CreateEntity("box");
+
+		auto transform = box->CreateComponentTransform();
+		transform->SetPosition(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f));
+
+		auto render = box->CreateComponentRender();
+		render->SetModel(ecs.SystemRender().GetSharedModelByName("box"));
+	}
+
+	game->RunHeadless(1, 16'666);
+
+	const auto& counters = backend.GetCounters();
+	JW_TEST_CHECK(counters.FrameCount == 1);
+	JW_TEST_CHECK(counters.DrawCallCount > 0);
+	JW_TEST_CHECK(counters.BufferCreationCount > 0);
+
+	// Every created buffer has its own non-null handle and ID.
+	VECTOR<const void*> handles{};
+	VECTOR<uint32_t> ids{};
+	for (const auto& command : backend.GetCommands())
+	{
+		if (command.Type != EGraphicsCommandType::CreateBuffer) { continue; }
+
+		JW_TEST_CHECK(command.Handle != nullptr);
+		JW_TEST_CHECK(command.Value != 0);
+
+		handles.emplace_back(command.Handle);
+		ids.emplace_back(command.Value);
+	}
+	JW_TEST_CHECK(handles.size() == counters.BufferCreationCount);
+
+	std::sort(ids.begin(), ids.end());
+	JW_TEST_CHECK(std::adjacent_find(ids.begin(), ids.end()) == ids.end());
+
+	// Handles are compared while they are alive (RunHeadless() released them).
+	ID3D11Buffer* buffer_a{};
+	ID3D11Buffer* buffer_b{};
+	backend.CreateBuffer(EGraphicsBufferType::StaticVertex, 16, nullptr, &buffer_a);
+	backend.CreateBuffer(EGraphicsBufferType::StaticVertex, 16, nullptr, &buffer_b);
+	JW_TEST_CHECK((buffer_a) && (buffer_b) && (buffer_a != buffer_b));
+	JW_TEST_CHECK(JWNullGraphicsBackend::GetBufferID(buffer_a) != JWNullGraphicsBackend::GetBufferID(buffer_b));
+	JW_RELEASE(buffer_a);
+	JW_RELEASE(buffer_b);
+}
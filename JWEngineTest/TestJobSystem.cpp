@@ -0,0 +1,169 @@
+#include "JWTest.h"
+#include "../Core/JWJobSystem.h"
+#include "../JWGame/JWGame.h"
+#include "../Core/JWNullGraphicsBackend.h"
+
+using namespace JWEngine;
+
+static JWGame* gs_pJobSystemGame{};
+
+JW_FUNCTION_ON_RENDER(OnJobSystemRender)
+{
+	gs_pJobSystemGame->ECS().ExecuteSystems();
+}
+
+// Every index of [0, Count) must be visited exactly once.
+static auto IsParallelForCovering(JWJobSystem& JobSystem, uint32_t Count, uint32_t MinChunkSize) noexcept->bool
+{
+	VECTOR<std::atomic<uint32_t>> visit_counts(Count);
+	JobSystem.ParallelFor(Count, MinChunkSize, [&](uint32_t Begin, uint32_t End)
+		{
+			for (uint32_t iter = Begin; iter < End; ++iter) { ++visit_counts[iter]; }
+		});
+
+	for (const auto& iter : visit_counts)
+	{
+		if (iter.load() != 1) { return false; }
+	}
+	return true;
+}
+
+// Jobs that spawn and wait for their own jobs (as systems calling ParallelFor() do)
+static auto RunNestedJobs(JWJobSystem& JobSystem, uint32_t OuterCount, uint32_t InnerCount) noexcept->uint32_t
+{
+	std::atomic<uint32_t> executed_count{};
+
+	SJobCounter outer_counter{};
+	for (uint32_t outer = 0; outer < OuterCount; ++outer)
+	{
+		JobSystem.Run([&]()
+			{
+				SJobCounter inner_counter{};
+				for (uint32_t inner = 0; inner < InnerCount; ++inner)
+				{
+					JobSystem.Run([&]() { ++executed_count; }, inner_counter);
+				}
+				JobSystem.Wait(inner_counter);
+			}, outer_counter);
+	}
+	JobSystem.Wait(outer_counter);
+
+	JW_TEST_CHECK(outer_counter.Count.load() == 0);
+	return executed_count.load();
+}
+
+static void CheckScheduler() noexcept
+{
+	static constexpr uint32_t KCounts[]{ 0, 1, 63, 64, 65, 1'000, 100'000 };
+
+	// Not created (inline), no workers, one worker, every hardware thread
+	JWJobSystem inline_job_system{};
+	JW_TEST_CHECK(IsParallelForCovering(inline_job_system, 1'000, 16));
+	JW_TEST_CHECK(RunNestedJobs(inline_job_system, 8, 8) == 64);
+
+	for (auto worker_count : { 0u, 1u, KJobSystemAutoWorkerCount })
+	{
+		JWJobSystem job_system{};
+		job_system.Create(worker_count);
+
+		for (auto count : KCounts)
+		{
+			JW_TEST_CHECK(IsParallelForCovering(job_system, count, 1));
+			JW_TEST_CHECK(IsParallelForCovering(job_system, count, KJobSystemDefaultMinChunkSize));
+		}
+
+		JW_TEST_CHECK(RunNestedJobs(job_system, 64, 64) == 64 * 64);
+
+		job_system.Destroy();
+		JW_TEST_CHECK(!job_system.IsCreated());
+	}
+}
+
+// A transform-like loop run serially and with ParallelFor() on every hardware thread
+static void MeasureParallelFor() noexcept
+{
+	static constexpr uint32_t KMatrixCount{ 200'000 };
+	static constexpr uint32_t KRepeatCount{ 10 };
+
+	VECTOR<XMFLOAT4X4> matrices(KMatrixCount);
+	auto build = [&](uint32_t Begin, uint32_t End)
+	{
+		for (uint32_t iter = Begin; iter < End; ++iter)
+		{
+			auto f = static_cast<float>(iter);
+			XMStoreFloat4x4(&matrices[iter], XMMatrixScaling(1.0f, 2.0f, 3.0f) * XMMatrixRotationRollPitchYaw(f, f * 0.5f, f * 0.25f)
+				* XMMatrixTranslation(f, -f, f));
+		}
+	};
+
+	JWJobSystem job_system{};
+	job_system.Create();
+
+	auto serial_time = MeasureAverageTime(KRepeatCount, [&]() { build(0, KMatrixCount); });
+	auto parallel_time = MeasureAverageTime(KRepeatCount, [&]() { job_system.ParallelFor(KMatrixCount, KJobSystemDefaultMinChunkSize, build); });
+
+	std::cout << "  " << KMatrixCount << " matrices, " << (job_system.GetWorkerThreadCount() + 1) << " threads: serial "
+		<< serial_time << " us, ParallelFor " << parallel_time << " us" << std::endl;
+}
+
+// Conflicting systems must be on different levels, and a headless frame must run every level.
+static void CheckExecutionLevels() noexcept
+{
+	static constexpr uint32_t KBoxCount{ 2'000 };
+
+	JWNullGraphicsBackend backend{};
+	backend.SetPayloadRecording(false);
+
+	auto game = MAKE_UNIQUE(JWGame)();
+	gs_pJobSystemGame = game.get();
+
+	game->CreateHeadless(SSize2(800, 600), GetTestBaseDirectory(), &backend);
+	game->SetFunctionOnRender(OnJobSystemRender);
+
+	auto& ecs = game->ECS();
+
+	const auto& nodes = ecs.GetSystemExecutionNodes();
+	JW_TEST_CHECK(ecs.GetExecutionLevelCount() >= 1);
+	JW_TEST_CHECK(ecs.GetExecutionLevelCount() < nodes.size());
+
+	for (size_t i = 0; i < nodes.size(); ++i)
+	{
+		for (size_t j = i + 1; j < nodes.size(); ++j)
+		{
+			bool is_conflicting{
+				((nodes[j].Write & (nodes[i].Read | nodes[i].Write)) != 0) ||
+				((nodes[j].Read & nodes[i].Write) != 0) };
+
+			if (is_conflicting) { JW_TEST_CHECK(nodes[j].Level > nodes[i].Level); }
+		}
+	}
+
+	ecs.SystemRender().CreateSharedModelFromModelData(ESharedModelType::StaticModel,
+		ecs.SystemRender().PrimitiveMaker().MakeCube(1.0f), "box");
+
+	{
+		auto camera_0 = ecs.CreateEntity("camera_0");
+		camera_0->CreateComponentTransform()->SetPosition(XMVectorSet(0.0f, 0.0f, -50.0f, 1.0f));
+		camera_0->CreateComponentCamera()->CreatePerspectiveCamera(ECameraType::FreeLook);
+	}
+
+	for (uint32_t iter = 0; iter < KBoxCount; ++iter)
+	{
+		auto box = ecs.CreateEntity("box_" + TO_STRING(iter));
+		box->CreateComponentTransform()->SetPosition(
+			XMVectorSet(static_cast<float>(iter % 50) - 25.0f, static_cast<float>(iter / 50) - 20.0f, 0.0f, 1.0f));
+		box->CreateComponentRender()->SetModel(ecs.SystemRender().GetSharedModelByName("box"));
+	}
+
+	game->RunHeadless(2, 16'666);
+
+	JW_TEST_CHECK(backend.GetCounters().FrameCount == 2);
+	JW_TEST_CHECK(backend.GetCounters().DrawCallCount > 0);
+}
+
+void JWEngine::TestJobSystem() noexcept
+{
+	CheckScheduler();
+	MeasureParallelFor();
+	CheckExecutionLevels();
+}
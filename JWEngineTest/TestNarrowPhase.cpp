@@ -0,0 +1,274 @@
+#include "JWTest.h"
+#include "../JWGame/JWGame.h"
+#include "../Core/JWNullGraphicsBackend.h"
+#include <random>
+
+using namespace JWEngine;
+
+static JWGame* gs_pNarrowPhaseGame{};
+
+JW_FUNCTION_ON_RENDER(OnNarrowPhaseRender)
+{
+	gs_pNarrowPhaseGame->ECS().ExecuteSystems();
+}
+
+struct SNarrowPhaseTestMesh
+{
+	JWModel*	PtrModel{};
+	XMFLOAT3	Min{};
+	XMFLOAT3	Max{};
+	XMVECTOR	Centroid{};
+	float		Radius{};
+
+	// Scales the mesh to about 1 unit
+	float		Scale{};
+};
+
+struct SNarrowPhaseTestContact
+{
+	EntityHandleType	A{};
+	EntityHandleType	B{};
+	float				PenetrationDepth{};
+};
+
+static auto MakeTestMesh(JWModel* PtrModel) noexcept->SNarrowPhaseTestMesh
+{
+	SNarrowPhaseTestMesh result{};
+	result.PtrModel = PtrModel;
+
+	auto min_vertex = XMVectorReplicate(FLT_MAX);
+	auto max_vertex = XMVectorReplicate(-FLT_MAX);
+	auto sum = KVectorZero;
+	for (const auto& iter : PtrModel->vPositionVertex)
+	{
+		min_vertex = XMVectorMin(min_vertex, iter);
+		max_vertex = XMVectorMax(max_vertex, iter);
+		sum = XMVectorAdd(sum, iter);
+		result.Radius = max(result.Radius, XMVectorGetX(XMVector3Length(iter)));
+	}
+	XMStoreFloat3(&result.Min, min_vertex);
+	XMStoreFloat3(&result.Max, max_vertex);
+	result.Centroid = XMVectorSetW(sum / static_cast<float>(PtrModel->vPositionVertex.size()), 1.0f);
+
+	auto extents = max_vertex - min_vertex;
+	result.Scale = 1.0f / max(XMVectorGetX(extents), max(XMVectorGetY(extents), XMVectorGetZ(extents)));
+
+	return result;
+}
+
+static void CreateTestBody(JWECS& ECS, const SNarrowPhaseTestMesh& Mesh, const XMVECTOR& Position, float Pitch) noexcept
+{
+	auto body = ECS.CreateEntity("body_" + TO_STRING(ECS.GetEntityCount()));
+
+	auto transform = body->CreateComponentTransform();
+	transform->SetWorldMatrixCalculationOrder(EWorldMatrixCalculationOrder::ScaleRotTrans);
+	transform->SetPosition(Position);
+	transform->SetScalingFactor(XMVectorSet(Mesh.Scale, Mesh.Scale, Mesh.Scale, 0.0f));
+	transform->SetPitchYawRoll(Pitch, 0, 0);
+
+	// The sphere is around the local origin, so it bounds the mesh in any orientation.
+	auto physics = body->CreateComponentPhysics();
+	physics->BoundingSphere = SBoundingSphereData(Mesh.Radius * Mesh.Scale);
+	physics->SetMassByKilogram(1.0f);
+	physics->SetCollisionMesh(Mesh.PtrModel);
+}
+
+static void SetNarrowPhase(JWSystemPhysics& SystemPhysics, ENarrowPhaseType Type, ESupportMappingType SupportMapping) noexcept
+{
+	for (auto& iter : SystemPhysics.ComponentPool())
+	{
+		iter.NarrowPhaseType = Type;
+		iter.SupportMappingType = SupportMapping;
+	}
+}
+
+// Colliding pairs of the last step, one per pair (deepest contact), sorted by entity handles
+static auto GetTestContacts(const JWSystemPhysics& SystemPhysics) noexcept->VECTOR<SNarrowPhaseTestContact>
+{
+	VECTOR<SNarrowPhaseTestContact> result{};
+	for (const auto& iter : SystemPhysics.GetFineCollisionList())
+	{
+		result.push_back({ min(iter.EntityA, iter.EntityB), max(iter.EntityA, iter.EntityB), iter.PenetrationDepth });
+	}
+
+	std::sort(result.begin(), result.end(), [](const SNarrowPhaseTestContact& a, const SNarrowPhaseTestContact& b)
+		{
+			if (a.A != b.A) { return a.A < b.A; }
+			if (a.B != b.B) { return a.B < b.B; }
+			return a.PenetrationDepth > b.PenetrationDepth;
+		});
+
+	result.erase(std::unique(result.begin(), result.end(), [](const SNarrowPhaseTestContact& a, const SNarrowPhaseTestContact& b)
+		{
+			return (a.A == b.A) && (a.B == b.B);
+		}), result.end());
+
+	return result;
+}
+
+static auto AreContactPairsEqual(const VECTOR<SNarrowPhaseTestContact>& vA, const VECTOR<SNarrowPhaseTestContact>& vB) noexcept->bool
+{
+	if (vA.size() != vB.size()) { return false; }
+	for (size_t iter = 0; iter < vA.size(); ++iter)
+	{
+		if ((vA[iter].A != vB[iter].A) || (vA[iter].B != vB[iter].B)) { return false; }
+	}
+	return true;
+}
+
+// Octahedron around the origin, its top vertex is pushed below the equator (a dent) if TopY < 0.
+static void MakeTestOctahedron(float TopY, JWModel& OutModel) noexcept
+{
+	OutModel.vPositionVertex = { XMVectorSet(1, 0, 0, 1), XMVectorSet(0, 0, 1, 1), XMVectorSet(-1, 0, 0, 1), XMVectorSet(0, 0, -1, 1),
+		XMVectorSet(0, TopY, 0, 1), XMVectorSet(0, -1, 0, 1) };
+	OutModel.vPositionVertexIndexFromVertexIndex = { 0, 1, 2, 3, 4, 5 };
+
+	auto& faces = OutModel.ModelData.IndexData.vFaces;
+	faces.clear();
+	for (DWORD iter = 0; iter < 4; ++iter)
+	{
+		faces.emplace_back(4, iter, (iter + 1) % 4);
+		faces.emplace_back(5, (iter + 1) % 4, iter);
+	}
+}
+
+// Every pair of shipped collision meshes is placed once overlapping (centroids coincide) and once apart
+// (a gap along x, which pitch doesn't change). FaceSearch, GJK with brute-force support mapping and GJK with
+// hill climbing must find the same colliding pairs, and their fine collision times are reported.
+// A dented mesh must fail the convexity check of hill climbing.
+void JWEngine::TestNarrowPhase() noexcept
+{
+	static constexpr const char* KCollisionMeshFileNames[]{ "jar_cm.mobj", "oil_drum_cm.mobj", "recycling_bin_cm.mobj", "simple_box.mobj" };
+	static constexpr uint32_t KCopyCount{ 4 };
+	static constexpr uint32_t KRepeatCount{ 10 };
+	static constexpr float KPairSpacing{ 8.0f };
+	static constexpr float KGap{ 0.05f };
+	static constexpr float KMaxDepthDifference{ 0.001f };
+
+	JWNullGraphicsBackend backend{};
+	backend.SetPayloadRecording(false);
+
+	auto game = MAKE_UNIQUE(JWGame)();
+	gs_pNarrowPhaseGame = game.get();
+
+	game->CreateHeadless(SSize2(800, 600), GetTestBaseDirectory(), &backend);
+	game->SetFunctionOnRender(OnNarrowPhaseRender);
+
+	auto& ecs = game->ECS();
+	auto& system_render = ecs.SystemRender();
+	auto& system_physics = ecs.SystemPhysics();
+
+	{
+		auto camera_0 = ecs.CreateEntity("camera_0");
+		camera_0->CreateComponentTransform()->SetPosition(XMVectorSet(0.0f, 0.0f, -10.0f, 1.0f));
+		camera_0->CreateComponentCamera()->CreatePerspectiveCamera(ECameraType::FreeLook);
+	}
+
+	VECTOR<SNarrowPhaseTestMesh> meshes{};
+	system_render.CreateSharedModelFromModelData(ESharedModelType::CollisionMesh, system_render.PrimitiveMaker().MakeCube(1.0f), "CM_box");
+	meshes.emplace_back(MakeTestMesh(system_render.GetSharedModelByName("CM_box")));
+	for (auto file_name : KCollisionMeshFileNames)
+	{
+		system_render.CreateSharedModelFromFile(ESharedModelType::CollisionMesh, file_name, file_name);
+		meshes.emplace_back(MakeTestMesh(system_render.GetSharedModelByName(file_name)));
+	}
+
+	std::mt19937 random{ 1 };
+	std::uniform_real_distribution<float> pitch{ -XM_PI, XM_PI };
+
+	uint32_t overlapping_pair_count{};
+	float slot_x{};
+	for (uint32_t copy = 0; copy < KCopyCount; ++copy)
+	{
+		for (const auto& a : meshes)
+		{
+			for (const auto& b : meshes)
+			{
+				auto pitch_a = pitch(random);
+				auto pitch_b = pitch(random);
+
+				// Overlapping: the same point is the (interior) centroid of both meshes.
+				auto center = XMVectorSet(slot_x, 0.0f, 0.0f, 1.0f);
+				auto a_centroid = XMVector3Transform(a.Centroid, XMMatrixScaling(a.Scale, a.Scale, a.Scale) * XMMatrixRotationX(pitch_a));
+				auto b_centroid = XMVector3Transform(b.Centroid, XMMatrixScaling(b.Scale, b.Scale, b.Scale) * XMMatrixRotationX(pitch_b));
+				CreateTestBody(ecs, a, XMVectorSetW(center - a_centroid, 1.0f), pitch_a);
+				CreateTestBody(ecs, b, XMVectorSetW(center - b_centroid, 1.0f), pitch_b);
+				++overlapping_pair_count;
+
+				// Apart: b's leftmost vertex is KGap right of a's rightmost one.
+				auto a_position = XMVectorSet(slot_x, KPairSpacing, 0.0f, 1.0f);
+				auto b_position = a_position + XMVectorSet(a.Max.x * a.Scale - b.Min.x * b.Scale + KGap, 0.0f, 0.0f, 0.0f);
+				CreateTestBody(ecs, a, a_position, pitch_a);
+				CreateTestBody(ecs, b, b_position, pitch_b);
+
+				slot_x += KPairSpacing;
+			}
+		}
+	}
+
+	// Every configuration starts from the same state.
+	system_physics.SetDeterministicMode(true);
+	ecs.SystemTransform().Execute();
+
+	SPhysicsSnapshot snapshot{};
+	system_physics.SaveSnapshot(snapshot);
+
+	static constexpr ENarrowPhaseType KTypes[]{ ENarrowPhaseType::FaceSearch, ENarrowPhaseType::GJK, ENarrowPhaseType::GJK };
+	static constexpr ESupportMappingType KSupportMappings[]{
+		ESupportMappingType::BruteForce, ESupportMappingType::BruteForce, ESupportMappingType::HillClimbing };
+	static constexpr const char* KNames[]{ "FaceSearch", "GJK (brute force)", "GJK (hill climbing)" };
+
+	VECTOR<SNarrowPhaseTestContact> contacts[3]{};
+	long long fine_collision_times[3]{};
+	for (uint32_t type = 0; type < 3; ++type)
+	{
+		SetNarrowPhase(system_physics, KTypes[type], KSupportMappings[type]);
+
+		for (uint32_t iter = 0; iter < KRepeatCount; ++iter)
+		{
+			JW_TEST_CHECK(system_physics.RestoreSnapshot(snapshot));
+			system_physics.Simulate(1);
+			fine_collision_times[type] += system_physics.GetFineCollisionTime();
+		}
+		contacts[type] = GetTestContacts(system_physics);
+
+		if (KTypes[type] == ENarrowPhaseType::GJK)
+		{
+			JW_TEST_CHECK(system_physics.GetGJKPairCount() == system_physics.GetCoarseCollisionPairCount());
+		}
+	}
+
+	JW_TEST_CHECK(contacts[0].size() == overlapping_pair_count);
+	JW_TEST_CHECK(AreContactPairsEqual(contacts[0], contacts[1]));
+	JW_TEST_CHECK(AreContactPairsEqual(contacts[1], contacts[2]));
+
+	// Hill climbing on a convex hull finds support points as far as brute force does, so EPA converges to the same depth.
+	bool are_depths_equal{ contacts[1].size() == contacts[2].size() };
+	for (size_t iter = 0; (are_depths_equal) && (iter < contacts[1].size()); ++iter)
+	{
+		are_depths_equal = (fabsf(contacts[1][iter].PenetrationDepth - contacts[2][iter].PenetrationDepth) < KMaxDepthDifference);
+		JW_TEST_CHECK(contacts[1][iter].PenetrationDepth > 0);
+	}
+	JW_TEST_CHECK(are_depths_equal);
+
+	std::cout << "  " << meshes.size() << " meshes, " << system_physics.GetCoarseCollisionPairCount() << " coarse pairs, "
+		<< overlapping_pair_count << " overlapping:";
+	for (uint32_t type = 0; type < 3; ++type)
+	{
+		std::cout << " " << KNames[type] << " " << fine_collision_times[type] / KRepeatCount << " us" << ((type < 2) ? "," : "");
+	}
+	std::cout << std::endl;
+
+	// Hill climbing is only used on meshes that pass the convexity check.
+	JWModel octahedron{};
+	SConvexHull octahedron_hull{};
+	MakeTestOctahedron(1.0f, octahedron);
+	JWNarrowPhase::BuildConvexHull(octahedron, octahedron_hull);
+	JW_TEST_CHECK(octahedron_hull.IsConvex);
+
+	MakeTestOctahedron(-0.5f, octahedron);
+	JWNarrowPhase::BuildConvexHull(octahedron, octahedron_hull);
+	JW_TEST_CHECK(!octahedron_hull.IsConvex);
+
+	game->RunHeadless(1, 16'666);
+}
@@ -0,0 +1,124 @@
+#include "JWTest.h"
+#include "../JWGame/JWGame.h"
+#include "../Core/JWNullGraphicsBackend.h"
+#include <random>
+
+using namespace JWEngine;
+
+static JWGame* gs_pPhysicsSnapshotGame{};
+
+JW_FUNCTION_ON_RENDER(OnPhysicsSnapshotRender)
+{
+	gs_pPhysicsSnapshotGame->ECS().ExecuteSystems();
+}
+
+static auto AreSnapshotsEqual(const SPhysicsSnapshot& A, const SPhysicsSnapshot& B) noexcept->bool
+{
+	if (A.Size != B.Size) { return false; }
+	return (memcmp(A.vData.data(), B.vData.data(), A.Size) == 0);
+}
+
+// Boxes are dropped onto a static floor so that contacts are made and cached during the steps.
+// A = snapshot, N steps, B = snapshot, rollback to A, N steps again, C = snapshot: B and C must be the same bytes,
+// with the deterministic mode on and off. The time of the rollback plus the resimulation is reported.
+void JWEngine::TestPhysicsSnapshot() noexcept
+{
+	static constexpr uint32_t KBoxCountPerSide{ 4 };
+	static constexpr uint32_t KWarmUpStepCount{ 30 };
+	static constexpr uint32_t KStepCount{ 120 };
+
+	JWNullGraphicsBackend backend{};
+	backend.SetPayloadRecording(false);
+
+	auto game = MAKE_UNIQUE(JWGame)();
+	gs_pPhysicsSnapshotGame = game.get();
+
+	game->CreateHeadless(SSize2(800, 600), GetTestBaseDirectory(), &backend);
+	game->SetFunctionOnRender(OnPhysicsSnapshotRender);
+
+	auto& ecs = game->ECS();
+	auto& system_render = ecs.SystemRender();
+	auto& system_physics = ecs.SystemPhysics();
+
+	{
+		auto camera_0 = ecs.CreateEntity("camera_0");
+		camera_0->CreateComponentTransform()->SetPosition(XMVectorSet(0.0f, 2.0f, -10.0f, 1.0f));
+		camera_0->CreateComponentCamera()->CreatePerspectiveCamera(ECameraType::FreeLook);
+	}
+
+	system_render.CreateSharedModelFromModelData(ESharedModelType::CollisionMesh, system_render.PrimitiveMaker().MakeCube(1.0f), "CM_box");
+	auto box_mesh = system_render.GetSharedModelByName("CM_box");
+
+	auto create_box = [&](const XMVECTOR& Position, const XMVECTOR& Scaling)
+	{
+		auto box = ecs.CreateEntity("box_" + TO_STRING(ecs.GetEntityCount()));
+
+		auto transform = box->CreateComponentTransform();
+		transform->SetWorldMatrixCalculationOrder(EWorldMatrixCalculationOrder::ScaleRotTrans);
+		transform->SetPosition(Position);
+		transform->SetScalingFactor(Scaling);
+
+		auto physics = box->CreateComponentPhysics();
+		physics->BoundingSphere = SBoundingSphereData(XMVectorGetX(XMVector3Length(Scaling * 0.5f)));
+		physics->SetCollisionMesh(box_mesh);
+		physics->NarrowPhaseType = ENarrowPhaseType::GJK;
+		return physics;
+	};
+
+	create_box(XMVectorSet(0.0f, -0.5f, 0.0f, 1.0f), XMVectorSet(20.0f, 1.0f, 20.0f, 0.0f))->SetMassToInfinite();
+
+	// Two layers, the upper one lands on the lower one.
+	std::mt19937 random{ 1 };
+	std::uniform_real_distribution<float> offset{ -0.2f, 0.2f };
+	for (uint32_t layer = 0; layer < 2; ++layer)
+	{
+		for (uint32_t z = 0; z < KBoxCountPerSide; ++z)
+		{
+			for (uint32_t x = 0; x < KBoxCountPerSide; ++x)
+			{
+				auto position = XMVectorSet(x * 1.5f + offset(random), 0.6f + layer * 1.2f, z * 1.5f + offset(random), 1.0f);
+				create_box(position, XMVectorSet(1.0f, 1.0f, 1.0f, 0.0f))->SetMassByKilogram(1.0f);
+			}
+		}
+	}
+
+	ecs.SystemTransform().Execute();
+
+	auto simulate = [&](uint32_t StepCount)
+	{
+		for (uint32_t step = 0; step < StepCount; ++step)
+		{
+			system_physics.ApplyUniversalGravity();
+			system_physics.Simulate(1);
+		}
+	};
+
+	static constexpr bool KDeterministicModes[]{ true, false };
+	SPhysicsSnapshot snapshots[3]{};
+	long long rollback_times[2]{};
+	for (uint32_t mode = 0; mode < 2; ++mode)
+	{
+		system_physics.SetTimeStepMode(EPhysicsTimeStepMode::Fixed);
+		system_physics.SetDeterministicMode(KDeterministicModes[mode]);
+
+		// The bodies are already touching and have cached contacts in A.
+		simulate(KWarmUpStepCount);
+		system_physics.SaveSnapshot(snapshots[0]);
+
+		simulate(KStepCount);
+		system_physics.SaveSnapshot(snapshots[1]);
+
+		auto start_time = STEADY_CLOCK::now();
+		JW_TEST_CHECK(system_physics.RestoreSnapshot(snapshots[0]));
+		simulate(KStepCount);
+		rollback_times[mode] = std::chrono::duration_cast<TIME_UNIT_mS>(STEADY_CLOCK::now() - start_time).count();
+
+		system_physics.SaveSnapshot(snapshots[2]);
+		JW_TEST_CHECK(AreSnapshotsEqual(snapshots[1], snapshots[2]));
+	}
+
+	std::cout << "  " << system_physics.ComponentPool().GetCount() << " bodies, rollback + " << KStepCount << " steps: deterministic "
+		<< rollback_times[0] << " us, non-deterministic " << rollback_times[1] << " us (" << snapshots[0].Size << " bytes)" << std::endl;
+
+	game->RunHeadless(1, 16'666);
+}
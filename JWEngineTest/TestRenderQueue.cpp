@@ -0,0 +1,154 @@
+#include "JWTest.h"
+#include "../JWGame/JWGame.h"
+#include "../Core/JWNullGraphicsBackend.h"
+
+using namespace JWEngine;
+
+static constexpr uint32_t KRenderQueueModelCount{ 3 };
+static constexpr uint32_t KRenderQueueTransparentCount{ 8 };
+
+static JWGame* gs_pRenderQueueGame{};
+
+// Captured in OnRenderQueueRender() (before RunHeadless() destroys the ECS)
+struct SRenderQueueTestFrame
+{
+	VECTOR<SRenderQueueItem>	vQueue{};
+	VECTOR<const JWModel*>		vModels{};
+	SDXFrameStatistics			Statistics{};
+	long long					SortTime{};
+};
+static SRenderQueueTestFrame gs_RenderQueueFrame{};
+
+JW_FUNCTION_ON_RENDER(OnRenderQueueRender)
+{
+	auto& ecs = gs_pRenderQueueGame->ECS();
+	ecs.ExecuteSystems();
+
+	auto& system_render = ecs.SystemRender();
+	gs_RenderQueueFrame.vQueue = system_render.GetRenderQueue();
+	gs_RenderQueueFrame.vModels.clear();
+	for (const auto& item : gs_RenderQueueFrame.vQueue)
+	{
+		gs_RenderQueueFrame.vModels.emplace_back(system_render.ComponentPool()[item.ComponentIndex].PtrModel);
+	}
+	gs_RenderQueueFrame.Statistics = gs_pRenderQueueGame->DX().GetFrameStatistics();
+	gs_RenderQueueFrame.SortTime = system_render.GetLastRenderQueueSortTime();
+}
+
+static auto GetModelField(uint64_t Key) noexcept->uint64_t
+{
+	bool is_opaque{ (Key >> KRenderKeyPassShift) == KRenderPassOpaque };
+	return (is_opaque ? (Key >> 20) : Key) & 0xFFFF;
+}
+
+// KRenderQueueModelCount shared models on EntityCount entities created in interleaved order,
+// the first KRenderQueueTransparentCount of them transparent.
+static auto RenderTestScene(uint32_t EntityCount, JWNullGraphicsBackend& Backend) noexcept->SRenderQueueTestFrame
+{
+	auto game = MAKE_UNIQUE(JWGame)();
+	gs_pRenderQueueGame = game.get();
+
+	game->CreateHeadless(SSize2(800, 600), GetTestBaseDirectory(), &Backend);
+	game->SetFunctionOnRender(OnRenderQueueRender);
+
+	auto& ecs = game->ECS();
+	auto& system_render = ecs.SystemRender();
+	system_render.CreateSharedModelFromModelData(ESharedModelType::StaticModel, system_render.PrimitiveMaker().MakeCube(1.0f), "model_0");
+	system_render.CreateSharedModelFromModelData(ESharedModelType::StaticModel, system_render.PrimitiveMaker().MakePyramid(1.0f, 1.0f), "model_1");
+	system_render.CreateSharedModelFromModelData(ESharedModelType::StaticModel, system_render.PrimitiveMaker().MakeCylinder(1.0f, 0.5f, 8), "model_2");
+
+	{
+		auto camera_0 = ecs.CreateEntity("camera_0");
+		camera_0->CreateComponentTransform()->SetPosition(XMVectorSet(0.0f, 0.0f, -20.0f, 1.0f));
+		camera_0->CreateComponentCamera()->CreatePerspectiveCamera(ECameraType::FreeLook);
+	}
+
+	for (uint32_t iter = 0; iter < EntityCount; ++iter)
+	{
+		auto entity = ecs.CreateEntity("entity_" + TO_STRING(iter));
+		entity->CreateComponentTransform()->SetPosition(
+			XMVectorSet(static_cast<float>(iter % 40) - 20.0f, static_cast<float>(iter / 40 % 20) - 10.0f, static_cast<float>(iter / 800), 1.0f));
+
+		auto render = entity->CreateComponentRender();
+		render->SetModel(system_render.GetSharedModelByName("model_" + TO_STRING(iter % KRenderQueueModelCount)));
+		if (iter < KRenderQueueTransparentCount)
+		{
+			render->SetRenderFlag(JWFlagComponentRenderOption_UseTransparency);
+		}
+	}
+
+	game->RunHeadless(1, 16'666);
+
+	return gs_RenderQueueFrame;
+}
+
+// The queue must be sorted, shared models must get distinct dense key fields, opaque items must be grouped by model,
+// and state changes must not grow with the number of opaque entities.
+void JWEngine::TestRenderQueue() noexcept
+{
+	static constexpr uint32_t KEntityCounts[]{ 300, 3'000 };
+
+	uint32_t state_change_counts[2]{};
+	for (uint32_t scene = 0; scene < 2; ++scene)
+	{
+		auto entity_count = KEntityCounts[scene];
+
+		JWNullGraphicsBackend backend{};
+		backend.SetPayloadRecording(false);
+
+		auto frame = RenderTestScene(entity_count, backend);
+		const auto& queue = frame.vQueue;
+
+		JW_TEST_CHECK(queue.size() == entity_count);
+		JW_TEST_CHECK(std::is_sorted(queue.begin(), queue.end(),
+			[](const SRenderQueueItem& a, const SRenderQueueItem& b) { return a.Key < b.Key; }));
+
+		// Model field <-> shared model is one to one.
+		UNORDERED_MAP<uint64_t, const JWModel*> model_from_field{};
+		UNORDERED_MAP<const JWModel*, uint64_t> field_from_model{};
+		bool are_model_fields_dense{ true };
+		uint32_t transparent_count{};
+		uint32_t opaque_model_run_count{};
+		uint64_t last_opaque_model_field{ UINT64_MAX };
+		for (size_t iter = 0; iter < queue.size(); ++iter)
+		{
+			auto key = queue[iter].Key;
+			auto model_field = GetModelField(key);
+			auto model = frame.vModels[iter];
+
+			are_model_fields_dense &= (model_field != 0);
+			are_model_fields_dense &= (model_from_field.emplace(model_field, model).first->second == model);
+			are_model_fields_dense &= (field_from_model.emplace(model, model_field).first->second == model_field);
+
+			if ((key >> KRenderKeyPassShift) == KRenderPassTransparent)
+			{
+				++transparent_count;
+				continue;
+			}
+
+			JW_TEST_CHECK(transparent_count == 0);
+			if (model_field != last_opaque_model_field)
+			{
+				++opaque_model_run_count;
+				last_opaque_model_field = model_field;
+			}
+		}
+		JW_TEST_CHECK(are_model_fields_dense);
+		JW_TEST_CHECK(model_from_field.size() == KRenderQueueModelCount);
+		JW_TEST_CHECK(transparent_count == KRenderQueueTransparentCount);
+		JW_TEST_CHECK(opaque_model_run_count == KRenderQueueModelCount);
+
+		const auto& statistics = frame.Statistics;
+		JW_TEST_CHECK(statistics.DrawCallCount > 0);
+		JW_TEST_CHECK(statistics.DrawCallCount <= backend.GetCounters().DrawCallCount);
+		state_change_counts[scene] = statistics.StateChangeCount;
+
+		std::cout << "  " << entity_count << " entities: sort " << frame.SortTime << " us, " << statistics.DrawCallCount << " draws, "
+			<< statistics.StateChangeCount << " state changes (" << statistics.RedundantStateChangeCount << " redundant skipped), "
+			<< statistics.ConstantBufferUpdateCount << " CB updates (" << statistics.RedundantConstantBufferUpdateCount << " redundant skipped)"
+			<< std::endl;
+	}
+
+	// Ten times the opaque entities, the same state changes
+	JW_TEST_CHECK(state_change_counts[0] == state_change_counts[1]);
+}
@@ -0,0 +1,254 @@
+#include "JWTest.h"
+#include "../ECS/JWDynamicAABBTree.h"
+#include "../Core/JWJobSystem.h"
+#include <random>
+
+using namespace JWEngine;
+
+struct SSceneQueryTestSphere
+{
+	XMVECTOR	Center{};
+	float		Radius{};
+	uint32_t	ProxyID{ KInvalidAABBTreeNodeID };
+};
+
+// Brute-force references (same leaf tests as JWDynamicAABBTree)
+static auto RayCastLinear(const VECTOR<SSceneQueryTestSphere>& vSpheres, const SSceneRayQuery& Query) noexcept->SSceneRayHit
+{
+	SSceneRayHit result{};
+	auto closest_t = XMVectorReplicate(Query.MaxT);
+	for (uint32_t iter = 0; iter < vSpheres.size(); ++iter)
+	{
+		const auto& sphere = vSpheres[iter];
+		if (sphere.ProxyID == KInvalidAABBTreeNodeID) { continue; }
+
+		if (IntersectRaySphere(Query.Origin, Query.Direction, sphere.Radius, sphere.Center, &closest_t))
+		{
+			result.IsHit = true;
+			result.UserData = iter;
+			result.T = XMVectorGetX(closest_t);
+		}
+	}
+	return result;
+}
+
+static void QuerySphereLinear(const VECTOR<SSceneQueryTestSphere>& vSpheres, const SSceneSphereQuery& Query,
+	VECTOR<uint32_t>& OutUserData) noexcept
+{
+	for (uint32_t iter = 0; iter < vSpheres.size(); ++iter)
+	{
+		const auto& sphere = vSpheres[iter];
+		if (sphere.ProxyID == KInvalidAABBTreeNodeID) { continue; }
+
+		auto distance_sq = XMVectorGetX(XMVector3LengthSq(sphere.Center - Query.Center));
+		auto radius_sum = sphere.Radius + Query.Radius;
+		if (distance_sq <= radius_sum * radius_sum) { OutUserData.emplace_back(iter); }
+	}
+}
+
+static void QueryFrustumLinear(const VECTOR<SSceneQueryTestSphere>& vSpheres, const SSceneFrustumQuery& Query,
+	VECTOR<uint32_t>& OutUserData) noexcept
+{
+	for (uint32_t iter = 0; iter < vSpheres.size(); ++iter)
+	{
+		const auto& sphere = vSpheres[iter];
+		if (sphere.ProxyID == KInvalidAABBTreeNodeID) { continue; }
+
+		bool is_outside{ false };
+		for (const auto& plane : Query.Planes)
+		{
+			if (XMVectorGetX(XMPlaneDotCoord(plane, sphere.Center)) < -sphere.Radius) { is_outside = true; break; }
+		}
+		if (!is_outside) { OutUserData.emplace_back(iter); }
+	}
+}
+
+// Planes of a view-projection matrix (row-vector convention), normalized and pointing inward
+static auto MakeFrustumQuery(const XMMATRIX& ViewProjection) noexcept->SSceneFrustumQuery
+{
+	XMFLOAT4X4 m{};
+	XMStoreFloat4x4(&m, ViewProjection);
+
+	auto column = [&](int Index) { return XMVectorSet(m.m[0][Index], m.m[1][Index], m.m[2][Index], m.m[3][Index]); };
+
+	SSceneFrustumQuery result{};
+	result.Planes[0] = column(3) + column(0);
+	result.Planes[1] = column(3) - column(0);
+	result.Planes[2] = column(3) + column(1);
+	result.Planes[3] = column(3) - column(1);
+	result.Planes[4] = column(2);
+	result.Planes[5] = column(3) - column(2);
+	for (auto& iter : result.Planes)
+	{
+		iter = XMPlaneNormalize(iter);
+	}
+	return result;
+}
+
+static auto SortUserData(VECTOR<uint32_t> vUserData) noexcept->VECTOR<uint32_t>
+{
+	std::sort(vUserData.begin(), vUserData.end());
+	return vUserData;
+}
+
+// Batched ray/sphere/frustum queries must return what brute force returns (also after proxies were moved
+// and destroyed), and both are timed in queries per second.
+void JWEngine::TestSceneQuery() noexcept
+{
+	static constexpr uint32_t KProxyCount{ 20'000 };
+	static constexpr uint32_t KRayQueryCount{ 4'096 };
+	static constexpr uint32_t KSphereQueryCount{ 4'096 };
+	static constexpr uint32_t KFrustumQueryCount{ 64 };
+	static constexpr float KWorldHalfExtent{ 200.0f };
+	static constexpr float KMaxTDifference{ 0.001f };
+
+	JWJobSystem job_system{};
+	job_system.Create();
+
+	std::mt19937 random{ 1 };
+	std::uniform_real_distribution<float> position{ -KWorldHalfExtent, KWorldHalfExtent };
+	std::uniform_real_distribution<float> radius{ 0.2f, 3.0f };
+	std::uniform_real_distribution<float> unit{ -1.0f, 1.0f };
+	std::uniform_real_distribution<float> angle{ -XM_PI, XM_PI };
+
+	auto random_point = [&]() { return XMVectorSet(position(random), position(random), position(random), 1.0f); };
+
+	JWDynamicAABBTree tree{};
+	VECTOR<SSceneQueryTestSphere> spheres(KProxyCount);
+	for (uint32_t iter = 0; iter < KProxyCount; ++iter)
+	{
+		auto& sphere = spheres[iter];
+		sphere.Center = random_point();
+		sphere.Radius = radius(random);
+		sphere.ProxyID = tree.CreateProxy(sphere.Center, sphere.Radius, iter);
+	}
+
+	// Move every other proxy (some a little, some across the world) and destroy every tenth one.
+	for (uint32_t iter = 0; iter < KProxyCount; iter += 2)
+	{
+		auto& sphere = spheres[iter];
+		sphere.Center = (iter % 4) ? sphere.Center + XMVectorSet(unit(random), unit(random), unit(random), 0.0f) : random_point();
+		tree.MoveProxy(sphere.ProxyID, sphere.Center, sphere.Radius);
+	}
+	for (uint32_t iter = 0; iter < KProxyCount; iter += 10)
+	{
+		tree.DestroyProxy(spheres[iter].ProxyID);
+		spheres[iter].ProxyID = KInvalidAABBTreeNodeID;
+	}
+	JW_TEST_CHECK(tree.GetProxyCount() == KProxyCount - KProxyCount / 10);
+
+	VECTOR<SSceneRayQuery> ray_queries{};
+	for (uint32_t iter = 0; iter < KRayQueryCount; ++iter)
+	{
+		ray_queries.emplace_back(random_point(), XMVector3Normalize(XMVectorSet(unit(random), unit(random), unit(random), 0.0f)),
+			(iter % 2) ? FLT_MAX : 50.0f);
+	}
+
+	VECTOR<SSceneSphereQuery> sphere_queries{};
+	for (uint32_t iter = 0; iter < KSphereQueryCount; ++iter)
+	{
+		sphere_queries.emplace_back(random_point(), 10.0f * radius(random));
+	}
+
+	VECTOR<SSceneFrustumQuery> frustum_queries{};
+	auto projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, 100.0f);
+	for (uint32_t iter = 0; iter < KFrustumQueryCount; ++iter)
+	{
+		auto view = XMMatrixInverse(nullptr, XMMatrixRotationRollPitchYaw(angle(random), angle(random), 0) *
+			XMMatrixTranslationFromVector(random_point()));
+		frustum_queries.emplace_back(MakeFrustumQuery(view * projection));
+	}
+
+	// Tree (batched)
+	VECTOR<SSceneRayHit> ray_hits{};
+	VECTOR<VECTOR<uint32_t>> sphere_results{};
+	VECTOR<VECTOR<uint32_t>> frustum_results{};
+	double tree_queries_per_second[3]{};
+
+	tree.RayCastBatch(job_system, ray_queries, ray_hits);
+	tree_queries_per_second[0] = tree.GetLastBatchQueriesPerSecond();
+	tree.QuerySphereBatch(job_system, sphere_queries, sphere_results);
+	tree_queries_per_second[1] = tree.GetLastBatchQueriesPerSecond();
+	tree.QueryFrustumBatch(job_system, frustum_queries, frustum_results);
+	tree_queries_per_second[2] = tree.GetLastBatchQueriesPerSecond();
+
+	// Brute force (on the same job system)
+	VECTOR<SSceneRayHit> linear_ray_hits(KRayQueryCount);
+	VECTOR<VECTOR<uint32_t>> linear_sphere_results(KSphereQueryCount);
+	VECTOR<VECTOR<uint32_t>> linear_frustum_results(KFrustumQueryCount);
+	double linear_time[3]{};
+
+	linear_time[0] = MeasureAverageTime(1, [&]()
+		{
+			job_system.ParallelFor(KRayQueryCount, KSceneQueryBatchMinChunkSize, [&](uint32_t Begin, uint32_t End)
+				{
+					for (uint32_t i = Begin; i < End; ++i) { linear_ray_hits[i] = RayCastLinear(spheres, ray_queries[i]); }
+				});
+		});
+	linear_time[1] = MeasureAverageTime(1, [&]()
+		{
+			job_system.ParallelFor(KSphereQueryCount, KSceneQueryBatchMinChunkSize, [&](uint32_t Begin, uint32_t End)
+				{
+					for (uint32_t i = Begin; i < End; ++i) { QuerySphereLinear(spheres, sphere_queries[i], linear_sphere_results[i]); }
+				});
+		});
+	linear_time[2] = MeasureAverageTime(1, [&]()
+		{
+			job_system.ParallelFor(KFrustumQueryCount, 1, [&](uint32_t Begin, uint32_t End)
+				{
+					for (uint32_t i = Begin; i < End; ++i) { QueryFrustumLinear(spheres, frustum_queries[i], linear_frustum_results[i]); }
+				});
+		});
+
+	bool are_ray_hits_equal{ true };
+	uint32_t ray_hit_count{};
+	for (uint32_t iter = 0; iter < KRayQueryCount; ++iter)
+	{
+		const auto& a = ray_hits[iter];
+		const auto& b = linear_ray_hits[iter];
+		are_ray_hits_equal &= (a.IsHit == b.IsHit);
+		if ((a.IsHit) && (b.IsHit))
+		{
+			are_ray_hits_equal &= (fabsf(a.T - b.T) < KMaxTDifference);
+			++ray_hit_count;
+		}
+	}
+	JW_TEST_CHECK(are_ray_hits_equal);
+	JW_TEST_CHECK(ray_hit_count > 0);
+
+	bool are_sphere_results_equal{ true };
+	for (uint32_t iter = 0; iter < KSphereQueryCount; ++iter)
+	{
+		are_sphere_results_equal &= (SortUserData(sphere_results[iter]) == SortUserData(linear_sphere_results[iter]));
+	}
+	JW_TEST_CHECK(are_sphere_results_equal);
+
+	bool are_frustum_results_equal{ true };
+	for (uint32_t iter = 0; iter < KFrustumQueryCount; ++iter)
+	{
+		are_frustum_results_equal &= (SortUserData(frustum_results[iter]) == SortUserData(linear_frustum_results[iter]));
+	}
+	JW_TEST_CHECK(are_frustum_results_equal);
+
+	// The traversal stack must keep its order past the inline entries.
+	SAABBTreeStack stack{};
+	for (uint32_t node_id = 0; node_id < KAABBTreeStackSize * 4; ++node_id)
+	{
+		stack.Push(node_id);
+	}
+	bool is_stack_order_kept{ true };
+	for (uint32_t node_id = KAABBTreeStackSize * 4; node_id > 0; --node_id)
+	{
+		is_stack_order_kept &= (stack.Pop() == node_id - 1);
+	}
+	JW_TEST_CHECK(is_stack_order_kept && stack.IsEmpty());
+
+	static constexpr const char* KQueryNames[]{ "ray", "sphere", "frustum" };
+	static constexpr uint32_t KQueryCounts[]{ KRayQueryCount, KSphereQueryCount, KFrustumQueryCount };
+	for (uint32_t type = 0; type < 3; ++type)
+	{
+		std::cout << "  " << tree.GetProxyCount() << " proxies, " << KQueryCounts[type] << " " << KQueryNames[type] << " queries: tree "
+			<< static_cast<uint64_t>(tree_queries_per_second[type]) << " q/s, brute force "
+			<< static_cast<uint64_t>(KQueryCounts[type] / (max(linear_time[type], 1.0) / 1'000'000.0)) << " q/s" << std::endl;
+	}
+}
@@ -0,0 +1,188 @@
+#include "JWTest.h"
+#include "../JWGame/JWGame.h"
+#include "../Core/JWSoftwareRasterizer.h"
+#include "../Core/JWJobSystem.h"
+
+using namespace JWEngine;
+
+static constexpr uint32_t KGoldenImageWidth{ 250 };
+static constexpr uint32_t KGoldenImageHeight{ 190 };
+static constexpr const char* KGoldenImageFileName{ "software_rasterizer_scene.raw" };
+
+static JWGame* gs_pRasterizerGame{};
+
+JW_FUNCTION_ON_RENDER(OnRasterizerRender)
+{
+	gs_pRasterizerGame->ECS().ExecuteSystems();
+}
+
+// Lit cube at the origin (it covers the center of the image), a sphere to its right and nothing in the corners
+static void RenderGoldenScene(JWSoftwareRasterizer& Rasterizer) noexcept
+{
+	auto game = MAKE_UNIQUE(JWGame)();
+	gs_pRasterizerGame = game.get();
+
+	game->CreateHeadless(SSize2(KGoldenImageWidth, KGoldenImageHeight), GetTestBaseDirectory(), &Rasterizer);
+	game->SetFunctionOnRender(OnRasterizerRender);
+
+	auto& ecs = game->ECS();
+	auto& system_render = ecs.SystemRender();
+	system_render.SetSystemRenderFlag(JWFlagSystemRenderOption_UseLighting);
+	system_render.CreateSharedModelFromModelData(ESharedModelType::StaticModel, system_render.PrimitiveMaker().MakeCube(2.0f), "cube");
+	system_render.CreateSharedModelFromModelData(ESharedModelType::StaticModel,
+		system_render.PrimitiveMaker().MakeSphere(0.8f, 16, 16, XMFLOAT3(1, 0.5f, 0), XMFLOAT3(0, 0.5f, 1)), "sphere");
+
+	{
+		auto camera_0 = ecs.CreateEntity("camera_0");
+		camera_0->CreateComponentTransform()->SetPosition(XMVectorSet(0.0f, 0.0f, -6.0f, 1.0f));
+		camera_0->CreateComponentCamera()->CreatePerspectiveCamera(ECameraType::FreeLook);
+	}
+
+	{
+		auto ambient_light = ecs.CreateEntity("ambient_light");
+		ambient_light->CreateComponentTransform()->SetPosition(XMVectorSet(0.0f, 10.0f, 0.0f, 1.0f));
+		ambient_light->CreateComponentLight()->MakeAmbientLight(XMFLOAT3(1.0f, 1.0f, 1.0f), 0.4f);
+	}
+
+	{
+		auto directional_light = ecs.CreateEntity("directional_light");
+		directional_light->CreateComponentTransform()->SetPosition(XMVectorSet(3.0f, 10.0f, -3.0f, 1.0f));
+		directional_light->CreateComponentLight()->MakeDirectionalLight(XMFLOAT3(1.0f, 1.0f, 1.0f), XMFLOAT3(-1.0f, -1.0f, 1.0f), 0.6f);
+	}
+
+	{
+		auto cube = ecs.CreateEntity("cube");
+		auto transform = cube->CreateComponentTransform();
+		transform->SetPitchYawRoll(0.4f, 0.6f, 0.0f);
+		cube->CreateComponentRender()->SetModel(system_render.GetSharedModelByName("cube"));
+	}
+
+	{
+		auto sphere = ecs.CreateEntity("sphere");
+		sphere->CreateComponentTransform()->SetPosition(XMVectorSet(2.4f, 0.6f, 1.0f, 1.0f));
+		sphere->CreateComponentRender()->SetModel(system_render.GetSharedModelByName("sphere"));
+	}
+
+	game->RunHeadless(1, 16'666);
+}
+
+// Color buffer without the row padding
+static auto GetImage(const JWSoftwareRasterizer& Rasterizer) noexcept->VECTOR<uint32_t>
+{
+	VECTOR<uint32_t> result{};
+	const auto& color_buffer = Rasterizer.GetColorBuffer();
+	for (uint32_t y = 0; y < Rasterizer.GetHeight(); ++y)
+	{
+		auto row = color_buffer.begin() + y * Rasterizer.GetBufferPitch();
+		result.insert(result.end(), row, row + Rasterizer.GetWidth());
+	}
+	return result;
+}
+
+// Golden file: width, height (uint32_t), then R8G8B8A8 pixels row by row
+static auto LoadGoldenImage(const STRING& FileName, VECTOR<uint32_t>& OutImage) noexcept->bool
+{
+	std::ifstream file{ FileName, std::ios::binary };
+	if (!file.is_open()) { return false; }
+
+	uint32_t size[2]{};
+	file.read(reinterpret_cast<char*>(size), sizeof(size));
+	if ((size[0] != KGoldenImageWidth) || (size[1] != KGoldenImageHeight)) { return false; }
+
+	OutImage.resize(size[0] * size[1]);
+	file.read(reinterpret_cast<char*>(OutImage.data()), OutImage.size() * sizeof(uint32_t));
+	return !file.fail();
+}
+
+static auto SaveGoldenImage(const STRING& FileName, const VECTOR<uint32_t>& Image) noexcept->bool
+{
+	std::ofstream file{ FileName, std::ios::binary };
+	if (!file.is_open()) { return false; }
+
+	uint32_t size[2]{ KGoldenImageWidth, KGoldenImageHeight };
+	file.write(reinterpret_cast<const char*>(size), sizeof(size));
+	file.write(reinterpret_cast<const char*>(Image.data()), Image.size() * sizeof(uint32_t));
+	return !file.fail();
+}
+
+// Pixels with any channel off by more than MaxChannelDifference
+static auto CountDifferentPixels(const VECTOR<uint32_t>& A, const VECTOR<uint32_t>& B, uint32_t MaxChannelDifference) noexcept->uint32_t
+{
+	uint32_t result{};
+	for (size_t iter = 0; iter < A.size(); ++iter)
+	{
+		for (uint32_t channel = 0; channel < 4; ++channel)
+		{
+			auto a = static_cast<int>((A[iter] >> (channel * 8)) & 0xFF);
+			auto b = static_cast<int>((B[iter] >> (channel * 8)) & 0xFF);
+			if (static_cast<uint32_t>(abs(a - b)) > MaxChannelDifference) { ++result; break; }
+		}
+	}
+	return result;
+}
+
+// Renders a lit scene headless through JWSoftwareRasterizer, single-threaded and on the job system.
+// Both images must be identical and must match the golden image (a missing one fails, --update-golden rewrites it).
+void JWEngine::TestSoftwareRasterizer() noexcept
+{
+	static constexpr uint32_t KMaxChannelDifference{ 2 };
+
+	// Edge pixels may flip between builds with different math paths (e.g. FMA3).
+	static constexpr uint32_t KMaxDifferentPixelCount{ KGoldenImageWidth * KGoldenImageHeight / 200 };
+
+	const SClearColor clear_color{ 0.2f, 0.3f, 0.4f };
+
+	JWSoftwareRasterizer serial_rasterizer{};
+	serial_rasterizer.Create(KGoldenImageWidth, KGoldenImageHeight, clear_color, nullptr);
+	RenderGoldenScene(serial_rasterizer);
+
+	JWJobSystem job_system{};
+	job_system.Create();
+
+	JWSoftwareRasterizer rasterizer{};
+	rasterizer.Create(KGoldenImageWidth, KGoldenImageHeight, clear_color, &job_system);
+	RenderGoldenScene(rasterizer);
+
+	// Tiles
+	JW_TEST_CHECK(rasterizer.GetTileCountX() == (KGoldenImageWidth + KRasterTileSize - 1) / KRasterTileSize);
+	JW_TEST_CHECK(rasterizer.GetTileCountY() == (KGoldenImageHeight + KRasterTileSize - 1) / KRasterTileSize);
+	JW_TEST_CHECK(rasterizer.GetTileMaxDepthBuffer().size() == rasterizer.GetTileCountX() * rasterizer.GetTileCountY());
+	JW_TEST_CHECK(rasterizer.GetBufferPitch() % KRasterTileSize == 0);
+	JW_TEST_CHECK(rasterizer.GetTriangleCount() > 0);
+
+	auto image = GetImage(rasterizer);
+	auto serial_image = GetImage(serial_rasterizer);
+	JW_TEST_CHECK(image == serial_image);
+
+	// The corner is cleared, the center is covered by the cube.
+	auto clear = image[0];
+	auto center_x = KGoldenImageWidth / 2;
+	auto center_y = KGoldenImageHeight / 2;
+	const auto& depth_buffer = rasterizer.GetDepthBuffer();
+	JW_TEST_CHECK(depth_buffer[0] == 1.0f);
+	JW_TEST_CHECK(image[center_y * KGoldenImageWidth + center_x] != clear);
+	JW_TEST_CHECK(depth_buffer[center_y * rasterizer.GetBufferPitch() + center_x] < 1.0f);
+	JW_TEST_CHECK(rasterizer.IsRectOccluded(center_x, center_y, center_x, center_y, 1.0f));
+	JW_TEST_CHECK(!rasterizer.IsRectOccluded(0, 0, 0, 0, 1.0f));
+
+	auto golden_file_name = GetTestBaseDirectory() + KTestProjectName + "\\Golden\\" + KGoldenImageFileName;
+	if (ex_ShouldUpdateGoldenFiles)
+	{
+		JW_TEST_CHECK(SaveGoldenImage(golden_file_name, image));
+
+		std::cout << "  Golden image written: " << golden_file_name << std::endl;
+		return;
+	}
+
+	VECTOR<uint32_t> golden_image{};
+	auto is_golden_image_loaded = LoadGoldenImage(golden_file_name, golden_image);
+	JW_TEST_CHECK(is_golden_image_loaded);
+	if (!is_golden_image_loaded) { return; }
+
+	auto different_pixel_count = CountDifferentPixels(image, golden_image, KMaxChannelDifference);
+	JW_TEST_CHECK(different_pixel_count <= KMaxDifferentPixelCount);
+
+	std::cout << "  " << KGoldenImageWidth << "x" << KGoldenImageHeight << ", " << rasterizer.GetTriangleCount() << " triangles, "
+		<< different_pixel_count << " pixels differ from the golden image, rasterization " << rasterizer.GetLastRasterizationTime()
+		<< " us (single-threaded " << serial_rasterizer.GetLastRasterizationTime() << " us)" << std::endl;
+}
@@ -0,0 +1,350 @@
+#include "JWTest.h"
+#include "../Core/JWDX.h"
+#include "../Core/JWNullGraphicsBackend.h"
+#include "../Core/JWTerrainGenerator.h"
+#include "../TinyXml2/tinyxml2.h"
+
+using namespace JWEngine;
+
+static constexpr const char* KTestXMLTRNFileName{ "_test_terrain_xml.trn" };
+static constexpr const char* KTestBinaryTRNFileName{ "_test_terrain_v2.trn" };
+static constexpr const char* KTestConvertedTRNFileName{ "_test_terrain_converted.trn" };
+static constexpr const char* KTestCorruptTRNFileName{ "_test_terrain_corrupt.trn" };
+
+// Root -> 4 nodes -> 16 leaves, every leaf is a (KLeafSize + 1)^2 vertex grid.
+static auto MakeTestTerrain(uint32_t LeafSize) noexcept->STerrainData
+{
+	STerrainData terrain{};
+	terrain.TerrainSizeX = terrain.TerrainSizeZ = LeafSize * 4;
+	terrain.HeightFactor = 4.0f;
+	terrain.XYSizeFactor = 1.0f;
+	terrain.WholeBoundingSphere = SBoundingSphereData(LeafSize * 3.0f, LeafSize * 2.0f, 0.0f, -(LeafSize * 2.0f));
+
+	terrain.QuadTree.emplace_back(0);
+	terrain.QuadTree[0].SizeX = terrain.QuadTree[0].SizeZ = LeafSize * 4;
+
+	for (int32_t child = 0; child < 4; ++child)
+	{
+		auto node_id = static_cast<int32_t>(terrain.QuadTree.size());
+		terrain.QuadTree[0].ChildrenID[child] = node_id;
+		terrain.QuadTree.emplace_back(node_id, 0);
+		terrain.QuadTree[node_id].StartX = (child % 2) * LeafSize * 2;
+		terrain.QuadTree[node_id].StartZ = (child / 2) * LeafSize * 2;
+		terrain.QuadTree[node_id].SizeX = terrain.QuadTree[node_id].SizeZ = LeafSize * 2;
+	}
+
+	for (int32_t parent = 1; parent <= 4; ++parent)
+	{
+		for (int32_t child = 0; child < 4; ++child)
+		{
+			auto node_id = static_cast<int32_t>(terrain.QuadTree.size());
+			terrain.QuadTree[parent].ChildrenID[child] = node_id;
+			terrain.QuadTree.emplace_back(node_id, parent);
+
+			auto& leaf = terrain.QuadTree[node_id];
+			leaf.StartX = terrain.QuadTree[parent].StartX + (child % 2) * LeafSize;
+			leaf.StartZ = terrain.QuadTree[parent].StartZ + (child / 2) * LeafSize;
+			leaf.SizeX = leaf.SizeZ = LeafSize;
+			leaf.HasMeshes = true;
+			leaf.SubBoundingVolumeID = static_cast<int32_t>(terrain.SubBoundingSpheres.size());
+
+			for (uint32_t z = 0; z <= LeafSize; ++z)
+			{
+				for (uint32_t x = 0; x <= LeafSize; ++x)
+				{
+					auto world_x = static_cast<float>(leaf.StartX + x);
+					auto world_z = -static_cast<float>(leaf.StartZ + z);
+
+					SVertexModel vertex{ world_x, sinf(world_x * 0.37f) * cosf(world_z * 0.21f) * terrain.HeightFactor, world_z,
+						static_cast<float>(x) / LeafSize, static_cast<float>(z) / LeafSize };
+					vertex.Normal = XMVector3Normalize(XMVectorSet(sinf(world_x), 4.0f, cosf(world_z), 0.0f));
+					vertex.Tangent = XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f);
+					vertex.Bitangent = XMVectorSet(0.0f, 0.0f, -1.0f, 0.0f);
+					leaf.VertexData.AddVertex(vertex);
+				}
+			}
+
+			for (uint32_t z = 0; z < LeafSize; ++z)
+			{
+				for (uint32_t x = 0; x < LeafSize; ++x)
+				{
+					DWORD v0 = z * (LeafSize + 1) + x;
+					DWORD v1 = v0 + 1;
+					DWORD v2 = v0 + (LeafSize + 1);
+					DWORD v3 = v2 + 1;
+					leaf.IndexData.vFaces.emplace_back(v0, v1, v2);
+					leaf.IndexData.vFaces.emplace_back(v1, v3, v2);
+				}
+			}
+
+			terrain.SubBoundingSpheres.emplace_back(LeafSize * 0.75f,
+				leaf.StartX + LeafSize * 0.5f, 0.0f, -(leaf.StartZ + LeafSize * 0.5f));
+		}
+	}
+
+	return terrain;
+}
+
+// The TRN format before v2 (tinyxml2, one element per vertex and face)
+static void SaveTerrainAsXMLTRN(const STRING& FilePath, const STerrainData& TerrainData) noexcept
+{
+	using namespace tinyxml2;
+	tinyxml2::XMLDocument doc{};
+
+	auto root = doc.NewElement("jw_terrain_root");
+
+	auto terrain_info = doc.NewElement("terrain_info");
+	terrain_info->SetAttribute("size_x", TerrainData.TerrainSizeX);
+	terrain_info->SetAttribute("size_z", TerrainData.TerrainSizeZ);
+	terrain_info->SetAttribute("height_factor", TerrainData.HeightFactor);
+	terrain_info->SetAttribute("xy_size_factor", TerrainData.XYSizeFactor);
+	terrain_info->SetAttribute("whole_bounding_sphere_center_x", XMVectorGetX(TerrainData.WholeBoundingSphere.Center));
+	terrain_info->SetAttribute("whole_bounding_sphere_center_y", XMVectorGetY(TerrainData.WholeBoundingSphere.Center));
+	terrain_info->SetAttribute("whole_bounding_sphere_center_z", XMVectorGetZ(TerrainData.WholeBoundingSphere.Center));
+	terrain_info->SetAttribute("whole_bounding_sphere_radius", TerrainData.WholeBoundingSphere.Radius);
+
+	auto quad_tree = doc.NewElement("quad_tree");
+	quad_tree->SetAttribute("node_count", static_cast<int>(TerrainData.QuadTree.size()));
+
+	for (auto& iter : TerrainData.QuadTree)
+	{
+		auto node = doc.NewElement("node");
+		node->SetAttribute("node_id", iter.NodeID);
+		node->SetAttribute("parent_id", iter.ParentID);
+		node->SetAttribute("children_id_0", iter.ChildrenID[0]);
+		node->SetAttribute("children_id_1", iter.ChildrenID[1]);
+		node->SetAttribute("children_id_2", iter.ChildrenID[2]);
+		node->SetAttribute("children_id_3", iter.ChildrenID[3]);
+		node->SetAttribute("start_x", iter.StartX);
+		node->SetAttribute("start_z", iter.StartZ);
+		node->SetAttribute("size_x", iter.SizeX);
+		node->SetAttribute("size_z", iter.SizeZ);
+		node->SetAttribute("has_meshes", iter.HasMeshes);
+		node->SetAttribute("sub_bounding_sphere_id", iter.SubBoundingVolumeID);
+
+		if (iter.HasMeshes)
+		{
+			auto vertices = doc.NewElement("vertices");
+			vertices->SetAttribute("vertex_count", static_cast<int>(iter.VertexData.vVerticesModel.size()));
+			for (auto& vertex_iter : iter.VertexData.vVerticesModel)
+			{
+				auto vertex = doc.NewElement("vertex");
+
+				// (texcoord is stored on the position element in this format)
+				auto position = doc.NewElement("position");
+				position->SetAttribute("x", XMVectorGetX(vertex_iter.Position));
+				position->SetAttribute("y", XMVectorGetY(vertex_iter.Position));
+				position->SetAttribute("z", XMVectorGetZ(vertex_iter.Position));
+				position->SetAttribute("u", XMVectorGetX(vertex_iter.TexCoord));
+				position->SetAttribute("v", XMVectorGetY(vertex_iter.TexCoord));
+
+				auto texcoord = doc.NewElement("texcoord");
+
+				auto normal = doc.NewElement("normal");
+				normal->SetAttribute("x", XMVectorGetX(vertex_iter.Normal));
+				normal->SetAttribute("y", XMVectorGetY(vertex_iter.Normal));
+				normal->SetAttribute("z", XMVectorGetZ(vertex_iter.Normal));
+
+				auto tangent = doc.NewElement("tangent");
+				tangent->SetAttribute("x", XMVectorGetX(vertex_iter.Tangent));
+				tangent->SetAttribute("y", XMVectorGetY(vertex_iter.Tangent));
+				tangent->SetAttribute("z", XMVectorGetZ(vertex_iter.Tangent));
+
+				auto bitangent = doc.NewElement("bitangent");
+				bitangent->SetAttribute("x", XMVectorGetX(vertex_iter.Bitangent));
+				bitangent->SetAttribute("y", XMVectorGetY(vertex_iter.Bitangent));
+				bitangent->SetAttribute("z", XMVectorGetZ(vertex_iter.Bitangent));
+
+				vertex->InsertEndChild(position);
+				vertex->InsertEndChild(texcoord);
+				vertex->InsertEndChild(normal);
+				vertex->InsertEndChild(tangent);
+				vertex->InsertEndChild(bitangent);
+
+				vertices->InsertEndChild(vertex);
+			}
+
+			auto faces = doc.NewElement("faces");
+			faces->SetAttribute("face_count", static_cast<int>(iter.IndexData.vFaces.size()));
+			for (auto& face_iter : iter.IndexData.vFaces)
+			{
+				auto face = doc.NewElement("face");
+				face->SetAttribute("_0", static_cast<int>(face_iter._0));
+				face->SetAttribute("_1", static_cast<int>(face_iter._1));
+				face->SetAttribute("_2", static_cast<int>(face_iter._2));
+
+				faces->InsertEndChild(face);
+			}
+
+			node->InsertEndChild(vertices);
+			node->InsertEndChild(faces);
+		}
+
+		quad_tree->InsertEndChild(node);
+	}
+
+	auto sub_bounding_spheres = doc.NewElement("sub_bounding_spheres");
+	sub_bounding_spheres->SetAttribute("count", static_cast<int>(TerrainData.SubBoundingSpheres.size()));
+
+	for (auto& iter : TerrainData.SubBoundingSpheres)
+	{
+		auto sub_bounding_sphere = doc.NewElement("sub_bounding_sphere");
+
+		auto center = doc.NewElement("center");
+		center->SetAttribute("x", XMVectorGetX(iter.Center));
+		center->SetAttribute("y", XMVectorGetY(iter.Center));
+		center->SetAttribute("z", XMVectorGetZ(iter.Center));
+
+		auto radius = doc.NewElement("radius");
+		radius->SetText(iter.Radius);
+
+		sub_bounding_sphere->InsertEndChild(center);
+		sub_bounding_sphere->InsertEndChild(radius);
+
+		sub_bounding_spheres->InsertEndChild(sub_bounding_sphere);
+	}
+
+	root->InsertEndChild(terrain_info);
+	root->InsertEndChild(quad_tree);
+	root->InsertEndChild(sub_bounding_spheres);
+
+	doc.InsertFirstChild(root);
+	doc.SaveFile(FilePath.c_str());
+}
+
+static auto AreVectorsEqual(const XMVECTOR& A, const XMVECTOR& B) noexcept->bool
+{
+	return XMVector3Equal(A, B);
+}
+
+static auto AreTerrainsEqual(const STerrainData& A, const STerrainData& B) noexcept->bool
+{
+	if ((A.TerrainSizeX != B.TerrainSizeX) || (A.TerrainSizeZ != B.TerrainSizeZ)) { return false; }
+	if ((A.HeightFactor != B.HeightFactor) || (A.XYSizeFactor != B.XYSizeFactor)) { return false; }
+	if (A.WholeBoundingSphere.Radius != B.WholeBoundingSphere.Radius) { return false; }
+	if (!AreVectorsEqual(A.WholeBoundingSphere.Center, B.WholeBoundingSphere.Center)) { return false; }
+
+	if (A.QuadTree.size() != B.QuadTree.size()) { return false; }
+	for (size_t node_id = 0; node_id < A.QuadTree.size(); ++node_id)
+	{
+		const auto& a = A.QuadTree[node_id];
+		const auto& b = B.QuadTree[node_id];
+
+		if ((a.NodeID != b.NodeID) || (a.ParentID != b.ParentID) || (a.HasMeshes != b.HasMeshes)) { return false; }
+		if (memcmp(a.ChildrenID, b.ChildrenID, sizeof(a.ChildrenID))) { return false; }
+		if ((a.StartX != b.StartX) || (a.StartZ != b.StartZ) || (a.SizeX != b.SizeX) || (a.SizeZ != b.SizeZ)) { return false; }
+		if (!a.HasMeshes) { continue; }
+
+		if (a.SubBoundingVolumeID != b.SubBoundingVolumeID) { return false; }
+		if ((!b.VertexBuffer) || (!b.IndexBuffer)) { return false; }
+
+		const auto& va = a.VertexData.vVerticesModel;
+		const auto& vb = b.VertexData.vVerticesModel;
+		if (va.size() != vb.size()) { return false; }
+		for (size_t vertex_id = 0; vertex_id < va.size(); ++vertex_id)
+		{
+			if (!AreVectorsEqual(va[vertex_id].Position, vb[vertex_id].Position)) { return false; }
+			if (XMVectorGetX(va[vertex_id].TexCoord) != XMVectorGetX(vb[vertex_id].TexCoord)) { return false; }
+			if (XMVectorGetY(va[vertex_id].TexCoord) != XMVectorGetY(vb[vertex_id].TexCoord)) { return false; }
+			if (!AreVectorsEqual(va[vertex_id].Normal, vb[vertex_id].Normal)) { return false; }
+			if (!AreVectorsEqual(va[vertex_id].Tangent, vb[vertex_id].Tangent)) { return false; }
+			if (!AreVectorsEqual(va[vertex_id].Bitangent, vb[vertex_id].Bitangent)) { return false; }
+		}
+
+		if (a.IndexData.vFaces.size() != b.IndexData.vFaces.size()) { return false; }
+		if (memcmp(a.IndexData.GetPtrData(), b.IndexData.GetPtrData(), a.IndexData.vFaces.size() * sizeof(SIndexTriangle))) { return false; }
+	}
+
+	if (A.SubBoundingSpheres.size() != B.SubBoundingSpheres.size()) { return false; }
+	for (size_t sphere_id = 0; sphere_id < A.SubBoundingSpheres.size(); ++sphere_id)
+	{
+		if (A.SubBoundingSpheres[sphere_id].Radius != B.SubBoundingSpheres[sphere_id].Radius) { return false; }
+		if (!AreVectorsEqual(A.SubBoundingSpheres[sphere_id].Center, B.SubBoundingSpheres[sphere_id].Center)) { return false; }
+	}
+
+	return true;
+}
+
+// TRN v2 and XML TRN files (also the converted one) must load to the same terrain, and the load times are compared.
+// Corrupt v2 files must load to an empty terrain.
+void JWEngine::TestTerrainTRN() noexcept
+{
+	static constexpr uint32_t KLeafSize{ 32 };
+
+	auto base_directory = GetTestBaseDirectory();
+	SSize2 window_size{ 800, 600 };
+
+	JWNullGraphicsBackend backend{};
+	backend.SetPayloadRecording(false);
+
+	JWDX dx{};
+	dx.CreateHeadless(window_size, base_directory, &backend);
+
+	JWTerrainGenerator terrain_generator{};
+	terrain_generator.Create(dx, base_directory);
+
+	auto source = MakeTestTerrain(KLeafSize);
+
+	SaveTerrainAsXMLTRN(base_directory + KAssetDirectory + KTestXMLTRNFileName, source);
+	terrain_generator.SaveTerrainAsTRN(KTestBinaryTRNFileName, source);
+	terrain_generator.ConvertXMLTRNToBinaryTRN(KTestXMLTRNFileName, KTestConvertedTRNFileName);
+
+	auto xml_terrain = terrain_generator.LoadTerrainFromTRN(KTestXMLTRNFileName);
+	auto xml_load_time = terrain_generator.GetLastTRNLoadTime();
+
+	auto binary_terrain = terrain_generator.LoadTerrainFromTRN(KTestBinaryTRNFileName);
+	auto binary_load_time = terrain_generator.GetLastTRNLoadTime();
+
+	auto converted_terrain = terrain_generator.LoadTerrainFromTRN(KTestConvertedTRNFileName);
+
+	JW_TEST_CHECK(AreTerrainsEqual(source, xml_terrain));
+	JW_TEST_CHECK(AreTerrainsEqual(source, binary_terrain));
+	JW_TEST_CHECK(AreTerrainsEqual(source, converted_terrain));
+
+	std::cout << "  " << source.QuadTree.size() << " nodes, " << (16 * (KLeafSize + 1) * (KLeafSize + 1)) << " vertices: XML "
+		<< xml_load_time << " us, v2 " << binary_load_time << " us" << std::endl;
+
+	xml_terrain.Destroy();
+	binary_terrain.Destroy();
+	converted_terrain.Destroy();
+
+	// A face index past the node's vertices, or a node/sub-bounding-sphere ID past its table, must be rejected.
+	auto is_rejected = [&](const STerrainData& Corrupt)
+	{
+		terrain_generator.SaveTerrainAsTRN(KTestCorruptTRNFileName, Corrupt);
+		auto loaded = terrain_generator.LoadTerrainFromTRN(KTestCorruptTRNFileName);
+		bool result{ loaded.QuadTree.empty() && loaded.SubBoundingSpheres.empty() };
+		loaded.Destroy();
+		return result;
+	};
+
+	auto leaf_id = source.QuadTree[1].ChildrenID[0];
+	auto vertex_count = static_cast<DWORD>(source.QuadTree[leaf_id].VertexData.vVerticesModel.size());
+	{
+		auto corrupt = source;
+		corrupt.QuadTree[leaf_id].IndexData.vFaces.back()._2 = vertex_count;
+		JW_TEST_CHECK(is_rejected(corrupt));
+	}
+	{
+		auto corrupt = source;
+		corrupt.QuadTree[1].ChildrenID[3] = static_cast<int32_t>(source.QuadTree.size());
+		JW_TEST_CHECK(is_rejected(corrupt));
+	}
+	{
+		auto corrupt = source;
+		corrupt.QuadTree[leaf_id].ParentID = -2;
+		JW_TEST_CHECK(is_rejected(corrupt));
+	}
+	{
+		auto corrupt = source;
+		corrupt.QuadTree[leaf_id].SubBoundingVolumeID = static_cast<int32_t>(source.SubBoundingSpheres.size());
+		JW_TEST_CHECK(is_rejected(corrupt));
+	}
+
+	dx.Destroy();
+
+	for (auto file_name : { KTestXMLTRNFileName, KTestBinaryTRNFileName, KTestConvertedTRNFileName, KTestCorruptTRNFileName })
+	{
+		DeleteFileA((base_directory + KAssetDirectory + file_name).c_str());
+	}
+}
@@ -0,0 +1,123 @@
+#include "JWTest.h"
+#include "../JWGame/JWGame.h"
+#include "../Core/JWNullGraphicsBackend.h"
+#include <random>
+
+using namespace JWEngine;
+
+static JWGame* gs_pTransformGame{};
+
+JW_FUNCTION_ON_RENDER(OnTransformRender)
+{
+	gs_pTransformGame->ECS().ExecuteSystems();
+}
+
+static void MarkEveryWorldMatrixDirty(JWSystemTransform& SystemTransform) noexcept
+{
+	for (auto& iter : SystemTransform.ComponentPool())
+	{
+		iter.MarkWorldMatrixDirty();
+	}
+}
+
+static auto GetMaxDifference(const XMMATRIX& A, const XMMATRIX& B) noexcept->float
+{
+	float result{};
+	for (int row = 0; row < 4; ++row)
+	{
+		auto difference = XMVectorAbs(XMVectorSubtract(A.r[row], B.r[row]));
+		result = max(result, max(max(XMVectorGetX(difference), XMVectorGetY(difference)),
+			max(XMVectorGetZ(difference), XMVectorGetW(difference))));
+	}
+	return result;
+}
+
+// The SoA path must build the same world matrices as the AoS reference for every calculation order,
+// and both are timed at 100k components.
+void JWEngine::TestTransform() noexcept
+{
+	static constexpr uint32_t KComponentCount{ 100'000 };
+	static constexpr uint32_t KRepeatCount{ 10 };
+	static constexpr float KMaxDifference{ 0.001f };
+
+	JWNullGraphicsBackend backend{};
+	backend.SetPayloadRecording(false);
+
+	auto game = MAKE_UNIQUE(JWGame)();
+	gs_pTransformGame = game.get();
+
+	game->CreateHeadless(SSize2(800, 600), GetTestBaseDirectory(), &backend);
+	game->SetFunctionOnRender(OnTransformRender);
+
+	auto& ecs = game->ECS();
+	auto& system_transform = ecs.SystemTransform();
+
+	{
+		auto camera_0 = ecs.CreateEntity("camera_0");
+		camera_0->CreateComponentTransform()->SetPosition(XMVectorSet(0.0f, 0.0f, -10.0f, 1.0f));
+		camera_0->CreateComponentCamera()->CreatePerspectiveCamera(ECameraType::FreeLook);
+	}
+
+	std::mt19937 random{ 1 };
+	std::uniform_real_distribution<float> position{ -100.0f, 100.0f };
+	std::uniform_real_distribution<float> scaling{ 0.1f, 4.0f };
+	std::uniform_real_distribution<float> angle{ -XM_PI, XM_PI };
+
+	for (uint32_t iter = 0; iter < KComponentCount; ++iter)
+	{
+		auto transform = ecs.CreateEntity("transform_" + TO_STRING(iter))->CreateComponentTransform();
+		transform->SetPosition(XMVectorSet(position(random), position(random), position(random), 1.0f));
+		transform->SetScalingFactor(XMVectorSet(scaling(random), scaling(random), scaling(random), 0.0f));
+		transform->SetPitchYawRoll(angle(random), angle(random), angle(random));
+		transform->SetWorldMatrixCalculationOrder(
+			static_cast<EWorldMatrixCalculationOrder>(iter % KWorldMatrixCalculationOrderCount));
+	}
+
+	// AoS reference
+	system_transform.SetWorldMatrixBuildPath(EWorldMatrixBuildPath::AoS);
+	system_transform.Execute();
+	JW_TEST_CHECK(system_transform.GetRecomputedWorldMatrixCount() == KComponentCount + 1);
+
+	VECTOR<XMMATRIX> reference_matrices{};
+	for (const auto& iter : system_transform.ComponentPool())
+	{
+		reference_matrices.emplace_back(iter.WorldMatrix);
+	}
+
+	// Nothing is rebuilt while nothing is dirty.
+	system_transform.Execute();
+	JW_TEST_CHECK(system_transform.GetRecomputedWorldMatrixCount() == 0);
+
+	// SoA
+	system_transform.SetWorldMatrixBuildPath(EWorldMatrixBuildPath::SoA);
+	MarkEveryWorldMatrixDirty(system_transform);
+	system_transform.Execute();
+
+	float max_difference{};
+	size_t component_index{};
+	for (const auto& iter : system_transform.ComponentPool())
+	{
+		max_difference = max(max_difference, GetMaxDifference(iter.WorldMatrix, reference_matrices[component_index++]));
+	}
+	JW_TEST_CHECK(component_index == reference_matrices.size());
+	JW_TEST_CHECK(max_difference < KMaxDifference);
+
+	// Timings (every component dirty, as after a full scene update)
+	long long build_times[2]{};
+	for (auto path : { EWorldMatrixBuildPath::AoS, EWorldMatrixBuildPath::SoA })
+	{
+		system_transform.SetWorldMatrixBuildPath(path);
+		for (uint32_t iter = 0; iter < KRepeatCount; ++iter)
+		{
+			MarkEveryWorldMatrixDirty(system_transform);
+			system_transform.Execute();
+			build_times[static_cast<uint32_t>(path)] += system_transform.GetWorldMatrixBuildTime();
+		}
+	}
+
+	std::cout << "  " << KComponentCount << " components: AoS " << build_times[0] / KRepeatCount << " us, SoA "
+		<< build_times[1] / KRepeatCount << " us (max difference " << max_difference << ")" << std::endl;
+
+	game->RunHeadless(1, 16'666);
+	JW_TEST_CHECK(backend.GetCounters().FrameCount == 1);
+}
@@ -0,0 +1,92 @@
+#include "../Core/JWLogger.h"
+#include "JWTest.h"
+
+using namespace JWEngine;
+
+JW_LOGGER_DECL;
+
+uint32_t JWEngine::ex_FailedCheckCount{};
+bool JWEngine::ex_ShouldUpdateGoldenFiles{};
+
+struct STest
+{
+	const char*	Name{};
+	void		(*Function)() noexcept {};
+};
+
+static const STest KTests[]{
+	{ "NullGraphicsBackend", TestNullGraphicsBackend },
+	{ "BroadPhase", TestBroadPhase },
+	{ "TerrainTRN", TestTerrainTRN },
+	{ "Animation", TestAnimation },
+	{ "JobSystem", TestJobSystem },
+	{ "Transform", TestTransform },
+	{ "NarrowPhase", TestNarrowPhase },
+	{ "SceneQuery", TestSceneQuery },
+	{ "FrustumCuller", TestFrustumCuller },
+	{ "RenderQueue", TestRenderQueue },
+	{ "SoftwareRasterizer", TestSoftwareRasterizer },
+	{ "ContactSolver", TestContactSolver },
+	{ "CCD", TestCCD },
+	{ "PhysicsSnapshot", TestPhysicsSnapshot },
+	{ "ECS", TestECS },
+};
+
+auto JWEngine::GetTestBaseDirectory() noexcept->STRING
+{
+	char current_directory[KMaxFileLength];
+	GetCurrentDirectory(KMaxFileLength, current_directory);
+
+	STRING base_directory = current_directory;
+	auto find_project_name = base_directory.find(KTestProjectName);
+	base_directory = base_directory.substr(0, find_project_name - 1);
+	base_directory += "\\";
+
+	return base_directory;
+}
+
+// Runs every test (or only the ones whose names are given as arguments) and returns the number of failed tests.
+// --update-golden rewrites the golden files of the tests that are run.
+int main(int argc, char* argv[])
+{
+	JW_LOGGER_INITIALIZE;
+
+	VECTOR<STRING> selected_test_names{};
+	for (int arg_id = 1; arg_id < argc; ++arg_id)
+	{
+		if (STRING(argv[arg_id]) == "--update-golden")
+		{
+			ex_ShouldUpdateGoldenFiles = true;
+			continue;
+		}
+		selected_test_names.emplace_back(argv[arg_id]);
+	}
+
+	int failed_test_count{};
+
+	for (const auto& test : KTests)
+	{
+		if ((selected_test_names.size()) &&
+			(std::find(selected_test_names.begin(), selected_test_names.end(), test.Name) == selected_test_names.end()))
+		{
+			continue;
+		}
+
+		std::cout << "[RUN] " << test.Name << std::endl;
+
+		ex_FailedCheckCount = 0;
+		test.Function();
+
+		if (ex_FailedCheckCount)
+		{
+			std::cout << "[FAILED] " << test.Name << " (" << ex_FailedCheckCount << " checks)" << std::endl;
+			++failed_test_count;
+		}
+		else
+		{
+			std::cout << "[OK] " << test.Name << std::endl;
+		}
+	}
+
+	return failed_test_count;
+}
@@ -91,6 +91,34 @@ void JWGame::Create(EAllowedDisplayMode DisplayMode, SPosition2 WindowPosition,
 	JW_LOG_METHOD_END(0);
 }
 
+void JWGame::CreateHeadless(const SSize2& WindowSize, STRING BaseDirectory, JWGraphicsBackend* pBackend) noexcept
+{
+	JW_LOG_METHOD_START(0);
+
+	if (!m_IsCreated)
+	{
+		m_BaseDirectory = BaseDirectory;
+		m_IsHeadless = true;
+
+		m_WindowSize = WindowSize;
+
+		m_DX.CreateHeadless(m_WindowSize, m_BaseDirectory, pBackend);
+		m_DX.SetRasterizerState(ERasterizerState::SolidNoCull);
+
+		m_IsDXCreated = true;
+
+		JW_LOG_D(0, "DX created (headless)");
+
+		m_ECS.Create(m_DX, nullptr, m_WindowSize, m_BaseDirectory);
+
+		JW_LOG_D(0, "ECS created");
+
+		m_IsCreated = true;
+	}
+
+	JW_LOG_METHOD_END(0);
+}
+
 void JWGame::LoadCursorImage(STRING FileName) noexcept
 {
 	m_MouseCursorImage.LoadImageCursorFromFile(m_BaseDirectory + KAssetDirectory, FileName);
@@ -252,6 +280,35 @@ void JWGame::Run() noexcept
 	JW_LOGGER_SAVE(m_BaseDirectory + "\\LOG.txt");
 }
 
+void JWGame::RunHeadless(uint32_t FrameCount, long long DeltaTime) noexcept
+{
+	JW_LOG_METHOD_START(0);
+
+	assert(m_IsHeadless);
+	assert(m_IsDXCreated);
+	assert(m_fpOnRender);
+
+	for (uint32_t frame = 0; frame < FrameCount; ++frame)
+	{
+		m_ECS.UpdateDeltaTime(DeltaTime);
+
+		// Begin the drawing process
+		m_DX.BeginDrawing();
+
+		// Call the outter OnRender function.
+		m_fpOnRender();
+
+		// End the drawing process
+		m_DX.EndDrawing();
+	}
+
+	// Destroy all the objects
+	m_ECS.Destroy();
+	m_DX.Destroy();
+
+	JW_LOG_METHOD_END(0);
+}
+
 void JWGame::Halt() noexcept
 {
 	m_IsRunning = false;
@@ -28,6 +28,11 @@ namespace JWEngine
 
 		void Create(EAllowedDisplayMode DisplayMode, SPosition2 WindowPosition, STRING WindowTitle, STRING GameFontFileName) noexcept;
 
+		// @important
+		// No window, input, instant text, raw pixel setter or mouse cursor is created.
+		// Every GPU command goes to pBackend (see JWDX::CreateHeadless()), which must outlive the game.
+		void CreateHeadless(const SSize2& WindowSize, STRING BaseDirectory, JWGraphicsBackend* pBackend) noexcept;
+
 		void LoadCursorImage(STRING FileName) noexcept;
 
 		void SetFunctionOnInput(FP_ON_INPUT Function) noexcept;
@@ -59,12 +64,16 @@ namespace JWEngine
 		void Run() noexcept;
 		void Halt() noexcept;
 
+		// Runs FrameCount frames with a fixed delta time (no input), then destroys all the objects as Run() does.
+		void RunHeadless(uint32_t FrameCount, long long DeltaTime) noexcept;
+
 	private:
 		bool					m_IsCreated{ false };
 		bool					m_IsWindowCreated{ false };
 		bool					m_IsDXCreated{ false };
 		bool					m_IsRunning{ false };
 		bool					m_IsMouseCursorLoaded{ false };
+		bool					m_IsHeadless{ false };
 		
 		STRING					m_BaseDirectory;
 		SSize2					m_ScreenResolution{};
@@ -108,7 +108,7 @@ int main()
 		auto debug_point = ecs.CreateEntity(EEntityType::Point3D);
 
 		auto transform = debug_point->CreateComponentTransform();
-		transform->Position = XMVectorSet(0.0f, 0.0f, 10.0f, 1.0f);
+		transform->SetPosition(XMVectorSet(0.0f, 0.0f, 10.0f, 1.0f));
 
 		auto render = debug_point->CreateComponentRender();
 		render->SetModel(ecs.SystemRender().GetSharedModelByName("POINT_3D"));
@@ -156,8 +156,8 @@ int main()
 		auto SKY_SPHERE = ecs.CreateEntity(EEntityType::Sky);
 
 		auto transform = SKY_SPHERE->CreateComponentTransform();
-		transform->WorldMatrixCalculationOrder = EWorldMatrixCalculationOrder::ScaleRotTrans;
-		transform->Position = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
+		transform->SetWorldMatrixCalculationOrder(EWorldMatrixCalculationOrder::ScaleRotTrans);
+		transform->SetPosition(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f));
 
 		auto render = SKY_SPHERE->CreateComponentRender();
 		render->SetModel(ecs.SystemRender().GetSharedModelByName("SKY_SPHERE"));
@@ -171,9 +171,9 @@ int main()
 		auto main_sprite = ecs.CreateEntity(EEntityType::MainSprite);
 
 		auto transform = main_sprite->CreateComponentTransform();
-		transform->WorldMatrixCalculationOrder = EWorldMatrixCalculationOrder::ScaleRotTrans;
-		transform->Position = XMVectorSet(4.0f, 2.8f, 0.0f, 1.0f);
-		transform->ScalingFactor = { 0.02f, 0.02f, 0.02f };
+		transform->SetWorldMatrixCalculationOrder(EWorldMatrixCalculationOrder::ScaleRotTrans);
+		transform->SetPosition(XMVectorSet(4.0f, 2.8f, 0.0f, 1.0f));
+		transform->SetScalingFactor(XMVectorSet(0.02f, 0.02f, 0.02f, 0.0f));
 		
 		auto physics = main_sprite->CreateComponentPhysics();
 		physics->BoundingSphere = SBoundingSphereData(3.0f, 0.0f, -0.5f, 0.0f);
@@ -196,13 +196,14 @@ int main()
 		auto terrain_data = ecs.SystemRender().GetSharedTerrain(0);
 		
 		auto transform = terrain->CreateComponentTransform();
-		transform->WorldMatrixCalculationOrder = EWorldMatrixCalculationOrder::ScaleRotTrans;
-		transform->Position = XMVectorSet(-10.0f, -10.0f, 10.0f, 1.0f);
+		transform->SetWorldMatrixCalculationOrder(EWorldMatrixCalculationOrder::ScaleRotTrans);
+		transform->SetPosition(XMVectorSet(-10.0f, -10.0f, 10.0f, 1.0f));
 
 		auto physics = terrain->CreateComponentPhysics();
 		physics->SetMassToInfinite();
 		physics->BoundingSphere = terrain_data->WholeBoundingSphere;
 		physics->SubBoundingSpheres = terrain_data->SubBoundingSpheres;
+		physics->SetHeightFieldCollider(terrain_data);
 
 		auto render = terrain->CreateComponentRender();
 		render->SetTerrain(terrain_data);
@@ -216,10 +217,11 @@ int main()
 		auto camera_0 = ecs.CreateEntity("camera_0");
 
 		auto transform = camera_0->CreateComponentTransform();
-		transform->Position = XMVectorSet(0.0f, 12.0f, -20.0f, 1.0f);
+		transform->SetPosition(XMVectorSet(0.0f, 12.0f, -20.0f, 1.0f));
 		transform->RotatePitchYawRoll(XMFLOAT3(XM_PIDIV2 * 1.3f, 0, 0), true);
 
 		auto physics = camera_0->CreateComponentPhysics();
+		physics->SetQueryOnly();
 		
 		auto camera = camera_0->CreateComponentCamera();
 		camera->CreatePerspectiveCamera(ECameraType::FreeLook);
@@ -232,9 +234,10 @@ int main()
 		auto camera_1 = ecs.CreateEntity("camera_1");
 
 		auto transform = camera_1->CreateComponentTransform();
-		transform->Position = XMVectorSet(0.0f, 12.0f, 0.0f, 1.0f);
+		transform->SetPosition(XMVectorSet(0.0f, 12.0f, 0.0f, 1.0f));
 
 		auto physics = camera_1->CreateComponentPhysics();
+		physics->SetQueryOnly();
 
 		auto camera = camera_1->CreateComponentCamera();
 		camera->CreatePerspectiveCamera(ECameraType::FreeLook);
@@ -247,12 +250,13 @@ int main()
 		auto ambient_light = ecs.CreateEntity("ambient_light");
 
 		auto transform = ambient_light->CreateComponentTransform();
-		transform->Position = XMVectorSet(0.0f, 10.0f, 0.0f, 1.0f);
+		transform->SetPosition(XMVectorSet(0.0f, 10.0f, 0.0f, 1.0f));
 		
 		auto light = ambient_light->CreateComponentLight();
 		light->MakeAmbientLight(XMFLOAT3(1.0f, 1.0f, 1.0f), 0.5f);
 
 		auto physics = ambient_light->CreateComponentPhysics();
+		physics->SetQueryOnly();
 
 		auto render = ambient_light->CreateComponentRender();
 		render->SetModel(ecs.SystemRender().GetSharedModelByName("LIGHT"));
@@ -264,12 +268,13 @@ int main()
 		auto directional_light = ecs.CreateEntity("directional_light");
 
 		auto transform = directional_light->CreateComponentTransform();
-		transform->Position = XMVectorSet(3.0f, 10.0f, -3.0f, 1.0f);
+		transform->SetPosition(XMVectorSet(3.0f, 10.0f, -3.0f, 1.0f));
 
 		auto light = directional_light->CreateComponentLight();
 		light->MakeDirectionalLight(XMFLOAT3(1.0f, 1.0f, 1.0f), XMFLOAT3(-1.0f, -1.0f, -1.0f), 0.6f);
 
 		auto physics = directional_light->CreateComponentPhysics();
+		physics->SetQueryOnly();
 
 		auto render = directional_light->CreateComponentRender();
 		render->SetModel(ecs.SystemRender().GetSharedModelByName("LIGHT"));
@@ -281,8 +286,8 @@ int main()
 		auto box = ecs.CreateEntity("box");
 
 		auto transform = box->CreateComponentTransform();
-		transform->ScalingFactor = XMVectorSet(32, 1.0f, 32, 0.0f);
-		transform->Position = XMVectorSet(0.0f, 0, 0.0f, 1.0f);
+		transform->SetScalingFactor(XMVectorSet(32, 1.0f, 32, 0.0f));
+		transform->SetPosition(XMVectorSet(0.0f, 0, 0.0f, 1.0f));
 		//transform->SetPitchYawRoll(0, 0, 0.2f);
 
 		auto physics = box->CreateComponentPhysics();
@@ -298,9 +303,9 @@ int main()
 		auto simple_box = ecs.CreateEntity("simple_box");
 
 		auto transform = simple_box->CreateComponentTransform();
-		//transform->Position = XMVectorSet(-14.0f, 2.5f, 0.0f, 1.0f);
-		//transform->Position = XMVectorSet(-16.0f, 2.7f, 0.0f, 1.0f);
-		transform->Position = XMVectorSet(-10.0f, 2.0f, 0.0f, 1.0f);
+		//transform->SetPosition(XMVectorSet(-14.0f, 2.5f, 0.0f, 1.0f));
+		//transform->SetPosition(XMVectorSet(-16.0f, 2.7f, 0.0f, 1.0f));
+		transform->SetPosition(XMVectorSet(-10.0f, 2.0f, 0.0f, 1.0f));
 		//transform->SetPitchYawRoll(0, 0, 0.3f);
 
 		auto physics = simple_box->CreateComponentPhysics();
@@ -320,9 +325,9 @@ int main()
 		auto oil_drum = ecs.CreateEntity("oil_drum");
 
 		auto transform = oil_drum->CreateComponentTransform();
-		transform->WorldMatrixCalculationOrder = EWorldMatrixCalculationOrder::ScaleRotTrans;
-		transform->Position = XMVectorSet(-10.0f, 0.0f, 0.0f, 1.0f);
-		transform->ScalingFactor = { 0.1f, 0.1f, 0.1f };
+		transform->SetWorldMatrixCalculationOrder(EWorldMatrixCalculationOrder::ScaleRotTrans);
+		transform->SetPosition(XMVectorSet(-10.0f, 0.0f, 0.0f, 1.0f));
+		transform->SetScalingFactor(XMVectorSet(0.1f, 0.1f, 0.1f, 0.0f));
 		transform->SetPitchYawRoll(0, 0, 0.3f);
 
 		auto physics = oil_drum->CreateComponentPhysics();
@@ -342,9 +347,9 @@ int main()
 		auto jar = ecs.CreateEntity("jar");
 
 		auto transform = jar->CreateComponentTransform();
-		transform->WorldMatrixCalculationOrder = EWorldMatrixCalculationOrder::ScaleRotTrans;
-		transform->Position = XMVectorSet(0, 4.0f, 0.0f, 1.0f);
-		transform->ScalingFactor = { 0.05f, 0.05f, 0.05f };
+		transform->SetWorldMatrixCalculationOrder(EWorldMatrixCalculationOrder::ScaleRotTrans);
+		transform->SetPosition(XMVectorSet(0, 4.0f, 0.0f, 1.0f));
+		transform->SetScalingFactor(XMVectorSet(0.05f, 0.05f, 0.05f, 0.0f));
 		transform->SetPitchYawRoll(0, 0, 0.2f);
 
 		auto physics = jar->CreateComponentPhysics();
@@ -363,9 +368,9 @@ int main()
 		auto recycling_bin = ecs.CreateEntity("recycling_bin");
 
 		auto transform = recycling_bin->CreateComponentTransform();
-		transform->WorldMatrixCalculationOrder = EWorldMatrixCalculationOrder::ScaleRotTrans;
-		transform->Position = XMVectorSet(18.0f, 10.0f, 0.0f, 1.0f);
-		transform->ScalingFactor = { 0.06f, 0.06f, 0.06f };
+		transform->SetWorldMatrixCalculationOrder(EWorldMatrixCalculationOrder::ScaleRotTrans);
+		transform->SetPosition(XMVectorSet(18.0f, 10.0f, 0.0f, 1.0f));
+		transform->SetScalingFactor(XMVectorSet(0.06f, 0.06f, 0.06f, 0.0f));
 
 		auto physics = recycling_bin->CreateComponentPhysics();
 		physics->BoundingSphere = SBoundingSphereData(1.6f, 0.0f, 0.26f, 0.0f);
@@ -539,8 +544,8 @@ JW_FUNCTION_ON_WINDOWS_CHAR_INPUT(OnWindowsCharKeyInput)
 	{
 		ecs.SystemPhysics().ZeroAllVelocities();
 
-		ecs.GetEntityByName("jar")->GetComponentTransform()->Position = XMVectorSet(0.0f, 4.0f, 0.0f, 1.0f);
-		ecs.GetEntityByName("oil_drum")->GetComponentTransform()->Position = XMVectorSet(-10.0f, 0.0f, 0.0f, 1.0f);
+		ecs.GetEntityByName("jar")->GetComponentTransform()->SetPosition(XMVectorSet(0.0f, 4.0f, 0.0f, 1.0f));
+		ecs.GetEntityByName("oil_drum")->GetComponentTransform()->SetPosition(XMVectorSet(-10.0f, 0.0f, 0.0f, 1.0f));
 	}
 }
 
@@ -613,20 +618,20 @@ JW_FUNCTION_ON_RENDER(OnRender)
 	auto& ecs = myGame.ECS();
 
 	// 3D Point for debugging
-	ecs.GetEntityByType(EEntityType::Point3D)->GetComponentTransform()->Position = ecs.SystemPhysics().GetPickedPoint();
+	ecs.GetEntityByType(EEntityType::Point3D)->GetComponentTransform()->SetPosition(ecs.SystemPhysics().GetPickedPoint());
 
-	ecs.GetEntityByName("closest_a0")->GetComponentTransform()->Position = ecs.SystemPhysics().GetClosestFaceA().V0;
-	ecs.GetEntityByName("closest_a1")->GetComponentTransform()->Position = ecs.SystemPhysics().GetClosestFaceA().V1;
-	ecs.GetEntityByName("closest_a2")->GetComponentTransform()->Position = ecs.SystemPhysics().GetClosestFaceA().V2;
+	ecs.GetEntityByName("closest_a0")->GetComponentTransform()->SetPosition(ecs.SystemPhysics().GetClosestFaceA().V0);
+	ecs.GetEntityByName("closest_a1")->GetComponentTransform()->SetPosition(ecs.SystemPhysics().GetClosestFaceA().V1);
+	ecs.GetEntityByName("closest_a2")->GetComponentTransform()->SetPosition(ecs.SystemPhysics().GetClosestFaceA().V2);
 	
-	ecs.GetEntityByName("closest_b0")->GetComponentTransform()->Position = ecs.SystemPhysics().GetClosestFaceB().V0;
-	ecs.GetEntityByName("closest_b1")->GetComponentTransform()->Position = ecs.SystemPhysics().GetClosestFaceB().V1;
-	ecs.GetEntityByName("closest_b2")->GetComponentTransform()->Position = ecs.SystemPhysics().GetClosestFaceB().V2;
+	ecs.GetEntityByName("closest_b0")->GetComponentTransform()->SetPosition(ecs.SystemPhysics().GetClosestFaceB().V0);
+	ecs.GetEntityByName("closest_b1")->GetComponentTransform()->SetPosition(ecs.SystemPhysics().GetClosestFaceB().V1);
+	ecs.GetEntityByName("closest_b2")->GetComponentTransform()->SetPosition(ecs.SystemPhysics().GetClosestFaceB().V2);
 
-	ecs.GetEntityByName("collision_point")->GetComponentTransform()->Position = ecs.SystemPhysics().GetClosestFaceB().V2;
+	ecs.GetEntityByName("collision_point")->GetComponentTransform()->SetPosition(ecs.SystemPhysics().GetClosestFaceB().V2);
 
 	// ECS entity Skybox
-	ecs.GetEntityByType(EEntityType::Sky)->GetComponentTransform()->Position = ecs.SystemCamera().GetCurrentCameraPosition();
+	ecs.GetEntityByType(EEntityType::Sky)->GetComponentTransform()->SetPosition(ecs.SystemCamera().GetCurrentCameraPosition());
 	
 	// ECS Physics - Gravity
 	ecs.SystemPhysics().ApplyUniversalGravity();
@@ -65,19 +65,24 @@ VS_OUTPUT_MODEL main(VS_INPUT_MODEL input)
 	uint temp_flag = Flag;
 
 	float4 position_result = float4(input.Position.xyz, 1.0);
+	float4 normal_result = float4(input.Normal.xyz, 0.0);
+	float4 tangent_result = float4(input.Tangent.xyz, 0.0);
+	float4 bitangent_result = float4(input.Bitangent.xyz, 0.0);
 
 	// Check if the model is instanced
 	if (temp_flag == EVS_INSTANCED)
 	{
+		// @important: World is identity for instanced draws, each instance carries its own world matrix.
 		float4x4 instance_world = float4x4(input.InstanceWorld0, input.InstanceWorld1, input.InstanceWorld2, input.InstanceWorld3);
 
 		position_result = mul(position_result, instance_world);
+		normal_result = mul(normal_result, instance_world);
+		tangent_result = mul(tangent_result, instance_world);
+		bitangent_result = mul(bitangent_result, instance_world);
 
 		temp_flag -= EVS_INSTANCED;
 	}
 
-	float4 normal_result = float4(input.Normal.xyz, 0.0);
-
 	// Check if the model is rigged
 	if (temp_flag > EVS_NO_ANIMATION)
 	{
@@ -113,8 +118,8 @@ VS_OUTPUT_MODEL main(VS_INPUT_MODEL input)
 	output.WorldPosition = mul(position_result, World).xyz;
 	output.Normal = normalize(mul(normal_result, World).xyz);
 	output.WVPNormal = normalize(mul(input.Normal, WVP)); // This will be used in GS
-	output.Tangent = normalize(mul(input.Tangent, World).xyz);
-	output.Bitangent = normalize(mul(input.Bitangent, World).xyz);
+	output.Tangent = normalize(mul(tangent_result, World).xyz);
+	output.Bitangent = normalize(mul(bitangent_result, World).xyz);
 
 	output.TexCoord = input.TexCoord;
 	output.Diffuse = input.Diffuse;